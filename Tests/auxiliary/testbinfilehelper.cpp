@@ -0,0 +1,264 @@
+/***************************************************************************
+                         testbinfilehelper.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testbinfilehelper.h"
+#include "skyobjects/deepstardata.h"
+#include "skyobjects/stardata.h"
+
+/* Qt Includes */
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+/* STL Includes */
+#include <cstring>
+
+// Same mesh as the deep star catalogs, HTM level 6
+#define CATALOG_TRIXELS 32768
+#define CATALOG_RECORDS 16
+
+namespace
+{
+starData syntheticStar(quint32 trixel, quint32 index)
+{
+    starData star;
+
+    memset(&star, 0, sizeof(starData));
+    star.RA       = static_cast<qint32>(trixel * 1000 + index);
+    star.Dec      = -static_cast<qint32>(index);
+    star.HD       = static_cast<qint32>(trixel ^ index);
+    star.mag      = static_cast<qint16>(index * 10);
+    star.bv_index = static_cast<qint16>(trixel % 300);
+    star.flags    = static_cast<char>(index & 0x7F);
+
+    return star;
+}
+
+bool sameStar(const starData &a, const starData &b)
+{
+    return memcmp(&a, &b, sizeof(starData)) == 0;
+}
+}
+
+TestBinFileHelper::TestBinFileHelper() : QObject()
+{
+}
+
+TestBinFileHelper::~TestBinFileHelper()
+{
+}
+
+void TestBinFileHelper::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    catalogPath = writeCatalog("testbinfilehelper.dat", CATALOG_TRIXELS, CATALOG_RECORDS);
+    QVERIFY(!catalogPath.isEmpty());
+}
+
+void TestBinFileHelper::cleanupTestCase()
+{
+    QFile::remove(catalogPath);
+}
+
+/*
+ * Writes a catalog in the format of the star data files: the text preamble, the field descriptors, the index table with
+ * absolute offsets and then the records of every trixel, one after the other. Records of the last trixel beyond
+ * truncate are left out of the file, although the index still counts them.
+ */
+QString TestBinFileHelper::writeCatalog(const QString &fileName, quint32 trixels, quint32 recordsPerTrixel,
+                                        quint32 truncate)
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/kstars";
+    QDir().mkpath(dir);
+
+    QFile file(dir + '/' + fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return QString();
+
+    char preamble[124];
+    memset(preamble, 0, sizeof(preamble));
+    strncpy(preamble, "KStars Star Data v1.0. To be read using the 32-bit starData structure only", sizeof(preamble));
+    file.write(preamble, sizeof(preamble));
+
+    qint16 endian = 0x4B53;
+    quint8 version = 1;
+    qint16 nfields = 1;
+    file.write(reinterpret_cast<const char *>(&endian), 2);
+    file.write(reinterpret_cast<const char *>(&version), 1);
+    file.write(reinterpret_cast<const char *>(&nfields), 2);
+
+    // A single field covering the whole record is enough for the record size to be 32 bytes
+    dataElement field;
+    memset(&field, 0, sizeof(dataElement));
+    strncpy(field.name, "record", sizeof(field.name));
+    field.size = sizeof(starData);
+    field.type = BinFileHelper::DT_CHARV;
+    file.write(reinterpret_cast<const char *>(&field), sizeof(dataElement));
+
+    file.write(reinterpret_cast<const char *>(&trixels), 4);
+
+    // The data section starts with faintmag, htm_level and MSpT
+    quint32 offset = file.pos() + trixels * 12 + 5;
+    for (quint32 i = 0; i < trixels; i++)
+    {
+        file.write(reinterpret_cast<const char *>(&i), 4);
+        file.write(reinterpret_cast<const char *>(&offset), 4);
+        file.write(reinterpret_cast<const char *>(&recordsPerTrixel), 4);
+        offset += recordsPerTrixel * sizeof(starData);
+    }
+
+    qint16 faintmag = 800;
+    quint8 htm_level = 6;
+    quint16 MSpT = recordsPerTrixel;
+    file.write(reinterpret_cast<const char *>(&faintmag), 2);
+    file.write(reinterpret_cast<const char *>(&htm_level), 1);
+    file.write(reinterpret_cast<const char *>(&MSpT), 2);
+
+    for (quint32 i = 0; i < trixels; i++)
+    {
+        quint32 records = (truncate && i == trixels - 1) ? truncate : recordsPerTrixel;
+        for (quint32 j = 0; j < records; j++)
+        {
+            starData star = syntheticStar(i, j);
+            file.write(reinterpret_cast<const char *>(&star), sizeof(starData));
+        }
+    }
+
+    return file.fileName();
+}
+
+void TestBinFileHelper::compareWithFread()
+{
+    BinFileHelper mapped, unmapped;
+
+    QVERIFY(mapped.openFile("testbinfilehelper.dat"));
+    QVERIFY(mapped.readHeader());
+    QVERIFY(mapped.mapFile());
+    QVERIFY(mapped.isMapped());
+
+    FILE *dataFile = unmapped.openFile("testbinfilehelper.dat");
+    QVERIFY(dataFile);
+    QVERIFY(unmapped.readHeader());
+    QVERIFY(!unmapped.isMapped());
+    QVERIFY(!unmapped.getRecords<starData>(0).isValid());
+
+    for (int i = 0; i < CATALOG_TRIXELS; i++)
+    {
+        const BinFileRecords<starData> records = mapped.getRecords<starData>(i);
+        QVERIFY(records.isValid());
+        QCOMPARE(records.size(), unmapped.getRecordCount(i));
+
+        BinFileHelper::unsigned_KDE_fseek(dataFile, unmapped.getOffset(i), SEEK_SET);
+        for (quint32 j = 0; j < records.size(); j++)
+        {
+            starData star;
+            QVERIFY(fread(&star, sizeof(starData), 1, dataFile) == 1);
+            QVERIFY(sameStar(records.at(j), star));
+            QVERIFY(sameStar(records.at(j), syntheticStar(i, j)));
+        }
+    }
+
+    // Closing the file releases the mapping
+    mapped.closeFile();
+    QVERIFY(!mapped.isMapped());
+    QVERIFY(!mapped.getRecords<starData>(0).isValid());
+    unmapped.closeFile();
+}
+
+void TestBinFileHelper::mismatchedRecordSize()
+{
+    BinFileHelper reader;
+
+    // Mapping needs the index
+    QVERIFY(reader.openFile("testbinfilehelper.dat"));
+    QVERIFY(!reader.mapFile());
+    QVERIFY(reader.readHeader());
+    QVERIFY(reader.mapFile());
+
+    QVERIFY(reader.getRecords<starData>(0).isValid());
+    QVERIFY(!reader.getRecords<deepStarData>(0).isValid());
+
+    reader.closeFile();
+}
+
+void TestBinFileHelper::truncatedFile()
+{
+    QString path = writeCatalog("testbinfilehelper-truncated.dat", 8, CATALOG_RECORDS, CATALOG_RECORDS / 2);
+    QVERIFY(!path.isEmpty());
+
+    // The last trixel points past the end of the file, its records must not be read from memory
+    BinFileHelper reader;
+    QVERIFY(reader.openFile("testbinfilehelper-truncated.dat"));
+    QVERIFY(reader.readHeader());
+    QVERIFY(!reader.mapFile());
+    QVERIFY(!reader.isMapped());
+    QVERIFY(!reader.getRecords<starData>(0).isValid());
+
+    reader.closeFile();
+    QFile::remove(path);
+}
+
+void TestBinFileHelper::benchmarkReadRecords_data()
+{
+    QTest::addColumn<bool>("map");
+
+    QTest::newRow("fread") << false;
+    QTest::newRow("mapped") << true;
+}
+
+void TestBinFileHelper::benchmarkReadRecords()
+{
+    QFETCH(bool, map);
+
+    BinFileHelper reader;
+    FILE *dataFile = reader.openFile("testbinfilehelper.dat");
+    QVERIFY(dataFile);
+    QVERIFY(reader.readHeader());
+    if (map)
+        QVERIFY(reader.mapFile());
+
+    qint64 sum = 0;
+
+    // Visits every record, as DeepStarComponent::loadStaticStars does
+    QBENCHMARK
+    {
+        for (int i = 0; i < CATALOG_TRIXELS; i++)
+        {
+            const BinFileRecords<starData> records = reader.getRecords<starData>(i);
+            starData star;
+
+            if (!records.isValid())
+                BinFileHelper::unsigned_KDE_fseek(dataFile, reader.getOffset(i), SEEK_SET);
+
+            for (quint32 j = 0; j < reader.getRecordCount(i); j++)
+            {
+                if (records.isValid())
+                    star = records.at(j);
+                else if (fread(&star, sizeof(starData), 1, dataFile) != 1)
+                    break;
+                sum += star.mag;
+            }
+        }
+    }
+
+    QVERIFY(sum > 0);
+    reader.closeFile();
+}
+
+QTEST_GUILESS_MAIN(TestBinFileHelper)
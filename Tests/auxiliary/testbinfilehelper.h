@@ -0,0 +1,56 @@
+/***************************************************************************
+                          testbinfilehelper.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTBINFILEHELPER_H
+#define TESTBINFILEHELPER_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "auxiliary/binfilehelper.h"
+
+/**
+ * @class TestBinFileHelper
+ * @short Compares the records of a memory mapped star catalog with those read through fread, and benchmarks both
+ * @author agent <agent@local>
+ */
+class TestBinFileHelper : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestBinFileHelper();
+    ~TestBinFileHelper();
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void compareWithFread();
+    void mismatchedRecordSize();
+    void truncatedFile();
+
+    void benchmarkReadRecords_data();
+    void benchmarkReadRecords();
+
+  private:
+    QString writeCatalog(const QString &fileName, quint32 trixels, quint32 recordsPerTrixel, quint32 truncate = 0);
+
+    QString catalogPath;
+};
+
+#endif
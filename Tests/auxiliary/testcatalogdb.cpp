@@ -0,0 +1,240 @@
+/***************************************************************************
+                          testcatalogdb.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testcatalogdb.h"
+
+#include "kspaths.h"
+
+#include <QSqlQuery>
+
+#include <cmath>
+
+// Objects of a large survey catalog
+#define BENCHMARK_ENTRIES 100000
+
+namespace
+{
+typedef struct
+{
+    double ra;
+    double dec;
+    double magnitude;
+} Entry;
+
+// Grid of objects, further apart than the fuzz of the matching
+QVector<Entry> makeEntries(int count, double shift = 0)
+{
+    QVector<Entry> entries;
+    for (int i = 0; i < count; i++)
+    {
+        Entry entry;
+        entry.ra        = 0.5 + (i % 1000) * 0.35 + shift;
+        entry.dec       = -80.5 + (i / 1000) * 1.6 + shift;
+        entry.magnitude = 10 + (i % 50) * 0.1;
+        entries.append(entry);
+    }
+    return entries;
+}
+
+void writeCatalog(const QString &filename, const QString &name, const QVector<Entry> &entries)
+{
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+
+    QTextStream stream(&file);
+    stream << "# Delimiter: ,\n"
+           << "# Name: " << name << "\n"
+           << "# Prefix: " << name << "\n"
+           << "# Color: #00FF00\n"
+           << "# Epoch: 2000\n"
+           << "# ID RA Dc Tp Nm Mg\n";
+
+    for (int i = 0; i < entries.size(); i++)
+    {
+        stream << i + 1 << ',' << QString::number(entries[i].ra / 15.0, 'f', 8) << ','
+               << QString::number(entries[i].dec, 'f', 7) << ",8," << name << ' ' << i + 1 << ','
+               << QString::number(entries[i].magnitude, 'f', 2) << "\n";
+    }
+}
+
+// Runs a query returning a single number on a connection of its own
+int count(const QString &dbFile, const QString &sql)
+{
+    int result = -1;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testcatalogdb");
+        db.setDatabaseName(dbFile);
+        if (db.open())
+        {
+            QSqlQuery query(db);
+            if (query.exec(sql) && query.next())
+                result = query.value(0).toInt();
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("testcatalogdb");
+    return result;
+}
+
+// Rows matching an entry as the SQL filter of CatalogDB::FindFuzzyEntry() selects them
+int scan(const QVector<Entry> &rows, double ra, double dec, double magnitude)
+{
+    for (int uid = 0; uid < rows.size(); uid++)
+    {
+        if (std::fabs(rows[uid].ra - ra) <= DSOIndex::POSITION_FUZZ &&
+            std::fabs(rows[uid].dec - dec) <= DSOIndex::POSITION_FUZZ &&
+            std::fabs(rows[uid].magnitude - magnitude) <= DSOIndex::MAGNITUDE_FUZZ)
+            return uid;
+    }
+    return -1;
+}
+}
+
+TestCatalogDB::TestCatalogDB() : QObject()
+{
+}
+
+TestCatalogDB::~TestCatalogDB()
+{
+}
+
+void TestCatalogDB::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    QVERIFY(catalogDir_.isValid());
+    QVERIFY(QDir().mkpath(KSPaths::writableLocation(QStandardPaths::GenericDataLocation)));
+    dbFile_ = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "skycomponents.sqlite";
+}
+
+void TestCatalogDB::init()
+{
+    // Each test starts from an empty database
+    QFile::remove(dbFile_);
+}
+
+void TestCatalogDB::cleanup()
+{
+    QSqlDatabase::removeDatabase("skydb");
+    QFile::remove(dbFile_);
+}
+
+void TestCatalogDB::fuzzyMatch()
+{
+    DSOIndex index;
+    index.insert(5, 10.0, 20.0, 8.0);
+    index.insert(3, 10.001, 20.001, 8.05);
+    index.insert(7, 359.9995, -45.0, 12.0);
+    QCOMPARE(index.count(), 3);
+
+    // The smallest UID of the matching rows
+    QCOMPARE(index.find(10.0005, 20.0005, 8.02), 3);
+    QCOMPARE(index.find(9.999, 19.999, 7.95), 5);
+
+    // Too far in RA, in Dec, or in magnitude
+    QCOMPARE(index.find(10.0033, 20.0, 8.0), -1);
+    QCOMPARE(index.find(10.0, 19.997, 8.0), -1);
+    QCOMPARE(index.find(10.0, 20.0, 8.2), -1);
+
+    // RA does not wrap around, as in the database
+    QCOMPARE(index.find(359.9999, -45.0, 12.0), 7);
+    QCOMPARE(index.find(0.0005, -45.0, 12.0), -1);
+
+    index.clear();
+    QCOMPARE(index.find(10.0, 20.0, 8.0), -1);
+}
+
+void TestCatalogDB::compareWithScan()
+{
+    // Crowded field, many objects in each cell
+    qsrand(42);
+    QVector<Entry> rows;
+    DSOIndex index;
+
+    for (int uid = 0; uid < 5000; uid++)
+    {
+        Entry row;
+        row.ra        = 150.0 + 0.05 * qrand() / RAND_MAX;
+        row.dec       = -0.02 + 0.05 * qrand() / RAND_MAX;
+        row.magnitude = 10.0 + qrand() % 10 * 0.05;
+        rows.append(row);
+        index.insert(uid, row.ra, row.dec, row.magnitude);
+    }
+
+    for (int i = 0; i < 5000; i++)
+    {
+        double ra        = 149.99 + 0.07 * qrand() / RAND_MAX;
+        double dec       = -0.03 + 0.07 * qrand() / RAND_MAX;
+        double magnitude = 10.0 + qrand() % 12 * 0.05;
+
+        QCOMPARE(index.find(ra, dec, magnitude), scan(rows, ra, dec, magnitude));
+    }
+}
+
+void TestCatalogDB::importMatchesRows()
+{
+    CatalogDB db;
+    QVERIFY(db.Initialize());
+
+    QString first = catalogDir_.filePath("first.txt"), second = catalogDir_.filePath("second.txt");
+    writeCatalog(first, "First", makeEntries(100));
+
+    // The same objects, measured slightly differently, and objects of their own
+    QVector<Entry> entries = makeEntries(100, 0.001);
+    for (Entry &entry : entries)
+        entry.magnitude += 0.05;
+    entries += makeEntries(110, 0.1).mid(100);
+    writeCatalog(second, "Second", entries);
+
+    QVERIFY(db.AddCatalogContents(first));
+    QCOMPARE(count(dbFile_, "SELECT COUNT(*) FROM DSO"), 100);
+
+    QVERIFY(db.AddCatalogContents(second));
+    QCOMPARE(count(dbFile_, "SELECT COUNT(*) FROM DSO"), 110);
+    QCOMPARE(count(dbFile_, "SELECT COUNT(*) FROM ObjectDesignation"), 210);
+    QCOMPARE(count(dbFile_, "SELECT COUNT(DISTINCT UID_DSO) FROM ObjectDesignation"), 110);
+
+    // Entries added one by one are still matched by querying the database
+    CatalogEntryData entry;
+    entry.catalog_name = "Second";
+    entry.ID           = 111;
+    entry.ra           = entries[0].ra + 0.0005;
+    entry.dec          = entries[0].dec;
+    entry.type         = 8;
+    entry.magnitude    = entries[0].magnitude;
+    QVERIFY(db.AddEntry(entry, db.FindCatalog("Second")));
+    QCOMPARE(count(dbFile_, "SELECT COUNT(*) FROM DSO"), 110);
+}
+
+void TestCatalogDB::benchmarkImport()
+{
+    QString filename = catalogDir_.filePath("benchmark.txt");
+    writeCatalog(filename, "Benchmark", makeEntries(BENCHMARK_ENTRIES));
+
+    CatalogDB db;
+    QVERIFY(db.Initialize());
+
+    // Importing changes the database, so it is only measured once
+    QBENCHMARK_ONCE
+    {
+        QVERIFY(db.AddCatalogContents(filename));
+    }
+
+    QCOMPARE(count(dbFile_, "SELECT COUNT(*) FROM DSO"), BENCHMARK_ENTRIES);
+}
+
+QTEST_GUILESS_MAIN(TestCatalogDB)
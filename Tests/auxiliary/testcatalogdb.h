@@ -0,0 +1,56 @@
+/***************************************************************************
+                          testcatalogdb.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTCATALOGDB_H
+#define TESTCATALOGDB_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "catalogdb.h"
+#include "dsoindex.h"
+
+/**
+ * @class TestCatalogDB
+ * @short Checks that custom catalogs are imported with the same fuzzy matching of their objects as before they were
+ * matched against an index of the DSO table, and measures the import of a large catalog
+ * @author agent <agent@local>
+ */
+class TestCatalogDB : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestCatalogDB();
+    ~TestCatalogDB();
+
+  private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void fuzzyMatch();
+    void compareWithScan();
+    void importMatchesRows();
+    void benchmarkImport();
+
+  private:
+    QString dbFile_;
+    QTemporaryDir catalogDir_;
+};
+
+#endif
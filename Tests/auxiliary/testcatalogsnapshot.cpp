@@ -0,0 +1,170 @@
+/***************************************************************************
+                          testcatalogsnapshot.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testcatalogsnapshot.h"
+
+#include <QTemporaryDir>
+
+namespace
+{
+CatalogSnapshot::Key makeKey()
+{
+    CatalogSnapshot::Key key;
+    key.catalog_id   = 3;
+    key.rows         = 4;
+    key.first_row    = 120;
+    key.last_row     = 123;
+    key.epoch        = 2000;
+    key.designations = true;
+    key.prefix       = "Abell";
+    return key;
+}
+
+QVector<CatalogSnapshot::Row> makeRows()
+{
+    QVector<CatalogSnapshot::Row> rows;
+    for (int i = 0; i < 4; i++)
+    {
+        CatalogSnapshot::Row row;
+        row.type           = i;
+        row.ra             = 10.125 * i;
+        row.dec            = -45.5 + i;
+        row.magnitude      = 12.5f + i;
+        row.major_axis     = 2.0f * i;
+        row.minor_axis     = 1.0f * i;
+        row.position_angle = 30.0f * i;
+        row.flux           = 0.25f * i;
+        row.name           = QString("Abell %1").arg(i + 1);
+        // Empty, non-Latin and long names
+        row.long_name = (i == 0) ? QString() : QString::fromUtf8("Nébuleuse ") + QString(i * 100, QChar(0x263C));
+        rows.append(row);
+    }
+    return rows;
+}
+}
+
+TestCatalogSnapshot::TestCatalogSnapshot() : QObject()
+{
+}
+
+TestCatalogSnapshot::~TestCatalogSnapshot()
+{
+}
+
+void TestCatalogSnapshot::roundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // Missing directories are created
+    const QString filename = dir.path() + "/catalogs/Abell.snapshot";
+    QVector<CatalogSnapshot::Row> rows = makeRows(), read;
+
+    QVERIFY(!CatalogSnapshot::read(filename, makeKey(), read));
+    QVERIFY(CatalogSnapshot::write(filename, makeKey(), rows));
+    QVERIFY(CatalogSnapshot::read(filename, makeKey(), read));
+
+    QCOMPARE(read.size(), rows.size());
+    for (int i = 0; i < rows.size(); i++)
+    {
+        QCOMPARE(read[i].type, rows[i].type);
+        QCOMPARE(read[i].ra, rows[i].ra);
+        QCOMPARE(read[i].dec, rows[i].dec);
+        QCOMPARE(read[i].magnitude, rows[i].magnitude);
+        QCOMPARE(read[i].major_axis, rows[i].major_axis);
+        QCOMPARE(read[i].minor_axis, rows[i].minor_axis);
+        QCOMPARE(read[i].position_angle, rows[i].position_angle);
+        QCOMPARE(read[i].flux, rows[i].flux);
+        QCOMPARE(read[i].name, rows[i].name);
+        QCOMPARE(read[i].long_name, rows[i].long_name);
+    }
+
+    // An empty catalog has a snapshot too
+    QVERIFY(CatalogSnapshot::write(filename, makeKey(), QVector<CatalogSnapshot::Row>()));
+    QVERIFY(CatalogSnapshot::read(filename, makeKey(), read));
+    QVERIFY(read.isEmpty());
+}
+
+void TestCatalogSnapshot::staleKey_data()
+{
+    QTest::addColumn<QString>("change");
+
+    QTest::newRow("Other catalog") << QString("catalog_id");
+    QTest::newRow("Entry added") << QString("rows");
+    QTest::newRow("Imported again") << QString("first_row");
+    QTest::newRow("Entry replaced") << QString("last_row");
+    QTest::newRow("Other epoch") << QString("epoch");
+    QTest::newRow("Without designations") << QString("designations");
+    QTest::newRow("Other prefix") << QString("prefix");
+}
+
+void TestCatalogSnapshot::staleKey()
+{
+    QFETCH(QString, change);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString filename = dir.path() + "/Abell.snapshot";
+    QVERIFY(CatalogSnapshot::write(filename, makeKey(), makeRows()));
+
+    CatalogSnapshot::Key key = makeKey();
+    if (change == "catalog_id")
+        key.catalog_id++;
+    else if (change == "rows")
+        key.rows++;
+    else if (change == "first_row")
+        key.first_row++;
+    else if (change == "last_row")
+        key.last_row++;
+    else if (change == "epoch")
+        key.epoch = 1950;
+    else if (change == "designations")
+        key.designations = false;
+    else if (change == "prefix")
+        key.prefix = "ACO";
+
+    QVector<CatalogSnapshot::Row> read;
+    QVERIFY(!CatalogSnapshot::read(filename, key, read));
+    QVERIFY(read.isEmpty());
+}
+
+void TestCatalogSnapshot::damagedFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString filename = dir.path() + "/Abell.snapshot";
+    QVERIFY(CatalogSnapshot::write(filename, makeKey(), makeRows()));
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 1));
+    file.close();
+
+    QVector<CatalogSnapshot::Row> read;
+    QVERIFY(!CatalogSnapshot::read(filename, makeKey(), read));
+
+    // Not a snapshot at all
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("# Delimiter: ,\n");
+    file.close();
+
+    QVERIFY(!CatalogSnapshot::read(filename, makeKey(), read));
+}
+
+QTEST_GUILESS_MAIN(TestCatalogSnapshot)
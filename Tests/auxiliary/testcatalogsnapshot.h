@@ -0,0 +1,47 @@
+/***************************************************************************
+                          testcatalogsnapshot.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTCATALOGSNAPSHOT_H
+#define TESTCATALOGSNAPSHOT_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "catalogsnapshot.h"
+
+/**
+ * @class TestCatalogSnapshot
+ * @short Checks that snapshots of catalogs read back the rows they were written with, and that stale or damaged
+ * snapshots are not read
+ * @author agent <agent@local>
+ */
+class TestCatalogSnapshot : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestCatalogSnapshot();
+    ~TestCatalogSnapshot();
+
+  private slots:
+    void roundTrip();
+    void staleKey_data();
+    void staleKey();
+    void damagedFile();
+};
+
+#endif
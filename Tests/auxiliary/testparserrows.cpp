@@ -0,0 +1,363 @@
+/***************************************************************************
+                          testparserrows.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testparserrows.h"
+
+// Rows of a file the size of the full MPC asteroid list
+#define BENCHMARK_ROWS 300000
+
+namespace
+{
+// Columns of asteroids.dat, as AsteroidsComponent reads them
+typedef struct
+{
+    QString full_name;
+    int epoch_mjd;
+    double q, a, e, i, w, om, ma;
+    QString orbit_id;
+    double H, G;
+    QString neo;
+    float diameter;
+    QString extent;
+    float albedo, rot_period, per_y;
+    double moid;
+    QString orbit_class;
+} AsteroidRow;
+
+const KSParser::Column<AsteroidRow> ASTEROID_COLUMNS[] = {
+    &AsteroidRow::full_name, &AsteroidRow::epoch_mjd, &AsteroidRow::q, &AsteroidRow::a, &AsteroidRow::e,
+    &AsteroidRow::i, &AsteroidRow::w, &AsteroidRow::om, &AsteroidRow::ma, {}, &AsteroidRow::orbit_id,
+    &AsteroidRow::H, &AsteroidRow::G, &AsteroidRow::neo, {}, {}, &AsteroidRow::diameter, &AsteroidRow::extent,
+    &AsteroidRow::albedo, &AsteroidRow::rot_period, &AsteroidRow::per_y, &AsteroidRow::moid, &AsteroidRow::orbit_class
+};
+
+// Columns of comets.dat, as CometsComponent reads them
+typedef struct
+{
+    QString full_name;
+    int epoch_mjd;
+    double q, e, i, w, om, tp_calc;
+    QString orbit_id;
+    QString neo;
+    float M1, M2, diameter;
+    QString extent;
+    float albedo, rot_period, per_y;
+    double moid;
+    QString orbit_class;
+    float K1, K2;
+} CometRow;
+
+const KSParser::Column<CometRow> COMET_COLUMNS[] = {
+    &CometRow::full_name, &CometRow::epoch_mjd, &CometRow::q, &CometRow::e, &CometRow::i, &CometRow::w,
+    &CometRow::om, &CometRow::tp_calc, &CometRow::orbit_id, &CometRow::neo, &CometRow::M1, &CometRow::M2,
+    &CometRow::diameter, &CometRow::extent, &CometRow::albedo, &CometRow::rot_period, &CometRow::per_y,
+    &CometRow::moid, &CometRow::orbit_class, &CometRow::K1, &CometRow::K2
+};
+
+typedef struct
+{
+    QString name;
+    int number;
+    float magnitude;
+    double distance;
+} TestRow;
+
+const KSParser::Column<TestRow> TEST_COLUMNS[] = { &TestRow::name, &TestRow::number, {}, &TestRow::magnitude,
+                                                   &TestRow::distance };
+
+// Sequence of the hash parser with the types of columns
+template <typename Row, int N>
+QList<QPair<QString, KSParser::DataTypes>> makeSequence(const KSParser::Column<Row> (&columns)[N])
+{
+    QList<QPair<QString, KSParser::DataTypes>> sequence;
+    for (int i = 0; i < N; i++)
+        sequence.append(qMakePair(QString("field%1").arg(i), columns[i].type));
+    return sequence;
+}
+
+template <typename Row, int N>
+void compare(const QString &filename, const KSParser::Column<Row> (&columns)[N])
+{
+    const QList<QPair<QString, KSParser::DataTypes>> sequence = makeSequence(columns);
+
+    KSParser hash_parser(filename, '#', sequence);
+    KSParser row_parser(filename, '#');
+
+    Row row;
+    int count = 0;
+
+    while (hash_parser.HasNextRow())
+    {
+        QHash<QString, QVariant> values = hash_parser.ReadNextRow();
+        QVERIFY(row_parser.ReadNextRow(row, columns));
+
+        for (int i = 0; i < N; i++)
+        {
+            const QVariant &value = values[sequence[i].first];
+
+            switch (columns[i].type)
+            {
+                case KSParser::D_QSTRING:
+                    QCOMPARE(row.*columns[i].string_member, value.toString());
+                    break;
+                case KSParser::D_INT:
+                    QCOMPARE(row.*columns[i].int_member, value.toInt());
+                    break;
+                case KSParser::D_FLOAT:
+                    QCOMPARE(row.*columns[i].float_member, value.toFloat());
+                    break;
+                case KSParser::D_DOUBLE:
+                    QCOMPARE(row.*columns[i].double_member, value.toDouble());
+                    break;
+                default:
+                    break;
+            }
+        }
+        count++;
+    }
+
+    QVERIFY(count > 0);
+    QVERIFY(!row_parser.ReadNextRow(row, columns));
+}
+
+template <typename Row, int N>
+int readRows(const QString &filename, const KSParser::Column<Row> (&columns)[N])
+{
+    KSParser parser(filename, '#');
+    Row row;
+    int count = 0;
+
+    while (parser.ReadNextRow(row, columns))
+        count++;
+
+    return count;
+}
+
+// Rows read as the components did before they read them into structs
+template <typename Row, int N>
+int readHashes(const QString &filename, const KSParser::Column<Row> (&columns)[N])
+{
+    const QList<QPair<QString, KSParser::DataTypes>> sequence = makeSequence(columns);
+    KSParser parser(filename, '#', sequence);
+    Row row;
+    int count = 0;
+
+    while (parser.HasNextRow())
+    {
+        QHash<QString, QVariant> values = parser.ReadNextRow();
+
+        for (int i = 0; i < N; i++)
+        {
+            const QVariant &value = values[sequence[i].first];
+
+            switch (columns[i].type)
+            {
+                case KSParser::D_QSTRING:
+                    row.*columns[i].string_member = value.toString();
+                    break;
+                case KSParser::D_INT:
+                    row.*columns[i].int_member = value.toInt();
+                    break;
+                case KSParser::D_FLOAT:
+                    row.*columns[i].float_member = value.toFloat();
+                    break;
+                case KSParser::D_DOUBLE:
+                    row.*columns[i].double_member = value.toDouble();
+                    break;
+                default:
+                    break;
+            }
+        }
+        count++;
+    }
+
+    return count;
+}
+
+QString writeFile(const QString &filename, const QString &contents)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+
+    QTextStream(&file) << contents;
+    return filename;
+}
+}
+
+TestParserRows::TestParserRows() : QObject()
+{
+}
+
+TestParserRows::~TestParserRows()
+{
+}
+
+void TestParserRows::initTestCase()
+{
+    QVERIFY(dir_.isValid());
+
+    // The asteroids of the data file, repeated
+    QFile asteroids(KSTARS_DATA_DIR "/asteroids.dat");
+    QVERIFY(asteroids.open(QIODevice::ReadOnly | QIODevice::Text));
+
+    QStringList lines = QString::fromUtf8(asteroids.readAll()).split('\n', QString::SkipEmptyParts);
+    lines.removeFirst();
+    QVERIFY(!lines.isEmpty());
+
+    largeFile_ = dir_.path() + "/asteroids.dat";
+    QFile large(largeFile_);
+    QVERIFY(large.open(QIODevice::WriteOnly | QIODevice::Text));
+
+    QTextStream stream(&large);
+    for (int i = 0; i < BENCHMARK_ROWS; i++)
+        stream << lines[i % lines.size()] << '\n';
+}
+
+void TestParserRows::csvRows()
+{
+    QString filename = writeFile(dir_.path() + "/rows.csv", "# name,number,skipped,magnitude,distance\n"
+                                                            "\n"
+                                                            "Vega,1,x,0.03,25.04\n"
+                                                            "\"Alpha, Centauri\",2,,-0.27, 4.37 \n"
+                                                            "incomplete,3,x,1.0\n"
+                                                            "no delimiter\n"
+                                                            "\"isn't\"(, )\"pi\",abc,x,,\n"
+                                                            ",,,,\n");
+    QVERIFY(!filename.isEmpty());
+
+    KSParser parser(filename, '#');
+    TestRow row;
+
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("Vega"));
+    QCOMPARE(row.number, 1);
+    QCOMPARE(row.magnitude, 0.03f);
+    QCOMPARE(row.distance, 25.04);
+
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("Alpha, Centauri"));
+    QCOMPARE(row.number, 2);
+    QCOMPARE(row.magnitude, -0.27f);
+    QCOMPARE(row.distance, 4.37);
+
+    // Quotes in quotes, and fields that are not numbers
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("isn't\"(, )\"pi"));
+    QCOMPARE(row.number, KSParser::EBROKEN_INT);
+    QCOMPARE(row.magnitude, KSParser::EBROKEN_FLOAT);
+    QCOMPARE(row.distance, KSParser::EBROKEN_DOUBLE);
+
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString(""));
+    QCOMPARE(row.number, 0);
+
+    // No dummy rows at the end of the file
+    row.name = "Unchanged";
+    for (int times = 0; times < 5; times++)
+        QVERIFY(!parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("Unchanged"));
+}
+
+void TestParserRows::fixedWidthRows()
+{
+    QString filename = writeFile(dir_.path() + "/rows.txt", "# Comment\n"
+                                                            "Vega      1   x  0.03 25.04\n"
+                                                            "Short\n"
+                                                            "Sirius    2   y -1.46  8.6\n");
+    QVERIFY(!filename.isEmpty());
+
+    KSParser parser(filename, '#', QList<int>() << 10 << 4 << 2 << 6);
+    TestRow row;
+
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("Vega"));
+    QCOMPARE(row.number, 1);
+    QCOMPARE(row.magnitude, 0.03f);
+    QCOMPARE(row.distance, 25.04);
+
+    QVERIFY(parser.ReadNextRow(row, TEST_COLUMNS));
+    QCOMPARE(row.name, QString("Sirius"));
+    QCOMPARE(row.number, 2);
+    QCOMPARE(row.magnitude, -1.46f);
+    QCOMPARE(row.distance, 8.6);
+
+    QVERIFY(!parser.ReadNextRow(row, TEST_COLUMNS));
+}
+
+void TestParserRows::missingFile()
+{
+    KSParser parser(dir_.path() + "/missing.csv", '#');
+    TestRow row;
+
+    for (int times = 0; times < 5; times++)
+        QVERIFY(!parser.ReadNextRow(row, TEST_COLUMNS));
+}
+
+void TestParserRows::compareWithHash_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("asteroids.dat") << QString("asteroids.dat");
+    QTest::newRow("comets.dat") << QString("comets.dat");
+}
+
+void TestParserRows::compareWithHash()
+{
+    QFETCH(QString, file);
+
+    if (file == "asteroids.dat")
+        compare(KSTARS_DATA_DIR "/asteroids.dat", ASTEROID_COLUMNS);
+    else
+        compare(KSTARS_DATA_DIR "/comets.dat", COMET_COLUMNS);
+}
+
+void TestParserRows::benchmarkRead_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<bool>("typed");
+
+    QTest::newRow("asteroids.dat, hashes") << QString("asteroids.dat") << false;
+    QTest::newRow("asteroids.dat, structs") << QString("asteroids.dat") << true;
+    QTest::newRow("comets.dat, hashes") << QString("comets.dat") << false;
+    QTest::newRow("comets.dat, structs") << QString("comets.dat") << true;
+    QTest::newRow("Full asteroid list, hashes") << QString() << false;
+    QTest::newRow("Full asteroid list, structs") << QString() << true;
+}
+
+void TestParserRows::benchmarkRead()
+{
+    QFETCH(QString, file);
+    QFETCH(bool, typed);
+
+    const QString filename = file.isEmpty() ? largeFile_ : QString(KSTARS_DATA_DIR "/") + file;
+    int count              = 0;
+
+    QBENCHMARK
+    {
+        if (file == "comets.dat")
+            count = typed ? readRows(filename, COMET_COLUMNS) : readHashes(filename, COMET_COLUMNS);
+        else
+            count = typed ? readRows(filename, ASTEROID_COLUMNS) : readHashes(filename, ASTEROID_COLUMNS);
+    }
+
+    QVERIFY(count > 0);
+    if (file.isEmpty())
+        QCOMPARE(count, BENCHMARK_ROWS);
+}
+
+QTEST_GUILESS_MAIN(TestParserRows)
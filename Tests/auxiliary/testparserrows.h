@@ -0,0 +1,57 @@
+/***************************************************************************
+                          testparserrows.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTPARSERROWS_H
+#define TESTPARSERROWS_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <QTemporaryDir>
+
+#include "ksparser.h"
+
+/**
+ * @class TestParserRows
+ * @short Checks that KSParser reads the same values into structs as into hashes of QVariants, and measures both on
+ * the asteroid and comet data files
+ * @author agent <agent@local>
+ */
+class TestParserRows : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestParserRows();
+    ~TestParserRows();
+
+  private slots:
+    void initTestCase();
+
+    void csvRows();
+    void fixedWidthRows();
+    void missingFile();
+    void compareWithHash_data();
+    void compareWithHash();
+    void benchmarkRead_data();
+    void benchmarkRead();
+
+  private:
+    QTemporaryDir dir_;
+    QString largeFile_;
+};
+
+#endif
@@ -0,0 +1,190 @@
+/***************************************************************************
+                          testcapturedframes.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testcapturedframes.h"
+
+/* Qt Includes */
+#include <QDirIterator>
+#include <QTemporaryDir>
+
+// Frames of a capture directory after months of imaging
+#define BENCHMARK_FRAMES 20000
+
+namespace
+{
+const QStringList FILTERS = { "L", "R", "G", "B", "Ha" };
+
+// Scheduler::getCompletedFiles before the frames were indexed
+int scan(const QString &path, const QString &seqPrefix)
+{
+    QString tempName;
+    int seqFileCount = 0;
+
+    QDirIterator it(path, QDir::Files);
+
+    while (it.hasNext())
+    {
+        tempName = it.next();
+        QFileInfo info(tempName);
+        tempName = info.baseName();
+
+        // find the prefix first
+        if (tempName.startsWith(seqPrefix) == false)
+            continue;
+
+        seqFileCount++;
+    }
+
+    return seqFileCount;
+}
+
+void touch(const QString &filename)
+{
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+}
+
+// Frames of a sequence through each filter, as Capture names them
+void makeFrames(const QString &path, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const QString &filter = FILTERS[i % FILTERS.size()];
+        QString number        = QString::number(i / FILTERS.size() + 1).rightJustified(3, '0');
+
+        touch(QString("%1/M31_Light_%2_300_secs_%3.fits").arg(path, filter, number));
+    }
+}
+}
+
+TestCapturedFrames::TestCapturedFrames() : QObject()
+{
+}
+
+TestCapturedFrames::~TestCapturedFrames()
+{
+}
+
+void TestCapturedFrames::compareWithScan_data()
+{
+    QTest::addColumn<QString>("prefix");
+
+    QTest::newRow("Sequence") << QString("M31_Light_Ha_300_secs");
+    QTest::newRow("Shared by sequences") << QString("M31_Light");
+    QTest::newRow("Prefix of a filter") << QString("M31_Light_R");
+    QTest::newRow("Every file") << QString("");
+    QTest::newRow("No file") << QString("M42_Light");
+    QTest::newRow("Past the first dot") << QString("M31_Dark.tmp");
+    QTest::newRow("Up to the first dot") << QString("M31_Dark");
+}
+
+void TestCapturedFrames::compareWithScan()
+{
+    QFETCH(QString, prefix);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    makeFrames(dir.path(), 100);
+    touch(dir.path() + "/M31_Dark.tmp.fits");
+    touch(dir.path() + "/M31_Dark_001.jpg");
+    touch(dir.path() + "/M31_Dark_001.fits");
+
+    Ekos::CapturedFrames frames;
+
+    QCOMPARE(frames.count(dir.path(), prefix), scan(dir.path(), prefix));
+    // Counted again from the cache
+    QCOMPARE(frames.count(dir.path() + "/", prefix), scan(dir.path(), prefix));
+}
+
+void TestCapturedFrames::addFrame()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    makeFrames(dir.path(), 10);
+
+    Ekos::CapturedFrames frames;
+    QCOMPARE(frames.count(dir.path(), "M31_Light_L"), 2);
+
+    QString filename = dir.path() + "/M31_Light_L_300_secs_003.fits";
+    touch(filename);
+    frames.addFrame(filename);
+    QCOMPARE(frames.count(dir.path(), "M31_Light_L"), 3);
+    QCOMPARE(frames.count(dir.path(), "M31_Light_R"), 2);
+
+    // A frame that is overwritten is only counted once
+    frames.addFrame(filename);
+    QCOMPARE(frames.count(dir.path(), "M31_Light_L"), 3);
+}
+
+void TestCapturedFrames::externalChanges()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    makeFrames(dir.path(), 10);
+
+    Ekos::CapturedFrames frames;
+    QCOMPARE(frames.count(dir.path(), "M31_Light"), 10);
+
+    // Let the directory be watched
+    QCoreApplication::processEvents();
+
+    touch(dir.path() + "/M31_Light_L_300_secs_003.fits");
+    QTRY_COMPARE(frames.count(dir.path(), "M31_Light"), 11);
+
+    QVERIFY(QFile::remove(dir.path() + "/M31_Light_R_300_secs_001.fits"));
+    QTRY_COMPARE(frames.count(dir.path(), "M31_Light"), 10);
+}
+
+void TestCapturedFrames::benchmarkCount_data()
+{
+    QTest::addColumn<bool>("index");
+
+    QTest::newRow("Directory scan") << false;
+    QTest::newRow("Index") << true;
+}
+
+void TestCapturedFrames::benchmarkCount()
+{
+    QFETCH(bool, index);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    makeFrames(dir.path(), BENCHMARK_FRAMES);
+
+    Ekos::CapturedFrames frames;
+    int count = 0;
+
+    // The scheduler estimates the progress of each sequence of a job
+    QBENCHMARK
+    {
+        count = 0;
+        foreach (const QString &filter, FILTERS)
+        {
+            QString prefix = QString("M31_Light_%1_300_secs").arg(filter);
+            count += index ? frames.count(dir.path(), prefix) : scan(dir.path(), prefix);
+        }
+    }
+
+    QCOMPARE(count, BENCHMARK_FRAMES);
+}
+
+QTEST_GUILESS_MAIN(TestCapturedFrames)
@@ -0,0 +1,51 @@
+/***************************************************************************
+                          testcapturedframes.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTCAPTUREDFRAMES_H
+#define TESTCAPTUREDFRAMES_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "capturedframes.h"
+
+/**
+ * @class TestCapturedFrames
+ * @short Compares the counts of CapturedFrames against a listing of the directory, as the scheduler did, and benchmarks
+ * both on a large capture directory
+ * @author agent <agent@local>
+ */
+class TestCapturedFrames : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestCapturedFrames();
+    ~TestCapturedFrames();
+
+  private slots:
+    void compareWithScan_data();
+    void compareWithScan();
+
+    void addFrame();
+    void externalChanges();
+
+    void benchmarkCount_data();
+    void benchmarkCount();
+};
+
+#endif
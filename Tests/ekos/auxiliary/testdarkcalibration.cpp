@@ -0,0 +1,231 @@
+/***************************************************************************
+                          testdarkcalibration.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+
+/* Project Includes */
+#include "testdarkcalibration.h"
+
+#include <algorithm>
+
+using namespace Ekos;
+
+// Size of a full frame of a 16 MP camera
+#define FRAME_WIDTH  4656
+#define FRAME_HEIGHT 3520
+
+namespace
+{
+// Dark frame with a bias, thermal noise and a few hot pixels
+QVector<uint16_t> darkFrame(int width, int height, unsigned int seed)
+{
+    QVector<uint16_t> dark(width * height);
+
+    qsrand(seed);
+    for (int i = 0; i < dark.size(); i++)
+        dark[i] = 1000 + qrand() % 50;
+
+    for (int i = 0; i < 10; i++)
+        dark[(i * 7919) % dark.size()] = 40000;
+
+    return dark;
+}
+
+// DarkLibrary::subtract before it was vectorized
+template <typename T>
+void branchySubtract(const T *darkBuffer, int darkW, int offsetX, int offsetY, T *lightBuffer, int lightW, int lightH)
+{
+    int darkoffset  = offsetX + offsetY * darkW;
+    int lightOffset = 0;
+
+    for (int i = 0; i < lightH; i++)
+    {
+        for (int j = 0; j < lightW; j++)
+        {
+            if (lightBuffer[j + lightOffset] > darkBuffer[j + darkoffset])
+                lightBuffer[j + lightOffset] -= darkBuffer[j + darkoffset];
+            else
+                lightBuffer[j + lightOffset] = 0;
+        }
+
+        lightOffset += lightW;
+        darkoffset += darkW;
+    }
+}
+}
+
+TestDarkCalibration::TestDarkCalibration() : QObject()
+{
+}
+
+TestDarkCalibration::~TestDarkCalibration()
+{
+}
+
+void TestDarkCalibration::stackMedian()
+{
+    // A cosmic ray hits the third frame
+    const uint16_t frames[5][3] = {
+        { 100, 200, 300 }, { 102, 198, 301 }, { 65535, 201, 299 }, { 99, 203, 300 }, { 101, 199, 302 }
+    };
+
+    QVector<const uint16_t *> buffers;
+    for (const auto &frame : frames)
+        buffers.append(frame);
+
+    uint16_t master[3];
+    DarkCalibration::stack<uint16_t>(buffers, 3, DarkCalibration::STACK_MEDIAN, master).waitForFinished();
+
+    QCOMPARE(master[0], uint16_t(101));
+    QCOMPARE(master[1], uint16_t(200));
+    QCOMPARE(master[2], uint16_t(300));
+}
+
+void TestDarkCalibration::stackSigmaClip()
+{
+    const float frames[6][2] = { { 10, 5 }, { 11, 5 }, { 9, 6 }, { 10, 4 }, { 1000, 5 }, { 10, 5 } };
+
+    QVector<const float *> buffers;
+    for (const auto &frame : frames)
+        buffers.append(frame);
+
+    // The master may be one of the frames
+    float master[2] = { frames[0][0], frames[0][1] };
+    buffers[0]      = master;
+
+    DarkCalibration::stack<float>(buffers, 2, DarkCalibration::STACK_SIGMA_CLIP, master).waitForFinished();
+
+    // The cosmic ray is rejected, the other frames are averaged
+    QCOMPARE(master[0], 10.0f);
+    QCOMPARE(master[1], 5.0f);
+}
+
+void TestDarkCalibration::findHotPixels()
+{
+    QVector<uint16_t> dark = darkFrame(640, 480, 3);
+
+    QVector<uint32_t> expected;
+    for (int i = 0; i < dark.size(); i++)
+    {
+        if (dark[i] == 40000)
+            expected.append(i);
+    }
+
+    QCOMPARE(DarkCalibration::findHotPixels<uint16_t>(dark.constData(), dark.size()), expected);
+
+    // Hot pixels of the light frame are replaced by their neighbours
+    QVector<uint16_t> light(dark.size(), 1100);
+    for (uint32_t hotPixel : expected)
+        light[hotPixel] = 65535;
+
+    DarkCalibration::subtract<uint16_t>(dark.constData(), 640, 0, 0, light.data(), 640, 480);
+    DarkCalibration::removeHotPixels<uint16_t>(expected, 640, 0, 0, light.data(), 640, 480);
+
+    for (uint32_t hotPixel : expected)
+        QVERIFY(light[hotPixel] <= 100);
+}
+
+void TestDarkCalibration::findHotPixelsFlatDark()
+{
+    // Most pixels of an 8 bit dark share the bias, so its MAD is 0
+    QVector<uint8_t> dark(640 * 480, 10);
+    for (int i = 0; i < dark.size(); i += 5)
+        dark[i] = 11;
+
+    QVector<uint32_t> expected;
+    for (int i = 0; i < 10; i++)
+    {
+        dark[1 + i * 7919] = 200;
+        expected.append(1 + i * 7919);
+    }
+
+    // The quantization noise is not taken for hot pixels
+    QCOMPARE(DarkCalibration::findHotPixels<uint8_t>(dark.constData(), dark.size()), expected);
+
+    // Too many hot pixels mean the noise is underestimated, and none is kept
+    for (int i = 0; i < dark.size(); i += 100)
+        dark[i] = 200;
+
+    QVERIFY(DarkCalibration::findHotPixels<uint8_t>(dark.constData(), dark.size()).isEmpty());
+}
+
+void TestDarkCalibration::subtract_data()
+{
+    QTest::addColumn<int>("offsetX");
+    QTest::addColumn<int>("offsetY");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    QTest::newRow("Full frame") << 0 << 0 << 640 << 480;
+    QTest::newRow("Subframe") << 100 << 50 << 333 << 217;
+}
+
+void TestDarkCalibration::subtract()
+{
+    QFETCH(int, offsetX);
+    QFETCH(int, offsetY);
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    QVector<uint16_t> dark  = darkFrame(640, 480, 5);
+    QVector<uint16_t> light = darkFrame(width, height, 7);
+
+    // Some pixels of the light frame are darker than the dark
+    for (int i = 0; i < light.size(); i++)
+        light[i] += (i % 3) * 20 - 25;
+
+    QVector<uint16_t> expected = light;
+    branchySubtract<uint16_t>(dark.constData(), 640, offsetX, offsetY, expected.data(), width, height);
+    DarkCalibration::subtract<uint16_t>(dark.constData(), 640, offsetX, offsetY, light.data(), width, height);
+    QCOMPARE(light, expected);
+
+    QVector<float> darkFloat(dark.size()), lightFloat(width * height);
+    std::copy(dark.constBegin(), dark.constEnd(), darkFloat.begin());
+    for (int i = 0; i < lightFloat.size(); i++)
+        lightFloat[i] = 1000.5f + i % 70;
+
+    QVector<float> expectedFloat = lightFloat;
+    branchySubtract<float>(darkFloat.constData(), 640, offsetX, offsetY, expectedFloat.data(), width, height);
+    DarkCalibration::subtract<float>(darkFloat.constData(), 640, offsetX, offsetY, lightFloat.data(), width, height);
+    QCOMPARE(lightFloat, expectedFloat);
+}
+
+void TestDarkCalibration::benchmarkSubtract_data()
+{
+    QTest::addColumn<bool>("vectorized");
+
+    QTest::newRow("Branchy") << false;
+    QTest::newRow("Vectorized") << true;
+}
+
+void TestDarkCalibration::benchmarkSubtract()
+{
+    QFETCH(bool, vectorized);
+
+    QVector<uint16_t> dark  = darkFrame(FRAME_WIDTH, FRAME_HEIGHT, 9);
+    QVector<uint16_t> light = darkFrame(FRAME_WIDTH, FRAME_HEIGHT, 11);
+
+    QBENCHMARK
+    {
+        if (vectorized)
+            DarkCalibration::subtract<uint16_t>(dark.constData(), FRAME_WIDTH, 0, 0, light.data(), FRAME_WIDTH,
+                                                FRAME_HEIGHT);
+        else
+            branchySubtract<uint16_t>(dark.constData(), FRAME_WIDTH, 0, 0, light.data(), FRAME_WIDTH, FRAME_HEIGHT);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestDarkCalibration)
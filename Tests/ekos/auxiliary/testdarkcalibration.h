@@ -0,0 +1,54 @@
+/***************************************************************************
+                          testdarkcalibration.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef TESTDARKCALIBRATION_H
+#define TESTDARKCALIBRATION_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "darkcalibration.h"
+
+/**
+ * @class TestDarkCalibration
+ * @short Checks the stacking of master darks, hot pixel maps and dark subtraction against simple reference loops, and
+ * benchmarks the subtraction of a full frame dark
+ * @author agent <agent@local>
+ */
+class TestDarkCalibration : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestDarkCalibration();
+    ~TestDarkCalibration();
+
+  private slots:
+    void stackMedian();
+    void stackSigmaClip();
+    void findHotPixels();
+    void findHotPixelsFlatDark();
+
+    void subtract_data();
+    void subtract();
+
+    void benchmarkSubtract_data();
+    void benchmarkSubtract();
+};
+
+#endif
@@ -0,0 +1,234 @@
+/***************************************************************************
+                          testimageautoguiding.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+
+/* Project Includes */
+#include "testimageautoguiding.h"
+
+#include <algorithm>
+#include <math.h>
+
+// Regions of a 256 x 256 guide frame
+#define FRAME_REGIONS 16
+#define REGION_AXIS   64
+
+namespace
+{
+// Gaussian stars on a flat background, moved by dx columns and dy rows
+QVector<float> starField(int n, double dx, double dy)
+{
+    QVector<float> image(n * n, 100);
+
+    qsrand(5);
+    for (int star = 0; star < 20; star++)
+    {
+        double x         = n * double(qrand()) / RAND_MAX + dx;
+        double y         = n * double(qrand()) / RAND_MAX + dy;
+        double amplitude = 200 + 2000 * double(qrand()) / RAND_MAX;
+
+        for (int row = 0; row < n; row++)
+        {
+            for (int column = 0; column < n; column++)
+            {
+                double r2 = (column - x) * (column - x) + (row - y) * (row - y);
+                image[row * n + column] += amplitude * exp(-r2 / 8);
+            }
+        }
+    }
+
+    return image;
+}
+
+// Spectrum of image at frequency fRow along the rows and fColumn along the columns, with the sign of rlft3
+void spectrum(const QVector<float> &image, int n, int fRow, int fColumn, double *re, double *im)
+{
+    *re = *im = 0;
+
+    for (int row = 0; row < n; row++)
+    {
+        for (int column = 0; column < n; column++)
+        {
+            double angle = 2 * M_PI * (fRow * row + fColumn * column) / n;
+            *re += image[row * n + column] * cos(angle);
+            *im += image[row * n + column] * sin(angle);
+        }
+    }
+}
+
+// Shift estimated as ImageAutoGuiding1 did, from a direct evaluation of the low spatial frequencies
+QPointF directShift(const QVector<float> &reference, const QVector<float> &image, int n)
+{
+    double fx2sum = 0, fy2sum = 0, phifxsum = 0, phifysum = 0, fxfysum = 0;
+
+    for (int ix = 0; ix < n; ix++)
+    {
+        double fx = (ix <= n / 2) ? double(ix) / n : -double(n - ix) / n;
+
+        for (int iy = 0; iy < n / 2; iy++)
+        {
+            double fy = double(iy) / n;
+
+            if (fx * fx + fy * fy >= 0.05 * 0.05)
+                continue;
+
+            double re, im, testre, testim;
+            spectrum(reference, n, ix, iy, &re, &im);
+            spectrum(image, n, ix, iy, &testre, &testim);
+
+            double power = re * re + im * im;
+            double phi   = atan2(re * testim - im * testre, re * testre + im * testim);
+
+            fx2sum += power * fx * fx;
+            fy2sum += power * fy * fy;
+            phifxsum += power * fx * phi;
+            phifysum += power * fy * phi;
+            fxfysum += power * fx * fy;
+        }
+    }
+
+    double dem = fx2sum * fy2sum - fxfysum * fxfysum;
+
+    return QPointF((phifxsum * fy2sum - fxfysum * phifysum) / (dem * 2 * M_PI),
+                   (phifysum * fx2sum - fxfysum * phifxsum) / (dem * 2 * M_PI));
+}
+
+// Shifts of regions of image against the same regions of reference
+QVector<QPointF> correlate(const QVector<float> &reference, const QVector<float> &image, int n, int count)
+{
+    QVector<float *> regions;
+    for (int i = 0; i < count; i++)
+        regions.append(ImageAutoGuiding::Correlator::allocateRegion(n));
+
+    ImageAutoGuiding::Correlator correlator;
+
+    foreach (float *region, regions)
+        std::copy(reference.constBegin(), reference.constEnd(), region);
+    correlator.setReference(regions, n);
+
+    foreach (float *region, regions)
+        std::copy(image.constBegin(), image.constEnd(), region);
+    QVector<QPointF> shifts = correlator.shifts(regions);
+
+    foreach (float *region, regions)
+        ImageAutoGuiding::Correlator::freeRegion(region);
+
+    return shifts;
+}
+}
+
+TestImageAutoGuiding::TestImageAutoGuiding() : QObject()
+{
+}
+
+TestImageAutoGuiding::~TestImageAutoGuiding()
+{
+}
+
+void TestImageAutoGuiding::compareWithDFT_data()
+{
+    QTest::addColumn<int>("n");
+    QTest::addColumn<double>("dx");
+    QTest::addColumn<double>("dy");
+
+    QTest::newRow("32, small shift") << 32 << 0.3 << -0.2;
+    QTest::newRow("64, small shift") << 64 << 0.3 << -0.2;
+    QTest::newRow("64, large shift") << 64 << 1.3 << -2.7;
+    QTest::newRow("128, large shift") << 128 << -1.6 << 2.1;
+}
+
+void TestImageAutoGuiding::compareWithDFT()
+{
+    QFETCH(int, n);
+    QFETCH(double, dx);
+    QFETCH(double, dy);
+
+    QVector<float> reference = starField(n, 0, 0);
+    QVector<float> image     = starField(n, dx, dy);
+
+    QPointF expected        = directShift(reference, image, n);
+    QVector<QPointF> shifts = correlate(reference, image, n, 4);
+
+    QCOMPARE(shifts.count(), 4);
+    foreach (const QPointF &shift, shifts)
+    {
+        QVERIFY2(qAbs(shift.x() - expected.x()) < 1e-3 && qAbs(shift.y() - expected.y()) < 1e-3,
+                 qPrintable(QString("Shift (%1, %2), expected (%3, %4)")
+                                .arg(shift.x())
+                                .arg(shift.y())
+                                .arg(expected.x())
+                                .arg(expected.y())));
+    }
+}
+
+void TestImageAutoGuiding::stationaryImage()
+{
+    QVector<float> image = starField(REGION_AXIS, 0, 0);
+
+    foreach (const QPointF &shift, correlate(image, image, REGION_AXIS, 1))
+    {
+        QVERIFY(qAbs(shift.x()) < 1e-6);
+        QVERIFY(qAbs(shift.y()) < 1e-6);
+    }
+}
+
+void TestImageAutoGuiding::benchmarkFrame_data()
+{
+    QTest::addColumn<bool>("keepReference");
+
+    QTest::newRow("Reference transformed every frame") << false;
+    QTest::newRow("Reference spectra kept") << true;
+}
+
+void TestImageAutoGuiding::benchmarkFrame()
+{
+    QFETCH(bool, keepReference);
+
+    QVector<float> reference = starField(REGION_AXIS, 0, 0);
+    QVector<float> image     = starField(REGION_AXIS, 0.4, 0.2);
+
+    QVector<float *> regions;
+    for (int i = 0; i < FRAME_REGIONS; i++)
+        regions.append(ImageAutoGuiding::Correlator::allocateRegion(REGION_AXIS));
+
+    ImageAutoGuiding::Correlator correlator;
+    QVector<QPointF> shifts;
+
+    foreach (float *region, regions)
+        std::copy(reference.constBegin(), reference.constEnd(), region);
+    correlator.setReference(regions, REGION_AXIS);
+
+    QBENCHMARK
+    {
+        if (keepReference == false)
+        {
+            foreach (float *region, regions)
+                std::copy(reference.constBegin(), reference.constEnd(), region);
+            correlator.setReference(regions, REGION_AXIS);
+        }
+
+        foreach (float *region, regions)
+            std::copy(image.constBegin(), image.constEnd(), region);
+        shifts = correlator.shifts(regions);
+    }
+
+    QCOMPARE(shifts.count(), FRAME_REGIONS);
+
+    foreach (float *region, regions)
+        ImageAutoGuiding::Correlator::freeRegion(region);
+}
+
+QTEST_GUILESS_MAIN(TestImageAutoGuiding)
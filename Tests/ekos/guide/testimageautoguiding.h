@@ -0,0 +1,49 @@
+/***************************************************************************
+                          testimageautoguiding.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTIMAGEAUTOGUIDING_H
+#define TESTIMAGEAUTOGUIDING_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "imageautoguiding.h"
+
+/**
+ * @class TestImageAutoGuiding
+ * @short Compares the shifts of the correlator with a direct evaluation of the spectra, and benchmarks a guide frame
+ * @author agent <agent@local>
+ */
+class TestImageAutoGuiding : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestImageAutoGuiding();
+    ~TestImageAutoGuiding();
+
+  private slots:
+    void compareWithDFT_data();
+    void compareWithDFT();
+
+    void stationaryImage();
+
+    void benchmarkFrame_data();
+    void benchmarkFrame();
+};
+
+#endif
@@ -0,0 +1,360 @@
+/***************************************************************************
+                          testschedulerephemeris.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testschedulerephemeris.h"
+#include "cachingdms.h"
+#include "geolocation.h"
+#include "ksmoon.h"
+#include "ksnumbers.h"
+#include "kssun.h"
+#include "ksutils.h"
+#include "skypoint.h"
+
+/* STL Includes */
+#include <cmath>
+
+// Jobs of a schedule large enough for the scheduler to spend a noticeable time evaluating it
+#define SCHEDULE_JOBS 250
+
+// Minutes that Scheduler::calculateAltitudeTime looks at
+#define MINUTES (24 * 60)
+
+// Times between two checks of the condition in SchedulerEphemeris::findFirst
+#define STRIDE 10
+
+// Hours covered by the ephemeris of the scheduler, a day after the latest startup time
+#define EPHEMERIS_HOURS 48
+
+// Sidereal time grows linearly over a couple of days, but for terms of the precession well below an arcsecond
+#define LST_TOLERANCE 1e-4
+
+// Altitudes of targets only inherit the error on sidereal time
+#define TARGET_TOLERANCE 1e-4
+
+// The topocentric Moon is interpolated over 10 minutes along a path bent by parallax, which costs a few arcseconds
+#define MOON_TOLERANCE (5.0 / 3600.0)
+#define ILLUMINATION_TOLERANCE 1e-4
+
+// Minimum Moon separation of the jobs of the schedule, in degrees
+#define MIN_MOON_SEPARATION 20.0
+
+namespace
+{
+// Difference between two angles in degrees, across 0 and 360
+double angleDifference(double a, double b)
+{
+    return std::remainder(a - b, 360.0);
+}
+
+// Whether the positions of the Moon, of the Sun and of the planets can be computed from the installed data files
+bool hasEphemerisData()
+{
+    QFile file;
+    return KSUtils::openDataFile(file, "moonLR.dat");
+}
+
+// Targets spread over the sky seen from the observatory, all observed above the same altitude
+class Schedule
+{
+  public:
+    Schedule() : geo(dms(2.35), dms(48.85)), start(QDate(2026, 10, 18), QTime(12, 0))
+    {
+        qsrand(11);
+        for (int i = 0; i < SCHEDULE_JOBS; i++)
+            targets.append(SkyPoint(24.0 * qrand() / RAND_MAX, -30.0 + 120.0 * qrand() / RAND_MAX));
+    }
+
+    // Whether the target of job is above the minimum altitude during the night, minute minutes after the start, as
+    // Scheduler::calculateAltitudeTime checked by converting coordinates
+    bool observable(int job, int minute) const
+    {
+        // Night from 18:00 to 06:00, starting at noon
+        if (minute < 6 * 60 || minute >= 18 * 60)
+            return false;
+
+        SkyPoint target   = targets[job];
+        KStarsDateTime ut = start.addSecs(minute * 60.0);
+        CachingDms LST    = geo.GSTtoLST(ut.gst());
+        target.EquatorialToHorizontal(&LST, geo.lat());
+
+        return target.alt().Degrees() > 30.0;
+    }
+
+    int scan(int job) const
+    {
+        for (int minute = 0; minute < MINUTES; minute++)
+        {
+            if (observable(job, minute))
+                return minute;
+        }
+        return -1;
+    }
+
+    int search(int job) const
+    {
+        return Ekos::SchedulerEphemeris::findFirst(MINUTES, [&](int minute) { return observable(job, minute); });
+    }
+
+    // Whether job is observable, minute minutes after the start, and far enough from the Moon, as the scheduler checks
+    // a job starting as soon as possible. The positions are found again for every minute without an ephemeris.
+    bool observableAwayFromMoon(int job, int minute, const Ekos::SchedulerEphemeris *ephemeris)
+    {
+        if (minute < 6 * 60 || minute >= 18 * 60)
+            return false;
+
+        KStarsDateTime ut = start.addSecs(minute * 60.0);
+
+        if (ephemeris)
+            return ephemeris->altitude(targets[job], ut.djd()) > 30.0 &&
+                   ephemeris->moonSeparation(targets[job], ut.djd()) > MIN_MOON_SEPARATION;
+
+        if (observable(job, minute) == false)
+            return false;
+
+        KSNumbers num(ut.djd());
+        CachingDms LST = geo.GSTtoLST(ut.gst());
+        moon.updateCoords(&num, true, geo.lat(), &LST, true);
+
+        return moon.angularDistanceTo(&targets[job]).Degrees() > MIN_MOON_SEPARATION;
+    }
+
+    // Schedule job as Scheduler::evaluateJob does with a job starting as soon as possible
+    int evaluate(int job, const Ekos::SchedulerEphemeris *ephemeris)
+    {
+        return Ekos::SchedulerEphemeris::findFirst(
+            MINUTES, [&](int minute) { return observableAwayFromMoon(job, minute, ephemeris); });
+    }
+
+    GeoLocation geo;
+    KStarsDateTime start;
+    QVector<SkyPoint> targets;
+    KSMoon moon;
+};
+}
+
+TestSchedulerEphemeris::TestSchedulerEphemeris() : QObject()
+{
+}
+
+TestSchedulerEphemeris::~TestSchedulerEphemeris()
+{
+}
+
+void TestSchedulerEphemeris::findFirst_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("start");  // First index at which the condition holds
+    QTest::addColumn<int>("length"); // Number of indexes for which it holds from there
+    QTest::addColumn<int>("period"); // Indexes between two times it starts to hold, 0 if it only does once
+
+    QTest::newRow("Never") << MINUTES << 0 << 0 << 0;
+    QTest::newRow("Always") << MINUTES << 0 << MINUTES << 0;
+    QTest::newRow("At the start") << MINUTES << 0 << STRIDE << 0;
+    QTest::newRow("At the end") << MINUTES << MINUTES - 1 << 1 << 0;
+    QTest::newRow("Right after a check") << MINUTES << STRIDE << 3 * STRIDE << 0;
+    QTest::newRow("Between two checks") << MINUTES << 733 << 200 << 0;
+    QTest::newRow("At the end of a partial stride") << MINUTES - 3 << MINUTES - 8 << 5 << 0;
+    QTest::newRow("Every night") << 2 * MINUTES << 1100 << 600 << MINUTES;
+}
+
+void TestSchedulerEphemeris::findFirst()
+{
+    QFETCH(int, count);
+    QFETCH(int, start);
+    QFETCH(int, length);
+    QFETCH(int, period);
+
+    auto condition = [=](int i) {
+        if (i < start)
+            return false;
+        return period > 0 ? (i - start) % period < length : i < start + length;
+    };
+
+    int expected = -1;
+    for (int i = 0; i < count && expected < 0; i++)
+    {
+        if (condition(i))
+            expected = i;
+    }
+
+    QCOMPARE(Ekos::SchedulerEphemeris::findFirst(count, condition), expected);
+}
+
+void TestSchedulerEphemeris::compareWithScan()
+{
+    Schedule schedule;
+
+    for (int job = 0; job < SCHEDULE_JOBS; job++)
+    {
+        int scanned = schedule.scan(job);
+        int found   = schedule.search(job);
+
+        if (found == scanned)
+            continue;
+
+        // The search may only miss a target that is observable for less than the stride, and never find a time at
+        // which it is not observable
+        QVERIFY2(scanned >= 0, qPrintable(QString("Job %1 is never observable").arg(job)));
+        QVERIFY(found < 0 || schedule.observable(job, found));
+
+        for (int minute = scanned; minute < scanned + STRIDE; minute++)
+        {
+            if (!schedule.observable(job, minute))
+                break;
+            QVERIFY2(minute < scanned + STRIDE - 1, qPrintable(QString("Job %1 observable from minute %2, found at %3")
+                                                                   .arg(job)
+                                                                   .arg(scanned)
+                                                                   .arg(found)));
+        }
+    }
+}
+
+void TestSchedulerEphemeris::interpolation_data()
+{
+    QTest::addColumn<double>("minutes"); // After the start of the ephemeris
+
+    // Samples are 10 minutes apart
+    QTest::newRow("First sample") << 0.0;
+    QTest::newRow("Between the first samples") << 3.7;
+    QTest::newRow("Middle of a step") << 125.0;
+    QTest::newRow("On a sample") << 600.0;
+    QTest::newRow("Right after a sample") << 900.5;
+    QTest::newRow("Right before a sample") << 1439.9;
+    QTest::newRow("Second night") << 1900.0 + 1 / 3.0;
+    QTest::newRow("Last sample") << EPHEMERIS_HOURS * 60.0;
+}
+
+void TestSchedulerEphemeris::interpolation()
+{
+    if (hasEphemerisData() == false)
+        QSKIP("The Moon cannot be computed without the KStars data files");
+
+    QFETCH(double, minutes);
+
+    Schedule schedule;
+    Ekos::SchedulerEphemeris ephemeris(&schedule.geo, schedule.start, EPHEMERIS_HOURS);
+
+    // Positions found directly, as the scheduler did without an ephemeris
+    KStarsDateTime ut = schedule.start.addSecs(minutes * 60.0);
+    KSNumbers num(ut.djd());
+    CachingDms LST = schedule.geo.GSTtoLST(ut.gst());
+    KSSun sun;
+    KSMoon moon;
+
+    sun.updateCoords(&num, true, schedule.geo.lat(), &LST, true);
+    moon.updateCoords(&num, true, schedule.geo.lat(), &LST, true);
+    moon.findPhase(&sun);
+
+    SkyPoint moonPoint(moon.ra(), moon.dec());
+    moonPoint.EquatorialToHorizontal(&LST, schedule.geo.lat());
+
+    const long double jd = ut.djd();
+
+    QVERIFY2(std::abs(angleDifference(ephemeris.lst(jd), LST.Degrees())) < LST_TOLERANCE,
+             qPrintable(QString("LST %1 instead of %2").arg(ephemeris.lst(jd)).arg(LST.Degrees())));
+
+    Ekos::SchedulerEphemeris::MoonState state = ephemeris.moon(jd);
+
+    QVERIFY(std::abs(angleDifference(state.ra, moon.ra().Degrees())) * std::cos(moon.dec().radians()) <
+            MOON_TOLERANCE);
+    QVERIFY(std::abs(state.dec - moon.dec().Degrees()) < MOON_TOLERANCE);
+    QVERIFY(std::abs(state.altitude - moonPoint.alt().Degrees()) < MOON_TOLERANCE);
+    QVERIFY(std::abs(state.illumination - moon.illum()) < ILLUMINATION_TOLERANCE);
+
+    for (int job = 0; job < 20; job++)
+    {
+        SkyPoint target = schedule.targets[job];
+        target.EquatorialToHorizontal(&LST, schedule.geo.lat());
+
+        QVERIFY2(std::abs(ephemeris.altitude(target, jd) - target.alt().Degrees()) < TARGET_TOLERANCE,
+                 qPrintable(QString("Job %1 at an altitude of %2 instead of %3")
+                                .arg(job)
+                                .arg(ephemeris.altitude(target, jd))
+                                .arg(target.alt().Degrees())));
+
+        // The separation inherits the error on the position of the Moon
+        QVERIFY(std::abs(ephemeris.moonSeparation(target, jd) - moon.angularDistanceTo(&target).Degrees()) <
+                MOON_TOLERANCE);
+    }
+}
+
+void TestSchedulerEphemeris::benchmarkSchedule_data()
+{
+    QTest::addColumn<bool>("search");
+
+    QTest::newRow("Every minute") << false;
+    QTest::newRow("Search") << true;
+}
+
+void TestSchedulerEphemeris::benchmarkSchedule()
+{
+    QFETCH(bool, search);
+
+    Schedule schedule;
+    int observable = 0;
+
+    QBENCHMARK
+    {
+        observable = 0;
+        for (int job = 0; job < SCHEDULE_JOBS; job++)
+        {
+            if ((search ? schedule.search(job) : schedule.scan(job)) >= 0)
+                observable++;
+        }
+    }
+
+    QVERIFY(observable > 0);
+}
+
+void TestSchedulerEphemeris::benchmarkEvaluateJob_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("Without ephemeris") << false;
+    QTest::newRow("With ephemeris") << true;
+}
+
+void TestSchedulerEphemeris::benchmarkEvaluateJob()
+{
+    if (hasEphemerisData() == false)
+        QSKIP("The Moon cannot be computed without the KStars data files");
+
+    QFETCH(bool, cached);
+
+    Schedule schedule;
+    int scheduled = 0;
+
+    QBENCHMARK
+    {
+        // The scheduler makes the ephemeris once for all the jobs it evaluates
+        QScopedPointer<Ekos::SchedulerEphemeris> ephemeris;
+        if (cached)
+            ephemeris.reset(new Ekos::SchedulerEphemeris(&schedule.geo, schedule.start, EPHEMERIS_HOURS));
+
+        scheduled = 0;
+        for (int job = 0; job < SCHEDULE_JOBS; job++)
+        {
+            if (schedule.evaluate(job, ephemeris.data()) >= 0)
+                scheduled++;
+        }
+    }
+
+    QVERIFY(scheduled > 0);
+}
+
+QTEST_GUILESS_MAIN(TestSchedulerEphemeris)
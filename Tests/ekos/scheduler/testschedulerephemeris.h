@@ -0,0 +1,57 @@
+/***************************************************************************
+                          testschedulerephemeris.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTSCHEDULEREPHEMERIS_H
+#define TESTSCHEDULEREPHEMERIS_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "schedulerephemeris.h"
+
+/**
+ * @class TestSchedulerEphemeris
+ * @short Compares the search of SchedulerEphemeris::findFirst against a scan of every minute, and the interpolated
+ * sidereal time, Moon and altitudes against positions found directly. Benchmarks the altitude searches of a large
+ * schedule, and the scheduling of its jobs with and without an ephemeris.
+ * @author agent <agent@local>
+ */
+class TestSchedulerEphemeris : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestSchedulerEphemeris();
+    ~TestSchedulerEphemeris();
+
+  private slots:
+    void findFirst_data();
+    void findFirst();
+
+    void compareWithScan();
+
+    void interpolation_data();
+    void interpolation();
+
+    void benchmarkSchedule_data();
+    void benchmarkSchedule();
+
+    void benchmarkEvaluateJob_data();
+    void benchmarkEvaluateJob();
+};
+
+#endif
@@ -0,0 +1,186 @@
+/***************************************************************************
+                          testschedulerevaluation.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testschedulerevaluation.h"
+#include "geolocation.h"
+#include "ksutils.h"
+#include "schedulerephemeris.h"
+#include "schedulerjob.h"
+#include "skypoint.h"
+
+// Jobs of a schedule large enough to be spread over every thread of the pool
+#define SCHEDULE_JOBS 250
+
+// Hours covered by the ephemeris of the scheduler
+#define EPHEMERIS_HOURS 50
+
+// Estimated time of the jobs, in seconds
+#define JOB_TIME 3600
+
+namespace
+{
+// Whether the positions of the Moon and of the Sun can be computed from the installed data files
+bool hasEphemerisData()
+{
+    QFile file;
+    return KSUtils::openDataFile(file, "moonLR.dat");
+}
+
+typedef Ekos::SchedulerEvaluation::JobEvaluation JobEvaluation;
+typedef Ekos::SchedulerEvaluation::EvaluationContext EvaluationContext;
+
+// Copy the jobs of the queue as Scheduler::evaluateJobs does, and score the copies
+QVector<JobEvaluation> evaluate(const QList<SchedulerJob *> &jobs, const EvaluationContext &context, bool parallel)
+{
+    QVector<JobEvaluation> evaluations;
+
+    foreach (SchedulerJob *job, jobs)
+    {
+        JobEvaluation evaluation;
+        evaluation.job      = job;
+        evaluation.snapshot = *job;
+        evaluations.append(evaluation);
+    }
+
+    if (parallel)
+        Ekos::SchedulerEvaluation::evaluate(context, evaluations).waitForFinished();
+    else
+    {
+        for (JobEvaluation &evaluation : evaluations)
+            Ekos::SchedulerEvaluation::evaluateJob(context, evaluation);
+    }
+
+    return evaluations;
+}
+}
+
+TestSchedulerEvaluation::TestSchedulerEvaluation() : QObject()
+{
+}
+
+TestSchedulerEvaluation::~TestSchedulerEvaluation()
+{
+}
+
+void TestSchedulerEvaluation::parallelMatchesSequential_data()
+{
+    QTest::addColumn<int>("threads"); // Threads of the global pool
+
+    QTest::newRow("Single thread") << 1;
+    QTest::newRow("Every core") << QThread::idealThreadCount();
+    QTest::newRow("More threads than jobs") << SCHEDULE_JOBS + 1;
+}
+
+void TestSchedulerEvaluation::parallelMatchesSequential()
+{
+    if (hasEphemerisData() == false)
+        QSKIP("The Moon cannot be computed without the KStars data files");
+
+    QFETCH(int, threads);
+
+    GeoLocation geo(dms(2.35), dms(48.85));
+    QDateTime now(QDate(2026, 10, 18), QTime(20, 0));
+    KStarsDateTime start = geo.LTtoUT(KStarsDateTime(now.date(), QTime()));
+
+    EvaluationContext context;
+    context.now             = now;
+    context.ephemeris       = QSharedPointer<const Ekos::SchedulerEphemeris>(
+        new Ekos::SchedulerEphemeris(&geo, start, EPHEMERIS_HOURS));
+    context.geo             = &geo;
+    context.lst             = geo.GSTtoLST(geo.LTtoUT(KStarsDateTime(now)).gst());
+    context.dawn            = 0.25;
+    context.dusk            = 0.8;
+    context.duskDateTime    = QDateTime(now.date(), QTime(19, 12));
+    context.preDawnDateTime = QDateTime(now.date().addDays(1), QTime(5, 30));
+    context.mountHourAngle  = 0;
+    context.indiReady       = false;
+    context.weatherChecked  = false;
+    context.weatherStatus   = IPS_IDLE;
+    context.minAltitude     = 15;
+    context.leadTime        = 5;
+    context.preDawnTime     = 30;
+    context.estimateJobTime = [](JobEvaluation &evaluation) {
+        evaluation.snapshot.setLightFramesRequired(true);
+        evaluation.snapshot.setEstimatedTime(JOB_TIME);
+        evaluation.log << QString("%1 observation job is estimated.").arg(evaluation.snapshot.getName());
+        return true;
+    };
+
+    QList<SchedulerJob *> jobs;
+    qsrand(17);
+    for (int i = 0; i < SCHEDULE_JOBS; i++)
+    {
+        SchedulerJob *job = new SchedulerJob();
+        job->setName(QString("Job %1").arg(i));
+        job->getTargetCoords() = SkyPoint(24.0 * qrand() / RAND_MAX, -30.0 + 120.0 * qrand() / RAND_MAX);
+        job->setMinAltitude(30.0);
+        job->setMinMoonSeparation(20.0);
+        job->setEnforceTwilight(true);
+        job->setStepPipeline(SchedulerJob::USE_TRACK);
+        job->setScore(0);
+        if (i % 10 == 0)
+            job->setCompletionCondition(SchedulerJob::FINISH_REPEAT);
+        // Some jobs start at a given time, earlier, now or later in the night
+        if (i % 4 == 0)
+        {
+            job->setStartupCondition(SchedulerJob::START_AT);
+            job->setFileStartupCondition(i % 8 ? SchedulerJob::START_AT : SchedulerJob::START_ASAP);
+            job->setStartupTime(now.addSecs(60 * (i % 9 - 2) * 30));
+        }
+        jobs.append(job);
+    }
+
+    int maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+    QVector<JobEvaluation> sequential = evaluate(jobs, context, false);
+    QVector<JobEvaluation> parallel   = evaluate(jobs, context, true);
+
+    QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(parallel.size(), sequential.size());
+
+    int scheduled = 0;
+    for (int i = 0; i < sequential.size(); i++)
+    {
+        // The queue keeps its order, and each job is left alone
+        QCOMPARE(parallel[i].job, jobs[i]);
+        QCOMPARE(sequential[i].job, jobs[i]);
+        QCOMPARE(jobs[i]->getState(), SchedulerJob::JOB_IDLE);
+
+        const SchedulerJob &expected = sequential[i].snapshot;
+        const SchedulerJob &actual   = parallel[i].snapshot;
+
+        QCOMPARE(actual.getName(), expected.getName());
+        QCOMPARE(actual.getState(), expected.getState());
+        QCOMPARE(actual.getScore(), expected.getScore());
+        QCOMPARE(actual.getStartupCondition(), expected.getStartupCondition());
+        QCOMPARE(actual.getStartupTime(), expected.getStartupTime());
+        QCOMPARE(actual.getEstimatedTime(), expected.getEstimatedTime());
+        QCOMPARE(parallel[i].log, sequential[i].log);
+
+        if (expected.getState() == SchedulerJob::JOB_SCHEDULED)
+            scheduled++;
+    }
+
+    QVERIFY(scheduled > 0);
+
+    qDeleteAll(jobs);
+}
+
+QTEST_GUILESS_MAIN(TestSchedulerEvaluation)
@@ -0,0 +1,46 @@
+/***************************************************************************
+                          testschedulerevaluation.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTSCHEDULEREVALUATION_H
+#define TESTSCHEDULEREVALUATION_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "schedulerevaluation.h"
+
+/**
+ * @class TestSchedulerEvaluation
+ * @short Scores copies of the jobs of a large schedule with SchedulerEvaluation, across the global thread pool and one
+ * after the other, and checks that both leave the same states, scores, startup times and logs, in the order of the
+ * queue. Jobs start as soon as possible or at a given time, culmination needs the sky of a KStars session.
+ * @author agent <agent@local>
+ */
+class TestSchedulerEvaluation : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestSchedulerEvaluation();
+    ~TestSchedulerEvaluation();
+
+  private slots:
+    void parallelMatchesSequential_data();
+    void parallelMatchesSequential();
+};
+
+#endif
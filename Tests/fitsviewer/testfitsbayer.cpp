@@ -0,0 +1,207 @@
+/***************************************************************************
+                          testfitsbayer.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsbayer.h"
+
+/* STL Includes */
+#include <limits>
+#include <vector>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+namespace
+{
+template <typename T>
+std::vector<T> syntheticBayer(uint32_t width, uint32_t height)
+{
+    std::vector<T> frame(width * height);
+
+    qsrand(7);
+    for (size_t i = 0; i < frame.size(); i++)
+        frame[i] = static_cast<T>(qrand() % (static_cast<int>(std::numeric_limits<T>::max()) + 1));
+
+    return frame;
+}
+
+dc1394error_t referenceDecode(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                              dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    return dc1394_bayer_decoding_8bit(bayer, rgb, width, height, filter, method);
+}
+
+dc1394error_t referenceDecode(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                              dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    return dc1394_bayer_decoding_16bit(bayer, rgb, width, height, filter, method, 16);
+}
+
+// FITSData::debayer before FITSBayer: serial decoding into interleaved RGB, then copied into three planes
+template <typename T>
+dc1394error_t referenceDebayer(const T *bayer, T *planar, uint32_t width, uint32_t height,
+                               dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    // The 16 bit decoders leave the border untouched, so start from a black image to get a defined result
+    std::vector<T> rgb(width * height * 3, 0);
+    dc1394error_t error = referenceDecode(bayer, rgb.data(), width, height, filter, method);
+    uint32_t samples    = width * height;
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        planar[i]               = rgb[i * 3];
+        planar[i + samples]     = rgb[i * 3 + 1];
+        planar[i + samples * 2] = rgb[i * 3 + 2];
+    }
+
+    return error;
+}
+}
+
+TestFITSBayer::TestFITSBayer() : QObject()
+{
+}
+
+TestFITSBayer::~TestFITSBayer()
+{
+}
+
+template <typename T>
+void TestFITSBayer::compare(uint32_t width, uint32_t height, dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    std::vector<T> bayer = syntheticBayer<T>(width, height);
+    std::vector<T> expected(width * height * 3), decoded(width * height * 3, 1);
+
+    QCOMPARE(referenceDebayer<T>(bayer.data(), expected.data(), width, height, filter, method), DC1394_SUCCESS);
+    QCOMPARE(FITSBayer::decode<T>(bayer.data(), decoded.data(), width, height, width * height, filter, method),
+             DC1394_SUCCESS);
+
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        if (decoded[i] != expected[i])
+            QFAIL(qPrintable(QString("Channel %1 differs at (%2, %3): %4 instead of %5")
+                                 .arg(i / (width * height))
+                                 .arg(i % width)
+                                 .arg((i / width) % height)
+                                 .arg(decoded[i])
+                                 .arg(expected[i])));
+    }
+}
+
+void TestFITSBayer::compareWithReference_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("method");
+    QTest::addColumn<int>("filter");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    const QList<QPair<QString, dc1394bayer_method_t>> methods = { { "bilinear", DC1394_BAYER_METHOD_BILINEAR },
+                                                                  { "vng", DC1394_BAYER_METHOD_VNG } };
+    const QList<QPair<QString, dc1394color_filter_t>> filters = { { "RGGB", DC1394_COLOR_FILTER_RGGB },
+                                                                  { "GBRG", DC1394_COLOR_FILTER_GBRG },
+                                                                  { "GRBG", DC1394_COLOR_FILTER_GRBG },
+                                                                  { "BGGR", DC1394_COLOR_FILTER_BGGR } };
+
+    for (const QString &type : { "uint8", "uint16" })
+    {
+        for (const QPair<QString, dc1394bayer_method_t> &method : methods)
+        {
+            for (const QPair<QString, dc1394color_filter_t> &filter : filters)
+            {
+                // Odd dimensions, and an image tall enough to be split in many bands
+                QTest::newRow(qPrintable(type + " " + method.first + " " + filter.first + " odd"))
+                    << type << static_cast<int>(method.second) << static_cast<int>(filter.second) << 101 << 97;
+                QTest::newRow(qPrintable(type + " " + method.first + " " + filter.first + " tall"))
+                    << type << static_cast<int>(method.second) << static_cast<int>(filter.second) << 514 << 2001;
+            }
+        }
+    }
+}
+
+void TestFITSBayer::compareWithReference()
+{
+    QFETCH(QString, type);
+    QFETCH(int, method);
+    QFETCH(int, filter);
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    if (type == "uint8")
+        compare<uint8_t>(width, height, static_cast<dc1394color_filter_t>(filter),
+                         static_cast<dc1394bayer_method_t>(method));
+    else
+        compare<uint16_t>(width, height, static_cast<dc1394color_filter_t>(filter),
+                          static_cast<dc1394bayer_method_t>(method));
+}
+
+template <typename T>
+void TestFITSBayer::benchmark(dc1394bayer_method_t method, bool reference)
+{
+    std::vector<T> bayer = syntheticBayer<T>(BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    std::vector<T> planar(bayer.size() * 3);
+
+    if (reference)
+    {
+        QBENCHMARK
+        {
+            referenceDebayer<T>(bayer.data(), planar.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT,
+                                DC1394_COLOR_FILTER_RGGB, method);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            FITSBayer::decode<T>(bayer.data(), planar.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, bayer.size(),
+                                 DC1394_COLOR_FILTER_RGGB, method);
+        }
+    }
+}
+
+void TestFITSBayer::benchmarkDebayer_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("method");
+    QTest::addColumn<bool>("reference");
+
+    for (const QString &type : { "uint8", "uint16" })
+    {
+        QTest::newRow(qPrintable(type + " bilinear"))
+            << type << static_cast<int>(DC1394_BAYER_METHOD_BILINEAR) << false;
+        QTest::newRow(qPrintable(type + " bilinear reference"))
+            << type << static_cast<int>(DC1394_BAYER_METHOD_BILINEAR) << true;
+    }
+
+    QTest::newRow("uint16 vng") << "uint16" << static_cast<int>(DC1394_BAYER_METHOD_VNG) << false;
+    QTest::newRow("uint16 vng reference") << "uint16" << static_cast<int>(DC1394_BAYER_METHOD_VNG) << true;
+}
+
+void TestFITSBayer::benchmarkDebayer()
+{
+    QFETCH(QString, type);
+    QFETCH(int, method);
+    QFETCH(bool, reference);
+
+    if (type == "uint8")
+        benchmark<uint8_t>(static_cast<dc1394bayer_method_t>(method), reference);
+    else
+        benchmark<uint16_t>(static_cast<dc1394bayer_method_t>(method), reference);
+}
+
+QTEST_GUILESS_MAIN(TestFITSBayer)
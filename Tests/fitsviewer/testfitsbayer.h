@@ -0,0 +1,54 @@
+/***************************************************************************
+                          testfitsbayer.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSBAYER_H
+#define TESTFITSBAYER_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "fitsbayer.h"
+
+/**
+ * @class TestFITSBayer
+ * @short Compares FITSBayer pixel by pixel against the serial dc1394 decoding followed by the planar copy of
+ * FITSData, and benchmarks debayering a full frame
+ * @author agent <agent@local>
+ */
+class TestFITSBayer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSBayer();
+    ~TestFITSBayer();
+
+  private slots:
+    void compareWithReference_data();
+    void compareWithReference();
+
+    void benchmarkDebayer_data();
+    void benchmarkDebayer();
+
+  private:
+    template <typename T>
+    void compare(uint32_t width, uint32_t height, dc1394color_filter_t filter, dc1394bayer_method_t method);
+    template <typename T>
+    void benchmark(dc1394bayer_method_t method, bool reference);
+};
+
+#endif
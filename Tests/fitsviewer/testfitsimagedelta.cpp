@@ -0,0 +1,167 @@
+/***************************************************************************
+                          testfitsimagedelta.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsimagedelta.h"
+#include "Options.h"
+
+/* STL Includes */
+#include <vector>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+namespace
+{
+std::vector<uint16_t> syntheticFrame(int width, int height, int channels)
+{
+    std::vector<uint16_t> frame(width * height * channels);
+
+    qsrand(5);
+    for (size_t i = 0; i < frame.size(); i++)
+        frame[i] = 1000 + qrand() % 500;
+
+    return frame;
+}
+
+// Clip a rectangle of one channel, as a filter applied to a region would
+void clipRegion(std::vector<uint16_t> &frame, int width, int height, int channel, const QRect &region)
+{
+    for (int y = region.top(); y <= region.bottom(); y++)
+        for (int x = region.left(); x <= region.right(); x++)
+            frame[(channel * height + y) * width + x] = 1200;
+}
+
+const uint8_t *bytes(const std::vector<uint16_t> &frame)
+{
+    return reinterpret_cast<const uint8_t *>(frame.data());
+}
+}
+
+TestFITSImageDelta::TestFITSImageDelta() : QObject()
+{
+}
+
+TestFITSImageDelta::~TestFITSImageDelta()
+{
+}
+
+void TestFITSImageDelta::initTestCase()
+{
+    fitsUndoMemory = Options::fITSUndoMemory();
+}
+
+void TestFITSImageDelta::cleanupTestCase()
+{
+    Options::setFITSUndoMemory(fitsUndoMemory);
+}
+
+void TestFITSImageDelta::testUnchanged()
+{
+    std::vector<uint16_t> frame = syntheticFrame(500, 300, 1);
+    FITSImageDelta delta;
+
+    QVERIFY(delta.record(bytes(frame), bytes(frame), 500, 300, 1, sizeof(uint16_t)));
+    QCOMPARE(delta.getTileCount(), 0);
+    QCOMPARE(delta.getSize(), 0LL);
+}
+
+void TestFITSImageDelta::testRegion()
+{
+    // Width and height are not multiples of the tile size, so edge tiles are partial
+    const int width = 1000, height = 700;
+    std::vector<uint16_t> before = syntheticFrame(width, height, 1), after = before;
+
+    // Touches 2 x 2 tiles, including the partial tiles in the bottom right corner
+    clipRegion(after, width, height, 0, QRect(900, 600, 100, 100));
+
+    FITSImageDelta delta;
+    QVERIFY(delta.record(bytes(before), bytes(after), width, height, 1, sizeof(uint16_t)));
+    QCOMPARE(delta.getTileCount(), 4);
+    QVERIFY(delta.getSize() < static_cast<qint64>(before.size() * sizeof(uint16_t)) / 10);
+
+    QVERIFY(delta.restore(reinterpret_cast<uint8_t *>(after.data())));
+    QVERIFY(after == before);
+}
+
+void TestFITSImageDelta::testMultiChannel()
+{
+    const int width = 300, height = 200;
+    std::vector<uint16_t> before = syntheticFrame(width, height, 3), after = before;
+
+    clipRegion(after, width, height, 2, QRect(10, 10, 20, 20));
+
+    FITSImageDelta delta;
+    QVERIFY(delta.record(bytes(before), bytes(after), width, height, 3, sizeof(uint16_t)));
+    QCOMPARE(delta.getTileCount(), 1);
+
+    QVERIFY(delta.restore(reinterpret_cast<uint8_t *>(after.data())));
+    QVERIFY(after == before);
+}
+
+void TestFITSImageDelta::testMemoryBudget()
+{
+    const int width = 2048, height = 2048;
+    std::vector<uint16_t> before = syntheticFrame(width, height, 1), after = before;
+
+    // Each delta changes the whole 8 MB frame, and noise does not compress much, so a few exceed the budget
+    for (uint16_t &value : after)
+        value++;
+
+    Options::setFITSUndoMemory(16);
+
+    qint64 memoryUsed = FITSImageDelta::getMemoryUsed();
+    QList<FITSImageDelta *> deltas;
+
+    while (deltas.count() < 10 && (deltas.isEmpty() || deltas.first()->isSpilled() == false))
+    {
+        deltas.append(new FITSImageDelta());
+        QVERIFY(deltas.last()->record(bytes(before), bytes(after), width, height, 1, sizeof(uint16_t)));
+        QVERIFY(deltas.last()->getSize() < static_cast<qint64>(before.size() * sizeof(uint16_t)));
+    }
+
+    // The oldest delta goes to disk first
+    QVERIFY(deltas.count() > 2);
+    QVERIFY(deltas.first()->isSpilled());
+    QVERIFY(deltas.last()->isSpilled() == false);
+    QVERIFY(FITSImageDelta::getMemoryUsed() - memoryUsed <= 16 * 1024 * 1024);
+
+    std::vector<uint16_t> restored = after;
+    QVERIFY(deltas.first()->restore(reinterpret_cast<uint8_t *>(restored.data())));
+    QVERIFY(restored == before);
+
+    qDeleteAll(deltas);
+}
+
+void TestFITSImageDelta::benchmarkRestore()
+{
+    std::vector<uint16_t> before = syntheticFrame(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1), after = before;
+
+    // A star sized region, undo must not depend on the sensor size
+    clipRegion(after, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0, QRect(4000, 3000, 200, 200));
+
+    FITSImageDelta delta;
+    QVERIFY(delta.record(bytes(before), bytes(after), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1, sizeof(uint16_t)));
+
+    QBENCHMARK
+    {
+        delta.restore(reinterpret_cast<uint8_t *>(after.data()));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestFITSImageDelta)
@@ -0,0 +1,54 @@
+/***************************************************************************
+                          testfitsimagedelta.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSIMAGEDELTA_H
+#define TESTFITSIMAGEDELTA_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "fitsimagedelta.h"
+
+/**
+ * @class TestFITSImageDelta
+ * @short Checks that FITSImageDelta stores only changed tiles and restores them, in memory and spilled to disk
+ * @author agent <agent@local>
+ */
+class TestFITSImageDelta : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSImageDelta();
+    ~TestFITSImageDelta();
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testUnchanged();
+    void testRegion();
+    void testMultiChannel();
+    void testMemoryBudget();
+
+    void benchmarkRestore();
+
+  private:
+    uint fitsUndoMemory = 0;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/***************************************************************************
+                         testfitsmemory.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsmemory.h"
+#include "fitsdata.h"
+
+/* STL Includes */
+#include <cstring>
+#include <vector>
+
+#include <fitsio.h>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+TestFITSMemory::TestFITSMemory() : QObject()
+{
+}
+
+TestFITSMemory::~TestFITSMemory()
+{
+}
+
+QString TestFITSMemory::createImage(int bitpix, int width, int height, bool emptyPrimary)
+{
+    std::vector<double> frame(width * height);
+
+    qsrand(11);
+    for (size_t i = 0; i < frame.size(); i++)
+        frame[i] = qrand() % 200 + (i % width) / 8;
+
+    QString filename = tempDir.path() + QString("/memory_%1_%2x%3%4.fits")
+                                            .arg(bitpix)
+                                            .arg(width)
+                                            .arg(height)
+                                            .arg(emptyPrimary ? "_extension" : "");
+    fitsfile *fptr   = nullptr;
+    int status       = 0;
+    long naxes[2]    = { width, height };
+
+    fits_create_file(&fptr, QString("!" + filename).toLatin1().constData(), &status);
+
+    // Images sent as an extension behind a primary HDU without data
+    if (emptyPrimary)
+        fits_create_img(fptr, BYTE_IMG, 0, nullptr, &status);
+
+    fits_create_img(fptr, bitpix, 2, naxes, &status);
+    fits_write_img(fptr, TDOUBLE, 1, frame.size(), frame.data(), &status);
+    fits_close_file(fptr, &status);
+
+    return status == 0 ? filename : QString();
+}
+
+void TestFITSMemory::compareWithFile_data()
+{
+    QTest::addColumn<int>("bitpix");
+    QTest::addColumn<bool>("emptyPrimary");
+
+    QTest::newRow("byte") << static_cast<int>(BYTE_IMG) << false;
+    QTest::newRow("short") << static_cast<int>(SHORT_IMG) << false;
+    QTest::newRow("ushort") << static_cast<int>(USHORT_IMG) << false;
+    QTest::newRow("ulong") << static_cast<int>(ULONG_IMG) << false;
+    QTest::newRow("float") << static_cast<int>(FLOAT_IMG) << false;
+    QTest::newRow("double") << static_cast<int>(DOUBLE_IMG) << false;
+    QTest::newRow("ushort extension") << static_cast<int>(USHORT_IMG) << true;
+}
+
+void TestFITSMemory::compareWithFile()
+{
+    QFETCH(int, bitpix);
+    QFETCH(bool, emptyPrimary);
+
+    QString filename = createImage(bitpix, 640, 479, emptyPrimary);
+    QVERIFY(filename.isEmpty() == false);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray buffer = file.readAll();
+
+    FITSData fromFile(FITS_GUIDE), fromMemory(FITS_GUIDE);
+    QVERIFY(fromFile.loadFITS(filename));
+    QVERIFY(fromMemory.loadFITSFromMemory(filename, buffer));
+
+    QVERIFY(fromFile.isInMemory() == false);
+    QVERIFY(fromMemory.isInMemory());
+    QCOMPARE(fromMemory.getFilename(), filename);
+
+    QCOMPARE(fromMemory.getBPP(), fromFile.getBPP());
+    QCOMPARE(fromMemory.getSize(), fromFile.getSize());
+    QCOMPARE(fromMemory.getBytesPerPixel(), fromFile.getBytesPerPixel());
+    QCOMPARE(fromMemory.getMin(), fromFile.getMin());
+    QCOMPARE(fromMemory.getMax(), fromFile.getMax());
+    QCOMPARE(fromMemory.getMean(), fromFile.getMean());
+    QCOMPARE(fromMemory.getStdDev(), fromFile.getStdDev());
+
+    size_t nbytes = fromFile.getSize() * fromFile.getBytesPerPixel();
+    QVERIFY(memcmp(fromMemory.getImageBuffer(), fromFile.getImageBuffer(), nbytes) == 0);
+
+    // Once saved, the image lives in its new file
+    QString saved = tempDir.path() + "/saved.fits";
+    QCOMPARE(fromMemory.saveFITS(saved), 0);
+    QCOMPARE(fromMemory.isInMemory(), false);
+    QCOMPARE(fromMemory.getFilename(), saved);
+    QVERIFY(QFile::exists(saved));
+}
+
+void TestFITSMemory::invalidBuffer()
+{
+    FITSData data(FITS_GUIDE);
+
+    QVERIFY(data.loadFITSFromMemory("empty", QByteArray()) == false);
+    QVERIFY(data.loadFITSFromMemory("garbage", QByteArray(2880 * 2, 'x')) == false);
+
+    // A frame cut short must not be read past its end
+    QString filename = createImage(USHORT_IMG, 320, 240);
+    QVERIFY(filename.isEmpty() == false);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(data.loadFITSFromMemory(filename, file.readAll().left(2880 * 4)) == false);
+}
+
+void TestFITSMemory::benchmarkLoad_data()
+{
+    QTest::addColumn<bool>("memory");
+
+    QTest::newRow("file") << false;
+    QTest::newRow("memory") << true;
+}
+
+void TestFITSMemory::benchmarkLoad()
+{
+    QFETCH(bool, memory);
+
+    QString filename = createImage(USHORT_IMG, BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+    QVERIFY(filename.isEmpty() == false);
+
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray blob = file.readAll();
+    file.close();
+
+    // From a received BLOB to a loaded frame, as ISD::CCD did before and does now
+    QBENCHMARK
+    {
+        FITSData data(FITS_GUIDE);
+
+        if (memory)
+            QVERIFY(data.loadFITSFromMemory(filename, QByteArray(blob.constData(), blob.size())));
+        else
+        {
+            QString frame = tempDir.path() + "/frame.fits";
+            QFile out(frame);
+            QVERIFY(out.open(QIODevice::WriteOnly));
+            QCOMPARE(out.write(blob), static_cast<qint64>(blob.size()));
+            out.close();
+            QVERIFY(data.loadFITS(frame));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestFITSMemory)
@@ -0,0 +1,52 @@
+/***************************************************************************
+                          testfitsmemory.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSMEMORY_H
+#define TESTFITSMEMORY_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <QTemporaryDir>
+
+/**
+ * @class TestFITSMemory
+ * @short Compares FITS images loaded from memory with the same images loaded from disk, and benchmarks both
+ * @author agent <agent@local>
+ */
+class TestFITSMemory : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSMemory();
+    ~TestFITSMemory();
+
+  private slots:
+    void compareWithFile_data();
+    void compareWithFile();
+    void invalidBuffer();
+
+    void benchmarkLoad_data();
+    void benchmarkLoad();
+
+  private:
+    QString createImage(int bitpix, int width, int height, bool emptyPrimary = false);
+
+    QTemporaryDir tempDir;
+};
+
+#endif
@@ -0,0 +1,162 @@
+/***************************************************************************
+                          testfitsstars.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsstars.h"
+#include "fitsdata.h"
+
+/* STL Includes */
+#include <cmath>
+#include <vector>
+
+#include <fitsio.h>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+TestFITSStars::TestFITSStars() : QObject()
+{
+}
+
+TestFITSStars::~TestFITSStars()
+{
+}
+
+QString TestFITSStars::createStarField(int width, int height, int stars, QVector<QPointF> &positions)
+{
+    std::vector<uint16_t> frame(width * height);
+
+    // Sky background with noise
+    qsrand(3);
+    for (size_t i = 0; i < frame.size(); i++)
+        frame[i] = 1000 + qrand() % 40;
+
+    // Gaussian stars on a grid, away from the border ignored in focus mode
+    int columns = ceil(sqrt(stars * width / static_cast<double>(height)));
+    int rows    = (stars + columns - 1) / columns;
+    double dx = width * 0.8 / columns, dy = height * 0.8 / rows;
+
+    positions.clear();
+    for (int s = 0; s < stars; s++)
+    {
+        double cx    = width * 0.1 + (s % columns + 0.5) * dx + (qrand() % 100) / 100.0;
+        double cy    = height * 0.1 + (s / columns + 0.5) * dy + (qrand() % 100) / 100.0;
+        double sigma = 1.5 + (qrand() % 100) / 100.0;
+        double peak  = 10000 + qrand() % 30000;
+
+        positions.append(QPointF(cx, cy));
+
+        for (int y = qMax(0, int(cy - 6 * sigma)); y < qMin(height, int(cy + 6 * sigma)); y++)
+        {
+            for (int x = qMax(0, int(cx - 6 * sigma)); x < qMin(width, int(cx + 6 * sigma)); x++)
+            {
+                double r2 = (x + 0.5 - cx) * (x + 0.5 - cx) + (y + 0.5 - cy) * (y + 0.5 - cy);
+                frame[y * width + x] = qMin(65535.0, frame[y * width + x] + peak * exp(-r2 / (2 * sigma * sigma)));
+            }
+        }
+    }
+
+    QString filename = tempDir.path() + QString("/stars_%1x%2.fits").arg(width).arg(height);
+    fitsfile *fptr   = nullptr;
+    int status       = 0;
+    long naxes[2]    = { width, height };
+
+    fits_create_file(&fptr, QString("!" + filename).toLatin1().constData(), &status);
+    fits_create_img(fptr, USHORT_IMG, 2, naxes, &status);
+    fits_write_img(fptr, TUSHORT, 1, frame.size(), frame.data(), &status);
+    fits_close_file(fptr, &status);
+
+    return status == 0 ? filename : QString();
+}
+
+void TestFITSStars::testStarField()
+{
+    QVector<QPointF> positions;
+    QString filename = createStarField(2000, 1500, 150, positions);
+    QVERIFY(filename.isEmpty() == false);
+
+    FITSData data(FITS_FOCUS);
+    QVERIFY(data.loadFITS(filename));
+
+    int count = data.findStars();
+    QVERIFY(count >= positions.count() * 8 / 10);
+    QVERIFY(count <= positions.count());
+
+    // Every detected star must be one of the synthetic stars, with a plausible HFR
+    for (Edge *center : data.getStarCenters())
+    {
+        bool matched = false;
+        for (const QPointF &position : positions)
+        {
+            if (std::abs(center->x - position.x()) < 2 && std::abs(center->y - position.y()) < 2)
+            {
+                matched = true;
+                break;
+            }
+        }
+
+        QVERIFY(matched);
+        QVERIFY(center->HFR > 0.5 && center->HFR < 5);
+    }
+}
+
+void TestFITSStars::testRepeatable()
+{
+    // Bands are scanned concurrently, the result must not depend on their timing
+    QVector<QPointF> positions;
+    QString filename = createStarField(2000, 1500, 150, positions);
+
+    FITSData data(FITS_FOCUS);
+    QVERIFY(data.loadFITS(filename));
+
+    data.findStars();
+    QList<Edge *> first = data.getStarCenters();
+    QVector<QPointF> firstCenters;
+    for (Edge *center : first)
+        firstCenters.append(QPointF(center->x, center->y));
+    double firstHFR = data.getHFR();
+
+    for (int i = 0; i < 5; i++)
+    {
+        data.findStars(QRectF(), true);
+        QList<Edge *> centers = data.getStarCenters();
+
+        QCOMPARE(centers.count(), firstCenters.count());
+        for (int j = 0; j < centers.count(); j++)
+            QCOMPARE(QPointF(centers[j]->x, centers[j]->y), firstCenters[j]);
+        QCOMPARE(data.getHFR(), firstHFR);
+    }
+}
+
+void TestFITSStars::benchmarkStarField()
+{
+    QVector<QPointF> positions;
+    QString filename = createStarField(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 500, positions);
+
+    FITSData data(FITS_FOCUS);
+    QVERIFY(data.loadFITS(filename));
+
+    QBENCHMARK
+    {
+        data.findStars(QRectF(), true);
+    }
+
+    QVERIFY(data.getStarCenters().count() >= positions.count() * 8 / 10);
+}
+
+QTEST_GUILESS_MAIN(TestFITSStars)
@@ -0,0 +1,50 @@
+/***************************************************************************
+                          testfitsstars.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSSTARS_H
+#define TESTFITSSTARS_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+#include <QTemporaryDir>
+
+/**
+ * @class TestFITSStars
+ * @short Runs centroid star detection on synthetic star fields, and benchmarks it on a full frame
+ * @author agent <agent@local>
+ */
+class TestFITSStars : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSStars();
+    ~TestFITSStars();
+
+  private slots:
+    void testStarField();
+    void testRepeatable();
+
+    void benchmarkStarField();
+
+  private:
+    QString createStarField(int width, int height, int stars, QVector<QPointF> &positions);
+
+    QTemporaryDir tempDir;
+};
+
+#endif
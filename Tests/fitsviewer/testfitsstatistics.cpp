@@ -0,0 +1,289 @@
+/***************************************************************************
+                          testfitsstatistics.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsstatistics.h"
+
+/* STL Includes */
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+namespace
+{
+template <typename T>
+std::vector<T> syntheticFrame(int width, int height, int channels)
+{
+    // Sky background with noise plus a few saturated pixels, scaled to the range of the type
+    double scale = std::numeric_limits<T>::is_integer ? std::min<double>(std::numeric_limits<T>::max(), 65535) : 1.0;
+    std::vector<T> frame(width * height * channels);
+
+    qsrand(7);
+    for (size_t i = 0; i < frame.size(); i++)
+    {
+        double value = 0.1 + 0.02 * (qrand() / static_cast<double>(RAND_MAX));
+        if (qrand() % 10000 == 0)
+            value = 1.0;
+        frame[i] = static_cast<T>(value * scale);
+    }
+
+    return frame;
+}
+
+// Scalar min/max followed by Welford's method, as FITSData computed them before
+template <typename T>
+void referenceStats(const T *buffer, uint32_t samples, FITSStatistics::ChannelStats &stats)
+{
+    stats.min = stats.max = buffer[0];
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        if (buffer[i] < stats.min)
+            stats.min = buffer[i];
+        if (buffer[i] > stats.max)
+            stats.max = buffer[i];
+    }
+
+    int m_n       = 2;
+    double m_oldM = buffer[0], m_newM = buffer[0], m_oldS = 0, m_newS = 0;
+
+    for (uint32_t i = 1; i < samples; i++)
+    {
+        m_newM = m_oldM + (buffer[i] - m_oldM) / m_n;
+        m_newS = m_oldS + (buffer[i] - m_oldM) * (buffer[i] - m_newM);
+
+        m_oldM = m_newM;
+        m_oldS = m_newS;
+        m_n++;
+    }
+
+    stats.mean   = m_newM;
+    stats.stddev = sqrt(m_newS / (m_n - 2));
+}
+}
+
+TestFITSStatistics::TestFITSStatistics() : QObject()
+{
+}
+
+TestFITSStatistics::~TestFITSStatistics()
+{
+}
+
+template <typename T>
+void TestFITSStatistics::compare(int width, int height, int channels)
+{
+    std::vector<T> frame = syntheticFrame<T>(width, height, channels);
+    uint32_t samples     = width * height;
+    FITSStatistics::ChannelStats stats[3];
+
+    FITSStatistics::calculate<T>(frame.data(), width, height, channels, stats);
+
+    for (int ch = 0; ch < channels; ch++)
+    {
+        FITSStatistics::ChannelStats reference;
+        referenceStats<T>(frame.data() + ch * samples, samples, reference);
+
+        QCOMPARE(stats[ch].min, reference.min);
+        QCOMPARE(stats[ch].max, reference.max);
+        QVERIFY(std::abs(stats[ch].mean - reference.mean) <= 1e-6 * std::abs(reference.mean) + 1e-9);
+        QVERIFY(std::abs(stats[ch].stddev - reference.stddev) <= 1e-5 * reference.stddev + 1e-9);
+
+        // Median and MAD are estimated, but must lie within the bulk of the distribution
+        QVERIFY(stats[ch].median >= stats[ch].min && stats[ch].median <= stats[ch].max);
+        QVERIFY(stats[ch].mad >= 0 && stats[ch].mad <= reference.stddev * 2);
+    }
+}
+
+void TestFITSStatistics::compareWithReference_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("channels");
+
+    for (const QString &type : { "uint8", "int16", "uint16", "int32", "uint32", "float", "int64", "double" })
+    {
+        // Odd widths exercise the scalar tail of the vectorized rows
+        QTest::newRow(qPrintable(type + " mono")) << type << 1021 << 767 << 1;
+        QTest::newRow(qPrintable(type + " rgb")) << type << 643 << 481 << 3;
+        QTest::newRow(qPrintable(type + " tiny")) << type << 3 << 2 << 1;
+    }
+}
+
+void TestFITSStatistics::compareWithReference()
+{
+    QFETCH(QString, type);
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, channels);
+
+    if (type == "uint8")
+        compare<uint8_t>(width, height, channels);
+    else if (type == "int16")
+        compare<int16_t>(width, height, channels);
+    else if (type == "uint16")
+        compare<uint16_t>(width, height, channels);
+    else if (type == "int32")
+        compare<int32_t>(width, height, channels);
+    else if (type == "uint32")
+        compare<uint32_t>(width, height, channels);
+    else if (type == "float")
+        compare<float>(width, height, channels);
+    else if (type == "int64")
+        compare<int64_t>(width, height, channels);
+    else
+        compare<double>(width, height, channels);
+}
+
+template <typename T>
+void TestFITSStatistics::compareHistogram(int width, int height)
+{
+    std::vector<T> frame = syntheticFrame<T>(width, height, 1);
+    uint32_t samples     = width * height;
+    FITSStatistics::ChannelStats stats;
+
+    FITSStatistics::calculate<T>(frame.data(), width, height, 1, &stats);
+
+    int binCount    = sqrt(samples);
+    double binWidth = (stats.max - stats.min) / (binCount - 1);
+    std::vector<double> frequency(binCount), reference(binCount, 0);
+
+    // Binning as FITSHistogram did it on the GUI thread
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        uint16_t id = round((frame[i] - stats.min) / binWidth);
+        reference[id >= binCount ? binCount - 1 : id]++;
+    }
+
+    FITSStatistics::histogram<T>(frame.data(), samples, stats.min, binWidth, binCount, frequency.data());
+    QVERIFY(frequency == reference);
+}
+
+void TestFITSStatistics::compareHistogram_data()
+{
+    QTest::addColumn<QString>("type");
+
+    for (const QString &type : { "uint8", "int16", "uint16", "int32", "uint32", "float", "int64", "double" })
+        QTest::newRow(qPrintable(type)) << type;
+}
+
+void TestFITSStatistics::compareHistogram()
+{
+    QFETCH(QString, type);
+
+    if (type == "uint8")
+        compareHistogram<uint8_t>(1021, 767);
+    else if (type == "int16")
+        compareHistogram<int16_t>(1021, 767);
+    else if (type == "uint16")
+        compareHistogram<uint16_t>(1021, 767);
+    else if (type == "int32")
+        compareHistogram<int32_t>(1021, 767);
+    else if (type == "uint32")
+        compareHistogram<uint32_t>(1021, 767);
+    else if (type == "float")
+        compareHistogram<float>(1021, 767);
+    else if (type == "int64")
+        compareHistogram<int64_t>(1021, 767);
+    else
+        compareHistogram<double>(1021, 767);
+}
+
+template <typename T>
+void TestFITSStatistics::benchmark(bool reference)
+{
+    std::vector<T> frame = syntheticFrame<T>(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1);
+    FITSStatistics::ChannelStats stats;
+
+    if (reference)
+    {
+        QBENCHMARK
+        {
+            referenceStats<T>(frame.data(), BENCHMARK_WIDTH * BENCHMARK_HEIGHT, stats);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            FITSStatistics::calculate<T>(frame.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1, &stats);
+        }
+    }
+}
+
+void TestFITSStatistics::benchmarkStatistics_data()
+{
+    QTest::addColumn<QString>("type");
+
+    for (const QString &type : { "uint8", "int16", "uint16", "int32", "uint32", "float", "int64", "double" })
+        QTest::newRow(qPrintable(type)) << type;
+}
+
+void TestFITSStatistics::benchmarkStatistics()
+{
+    QFETCH(QString, type);
+
+    if (type == "uint8")
+        benchmark<uint8_t>(false);
+    else if (type == "int16")
+        benchmark<int16_t>(false);
+    else if (type == "uint16")
+        benchmark<uint16_t>(false);
+    else if (type == "int32")
+        benchmark<int32_t>(false);
+    else if (type == "uint32")
+        benchmark<uint32_t>(false);
+    else if (type == "float")
+        benchmark<float>(false);
+    else if (type == "int64")
+        benchmark<int64_t>(false);
+    else
+        benchmark<double>(false);
+}
+
+void TestFITSStatistics::benchmarkReference_data()
+{
+    benchmarkStatistics_data();
+}
+
+void TestFITSStatistics::benchmarkReference()
+{
+    QFETCH(QString, type);
+
+    if (type == "uint8")
+        benchmark<uint8_t>(true);
+    else if (type == "int16")
+        benchmark<int16_t>(true);
+    else if (type == "uint16")
+        benchmark<uint16_t>(true);
+    else if (type == "int32")
+        benchmark<int32_t>(true);
+    else if (type == "uint32")
+        benchmark<uint32_t>(true);
+    else if (type == "float")
+        benchmark<float>(true);
+    else if (type == "int64")
+        benchmark<int64_t>(true);
+    else
+        benchmark<double>(true);
+}
+
+QTEST_GUILESS_MAIN(TestFITSStatistics)
@@ -0,0 +1,61 @@
+/***************************************************************************
+                          testfitsstatistics.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSSTATISTICS_H
+#define TESTFITSSTATISTICS_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "fitsstatistics.h"
+
+/**
+ * @class TestFITSStatistics
+ * @short Compares FITSStatistics against the scalar min/max and Welford passes it replaces, and benchmarks it per data type
+ * @author agent <agent@local>
+ */
+class TestFITSStatistics : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSStatistics();
+    ~TestFITSStatistics();
+
+  private slots:
+    void compareWithReference_data();
+    void compareWithReference();
+
+    void compareHistogram_data();
+    void compareHistogram();
+
+    void benchmarkStatistics_data();
+    void benchmarkStatistics();
+
+    void benchmarkReference_data();
+    void benchmarkReference();
+
+  private:
+    template <typename T>
+    void compare(int width, int height, int channels);
+    template <typename T>
+    void benchmark(bool reference);
+    template <typename T>
+    void compareHistogram(int width, int height);
+};
+
+#endif
@@ -0,0 +1,237 @@
+/***************************************************************************
+                          testfitsstretch.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitsstretch.h"
+
+/* Qt Includes */
+#include <QImage>
+
+/* STL Includes */
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Dimensions of a 61 MP full frame sensor
+#define BENCHMARK_WIDTH  9576
+#define BENCHMARK_HEIGHT 6388
+
+namespace
+{
+template <typename T>
+std::vector<T> syntheticFrame(int width, int height, int channels)
+{
+    std::vector<T> frame(width * height * channels);
+    double low  = std::max<double>(std::numeric_limits<T>::lowest(), -1000);
+    double high = std::min<double>(std::numeric_limits<T>::max(), 65535);
+
+    qsrand(11);
+    for (size_t i = 0; i < frame.size(); i++)
+        frame[i] = static_cast<T>(low + (high - low) * (qrand() / static_cast<double>(RAND_MAX)));
+
+    return frame;
+}
+
+// The point filters of FITSData::applyFilter before they moved to FITSStretch
+template <typename T>
+void referenceFilter(FITSScale type, T *image, uint32_t samples, T min, T max)
+{
+    double coeff = 0;
+
+    if (type == FITS_LOG)
+        coeff = max / log(1 + max);
+    else if (type == FITS_SQRT)
+        coeff = max / sqrt(max);
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        if (type == FITS_LOG)
+            image[i] = qBound(min, static_cast<T>(round(coeff * log(1 + qBound(min, image[i], max)))), max);
+        else if (type == FITS_SQRT)
+            image[i] = qBound(min, static_cast<T>(round(coeff * image[i])), max);
+        else
+            image[i] = qBound(min, image[i], max);
+    }
+}
+
+// The display loop of FITSView::rescale before it moved to FITSStretch, colour channels clamped like mono ones
+template <typename T>
+void referenceDisplay(const T *buffer, int width, int height, int channels, double min, double max, QImage *image)
+{
+    double bscale = 255. / (max - min);
+    double bzero  = (-min) * (255. / (max - min));
+    int size      = width * height;
+
+    for (int j = 0; j < height; j++)
+    {
+        if (channels == 1)
+        {
+            uchar *scanLine = image->scanLine(j);
+            for (int i = 0; i < width; i++)
+                scanLine[i] = qBound(0.0, buffer[j * width + i] * bscale + bzero, 255.0);
+        }
+        else
+        {
+            QRgb *scanLine = reinterpret_cast<QRgb *>(image->scanLine(j));
+            for (int i = 0; i < width; i++)
+                scanLine[i] = qRgb(qBound(0.0, buffer[j * width + i] * bscale + bzero, 255.0),
+                                   qBound(0.0, buffer[j * width + i + size] * bscale + bzero, 255.0),
+                                   qBound(0.0, buffer[j * width + i + size * 2] * bscale + bzero, 255.0));
+        }
+    }
+}
+
+QImage displayImage(int width, int height, int channels)
+{
+    if (channels > 1)
+        return QImage(width, height, QImage::Format_RGB32);
+
+    QImage image(width, height, QImage::Format_Indexed8);
+    image.setColorCount(256);
+    for (int i = 0; i < 256; i++)
+        image.setColor(i, qRgb(i, i, i));
+    return image;
+}
+}
+
+TestFITSStretch::TestFITSStretch() : QObject()
+{
+}
+
+TestFITSStretch::~TestFITSStretch()
+{
+}
+
+template <typename T>
+void TestFITSStretch::compare(FITSScale type, int channels)
+{
+    const int width = 1021, height = 383;
+    std::vector<T> frame = syntheticFrame<T>(width, height, channels);
+    std::vector<T> expected(frame), stretched(frame.size());
+    T min = std::max<double>(std::numeric_limits<T>::lowest(), 100), max = 40000;
+
+    if (std::numeric_limits<T>::max() < max)
+        max = std::numeric_limits<T>::max() - 10;
+
+    FITSStretch stretch(type, min, max);
+
+    referenceFilter<T>(type, expected.data(), expected.size(), min, max);
+    stretch.apply<T>(frame.data(), stretched.data(), width, height, channels);
+    QVERIFY(stretched == expected);
+
+    // Rendering must match applying the filter and then scaling the result linearly to 8 bits
+    QImage rendered = displayImage(width, height, channels), reference = displayImage(width, height, channels);
+
+    stretch.render<T>(frame.data(), width, height, channels, &rendered);
+    referenceDisplay<T>(expected.data(), width, height, channels, min, max, &reference);
+    QVERIFY(rendered == reference);
+}
+
+void TestFITSStretch::compareWithReference_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("filter");
+    QTest::addColumn<int>("channels");
+
+    const QList<QPair<QString, FITSScale>> filters = { { "linear", FITS_LINEAR },
+                                                       { "log", FITS_LOG },
+                                                       { "sqrt", FITS_SQRT },
+                                                       { "auto stretch", FITS_AUTO_STRETCH } };
+
+    for (const QString &type : { "uint8", "int16", "uint16", "int32", "float", "double" })
+    {
+        for (const QPair<QString, FITSScale> &filter : filters)
+        {
+            QTest::newRow(qPrintable(type + " " + filter.first + " mono")) << type << static_cast<int>(filter.second) << 1;
+            QTest::newRow(qPrintable(type + " " + filter.first + " rgb")) << type << static_cast<int>(filter.second) << 3;
+        }
+    }
+}
+
+void TestFITSStretch::compareWithReference()
+{
+    QFETCH(QString, type);
+    QFETCH(int, filter);
+    QFETCH(int, channels);
+
+    FITSScale scale = static_cast<FITSScale>(filter);
+
+    if (type == "uint8")
+        compare<uint8_t>(scale, channels);
+    else if (type == "int16")
+        compare<int16_t>(scale, channels);
+    else if (type == "uint16")
+        compare<uint16_t>(scale, channels);
+    else if (type == "int32")
+        compare<int32_t>(scale, channels);
+    else if (type == "float")
+        compare<float>(scale, channels);
+    else
+        compare<double>(scale, channels);
+}
+
+template <typename T>
+void TestFITSStretch::benchmark(bool reference)
+{
+    std::vector<T> frame = syntheticFrame<T>(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1);
+    QImage image         = displayImage(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1);
+
+    if (reference)
+    {
+        // Copy, clip and scale, as FITSView::rescale did for auto stretch
+        QBENCHMARK
+        {
+            std::vector<T> copy(frame);
+            referenceFilter<T>(FITS_AUTO_STRETCH, copy.data(), copy.size(), 1000, 30000);
+            referenceDisplay<T>(copy.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1, 1000, 30000, &image);
+        }
+    }
+    else
+    {
+        FITSStretch stretch(FITS_AUTO_STRETCH, 1000, 30000);
+
+        QBENCHMARK
+        {
+            stretch.render<T>(frame.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 1, &image);
+        }
+    }
+}
+
+void TestFITSStretch::benchmarkRender_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<bool>("reference");
+
+    for (const QString &type : { "uint16", "float" })
+    {
+        QTest::newRow(qPrintable(type + " stretch")) << type << false;
+        QTest::newRow(qPrintable(type + " reference")) << type << true;
+    }
+}
+
+void TestFITSStretch::benchmarkRender()
+{
+    QFETCH(QString, type);
+    QFETCH(bool, reference);
+
+    if (type == "uint16")
+        benchmark<uint16_t>(reference);
+    else
+        benchmark<float>(reference);
+}
+
+QTEST_GUILESS_MAIN(TestFITSStretch)
@@ -0,0 +1,54 @@
+/***************************************************************************
+                          testfitsstretch.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSSTRETCH_H
+#define TESTFITSSTRETCH_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "fitsstretch.h"
+
+/**
+ * @class TestFITSStretch
+ * @short Compares FITSStretch against the scalar filter and display loops of FITSData and FITSView, and benchmarks
+ * rendering a full frame
+ * @author agent <agent@local>
+ */
+class TestFITSStretch : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSStretch();
+    ~TestFITSStretch();
+
+  private slots:
+    void compareWithReference_data();
+    void compareWithReference();
+
+    void benchmarkRender_data();
+    void benchmarkRender();
+
+  private:
+    template <typename T>
+    void compare(FITSScale type, int channels);
+    template <typename T>
+    void benchmark(bool reference);
+};
+
+#endif
@@ -0,0 +1,238 @@
+/***************************************************************************
+                          testfitswcsgrid.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "testfitswcsgrid.h"
+
+/* WCS Includes */
+#include <wcs.h>
+
+/* STL Includes */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// Dimensions of a 61 MP full frame sensor
+#define IMAGE_WIDTH  9576
+#define IMAGE_HEIGHT 6388
+
+TestFITSWCSGrid::TestFITSWCSGrid() : QObject()
+{
+}
+
+TestFITSWCSGrid::~TestFITSWCSGrid()
+{
+}
+
+struct wcsprm *TestFITSWCSGrid::createWCS(double ra, double dec, double pixscale, double rotation)
+{
+    struct wcsprm *newWCS = static_cast<struct wcsprm *>(calloc(1, sizeof(struct wcsprm)));
+    newWCS->flag          = -1;
+
+    wcsini(1, 2, newWCS);
+
+    strcpy(newWCS->ctype[0], "RA---TAN");
+    strcpy(newWCS->ctype[1], "DEC--TAN");
+
+    newWCS->crval[0] = ra;
+    newWCS->crval[1] = dec;
+    newWCS->crpix[0] = IMAGE_WIDTH / 2.0;
+    newWCS->crpix[1] = IMAGE_HEIGHT / 2.0;
+
+    double scale = pixscale / 3600.0;
+    double theta = rotation * M_PI / 180.0;
+
+    newWCS->altlin |= 2;
+    newWCS->cd[0]  = -scale * cos(theta);
+    newWCS->cd[1]  = scale * sin(theta);
+    newWCS->cd[2]  = scale * sin(theta);
+    newWCS->cd[3]  = scale * cos(theta);
+
+    wcsset(newWCS);
+
+    return newWCS;
+}
+
+void TestFITSWCSGrid::freeWCS(struct wcsprm *oldWCS)
+{
+    wcsfree(oldWCS);
+    free(oldWCS);
+}
+
+void TestFITSWCSGrid::initTestCase()
+{
+    // M31 imaged at 1.2"/px with a slight rotation
+    wcs = createWCS(10.6847, 41.2690, 1.2, 12.5);
+}
+
+void TestFITSWCSGrid::cleanupTestCase()
+{
+    freeWCS(wcs);
+}
+
+void TestFITSWCSGrid::interpolationAccuracy_data()
+{
+    QTest::addColumn<double>("maxError");
+
+    QTest::newRow("0.1 arcsec") << 0.1;
+    QTest::newRow("0.01 arcsec") << 0.01;
+    QTest::newRow("1 arcsec") << 1.0;
+}
+
+void TestFITSWCSGrid::interpolationAccuracy()
+{
+    QFETCH(double, maxError);
+
+    FITSWCSGrid grid(wcs, IMAGE_WIDTH, IMAGE_HEIGHT);
+    grid.setMaxError(maxError);
+
+    qsrand(42);
+
+    for (int i = 0; i < 5000; i++)
+    {
+        double x = (qrand() % (IMAGE_WIDTH * 10)) / 10.0;
+        double y = (qrand() % (IMAGE_HEIGHT * 10)) / 10.0;
+        wcs_point interpolated, exact;
+
+        QVERIFY(grid.pixelToWCS(x, y, interpolated));
+        QVERIFY(grid.exactPixelToWCS(x, y, exact));
+
+        double dRA = (interpolated.ra - exact.ra) * cos(exact.dec * M_PI / 180.0);
+        double dDE = interpolated.dec - exact.dec;
+
+        // Results are rounded to float, which limits the resolution to ~0.005 arcsecs around 41 degrees
+        QVERIFY(sqrt(dRA * dRA + dDE * dDE) * 3600.0 <= maxError + 0.01);
+    }
+}
+
+void TestFITSWCSGrid::wrapAroundZeroRA()
+{
+    struct wcsprm *zeroWCS = createWCS(0.0, 10.0, 1.2, 0);
+    FITSWCSGrid grid(zeroWCS, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+    for (int x = IMAGE_WIDTH / 2 - 64; x < IMAGE_WIDTH / 2 + 64; x++)
+    {
+        wcs_point interpolated, exact;
+
+        QVERIFY(grid.pixelToWCS(x + 0.5, IMAGE_HEIGHT / 2, interpolated));
+        QVERIFY(grid.exactPixelToWCS(x + 0.5, IMAGE_HEIGHT / 2, exact));
+
+        double dRA = interpolated.ra - exact.ra;
+        if (dRA > 180)
+            dRA -= 360;
+        else if (dRA < -180)
+            dRA += 360;
+
+        // Results are rounded to float, which only resolves ~0.11 arcsecs of RA near 360 degrees
+        QVERIFY(interpolated.ra >= 0 && interpolated.ra < 360);
+        QVERIFY(std::abs(dRA) * 3600.0 < grid.getMaxError() + 0.12);
+    }
+
+    freeWCS(zeroWCS);
+}
+
+void TestFITSWCSGrid::boundsIncludePole()
+{
+    struct wcsprm *poleWCS = createWCS(45.0, 89.5, 1.2, 0);
+    FITSWCSGrid grid(poleWCS, IMAGE_WIDTH, IMAGE_HEIGHT);
+    double minRA, maxRA, minDE, maxDE;
+
+    grid.getBounds(&minRA, &maxRA, &minDE, &maxDE);
+
+    QCOMPARE(minRA, 0.0);
+    QCOMPARE(maxRA, 360.0);
+    QCOMPARE(maxDE, 90.0);
+    QVERIFY(minDE > 88.0);
+
+    freeWCS(poleWCS);
+}
+
+void TestFITSWCSGrid::cacheLimit()
+{
+    FITSWCSGrid grid(wcs, IMAGE_WIDTH, IMAGE_HEIGHT);
+    grid.setCacheLimit(64 * 1024);
+
+    wcs_point coord;
+    for (int y = 0; y < IMAGE_HEIGHT; y += FITSWCSGrid::TILE_SIZE)
+        for (int x = 0; x < IMAGE_WIDTH; x += FITSWCSGrid::TILE_SIZE)
+            QVERIFY(grid.pixelToWCS(x + 1.5, y + 1.5, coord));
+
+    QVERIFY(grid.getCacheSize() <= 64 * 1024);
+}
+
+void TestFITSWCSGrid::benchmarkFullArray()
+{
+    // This replicates what FITSData::loadWCS used to do for every solved image
+    wcs_point *coords = nullptr;
+
+    QBENCHMARK_ONCE
+    {
+        coords = new wcs_point[IMAGE_WIDTH * IMAGE_HEIGHT];
+        wcs_point *p = coords;
+        double imgcrd[2], phi, pixcrd[2], theta, world[2];
+        int stat[2];
+
+        for (int i = 0; i < IMAGE_HEIGHT; i++)
+        {
+            for (int j = 0; j < IMAGE_WIDTH; j++)
+            {
+                pixcrd[0] = j;
+                pixcrd[1] = i;
+
+                if (wcsp2s(wcs, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0]) == 0)
+                {
+                    p->ra  = world[0];
+                    p->dec = world[1];
+                    p++;
+                }
+            }
+        }
+    }
+
+    delete[] coords;
+}
+
+void TestFITSWCSGrid::benchmarkGridFirstQuery()
+{
+    QBENCHMARK
+    {
+        FITSWCSGrid grid(wcs, IMAGE_WIDTH, IMAGE_HEIGHT);
+        wcs_point coord;
+        grid.pixelToWCS(IMAGE_WIDTH / 2, IMAGE_HEIGHT / 2, coord);
+    }
+}
+
+void TestFITSWCSGrid::benchmarkGridAllPixels()
+{
+    FITSWCSGrid grid(wcs, IMAGE_WIDTH, IMAGE_HEIGHT);
+    // Large enough to hold every tile so that the memory of a fully resolved image is measured
+    grid.setCacheLimit(256 * 1024 * 1024);
+
+    QBENCHMARK_ONCE
+    {
+        wcs_point coord;
+        for (int i = 0; i < IMAGE_HEIGHT; i++)
+            for (int j = 0; j < IMAGE_WIDTH; j++)
+                grid.pixelToWCS(j, i, coord);
+    }
+
+    // The grid of the whole image takes a small fraction of the full array of coordinates
+    QVERIFY(grid.getCacheSize() > 0);
+    QVERIFY(static_cast<size_t>(grid.getCacheSize()) < IMAGE_WIDTH * IMAGE_HEIGHT * sizeof(wcs_point) / 20);
+}
+
+QTEST_GUILESS_MAIN(TestFITSWCSGrid)
@@ -0,0 +1,62 @@
+/***************************************************************************
+                          testfitswcsgrid.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTFITSWCSGRID_H
+#define TESTFITSWCSGRID_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "fitswcsgrid.h"
+
+struct wcsprm;
+
+/**
+ * @class TestFITSWCSGrid
+ * @short Accuracy tests and benchmarks for FITSWCSGrid against the full per-pixel wcsp2s array
+ * @author agent <agent@local>
+ */
+class TestFITSWCSGrid : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestFITSWCSGrid();
+    ~TestFITSWCSGrid();
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void interpolationAccuracy_data();
+    void interpolationAccuracy();
+    void wrapAroundZeroRA();
+    void boundsIncludePole();
+    void cacheLimit();
+
+    void benchmarkFullArray();
+    void benchmarkGridFirstQuery();
+    void benchmarkGridAllPixels();
+
+  private:
+    struct wcsprm *createWCS(double ra, double dec, double pixscale, double rotation);
+    void freeWCS(struct wcsprm *wcs);
+
+    struct wcsprm *wcs = nullptr;
+};
+
+#endif
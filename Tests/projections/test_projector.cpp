@@ -0,0 +1,246 @@
+/***************************************************************************
+                   test_projector.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_projector.h"
+#include "auxiliary/cachingdms.h"
+#include "projections/azimuthalequidistantprojector.h"
+#include "projections/equirectangularprojector.h"
+#include "projections/gnomonicprojector.h"
+#include "projections/lambertprojector.h"
+#include "projections/orthographicprojector.h"
+#include "projections/stereographicprojector.h"
+
+namespace
+{
+// A thousandth of a pixel
+const float TOLERANCE = 1e-3;
+
+const int POINTS = 20000;
+
+const CachingDms LST(123.4), LAT(48.2);
+
+Projector *makeProjector(Projector::Projection projection, const ViewParams &p)
+{
+    switch (projection)
+    {
+        case Projector::Gnomonic:
+            return new GnomonicProjector(p);
+        case Projector::Stereographic:
+            return new StereographicProjector(p);
+        case Projector::Orthographic:
+            return new OrthographicProjector(p);
+        case Projector::AzimuthalEquidistant:
+            return new AzimuthalEquidistantProjector(p);
+        case Projector::Equirectangular:
+            return new EquirectangularProjector(p);
+        default:
+            return new LambertProjector(p);
+    }
+}
+
+ViewParams viewParams(SkyPoint *focus, bool useAltAz, float zoomFactor)
+{
+    ViewParams p;
+
+    p.width         = 1600;
+    p.height        = 1000;
+    p.zoomFactor    = zoomFactor;
+    p.useRefraction = true;
+    p.useAltAz      = useAltAz;
+    p.fillGround    = true;
+    p.focus         = focus;
+
+    return p;
+}
+
+const QList<QPair<const char *, Projector::Projection>> PROJECTIONS = {
+    { "Lambert", Projector::Lambert },
+    { "AzimuthalEquidistant", Projector::AzimuthalEquidistant },
+    { "Orthographic", Projector::Orthographic },
+    { "Equirectangular", Projector::Equirectangular },
+    { "Stereographic", Projector::Stereographic },
+    { "Gnomonic", Projector::Gnomonic }
+};
+
+// What drawPointSource() finds out about a point, through checkVisibility(), toScreenVec() and onScreen()
+quint8 referenceFlags(const Projector *proj, SkyPoint *p, Vector2f &pos)
+{
+    bool visible = false;
+    quint8 flags = 0;
+
+    if (!proj->checkVisibility(p))
+    {
+        pos = Vector2f(0, 0);
+        return 0;
+    }
+
+    pos = proj->toScreenVec(p, true, &visible);
+    if (visible)
+        flags |= Projector::PointVisible;
+    if (proj->onScreen(pos))
+        flags |= Projector::PointOnScreen;
+
+    return flags;
+}
+}
+
+void TestProjector::initTestCase()
+{
+    qsrand(42);
+
+    // Points all over the sky, with horizontal coordinates that match their equatorial coordinates
+    for (int i = 0; i < POINTS; ++i)
+    {
+        SkyPoint p(24.0 * qrand() / RAND_MAX, 180.0 * qrand() / RAND_MAX - 90.0);
+
+        p.EquatorialToHorizontal(&LST, &LAT);
+        ra.append(p.ra().Hours());
+        dec.append(p.dec().Degrees());
+        alt.append(p.alt().Degrees());
+        az.append(p.az().Degrees());
+    }
+}
+
+void TestProjector::toScreenBatch_data()
+{
+    QTest::addColumn<Projector::Projection>("projection");
+    QTest::addColumn<bool>("useAltAz");
+    QTest::addColumn<double>("focusAlt");
+    QTest::addColumn<float>("zoomFactor");
+
+    // Wide and narrow fields, and a field around the zenith where checkVisibility() accepts all azimuths
+    for (const auto &projection : PROJECTIONS)
+    {
+        QByteArray name(projection.first);
+
+        QTest::newRow((name + " equatorial").constData()) << projection.second << false << 30.0 << 250.f;
+        QTest::newRow((name + " horizontal").constData()) << projection.second << true << 30.0 << 250.f;
+        QTest::newRow((name + " zoomed").constData()) << projection.second << true << 30.0 << 8000.f;
+        QTest::newRow((name + " zenith").constData()) << projection.second << true << 85.0 << 1000.f;
+    }
+}
+
+void TestProjector::toScreenBatch()
+{
+    QFETCH(Projector::Projection, projection);
+    QFETCH(bool, useAltAz);
+    QFETCH(double, focusAlt);
+    QFETCH(float, zoomFactor);
+
+    SkyPoint focus;
+    focus.setAlt(focusAlt);
+    focus.setAz(200.0);
+    focus.HorizontalToEquatorial(&LST, &LAT);
+
+    QScopedPointer<Projector> proj(makeProjector(projection, viewParams(&focus, useAltAz, zoomFactor)));
+    QCOMPARE(proj->type(), projection);
+
+    QVector<float> x(POINTS), y(POINTS);
+    QVector<quint8> flags(POINTS);
+
+    proj->toScreenBatch(POINTS, ra.constData(), dec.constData(), alt.constData(), az.constData(), x.data(), y.data(),
+                        flags.data());
+
+    int drawn = 0;
+
+    for (int i = 0; i < POINTS; ++i)
+    {
+        SkyPoint p;
+        Vector2f pos;
+
+        p.setRA(ra[i]);
+        p.setDec(dec[i]);
+        p.setAlt(alt[i]);
+        p.setAz(az[i]);
+
+        quint8 expected = referenceFlags(proj.data(), &p, pos);
+
+        QCOMPARE(flags[i], expected);
+        if (std::isfinite(pos[0]) && std::isfinite(pos[1]))
+        {
+            QVERIFY(fabs(x[i] - pos[0]) < TOLERANCE);
+            QVERIFY(fabs(y[i] - pos[1]) < TOLERANCE);
+        }
+
+        if (flags[i] == (Projector::PointVisible | Projector::PointOnScreen))
+            ++drawn;
+    }
+
+    // Otherwise the view would not test much
+    QVERIFY(drawn > 0);
+}
+
+void TestProjector::benchmarkToScreen_data()
+{
+    QTest::addColumn<Projector::Projection>("projection");
+    QTest::addColumn<bool>("batch");
+
+    for (const auto &projection : PROJECTIONS)
+    {
+        QByteArray name(projection.first);
+
+        QTest::newRow((name + " SkyPoint").constData()) << projection.second << false;
+        QTest::newRow((name + " batch").constData()) << projection.second << true;
+    }
+}
+
+void TestProjector::benchmarkToScreen()
+{
+    QFETCH(Projector::Projection, projection);
+    QFETCH(bool, batch);
+
+    SkyPoint focus;
+    focus.setAlt(30.0);
+    focus.setAz(200.0);
+    focus.HorizontalToEquatorial(&LST, &LAT);
+
+    QScopedPointer<Projector> proj(makeProjector(projection, viewParams(&focus, true, 250.f)));
+
+    QVector<float> x(POINTS), y(POINTS);
+    QVector<quint8> flags(POINTS);
+
+    // What DeepStarComponent::draw does for the stars of a block, before and after the batch API
+    if (batch)
+    {
+        QBENCHMARK
+        {
+            proj->toScreenBatch(POINTS, ra.constData(), dec.constData(), alt.constData(), az.constData(), x.data(),
+                                y.data(), flags.data());
+        }
+    }
+    else
+    {
+        SkyPoint p;
+
+        QBENCHMARK
+        {
+            for (int i = 0; i < POINTS; ++i)
+            {
+                Vector2f pos;
+
+                p.setAlt(alt[i]);
+                p.setAz(az[i]);
+                flags[i] = referenceFlags(proj.data(), &p, pos);
+                x[i]     = pos[0];
+                y[i]     = pos[1];
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestProjector)
@@ -0,0 +1,53 @@
+/***************************************************************************
+                    test_projector.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_PROJECTOR_H
+#define TEST_PROJECTOR_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "projections/projector.h"
+
+/**
+ * @class TestProjector
+ * @short Compares Projector::toScreenBatch with the projection of single SkyPoints, and benchmarks both
+ * @author agent <agent@local>
+ */
+
+class TestProjector : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestProjector() : QObject(){};
+    ~TestProjector(){};
+
+  private slots:
+    void initTestCase();
+
+    void toScreenBatch_data();
+    void toScreenBatch();
+
+    void benchmarkToScreen_data();
+    void benchmarkToScreen();
+
+  private:
+    QVector<double> ra, dec, alt, az;
+};
+
+#endif
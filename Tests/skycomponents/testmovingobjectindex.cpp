@@ -0,0 +1,244 @@
+/***************************************************************************
+                          testmovingobjectindex.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testmovingobjectindex.h"
+
+#include "skyobjects/ksasteroid.h"
+#include "skyobjects/skyobject.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Asteroids of the full MPC list
+#define BENCHMARK_OBJECTS 300000
+
+namespace
+{
+typedef std::vector<std::unique_ptr<SkyObject>> Objects;
+
+// Uniform on the sphere
+SkyPoint randomPoint()
+{
+    double ra  = 24.0 * qrand() / RAND_MAX;
+    double dec = asin(2.0 * qrand() / RAND_MAX - 1.0) * 180.0 / dms::PI;
+    return SkyPoint(ra, dec);
+}
+
+void makeObjects(Objects &objects, int count, MovingObjectIndex &index)
+{
+    for (int i = 0; i < count; i++)
+    {
+        SkyPoint p = randomPoint();
+        objects.emplace_back(new SkyObject(SkyObject::ASTEROID, p.ra().Hours(), p.dec().Degrees(), 10.0));
+        index.update(objects.back().get());
+    }
+}
+
+// ListComponent::objectNearest before the objects were indexed
+SkyObject *scan(const Objects &objects, SkyPoint *p, double &maxrad)
+{
+    SkyObject *oBest = nullptr;
+    for (const auto &o : objects)
+    {
+        double r = o->angularDistanceTo(p).Degrees();
+        if (r < maxrad)
+        {
+            oBest  = o.get();
+            maxrad = r;
+        }
+    }
+    return oBest;
+}
+
+// The aperture is computed by SkyMapComposite::objectNearest
+SkyObject *nearest(const MovingObjectIndex &index, SkyPoint *p, double &maxrad)
+{
+    SkyMesh::Instance()->index(p, maxrad + 1.0, OBJ_NEAREST_NO_PRECESS_BUF);
+
+    SkyObject *oBest = nullptr;
+    index.visit(OBJ_NEAREST_NO_PRECESS_BUF, [&](SkyObject *o) {
+        double r = o->angularDistanceTo(p).Degrees();
+        if (r < maxrad)
+        {
+            oBest  = o;
+            maxrad = r;
+        }
+    });
+    return oBest;
+}
+}
+
+TestMovingObjectIndex::TestMovingObjectIndex() : QObject()
+{
+}
+
+TestMovingObjectIndex::~TestMovingObjectIndex()
+{
+}
+
+void TestMovingObjectIndex::initTestCase()
+{
+    // The mesh of SkyMapComposite
+    SkyMesh::Create(3);
+    qsrand(42);
+}
+
+void TestMovingObjectIndex::compareWithScan()
+{
+    Objects objects;
+    MovingObjectIndex index;
+    makeObjects(objects, 5000, index);
+
+    QCOMPARE(index.count(), 5000);
+
+    for (int step = 0; step < 5; step++)
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            SkyPoint p         = randomPoint();
+            double maxrad      = 0.5 + 5.0 * qrand() / RAND_MAX;
+            double indexMaxrad = maxrad;
+
+            SkyObject *expected = scan(objects, &p, maxrad);
+            QCOMPARE(nearest(index, &p, indexMaxrad), expected);
+            QCOMPARE(indexMaxrad, maxrad);
+        }
+
+        // Objects move, some across trixels, as positions are recomputed
+        for (const auto &o : objects)
+        {
+            o->setRA(dms(o->ra().Degrees() + 10.0 * qrand() / RAND_MAX).reduce());
+            o->setDec(qBound(-90.0, o->dec().Degrees() + 4.0 * qrand() / RAND_MAX - 2.0, 90.0));
+            index.update(o.get());
+        }
+
+        QCOMPARE(index.count(), 5000);
+    }
+}
+
+void TestMovingObjectIndex::removeObjects()
+{
+    Objects objects;
+    MovingObjectIndex index;
+    makeObjects(objects, 100, index);
+
+    // The nearest objects are found again once removed
+    for (int i = 0; i < 100; i++)
+    {
+        SkyPoint p    = randomPoint();
+        double maxrad = 180.0;
+
+        SkyObject *o = nearest(index, &p, maxrad);
+        QVERIFY(o != nullptr);
+
+        index.remove(o);
+        QCOMPARE(index.count(), 99 - i);
+    }
+
+    SkyPoint p    = randomPoint();
+    double maxrad = 180.0;
+    QVERIFY(nearest(index, &p, maxrad) == nullptr);
+
+    index.update(objects.front().get());
+    index.update(objects.back().get());
+    QCOMPARE(index.count(), 2);
+
+    index.clear();
+    QCOMPARE(index.count(), 0);
+    QVERIFY(nearest(index, &p, maxrad) == nullptr);
+}
+
+void TestMovingObjectIndex::followMovingBodies()
+{
+    MovingObjectIndex index;
+    KSAsteroid asteroid(1, "1 Ceres", QString(), 2458600.5, 2.7691, 0.0760, dms(10.594), dms(73.597), dms(80.305),
+                        dms(77.372), 3.34, 0.12);
+    asteroid.setIndex(&index);
+
+    // The asteroid is indexed once it has a position, then found wherever it moves
+    KSPlanetBase::Position position;
+    position.rearth = position.phase = position.angularSize = 0.0;
+    position.mag                                             = 7.0;
+
+    for (int i = 0; i < 20; i++)
+    {
+        SkyPoint previous = position.coords;
+
+        position.coords = randomPoint();
+        asteroid.setPosition(position);
+        QCOMPARE(index.count(), 1);
+
+        SkyPoint p    = position.coords;
+        double maxrad = 0.1;
+        QCOMPARE(nearest(index, &p, maxrad), static_cast<SkyObject *>(&asteroid));
+
+        // Nothing is left where it was
+        maxrad = 0.1;
+        if (i > 0 && previous.angularDistanceTo(&p).Degrees() > 1.0)
+            QVERIFY(nearest(index, &previous, maxrad) == nullptr);
+    }
+
+    // Copies, such as those of the tools, are not indexed
+    std::unique_ptr<KSAsteroid> copy(asteroid.clone());
+    position.coords = randomPoint();
+    copy->setPosition(position);
+    QCOMPARE(index.count(), 1);
+
+    SkyPoint p(asteroid.ra(), asteroid.dec());
+    double maxrad = 0.1;
+    QCOMPARE(nearest(index, &p, maxrad), static_cast<SkyObject *>(&asteroid));
+}
+
+void TestMovingObjectIndex::benchmarkNearest_data()
+{
+    QTest::addColumn<bool>("useIndex");
+
+    QTest::newRow("List scan") << false;
+    QTest::newRow("Index") << true;
+}
+
+void TestMovingObjectIndex::benchmarkNearest()
+{
+    QFETCH(bool, useIndex);
+
+    Objects objects;
+    MovingObjectIndex index;
+    makeObjects(objects, BENCHMARK_OBJECTS, index);
+
+    // The mouse hovers the sky map
+    QVector<SkyPoint> points;
+    for (int i = 0; i < 20; i++)
+        points.append(randomPoint());
+
+    int found = 0;
+
+    QBENCHMARK
+    {
+        found = 0;
+        for (SkyPoint &p : points)
+        {
+            double maxrad = 0.25;
+            if (useIndex ? nearest(index, &p, maxrad) : scan(objects, &p, maxrad))
+                found++;
+        }
+    }
+
+    QVERIFY(found > 0);
+}
+
+QTEST_GUILESS_MAIN(TestMovingObjectIndex)
@@ -0,0 +1,51 @@
+/***************************************************************************
+                          testmovingobjectindex.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTMOVINGOBJECTINDEX_H
+#define TESTMOVINGOBJECTINDEX_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "skycomponents/movingobjectindex.h"
+
+/**
+ * @class TestMovingObjectIndex
+ * @short Checks that the trixel index of moving objects finds the nearest objects that the components used to find
+ * by scanning their lists, while the objects move, that asteroids follow in the index wherever they are moved, and
+ * measures both searches
+ * @author agent <agent@local>
+ */
+class TestMovingObjectIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestMovingObjectIndex();
+    ~TestMovingObjectIndex();
+
+  private slots:
+    void initTestCase();
+
+    void compareWithScan();
+    void removeObjects();
+    void followMovingBodies();
+    void benchmarkNearest_data();
+    void benchmarkNearest();
+};
+
+#endif
@@ -0,0 +1,229 @@
+/***************************************************************************
+                          testnameindex.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "testnameindex.h"
+
+#include "skyobjects/skyobject.h"
+
+#include <memory>
+#include <vector>
+
+// Named stars, deep-sky objects and minor planets of a full installation
+#define BENCHMARK_OBJECTS 100000
+
+namespace
+{
+// ListComponent::findByName before the names were indexed
+SkyObject *scan(const std::vector<std::unique_ptr<SkyObject>> &objects, const QString &name)
+{
+    for (const auto &o : objects)
+    {
+        if (QString::compare(o->name(), name, Qt::CaseInsensitive) == 0 ||
+            QString::compare(o->longname(), name, Qt::CaseInsensitive) == 0 ||
+            QString::compare(o->name2(), name, Qt::CaseInsensitive) == 0)
+            return o.get();
+    }
+    return nullptr;
+}
+}
+
+TestNameIndex::TestNameIndex() : QObject()
+{
+}
+
+TestNameIndex::~TestNameIndex()
+{
+}
+
+void TestNameIndex::findIgnoresCase()
+{
+    SkyObject galaxy(SkyObject::GALAXY, 0.0, 0.0, 3.4, "M 31", "NGC 224", "Andromeda Galaxy");
+
+    NameIndex index;
+    index.add(galaxy.name(), &galaxy);
+    index.add(galaxy.longname(), &galaxy);
+
+    QCOMPARE(index.find("M 31"), &galaxy);
+    QCOMPARE(index.find("m 31"), &galaxy);
+    QCOMPARE(index.find("ANDROMEDA GALAXY"), &galaxy);
+    QVERIFY(index.find("M 3") == nullptr);
+    QVERIFY(index.find(QString()) == nullptr);
+    QCOMPARE(index.count(), 2);
+}
+
+void TestNameIndex::findAliases()
+{
+    SkyObject galaxy(SkyObject::GALAXY, 0.0, 0.0, 3.4, "M 31", "NGC 224", "Andromeda Galaxy");
+
+    NameIndex index;
+    index.add(galaxy.name(), &galaxy);
+    index.addAliases(&galaxy);
+
+    // Aliases are found, but not listed
+    QCOMPARE(index.find("ngc 224"), &galaxy);
+    QCOMPARE(index.find("andromeda galaxy"), &galaxy);
+    QCOMPARE(index.startingWith("N"), QStringList());
+    QCOMPARE(index.startingWith("M"), QStringList() << "M 31");
+
+    // Names indexed for the object already are not added again
+    QCOMPARE(index.count(), 3);
+    index.addAlias("m 31", &galaxy);
+    QCOMPARE(index.count(), 3);
+}
+
+void TestNameIndex::findByKind()
+{
+    // Added in the order the components load
+    SkyObject star(SkyObject::STAR, 0.0, 0.0, 1.0, "Mars");
+    SkyObject satellite(SkyObject::SATELLITE, 0.0, 0.0, 1.0, "Mars");
+    SkyObject constellation(SkyObject::CONSTELLATION, 0.0, 0.0, 1.0, "Mars");
+    SkyObject planet(SkyObject::PLANET, 0.0, 0.0, 1.0, "Mars");
+    SkyObject nebula(SkyObject::GASEOUS_NEBULA, 0.0, 0.0, 1.0, "Mars");
+    SkyObject cluster(SkyObject::OPEN_CLUSTER, 0.0, 0.0, 1.0, "mars");
+
+    NameIndex index;
+    index.add(star.name(), &star);
+    index.add(satellite.name(), &satellite);
+    index.add(constellation.name(), &constellation);
+
+    // Constellations were searched before stars and satellites
+    QCOMPARE(index.find("Mars"), &constellation);
+
+    index.add(nebula.name(), &nebula);
+    index.add(cluster.name(), &cluster);
+    QCOMPARE(index.find("MARS"), &nebula);
+
+    // Solar system bodies were searched first
+    index.add(planet.name(), &planet);
+    QCOMPARE(index.find("mars"), &planet);
+
+    index.remove(planet.name(), &planet);
+    QCOMPARE(index.find("mars"), &nebula);
+    index.remove(nebula.name(), &nebula);
+    QCOMPARE(index.find("mars"), &cluster);
+}
+
+void TestNameIndex::removeNames()
+{
+    SkyObject galaxy(SkyObject::GALAXY, 0.0, 0.0, 3.4, "M 31", "NGC 224", "Andromeda Galaxy");
+    SkyObject comet(SkyObject::COMET, 0.0, 0.0, 5.0, "C/1995 O1", QString(), "Hale-Bopp");
+    SkyObject asteroid(SkyObject::ASTEROID, 0.0, 0.0, 5.0, "1 Ceres");
+
+    NameIndex index;
+    index.add(galaxy.name(), &galaxy);
+    index.add(galaxy.longname(), &galaxy);
+    index.addAliases(&galaxy);
+    index.add(comet.name(), &comet);
+    index.addAliases(&comet);
+    index.add(asteroid.name(), &asteroid);
+
+    uint revision = index.revision();
+
+    index.removeNames(&galaxy);
+    QVERIFY(index.find("M 31") == nullptr);
+    QVERIFY(index.find("NGC 224") == nullptr);
+    QVERIFY(index.find("Andromeda Galaxy") == nullptr);
+    QVERIFY(index.revision() != revision);
+
+    revision = index.revision();
+    index.removeType(SkyObject::COMET);
+    QVERIFY(index.find("hale-bopp") == nullptr);
+    QVERIFY(index.find("c/1995 o1") == nullptr);
+    QCOMPARE(index.find("1 ceres"), &asteroid);
+    QCOMPARE(index.count(), 1);
+    QVERIFY(index.revision() != revision);
+
+    // Removing names that are not indexed changes nothing
+    revision = index.revision();
+    index.remove("Vesta", &asteroid);
+    index.removeType(SkyObject::SATELLITE);
+    QCOMPARE(index.revision(), revision);
+}
+
+void TestNameIndex::startingWith()
+{
+    SkyObject aldebaran(SkyObject::STAR, 0.0, 0.0, 0.9, "Aldebaran");
+    SkyObject algol(SkyObject::STAR, 0.0, 0.0, 2.1, "Algol");
+    SkyObject m31(SkyObject::GALAXY, 0.0, 0.0, 3.4, "M 31");
+    SkyObject m3(SkyObject::GLOBULAR_CLUSTER, 0.0, 0.0, 6.2, "M 3");
+    SkyObject m33(SkyObject::GALAXY, 0.0, 0.0, 5.7, "m 33");
+
+    NameIndex index;
+    index.add(m31.name(), &m31);
+    index.add(algol.name(), &algol);
+    index.add(m33.name(), &m33);
+    index.add(aldebaran.name(), &aldebaran);
+
+    QCOMPARE(index.startingWith("AL"), QStringList() << "Aldebaran" << "Algol");
+    QCOMPARE(index.startingWith("m 3"), QStringList() << "M 31" << "m 33");
+    QCOMPARE(index.startingWith("Vega"), QStringList());
+
+    QCOMPARE(index.firstStartingWith("alg"), QString("Algol"));
+    QCOMPARE(index.firstStartingWith("M 3"), QString("M 31"));
+    QCOMPARE(index.firstStartingWith("M 3", QList<int>() << SkyObject::GLOBULAR_CLUSTER), QString());
+    QCOMPARE(index.firstStartingWith("Z"), QString());
+
+    // Names added after a search are found by the next one
+    index.add(m3.name(), &m3);
+    QCOMPARE(index.firstStartingWith("M 3"), QString("M 3"));
+    QCOMPARE(index.firstStartingWith("M 3", QList<int>() << SkyObject::GALAXY), QString("M 31"));
+}
+
+void TestNameIndex::benchmarkFind_data()
+{
+    QTest::addColumn<bool>("index");
+
+    QTest::newRow("List scan") << false;
+    QTest::newRow("Index") << true;
+}
+
+void TestNameIndex::benchmarkFind()
+{
+    QFETCH(bool, index);
+
+    std::vector<std::unique_ptr<SkyObject>> objects;
+    NameIndex names;
+
+    for (int i = 0; i < BENCHMARK_OBJECTS; i++)
+    {
+        objects.emplace_back(new SkyObject(SkyObject::CATALOG_STAR, 0.0, 0.0, 10.0, QString("HD %1").arg(i),
+                                           QString("HIP %1").arg(i)));
+        names.add(objects.back()->name(), objects.back().get());
+        names.addAliases(objects.back().get());
+    }
+
+    // Objects of an observing list, looked up by the labels of the sky map
+    QStringList targets;
+    for (int i = 0; i < 20; i++)
+        targets << QString("hip %1").arg((i * 7919) % BENCHMARK_OBJECTS);
+
+    int found = 0;
+
+    QBENCHMARK
+    {
+        found = 0;
+        foreach (const QString &target, targets)
+        {
+            if (index ? names.find(target) : scan(objects, target))
+                found++;
+        }
+    }
+
+    QCOMPARE(found, targets.size());
+}
+
+QTEST_GUILESS_MAIN(TestNameIndex)
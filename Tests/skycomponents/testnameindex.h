@@ -0,0 +1,49 @@
+/***************************************************************************
+                          testnameindex.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTNAMEINDEX_H
+#define TESTNAMEINDEX_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "skycomponents/nameindex.h"
+
+/**
+ * @class TestNameIndex
+ * @short Checks that the name index finds the objects that the components used to find by scanning their lists
+ * @author agent <agent@local>
+ */
+class TestNameIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestNameIndex();
+    ~TestNameIndex();
+
+  private slots:
+    void findIgnoresCase();
+    void findAliases();
+    void findByKind();
+    void removeNames();
+    void startingWith();
+    void benchmarkFind_data();
+    void benchmarkFind();
+};
+
+#endif
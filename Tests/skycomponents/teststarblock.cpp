@@ -0,0 +1,138 @@
+/***************************************************************************
+                          teststarblock.cpp  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "teststarblock.h"
+
+#include "skyobjects/deepstardata.h"
+#include "skyobjects/stardata.h"
+#include "skyobjects/starobject.h"
+
+#include <cstring>
+
+namespace
+{
+starData shallowRecord(int i)
+{
+    starData data;
+    memset(&data, 0, sizeof(starData));
+    data.RA           = 1000000 * (i % 24) + 12345 * i;
+    data.Dec          = 100000 * (i % 180 - 89) + 4321 * (i % 7);
+    data.dRA          = 10 * i - 250;
+    data.dDec         = 350 - 7 * i;
+    data.HD           = i % 3 ? 0 : 1000 + i;
+    data.mag          = 300 + 11 * i;
+    data.spec_type[0] = "OBAFGKM"[i % 7];
+    data.spec_type[1] = '0' + i % 10;
+    return data;
+}
+
+deepStarData deepRecord(int i)
+{
+    deepStarData data;
+    data.RA   = 1000000 * (i % 24) + 54321 * i;
+    data.Dec  = 100000 * (i % 180 - 89) + 1234 * (i % 5);
+    data.dRA  = 3 * i - 40;
+    data.dDec = 60 - 5 * i;
+    data.B    = i % 5 ? 12000 + 40 * i + 100 * (i % 23) : 30000;
+    data.V    = i % 7 ? 12000 + 40 * i : 30000;
+    return data;
+}
+
+template <typename T>
+void compare(StarBlock &block, const QVector<T> &records)
+{
+    SkyPoint point;
+    StarObject star;
+
+    QCOMPARE(block.getStarCount(), records.size());
+
+    for (int i = 0; i < records.size(); ++i)
+    {
+        star.init(&records[i]);
+        block.equatorialCoords(i, &point);
+
+        QCOMPARE(block.mag(i), star.mag());
+        QCOMPARE(block.spchar(i), star.spchar());
+        QCOMPARE(point.ra().Degrees(), star.ra().Degrees());
+        QCOMPARE(point.dec().Degrees(), star.dec().Degrees());
+
+        QVERIFY(block.getFaintMag() >= star.mag());
+        QVERIFY(block.getBrightMag() <= star.mag());
+    }
+}
+}
+
+TestStarBlock::TestStarBlock() : QObject()
+{
+}
+
+TestStarBlock::~TestStarBlock()
+{
+}
+
+void TestStarBlock::packedShallowStars()
+{
+    QVector<starData> records;
+    StarBlock block(50);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        records.append(shallowRecord(i));
+        QVERIFY(block.addStar(records.last()));
+    }
+
+    compare(block, records);
+}
+
+void TestStarBlock::packedDeepStars()
+{
+    QVector<deepStarData> records;
+    StarBlock block(50);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        records.append(deepRecord(i));
+        QVERIFY(block.addStar(records.last()));
+    }
+
+    compare(block, records);
+}
+
+void TestStarBlock::capacity()
+{
+    StarBlock block(3);
+
+    QCOMPARE(block.size(), 3);
+
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(block.addStar(deepRecord(i)));
+
+    QVERIFY(block.isFull());
+    QVERIFY(!block.addStar(deepRecord(3)));
+    QCOMPARE(block.getStarCount(), 3);
+
+    // Once reset, a block can be filled with the other kind of record, but never with both at once
+    block.reset();
+    QCOMPARE(block.getStarCount(), 0);
+    QVERIFY(block.addStar(shallowRecord(0)));
+    QVERIFY(!block.addStar(deepRecord(1)));
+    QCOMPARE(block.getStarCount(), 1);
+
+    compare(block, QVector<starData>() << shallowRecord(0));
+}
+
+QTEST_GUILESS_MAIN(TestStarBlock)
@@ -0,0 +1,45 @@
+/***************************************************************************
+                          teststarblock.h  -
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TESTSTARBLOCK_H
+#define TESTSTARBLOCK_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "skycomponents/starblock.h"
+
+/**
+ * @class TestStarBlock
+ * @short Checks that stars packed in a StarBlock match the StarObjects made from the same catalog records
+ * @author agent <agent@local>
+ */
+class TestStarBlock : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestStarBlock();
+    ~TestStarBlock();
+
+  private slots:
+    void packedShallowStars();
+    void packedDeepStars();
+    void capacity();
+};
+
+#endif
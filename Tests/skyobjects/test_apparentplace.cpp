@@ -0,0 +1,197 @@
+/***************************************************************************
+                   test_apparentplace.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_apparentplace.h"
+#include "ksnumbers.h"
+#include "Options.h"
+#include "auxiliary/cachingdms.h"
+#include "skyobjects/apparentplace.h"
+#include "skyobjects/starobject.h"
+#include "time/kstarsdatetime.h"
+
+namespace
+{
+// 1e-6 arcsecond, far below what can be drawn
+const double TOLERANCE = 1e-6 / 3600.0;
+
+const int STARS = 20000;
+
+void catalogCoords(const QVector<deepStarData> &records, QVector<double> &ra0, QVector<double> &dec0,
+                   QVector<double> &pmRA, QVector<double> &pmDec)
+{
+    for (const deepStarData &data : records)
+    {
+        ra0.append(data.RA / 1000000.0);
+        dec0.append(data.Dec / 100000.0);
+        pmRA.append(data.dRA / 100.0);
+        pmDec.append(data.dDec / 100.0);
+    }
+}
+
+double angularError(double ra1, double dec1, double ra2, double dec2)
+{
+    double dRA = fabs(ra1 - ra2) * 15.0;
+
+    if (dRA > 180.0)
+        dRA = 360.0 - dRA;
+
+    return qMax(dRA * cos(dec1 * dms::DegToRad), fabs(dec1 - dec2));
+}
+}
+
+void TestApparentPlace::initTestCase()
+{
+    useRelativistic            = Options::useRelativistic();
+    alwaysRecomputeCoordinates = Options::alwaysRecomputeCoordinates();
+    Options::setUseRelativistic(false);
+    Options::setAlwaysRecomputeCoordinates(false);
+
+    qsrand(42);
+
+    // Stars all over the sky, including around the poles where nutation is computed exactly, some with a fast
+    // proper motion and some with none
+    for (int i = 0; i < STARS; ++i)
+    {
+        deepStarData data;
+        data.RA   = qrand() % 24000000;
+        data.Dec  = (i % 10 == 0) ? 8000000 + qrand() % 999999 : qrand() % 18000000 - 9000000;
+        data.dRA  = (i % 3 == 0) ? 0 : qrand() % 60000 - 30000;
+        data.dDec = (i % 3 == 0) ? 0 : qrand() % 60000 - 30000;
+        data.B    = 12000;
+        data.V    = 11500;
+        records.append(data);
+    }
+}
+
+void TestApparentPlace::cleanupTestCase()
+{
+    Options::setUseRelativistic(useRelativistic);
+    Options::setAlwaysRecomputeCoordinates(alwaysRecomputeCoordinates);
+}
+
+void TestApparentPlace::fromCatalog_data()
+{
+    QTest::addColumn<double>("epoch");
+
+    QTest::newRow("1900") << 1900.0;
+    QTest::newRow("2026.8") << 2026.8;
+    QTest::newRow("2500") << 2500.0;
+}
+
+void TestApparentPlace::fromCatalog()
+{
+    QFETCH(double, epoch);
+
+    KSNumbers num(KStarsDateTime::epochToJd(epoch));
+    QVector<double> ra0, dec0, pmRA, pmDec, ra(STARS), dec(STARS);
+    StarObject star;
+
+    catalogCoords(records, ra0, dec0, pmRA, pmDec);
+    ApparentPlace::fromCatalog(&num, STARS, ra0.constData(), dec0.constData(), pmRA.constData(), pmDec.constData(),
+                               ra.data(), dec.data());
+
+    double maxError = 0;
+
+    for (int i = 0; i < STARS; ++i)
+    {
+        star.init(&records[i]);
+        star.updateCoords(&num);
+
+        QVERIFY(ra[i] >= 0 && ra[i] < 24.0);
+        maxError = qMax(maxError, angularError(ra[i], dec[i], star.ra().Hours(), star.dec().Degrees()));
+    }
+
+    QVERIFY2(maxError < TOLERANCE, qPrintable(QString("Largest difference with StarObject::updateCoords is %1 arcsec")
+                                                  .arg(maxError * 3600.0)));
+}
+
+void TestApparentPlace::toHorizontal()
+{
+    CachingDms LST(123.4), lat(48.2);
+    QVector<double> ra, dec, alt(STARS), az(STARS);
+    SkyPoint point;
+
+    for (const deepStarData &data : records)
+    {
+        ra.append(data.RA / 1000000.0);
+        dec.append(data.Dec / 100000.0);
+    }
+
+    ApparentPlace::toHorizontal(&LST, &lat, STARS, ra.constData(), dec.constData(), alt.data(), az.data());
+
+    for (int i = 0; i < STARS; ++i)
+    {
+        point.setRA(ra[i]);
+        point.setDec(dec[i]);
+        point.EquatorialToHorizontal(&LST, &lat);
+
+        QVERIFY(fabs(alt[i] - point.alt().Degrees()) < TOLERANCE);
+
+        // Azimuth is found with acos(), which is ill-conditioned on the meridian, and it is meaningless at the
+        // zenith. Compare the distance along the horizon, with a looser tolerance.
+        double dAz = fabs(az[i] - point.az().Degrees());
+        QVERIFY(qMin(dAz, 360.0 - dAz) * cos(alt[i] * dms::DegToRad) < 1000 * TOLERANCE);
+    }
+}
+
+void TestApparentPlace::benchmarkUpdateCoords_data()
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("StarObject") << false;
+    QTest::newRow("ApparentPlace") << true;
+}
+
+void TestApparentPlace::benchmarkUpdateCoords()
+{
+    QFETCH(bool, batch);
+
+    KSNumbers num(KStarsDateTime::epochToJd(2026.8));
+    CachingDms LST(123.4), lat(48.2);
+    QVector<double> ra0, dec0, pmRA, pmDec, ra(STARS), dec(STARS), alt(STARS), az(STARS);
+    StarObject star;
+
+    catalogCoords(records, ra0, dec0, pmRA, pmDec);
+
+    // What StarBlock::JITupdate does for each block, before and after the batch API
+    if (batch)
+    {
+        QBENCHMARK
+        {
+            ApparentPlace::fromCatalog(&num, STARS, ra0.constData(), dec0.constData(), pmRA.constData(),
+                                       pmDec.constData(), ra.data(), dec.data());
+            ApparentPlace::toHorizontal(&LST, &lat, STARS, ra.constData(), dec.constData(), alt.data(), az.data());
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            for (int i = 0; i < STARS; ++i)
+            {
+                star.init(&records[i]);
+                star.updateCoords(&num);
+                star.EquatorialToHorizontal(&LST, &lat);
+                alt[i] = star.alt().Degrees();
+                az[i]  = star.az().Degrees();
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestApparentPlace)
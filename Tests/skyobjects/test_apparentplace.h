@@ -0,0 +1,57 @@
+/***************************************************************************
+                   test_apparentplace.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_APPARENTPLACE_H
+#define TEST_APPARENTPLACE_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+#include "skyobjects/deepstardata.h"
+
+/**
+ * @class TestApparentPlace
+ * @short Compares the batched apparent place of stars with StarObject::updateCoords, and benchmarks both
+ * @author agent <agent@local>
+ */
+
+class TestApparentPlace : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestApparentPlace() : QObject(){};
+    ~TestApparentPlace(){};
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void fromCatalog_data();
+    void fromCatalog();
+    void toHorizontal();
+
+    void benchmarkUpdateCoords_data();
+    void benchmarkUpdateCoords();
+
+  private:
+    QVector<deepStarData> records;
+    bool useRelativistic { false };
+    bool alwaysRecomputeCoordinates { false };
+};
+
+#endif
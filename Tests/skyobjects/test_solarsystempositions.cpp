@@ -0,0 +1,146 @@
+/***************************************************************************
+              test_solarsystempositions.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_solarsystempositions.h"
+#include "ksnumbers.h"
+#include "auxiliary/cachingdms.h"
+#include "skyobjects/ksasteroid.h"
+#include "skyobjects/kscomet.h"
+
+Q_DECLARE_METATYPE(KSPlanetBase *)
+
+namespace
+{
+// Both paths run the same arithmetic, so they only differ by rounding
+const double TOLERANCE = 1e-9;
+
+// Dates around the perihelia of the comets below, and far from them
+const double DATES[] = { 2446470.5, 2451545.0, 2459034.5, 2459400.25 };
+
+// Heliocentric ecliptic position of the Earth, as KSPlanet gives it
+KSAsteroid *makeEarth(const EclipticPosition &position)
+{
+    KSAsteroid *earth = new KSAsteroid(0, "Earth stand-in", QString(), 2451545.0, 1.0, 0.0, dms(0.0), dms(0.0),
+                                       dms(0.0), dms(0.0), 0.0, 0.0);
+    earth->setEcLong(position.longitude);
+    earth->setEcLat(position.latitude);
+    earth->setRsun(position.radius);
+    return earth;
+}
+
+// Finds the position of body both ways, and compares them
+void comparePositions(KSPlanetBase *body, double jd, bool topocentric, KSPlanetBase *moved)
+{
+    KSNumbers num(jd);
+    const CachingDms lat(48.1), lst(dms(jd * 360.98564736629).reduce());
+    const CachingDms *latp = topocentric ? &lat : nullptr;
+    const CachingDms *lstp = topocentric ? &lst : nullptr;
+
+    // The Earth moves along the ecliptic with the date
+    const EclipticPosition earthPosition(dms(jd * 0.98564736).reduce(), dms(0.0001), 0.9833 + 0.03 * sin(jd));
+    QScopedPointer<KSAsteroid> earth(makeEarth(earthPosition));
+
+    body->findPosition(&num, latp, lstp, earth.data());
+
+    KSPlanetBase::Position position;
+    QVERIFY(moved->computePosition(&num, latp, lstp, earthPosition, position));
+    moved->setPosition(position);
+
+    QVERIFY(fabs(body->ra().Degrees() - moved->ra().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->dec().Degrees() - moved->dec().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->ecLong().Degrees() - moved->ecLong().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->ecLat().Degrees() - moved->ecLat().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->helEcLong().Degrees() - moved->helEcLong().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->rsun() - moved->rsun()) < TOLERANCE);
+    QVERIFY(fabs(body->rearth() - moved->rearth()) < TOLERANCE);
+    QVERIFY(fabs(body->phase().Degrees() - moved->phase().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(body->angSize() - moved->angSize()) < TOLERANCE);
+    QVERIFY(fabs(body->mag() - moved->mag()) < 1e-5);
+}
+}
+
+void TestSolarSystemPositions::addRows(const QString &name, KSPlanetBase *body)
+{
+    bodies.append(body);
+
+    for (double jd : DATES)
+    {
+        QTest::newRow(QString("%1 at %2, geocentric").arg(name).arg(jd).toLatin1()) << body << jd << false;
+        QTest::newRow(QString("%1 at %2, topocentric").arg(name).arg(jd).toLatin1()) << body << jd << true;
+    }
+}
+
+void TestSolarSystemPositions::cleanupTestCase()
+{
+    qDeleteAll(bodies);
+}
+
+void TestSolarSystemPositions::asteroid_data()
+{
+    QTest::addColumn<KSPlanetBase *>("body");
+    QTest::addColumn<double>("jd");
+    QTest::addColumn<bool>("topocentric");
+
+    // A main belt asteroid, and an eccentric near-Earth one that needs the iterated eccentric anomaly
+    addRows("Ceres", new KSAsteroid(1, "1 Ceres", QString(), 2458600.5, 2.7691, 0.0760, dms(10.594), dms(73.597),
+                                     dms(80.305), dms(77.372), 3.34, 0.12));
+    addRows("Icarus", new KSAsteroid(1566, "1566 Icarus", QString(), 2458600.5, 1.0779, 0.8269, dms(22.828),
+                                      dms(31.364), dms(87.995), dms(320.49), 15.9, 0.15));
+}
+
+void TestSolarSystemPositions::asteroid()
+{
+    QFETCH(KSPlanetBase *, body);
+    QFETCH(double, jd);
+    QFETCH(bool, topocentric);
+
+    QScopedPointer<KSAsteroid> found(static_cast<KSAsteroid *>(body)->clone());
+    QScopedPointer<KSAsteroid> moved(static_cast<KSAsteroid *>(body)->clone());
+
+    comparePositions(found.data(), jd, topocentric, moved.data());
+}
+
+void TestSolarSystemPositions::comet_data()
+{
+    QTest::addColumn<KSPlanetBase *>("body");
+    QTest::addColumn<double>("jd");
+    QTest::addColumn<bool>("topocentric");
+
+    // An elliptic orbit, and a near-parabolic one
+    addRows("Halley", new KSComet("1P/Halley", QString(), 2449400.5, 0.5871, 0.9672, dms(162.26), dms(111.33),
+                                  dms(58.42), 19860209.46, 5.5, 0.0, 8.0, 0.0));
+    addRows("NEOWISE", new KSComet("C/2020 F3 (NEOWISE)", QString(), 2459000.5, 0.2947, 0.9992, dms(128.94),
+                                   dms(37.28), dms(61.01), 20200703.68, 12.0, 0.0, 3.2, 0.0));
+}
+
+void TestSolarSystemPositions::comet()
+{
+    QFETCH(KSPlanetBase *, body);
+    QFETCH(double, jd);
+    QFETCH(bool, topocentric);
+
+    QScopedPointer<KSComet> found(static_cast<KSComet *>(body)->clone());
+    QScopedPointer<KSComet> moved(static_cast<KSComet *>(body)->clone());
+
+    comparePositions(found.data(), jd, topocentric, moved.data());
+
+    QVERIFY(fabs(found->getComaAngSize().Degrees() - moved->getComaAngSize().Degrees()) < TOLERANCE);
+    QVERIFY(fabs(found->getTailSize() - moved->getTailSize()) < 1e-3);
+}
+
+QTEST_GUILESS_MAIN(TestSolarSystemPositions)
@@ -0,0 +1,55 @@
+/***************************************************************************
+               test_solarsystempositions.h  -  KStars Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (c) 2026 by agent
+    email                : agent@local
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_SOLARSYSTEMPOSITIONS_H
+#define TEST_SOLARSYSTEMPOSITIONS_H
+
+#include <QtTest/QtTest>
+#include <QDebug>
+
+class KSPlanetBase;
+
+/**
+ * @class TestSolarSystemPositions
+ * @short Checks that the positions the workers compute with computePosition() are those findPosition() finds
+ * @author agent <agent@local>
+ */
+
+class TestSolarSystemPositions : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestSolarSystemPositions() : QObject(){};
+    ~TestSolarSystemPositions(){};
+
+  private slots:
+    void cleanupTestCase();
+
+    void asteroid_data();
+    void asteroid();
+    void comet_data();
+    void comet();
+
+  private:
+    void addRows(const QString &name, KSPlanetBase *body);
+
+    // Bodies of the rows of the data functions
+    QList<KSPlanetBase *> bodies;
+};
+
+#endif
@@ -31,6 +31,14 @@
 #include <QSqlRecord>
 #include <QSqlQuery>
 
+static const char INSERT_DSO_QUERY[] = "INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                                       " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
+                                       " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
+                                       " :Flux)";
+
+static const char INSERT_DESIGNATION_QUERY[] = "INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                                               ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)";
+
 bool CatalogDB::Initialize()
 {
     skydb_         = QSqlDatabase::addDatabase("QSQLITE", "skydb");
@@ -208,6 +216,8 @@ void CatalogDB::AddCatalog(const CatalogData &catalog_data)
 
 void CatalogDB::RemoveCatalog(const QString &catalog_name)
 {
+    QFile::remove(CatalogSnapshot::filename(catalog_name));
+
     // Part 1 Clear DSO Entries
     ClearDSOEntries(FindCatalog(catalog_name));
 
@@ -301,7 +311,33 @@ bool CatalogDB::AddEntry(const CatalogEntryData &catalog_entry, int catid)
     return retVal;
 }
 
-bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
+void CatalogDB::BuildDSOIndex(DSOIndex &index)
+{
+    index.clear();
+
+    QSqlQuery dso_query(skydb_);
+    dso_query.setForwardOnly(true);
+    if (!dso_query.exec("SELECT UID, RA, Dec, Magnitude FROM DSO"))
+    {
+        qWarning() << dso_query.lastQuery();
+        qWarning() << dso_query.lastError();
+        return;
+    }
+
+    while (dso_query.next())
+    {
+        // Rows without magnitude never match, as in FindFuzzyEntry()
+        if (dso_query.isNull(3))
+            continue;
+
+        index.insert(dso_query.value(0).toInt(), dso_query.value(1).toDouble(), dso_query.value(2).toDouble(),
+                     dso_query.value(3).toDouble());
+    }
+
+    dso_query.clear();
+}
+
+bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid, ImportContext *import)
 {
     // Verification step
     // If RA, Dec are Null, it denotes an invalid object and should not be written
@@ -322,16 +358,17 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
     // out the lastInsertId
 
     // Part 2: Fuzzy Match or Create New Entry
-    int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+    // Imports match against their in-memory index, the DSO table cannot be searched by position efficiently
+    int rowuid = import ? import->dso_index.find(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude) :
+                          FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
     //skydb_.open();
 
     if (rowuid == -1) //i.e. No fuzzy match found. Proceed to add new entry
     {
-        QSqlQuery add_query(skydb_);
-        add_query.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
-                          " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
-                          " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
-                          " :Flux)");
+        QSqlQuery single_query(skydb_);
+        QSqlQuery &add_query = import ? import->add_dso : single_query;
+        if (!import)
+            add_query.prepare(INSERT_DSO_QUERY);
         add_query.bindValue(":RA", catalog_entry.ra);
         add_query.bindValue(":Dec", catalog_entry.dec);
         add_query.bindValue(":Type", catalog_entry.type);
@@ -349,7 +386,10 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
 
         // Find UID of the Row just added
         rowuid = add_query.lastInsertId().toInt();
-        add_query.clear();
+        if (import)
+            import->dso_index.insert(rowuid, catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+        else
+            add_query.clear();
     }
     int ID = catalog_entry.ID;
 
@@ -367,11 +407,12 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
 
     // Part 3: Add in Object Designation
     //skydb_.open();
-    QSqlQuery add_od(skydb_);
+    QSqlQuery single_od(skydb_);
+    QSqlQuery &add_od = (import && ID >= 0) ? import->add_od : single_od;
     if (ID >= 0)
     {
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
+        if (!import)
+            add_od.prepare(INSERT_DESIGNATION_QUERY);
         add_od.bindValue(":id", ID);
     }
     else
@@ -392,7 +433,8 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qWarning() << skydb_.lastError();
         retVal = false;
     }
-    add_od.clear();
+    if (!import)
+        add_od.clear();
     //skydb_.close();
 
     return retVal;
@@ -485,6 +527,13 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
         skydb_.open();
         skydb_.transaction();
 
+        // The statements are prepared once, and the entries are matched
+        // against an index of the DSO table that grows with the import
+        ImportContext import(skydb_);
+        BuildDSOIndex(import.dso_index);
+        import.add_dso.prepare(INSERT_DSO_QUERY);
+        import.add_od.prepare(INSERT_DESIGNATION_QUERY);
+
         QHash<QString, QVariant> row_content;
         while (catalog_text_parser.HasNextRow())
         {
@@ -507,9 +556,12 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
             catalog_entry.minor_axis     = row_content["Mn"].toFloat();
             catalog_entry.flux           = row_content["Flux"].toFloat();
 
-            _AddEntry(catalog_entry, catid);
+            _AddEntry(catalog_entry, catid, &import);
         }
 
+        import.add_dso.clear();
+        import.add_od.clear();
+
         skydb_.commit();
         skydb_.close();
     }
@@ -831,8 +883,112 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
                               bool includeCatalogDesignation)
 {
     sky_list.clear();
-    QString selected_catalog = QString::number(FindCatalog(catalog));
+    int catalog_id = FindCatalog(catalog);
+    if (catalog_id == -1)
+        return;
+
     skydb_.open();
+
+    // The objects are read from the snapshot of the catalog, unless its
+    // rows changed since the snapshot was written
+    CatalogSnapshot::Key key        = SnapshotKey(catalog_id, includeCatalogDesignation);
+    const QString snapshot_filename = CatalogSnapshot::filename(catalog);
+    QVector<CatalogSnapshot::Row> rows;
+
+    if (!CatalogSnapshot::read(snapshot_filename, key, rows))
+    {
+        ReadObjects(key, rows);
+
+        if (!CatalogSnapshot::write(snapshot_filename, key, rows))
+            qWarning() << "Could not write the snapshot of catalog" << catalog << "to" << snapshot_filename;
+    }
+
+    skydb_.close();
+
+    sky_list.reserve(rows.size());
+
+    for (const CatalogSnapshot::Row &row : rows)
+    {
+        dms RA(row.ra);
+        dms Dec(row.dec);
+
+        // FIXME: It is a bad idea to create objects in one class
+        // (using new) and delete them in another! The objects created
+        // here are usually deleted by CatalogComponent! See
+        // CatalogComponent::loadData for more information!
+
+        if (row.type == 0) // Add a star
+        {
+            StarObject *o = new StarObject(RA, Dec, row.magnitude, row.long_name);
+            sky_list.append(o);
+        }
+        else // Add a deep-sky object
+        {
+            DeepSkyObject *o = new DeepSkyObject(row.type, RA, Dec, row.magnitude, row.name, QString(), row.long_name,
+                                                 key.prefix, row.major_axis, row.minor_axis, -row.position_angle);
+            o->setFlux(row.flux);
+            o->setCustomCatalog(catalog_ptr);
+
+            sky_list.append(o);
+
+            // Add name to the list of object names
+            if (!row.name.isEmpty())
+            {
+                object_names.append(qMakePair<int, QString>(row.type, row.name));
+            }
+        }
+
+        if (!row.long_name.isEmpty() && row.long_name != row.name)
+        {
+            object_names.append(qMakePair<int, QString>(row.type, row.long_name));
+        }
+    }
+}
+
+CatalogSnapshot::Key CatalogDB::SnapshotKey(int catalog_id, bool includeCatalogDesignation)
+{
+    CatalogSnapshot::Key key;
+    key.catalog_id   = catalog_id;
+    key.rows         = 0;
+    key.first_row    = 0;
+    key.last_row     = 0;
+    key.epoch        = 0;
+    key.designations = includeCatalogDesignation;
+
+    // Designations get new ids whenever a catalog is imported or edited
+    QSqlQuery rows_query(skydb_);
+    rows_query.prepare("SELECT COUNT(*), MIN(id), MAX(id) FROM ObjectDesignation WHERE id_Catalog = :catID");
+    rows_query.bindValue(":catID", catalog_id);
+
+    if (rows_query.exec() && rows_query.next())
+    {
+        key.rows      = rows_query.value(0).toLongLong();
+        key.first_row = rows_query.value(1).toLongLong();
+        key.last_row  = rows_query.value(2).toLongLong();
+    }
+    else
+        qWarning() << rows_query.lastError();
+
+    QSqlQuery catalog_query(skydb_);
+    catalog_query.prepare("SELECT Prefix, Epoch FROM Catalog WHERE id = :catID");
+    catalog_query.bindValue(":catID", catalog_id);
+
+    if (catalog_query.exec() && catalog_query.next())
+    {
+        key.prefix = catalog_query.value(0).toString();
+        key.epoch  = catalog_query.value(1).toFloat();
+    }
+    else
+        qWarning() << catalog_query.lastError();
+
+    return key;
+}
+
+void CatalogDB::ReadObjects(const CatalogSnapshot::Key &key, QVector<CatalogSnapshot::Row> &rows)
+{
+    rows.clear();
+    rows.reserve(key.rows);
+
     QSqlQuery get_query(skydb_);
     get_query.prepare("SELECT Epoch, Type, RA, Dec, Magnitude, Prefix, "
                       "IDNumber, LongName, MajorAxis, MinorAxis, "
@@ -840,11 +996,7 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
                       "JOIN Catalog WHERE Catalog.id = :catID AND "
                       "ObjectDesignation.id_Catalog = Catalog.id AND "
                       "ObjectDesignation.UID_DSO = DSO.UID");
-    get_query.bindValue(":catID", selected_catalog);
-
-    //     qWarning() << get_query.lastQuery();
-    //     qWarning() << get_query.lastError();
-    //     qWarning() << FindCatalog(catalog);
+    get_query.bindValue(":catID", key.catalog_id);
 
     if (!get_query.exec())
     {
@@ -854,27 +1006,28 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
 
     while (get_query.next())
     {
-        int cat_epoch       = get_query.value(0).toInt();
-        unsigned char iType = get_query.value(1).toInt();
+        CatalogSnapshot::Row row;
+
+        int cat_epoch = get_query.value(0).toInt();
+        row.type      = get_query.value(1).toInt();
         dms RA(get_query.value(2).toDouble());
         dms Dec(get_query.value(3).toDouble());
-        float mag                = get_query.value(4).toFloat();
+        row.magnitude            = get_query.value(4).toFloat();
         QString catPrefix        = get_query.value(5).toString();
         int id_number_in_catalog = get_query.value(6).toInt();
-        QString lname            = get_query.value(7).toString();
-        float a                  = get_query.value(8).toFloat();
-        float b                  = get_query.value(9).toFloat();
-        float PA                 = get_query.value(10).toFloat();
-        float flux               = get_query.value(11).toFloat();
-
-        QString name;
-        if (!includeCatalogDesignation && !lname.isEmpty())
+        row.long_name            = get_query.value(7).toString();
+        row.major_axis           = get_query.value(8).toFloat();
+        row.minor_axis           = get_query.value(9).toFloat();
+        row.position_angle       = get_query.value(10).toFloat();
+        row.flux                 = get_query.value(11).toFloat();
+
+        if (!key.designations && !row.long_name.isEmpty())
         {
-            name  = lname;
-            lname = QString();
+            row.name      = row.long_name;
+            row.long_name = QString();
         }
         else
-            name = catPrefix + ' ' + QString::number(id_number_in_catalog);
+            row.name = catPrefix + ' ' + QString::number(id_number_in_catalog);
 
         SkyPoint t;
         t.set(RA, Dec);
@@ -901,42 +1054,13 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
                           " J2000.0";
         }
 
-        RA  = t.ra();
-        Dec = t.dec();
-
-        // FIXME: It is a bad idea to create objects in one class
-        // (using new) and delete them in another! The objects created
-        // here are usually deleted by CatalogComponent! See
-        // CatalogComponent::loadData for more information!
+        row.ra  = t.ra().Degrees();
+        row.dec = t.dec().Degrees();
 
-        if (iType == 0) // Add a star
-        {
-            StarObject *o = new StarObject(RA, Dec, mag, lname);
-            sky_list.append(o);
-        }
-        else // Add a deep-sky object
-        {
-            DeepSkyObject *o = new DeepSkyObject(iType, RA, Dec, mag, name, QString(), lname, catPrefix, a, b, -PA);
-            o->setFlux(flux);
-            o->setCustomCatalog(catalog_ptr);
-
-            sky_list.append(o);
-
-            // Add name to the list of object names
-            if (!name.isEmpty())
-            {
-                object_names.append(qMakePair<int, QString>(iType, name));
-            }
-        }
-
-        if (!lname.isEmpty() && lname != name)
-        {
-            object_names.append(qMakePair<int, QString>(iType, lname));
-        }
+        rows.append(row);
     }
 
     get_query.clear();
-    skydb_.close();
 }
 
 QList<QPair<QString, KSParser::DataTypes>> CatalogDB::buildParserSequence(const QStringList &Columns)
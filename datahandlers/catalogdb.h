@@ -30,6 +30,8 @@
 #include <KMessageBox>
 #endif
 
+#include "catalogsnapshot.h"
+#include "dsoindex.h"
 #include "ksparser.h"
 
 #include <QString>
@@ -122,6 +124,9 @@ class CatalogDB
     /**
          * @brief Creates objects of type SkyObject and assigns them to references
          *
+         * The objects are read from the snapshot of the catalog if it is up
+         * to date, and the snapshot is written otherwise, see CatalogSnapshot.
+         *
          * @param catalog Name of the catalog whose objects are needed.
          * @param sky_list List of all skyobjects stored in database (assigns)
          * @param names List of named objects in database (assigns)
@@ -179,6 +184,19 @@ class CatalogDB
     void AddCatalog(const CatalogData &catalog_data);
 
   private:
+    /**
+         * @brief Prepared statements and index of the DSO table shared by
+         * the entries of an import, see AddCatalogContents()
+         **/
+    struct ImportContext
+    {
+        explicit ImportContext(const QSqlDatabase &db) : add_dso(db), add_od(db) {}
+
+        DSOIndex dso_index;
+        QSqlQuery add_dso;
+        QSqlQuery add_od;
+    };
+
     /**
          * @brief Used to add a cross referenced entry into the database
          *
@@ -187,9 +205,40 @@ class CatalogDB
          *
          * @param catalog_entry Data structure with entry details
          * @param catid Category ID in the database
+         * @param import If set, the entry is matched against its DSO index
+         * instead of the DSO table, and written with its statements
          * @return false if adding was unsuccessful
          **/
-    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
+    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid, ImportContext *import = 0);
+
+    /**
+         * @brief Loads the UID, position and magnitude of the rows of the
+         * DSO table into index
+         *
+         * @param index Index to fill, it is cleared first
+         * @return void
+         **/
+    void BuildDSOIndex(DSOIndex &index);
+
+    /**
+         * @brief Summarizes the rows of a catalog to tell whether its
+         * snapshot is up to date. The database must be open.
+         *
+         * @param catalog_id ID of the catalog
+         * @param includeCatalogDesignation See GetAllObjects()
+         * @return the key of the snapshot of the catalog
+         **/
+    CatalogSnapshot::Key SnapshotKey(int catalog_id, bool includeCatalogDesignation);
+
+    /**
+         * @brief Reads the objects of a catalog from the database, with
+         * J2000 coordinates. The database must be open.
+         *
+         * @param key Key of the catalog, see SnapshotKey()
+         * @param rows Filled with the objects of the catalog
+         * @return void
+         **/
+    void ReadObjects(const CatalogSnapshot::Key &key, QVector<CatalogSnapshot::Row> &rows);
 
     /**
          * @brief Database object for the sky object. Assigned and Initialized by
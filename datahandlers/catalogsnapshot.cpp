@@ -0,0 +1,191 @@
+/***************************************************************************
+                  catalogsnapshot.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "catalogsnapshot.h"
+
+#include "../kstars/auxiliary/kspaths.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QUrl>
+
+#include <cstring>
+
+// Increase whenever the layout of snapshots changes
+#define SNAPSHOT_VERSION 1
+
+namespace
+{
+const char SNAPSHOT_MAGIC[8] = { 'K', 'S', 'C', 'A', 'T', 'S', 'N', 'P' };
+
+typedef struct
+{
+    char magic[8];
+    quint32 version;
+    quint32 designations;
+    qint64 catalog_id;
+    qint64 rows;
+    qint64 first_row;
+    qint64 last_row;
+    float epoch;
+    quint32 prefix_length; // The prefix is at the start of the characters
+    quint32 count;         // Number of records
+    quint32 characters;    // Number of characters of the names
+} Header;
+
+typedef struct
+{
+    double ra;
+    double dec;
+    float magnitude;
+    float major_axis;
+    float minor_axis;
+    float position_angle;
+    float flux;
+    quint32 name_offset;
+    quint32 name_length;
+    quint32 long_name_offset;
+    quint32 long_name_length;
+    quint8 type;
+} Record;
+}
+
+QString CatalogSnapshot::filename(const QString &catalog_name)
+{
+    // Catalog names may contain any character
+    return KSPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "catalogs/" +
+           QString::fromLatin1(QUrl::toPercentEncoding(catalog_name)) + ".snapshot";
+}
+
+bool CatalogSnapshot::read(const QString &filename, const Key &key, QVector<Row> &rows)
+{
+    rows.clear();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(sizeof(Header)))
+        return false;
+
+    const uchar *data = file.map(0, file.size());
+    if (data == 0)
+        return false;
+
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+
+    const qint64 size = sizeof(Header) + static_cast<qint64>(header.count) * sizeof(Record) +
+                        static_cast<qint64>(header.characters) * sizeof(QChar);
+
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header.version != SNAPSHOT_VERSION ||
+        size != file.size() || header.prefix_length > header.characters ||
+        header.designations != static_cast<quint32>(key.designations) || header.catalog_id != key.catalog_id ||
+        header.rows != key.rows || header.first_row != key.first_row || header.last_row != key.last_row ||
+        header.epoch != key.epoch)
+        return false;
+
+    const uchar *records     = data + sizeof(Header);
+    const QChar *characters = reinterpret_cast<const QChar *>(records + header.count * sizeof(Record));
+
+    if (QString(characters, header.prefix_length) != key.prefix)
+        return false;
+
+    rows.resize(header.count);
+
+    for (quint32 i = 0; i < header.count; ++i)
+    {
+        Record record;
+        memcpy(&record, records + i * sizeof(Record), sizeof(Record));
+
+        if (static_cast<quint64>(record.name_offset) + record.name_length > header.characters ||
+            static_cast<quint64>(record.long_name_offset) + record.long_name_length > header.characters)
+        {
+            rows.clear();
+            return false;
+        }
+
+        Row &row           = rows[i];
+        row.type           = record.type;
+        row.ra             = record.ra;
+        row.dec            = record.dec;
+        row.magnitude      = record.magnitude;
+        row.major_axis     = record.major_axis;
+        row.minor_axis     = record.minor_axis;
+        row.position_angle = record.position_angle;
+        row.flux           = record.flux;
+        row.name           = QString(characters + record.name_offset, record.name_length);
+        row.long_name      = QString(characters + record.long_name_offset, record.long_name_length);
+    }
+
+    return true;
+}
+
+bool CatalogSnapshot::write(const QString &filename, const Key &key, const QVector<Row> &rows)
+{
+    if (!QDir().mkpath(QFileInfo(filename).absolutePath()))
+        return false;
+
+    QString characters = key.prefix;
+    QVector<Record> records(rows.size());
+
+    for (int i = 0; i < rows.size(); ++i)
+    {
+        const Row &row = rows[i];
+        Record &record = records[i];
+
+        // Padding is written too, keep it deterministic
+        memset(&record, 0, sizeof(Record));
+        record.type             = row.type;
+        record.ra               = row.ra;
+        record.dec              = row.dec;
+        record.magnitude        = row.magnitude;
+        record.major_axis       = row.major_axis;
+        record.minor_axis       = row.minor_axis;
+        record.position_angle   = row.position_angle;
+        record.flux             = row.flux;
+        record.name_offset      = characters.size();
+        record.name_length      = row.name.size();
+        characters += row.name;
+        record.long_name_offset = characters.size();
+        record.long_name_length = row.long_name.size();
+        characters += row.long_name;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version       = SNAPSHOT_VERSION;
+    header.designations  = key.designations;
+    header.catalog_id    = key.catalog_id;
+    header.rows          = key.rows;
+    header.first_row     = key.first_row;
+    header.last_row      = key.last_row;
+    header.epoch         = key.epoch;
+    header.prefix_length = key.prefix.size();
+    header.count         = records.size();
+    header.characters    = characters.size();
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(Record));
+    file.write(reinterpret_cast<const char *>(characters.constData()), characters.size() * sizeof(QChar));
+
+    return file.commit();
+}
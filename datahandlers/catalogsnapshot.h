@@ -0,0 +1,91 @@
+/***************************************************************************
+                  catalogsnapshot.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Binary snapshot of the objects of a catalog of the database, so
+ * that they can be loaded without querying the database.
+ *
+ * A snapshot holds the rows that CatalogDB::GetAllObjects() reads, with
+ * J2000 coordinates and the names of the objects as they are shown. It is
+ * a header, an array of fixed size records and the UTF-16 characters of
+ * the names, in native byte order, and is memory mapped to be read.
+ *
+ * The header stores the key of the catalog, which summarizes its rows in
+ * the database. A snapshot is only read if its key and format version
+ * match, so it is rebuilt when entries are added to or removed from the
+ * catalog, or when the catalog is imported again.
+ **/
+class CatalogSnapshot
+{
+  public:
+    /** @brief Summary of the rows of a catalog in the database */
+    typedef struct
+    {
+        qint64 catalog_id;
+        qint64 rows;      // Number of designations of the catalog
+        qint64 first_row; // Smallest and largest id of the designations
+        qint64 last_row;
+        float epoch;
+        bool designations; // Whether names include the catalog designation
+        QString prefix;
+    } Key;
+
+    /** @brief Object of the catalog, see CatalogDB::GetAllObjects() */
+    typedef struct
+    {
+        unsigned char type;
+        double ra; // J2000 degrees
+        double dec;
+        float magnitude;
+        float major_axis;
+        float minor_axis;
+        float position_angle;
+        float flux;
+        QString name;
+        QString long_name;
+    } Row;
+
+    /**
+     * @brief Returns the file of the snapshot of a catalog in the cache
+     * directory
+     **/
+    static QString filename(const QString &catalog_name);
+
+    /**
+     * @brief Reads the rows of a snapshot
+     *
+     * @return false if the file is missing, damaged, of another version
+     * or of another key
+     **/
+    static bool read(const QString &filename, const Key &key, QVector<Row> &rows);
+
+    /**
+     * @brief Writes the rows of a catalog to a snapshot, replacing the
+     * previous one atomically
+     *
+     * @return false if the snapshot could not be written
+     **/
+    static bool write(const QString &filename, const Key &key, const QVector<Row> &rows);
+};
+
+#endif // CATALOGSNAPSHOT_H
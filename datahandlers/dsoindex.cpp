@@ -0,0 +1,82 @@
+/***************************************************************************
+                  dsoindex.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "dsoindex.h"
+
+#include <cmath>
+
+const double DSOIndex::POSITION_FUZZ  = 0.0016;
+const double DSOIndex::MAGNITUDE_FUZZ = 0.1;
+
+// Cells are twice as large as the fuzz, so that rounding never pushes a match
+// out of the neighbouring cells
+#define CELL_SIZE (2 * POSITION_FUZZ)
+
+qint64 DSOIndex::cell(int column, int row)
+{
+    return (static_cast<qint64>(column) << 32) | static_cast<quint32>(row);
+}
+
+int DSOIndex::column(double degrees)
+{
+    return static_cast<int>(std::floor(degrees / CELL_SIZE));
+}
+
+void DSOIndex::insert(int uid, double ra, double dec, double magnitude)
+{
+    Row entry;
+    entry.uid       = uid;
+    entry.ra        = ra;
+    entry.dec       = dec;
+    entry.magnitude = magnitude;
+
+    cells_[cell(column(ra), column(dec))].append(entry);
+    count_++;
+}
+
+int DSOIndex::find(double ra, double dec, double magnitude) const
+{
+    const int ra_column = column(ra);
+    const int dec_row   = column(dec);
+    int uid             = -1;
+
+    for (int i = ra_column - 1; i <= ra_column + 1; ++i)
+    {
+        for (int j = dec_row - 1; j <= dec_row + 1; ++j)
+        {
+            auto rows = cells_.constFind(cell(i, j));
+            if (rows == cells_.constEnd())
+                continue;
+
+            for (const Row &candidate : rows.value())
+            {
+                // Same test as the SQL filter of CatalogDB::FindFuzzyEntry(), RA does not wrap around
+                if (std::fabs(candidate.ra - ra) <= POSITION_FUZZ && std::fabs(candidate.dec - dec) <= POSITION_FUZZ &&
+                    std::fabs(candidate.magnitude - magnitude) <= MAGNITUDE_FUZZ && (uid == -1 || candidate.uid < uid))
+                    uid = candidate.uid;
+            }
+        }
+    }
+
+    return uid;
+}
+
+void DSOIndex::clear()
+{
+    cells_.clear();
+    count_ = 0;
+}
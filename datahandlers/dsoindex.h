@@ -0,0 +1,80 @@
+/***************************************************************************
+                  dsoindex.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef DSOINDEX_H
+#define DSOINDEX_H
+
+#include <QHash>
+#include <QVector>
+
+/**
+ * @brief In-memory grid of the rows of the DSO table, to match imported
+ * catalog entries with the objects of the database.
+ *
+ * Rows are bucketed in cells of twice the position fuzz on a side, so the
+ * rows that match an entry are in the cell of the entry or in one of its
+ * eight neighbours. An entry matches a row when their RA and Dec differ by
+ * at most POSITION_FUZZ degrees, and their magnitudes by at most
+ * MAGNITUDE_FUZZ, as CatalogDB::FindFuzzyEntry() does.
+ **/
+class DSOIndex
+{
+  public:
+    /** @brief Largest difference of RA and Dec, in degrees, of matching entries */
+    static const double POSITION_FUZZ;
+
+    /** @brief Largest difference of magnitude of matching entries */
+    static const double MAGNITUDE_FUZZ;
+
+    /**
+     * @brief Adds a row of the DSO table
+     *
+     * @param uid UID of the row
+     * @param ra Right Ascension in degrees
+     * @param dec Declination in degrees
+     * @param magnitude Magnitude
+     **/
+    void insert(int uid, double ra, double dec, double magnitude);
+
+    /**
+     * @brief Returns the smallest UID of the rows that match an entry,
+     * or -1 if none does
+     **/
+    int find(double ra, double dec, double magnitude) const;
+
+    /** @brief Number of rows in the index */
+    int count() const { return count_; }
+
+    void clear();
+
+  private:
+    typedef struct
+    {
+        int uid;
+        double ra;
+        double dec;
+        double magnitude;
+    } Row;
+
+    static qint64 cell(int column, int row);
+    static int column(double degrees);
+
+    QHash<qint64, QVector<Row>> cells_;
+    int count_ = 0;
+};
+
+#endif // DSOINDEX_H
@@ -57,6 +57,29 @@ KSParser::KSParser(const QString &filename, const char comment_char, const QList
     }
 }
 
+KSParser::KSParser(const QString &filename, const char comment_char, const char delimiter)
+    : filename_(filename), comment_char_(comment_char), delimiter_(delimiter)
+{
+    // Without a sequence, ReadNextRow() can only return empty rows
+    readFunctionPtr = &KSParser::DummyRow;
+
+    if (!file_reader_.openFullPath(filename_))
+        qWarning() << "Unable to open file: " << filename;
+    else
+        qDebug() << "File opened: " << filename;
+}
+
+KSParser::KSParser(const QString &filename, const char comment_char, const QList<int> &widths)
+    : filename_(filename), comment_char_(comment_char), width_sequence_(widths), delimiter_(0)
+{
+    readFunctionPtr = &KSParser::DummyRow;
+
+    if (!file_reader_.openFullPath(filename_))
+        qWarning() << "Unable to open file: " << filename;
+    else
+        qDebug() << "File opened: " << filename;
+}
+
 QHash<QString, QVariant> KSParser::ReadNextRow()
 {
     return (this->*readFunctionPtr)();
@@ -338,3 +361,104 @@ QVariant KSParser::ConvertToQVariant(const QString &input_string, const KSParser
     }
     return converted_object;
 }
+
+bool KSParser::ReadFields(int count)
+{
+    const bool fixed_width = (delimiter_ == 0);
+
+    if (fixed_width && count != width_sequence_.length() + 1)
+    {
+        qWarning() << "Unequal fields and widths! No row read!";
+        Q_ASSERT(false);
+        return false;
+    }
+
+    if (fields_.size() != count)
+        fields_.resize(count);
+
+    while (file_reader_.readLineInto(line_))
+    {
+        if (!line_.isEmpty() && line_.at(0) == comment_char_)
+            continue;
+
+        if (fixed_width)
+        {
+            if (SplitFixedWidthFields())
+                return true;
+        }
+        // Skip incomplete rows, and rows without delimiter
+        else if (SplitCSVFields() == count)
+            return true;
+    }
+
+    return false;
+}
+
+int KSParser::SplitCSVFields()
+{
+    const QChar delimiter = QLatin1Char(delimiter_);
+    const int length      = line_.length();
+    int count             = 0;
+    int start             = 0;
+
+    if (!line_.contains(delimiter))
+        return 0;
+
+    while (true)
+    {
+        int end = line_.indexOf(delimiter, start);
+        if (end < 0)
+            end = length;
+
+        int field_start = start, field_end = end;
+
+        if (start < length && line_.at(start) == '\"')
+        {
+            /*
+             * As in CombineQuoteParts(), a quoted field ends with the first
+             * part that ends with a quote mark, or that is empty. The first
+             * part is considered without its opening quote mark.
+             */
+            int part_start = start + 1;
+
+            while (end > part_start && line_.at(end - 1) != '\"' && end < length)
+            {
+                part_start = end + 1;
+                end        = line_.indexOf(delimiter, part_start);
+                if (end < 0)
+                    end = length;
+            }
+
+            field_start = start + 1;
+            field_end   = (end > part_start && line_.at(end - 1) == '\"') ? end - 1 : end;
+        }
+
+        if (count < fields_.size())
+            fields_[count] = line_.midRef(field_start, field_end - field_start);
+        count++;
+
+        if (end >= length)
+            break;
+        start = end + 1;
+    }
+
+    return count;
+}
+
+bool KSParser::SplitFixedWidthFields()
+{
+    int position = 0;
+
+    for (int i = 0; i < width_sequence_.length(); ++i)
+    {
+        if (position + width_sequence_[i] > line_.length())
+            return false;
+
+        fields_[i] = line_.midRef(position, width_sequence_[i]).trimmed();
+        position += width_sequence_[i];
+    }
+
+    // The last field runs till the end of the line
+    fields_[width_sequence_.length()] = line_.midRef(position).trimmed();
+    return true;
+}
@@ -24,6 +24,7 @@
 #include <QHash>
 #include <QDebug>
 #include <QVariant>
+#include <QVector>
 
 #include "ksfilereader.h"
 
@@ -47,6 +48,16 @@
  * In case of failure, the parser returns a Dummy Row. So if you see the
  * string "Null" in the returned QHash, it signifies the parserencountered an
  * unexpected error.
+ *
+ * Large files are better read into a struct, which avoids building a QHash
+ * of QVariants for each row:
+ * 1) declare the columns, the members of the struct the fields go to
+ *    static const KSParser::Column<Row> columns[] = { &Row::name, {}, &Row::magnitude };
+ * 2) initialize KSParser without a sequence
+ * 3) Row row;
+ *    while (KSParserObject.ReadNextRow(row, columns)) {
+ *      ...
+ *    }
  **/
 class KSParser
 {
@@ -76,6 +87,30 @@ class KSParser
         D_SKIP
     };
 
+    /**
+         * @brief Column of a row read by ReadNextRow(Row &, columns), the
+         * member of Row its field is stored into. Its type is the type of
+         * the member. A default constructed column skips its field.
+         **/
+    template <typename Row>
+    struct Column
+    {
+        constexpr Column() : type(D_SKIP), string_member(nullptr) {}
+        constexpr Column(QString Row::*member) : type(D_QSTRING), string_member(member) {}
+        constexpr Column(int Row::*member) : type(D_INT), int_member(member) {}
+        constexpr Column(float Row::*member) : type(D_FLOAT), float_member(member) {}
+        constexpr Column(double Row::*member) : type(D_DOUBLE), double_member(member) {}
+
+        DataTypes type;
+        union
+        {
+            QString Row::*string_member;
+            int Row::*int_member;
+            float Row::*float_member;
+            double Row::*double_member;
+        };
+    };
+
     /**
          * @brief Returns a CSV parsing instance of a KSParser type object.
          *
@@ -124,6 +159,27 @@ class KSParser
     KSParser(const QString &filename, const char comment_char, const QList<QPair<QString, DataTypes>> &sequence,
              const QList<int> &widths);
 
+    /**
+         * @brief Returns a CSV parsing instance whose rows are read with
+         * ReadNextRow(Row &, columns). Rows are split as with a sequence.
+         *
+         * @param filename Full Path (Dir + Filename) of source file
+         * @param comment_char Character signifying a comment line
+         * @param delimiter separate on which character. default ','
+         **/
+    KSParser(const QString &filename, const char comment_char, const char delimiter = ',');
+
+    /**
+         * @brief Returns a Fixed Width parsing instance whose rows are read
+         * with ReadNextRow(Row &, columns). Rows are split as with a sequence.
+         *
+         * @param filename Full Path (Dir + Filename) of source file
+         * @param comment_char Character signifying a comment line
+         * @param widths width sequence. Last value is line.length() by default
+         *               Hence, there should be (width.length()+1) columns
+         **/
+    KSParser(const QString &filename, const char comment_char, const QList<int> &widths);
+
     /**
          * @brief Generic function used to read the next row of a text file.
          * The contructor changes the function pointer to the appropriate function.
@@ -133,6 +189,23 @@ class KSParser
          **/
     QHash<QString, QVariant> ReadNextRow();
 
+    /**
+         * @brief Reads the next row of a text file into row, converting
+         * each field to the type of the member of its column. Nothing is
+         * allocated for each row, but for the strings row keeps.
+         *
+         * Incomplete rows are skipped, and fields that cannot be converted
+         * are set to the EBROKEN value of their type, as with ReadNextRow().
+         * Unlike ReadNextRow(), no dummy row is returned at the end of the
+         * file.
+         *
+         * @param row Structure to fill
+         * @param columns Column of each field of the rows, see Column
+         * @return false if there are no more rows, row is not changed then
+         **/
+    template <typename Row, int N>
+    bool ReadNextRow(Row &row, const Column<Row> (&columns)[N]);
+
     /**
          * @brief Returns True if there are more rows to be read
          *
@@ -212,6 +285,31 @@ class KSParser
          **/
     QVariant ConvertToQVariant(const QString &input_string, const DataTypes &data_type, bool &ok);
 
+    /**
+         * @brief Reads the next complete row into line_ and splits it into
+         * fields_, as ReadCSVRow() and ReadFixedWidthRow() do
+         *
+         * @param count Number of fields of complete rows
+         * @return false if there are no more rows
+         **/
+    bool ReadFields(int count);
+
+    /**
+         * @brief Splits line_ at the delimiter into fields_, combining the
+         * parts of quoted fields as CombineQuoteParts() does
+         *
+         * @return the number of fields of line_, which may be more than
+         * the size of fields_, or 0 if line_ has no delimiter
+         **/
+    int SplitCSVFields();
+
+    /**
+         * @brief Splits line_ into fields_ according to width_sequence_
+         *
+         * @return false if line_ is too short
+         **/
+    bool SplitFixedWidthFields();
+
     static const bool parser_debug_mode_;
 
     KSFileReader file_reader_;
@@ -221,6 +319,54 @@ class KSParser
     QList<QPair<QString, DataTypes>> name_type_sequence_;
     QList<int> width_sequence_;
     char delimiter_;
+
+    // Buffers of ReadNextRow(Row &, columns), reused by each row
+    QString line_;
+    QVector<QStringRef> fields_;
 };
 
+template <typename Row, int N>
+bool KSParser::ReadNextRow(Row &row, const Column<Row> (&columns)[N])
+{
+    if (!ReadFields(N))
+        return false;
+
+    for (int i = 0; i < N; i++)
+    {
+        const QStringRef &field = fields_[i];
+        bool ok                 = true;
+
+        switch (columns[i].type)
+        {
+            case D_QSTRING:
+                // Reuses the memory of the string if row does not share it
+                (row.*columns[i].string_member).setUnicode(field.constData(), field.size());
+                break;
+            case D_INT:
+                row.*columns[i].int_member = field.trimmed().toInt(&ok);
+                if (!ok)
+                    row.*columns[i].int_member = EBROKEN_INT;
+                break;
+            case D_FLOAT:
+                row.*columns[i].float_member = field.trimmed().toFloat(&ok);
+                if (!ok)
+                    row.*columns[i].float_member = EBROKEN_FLOAT;
+                break;
+            case D_DOUBLE:
+                row.*columns[i].double_member = field.trimmed().toDouble(&ok);
+                if (!ok)
+                    row.*columns[i].double_member = EBROKEN_DOUBLE;
+                break;
+            case D_SKIP:
+            default:
+                break;
+        }
+
+        if (!ok && parser_debug_mode_)
+            qDebug() << columns[i].type << "Failed at field: " << i << " & line_ : " << line_;
+    }
+
+    return true;
+}
+
 #endif // KSTARS_KSPARSER_H
@@ -18,6 +18,7 @@
 
 #include "binfilehelper.h"
 
+#include <QFile>
 #include <QStandardPaths>
 #include "byteorder.h"
 #include "auxiliary/kspaths.h"
@@ -27,6 +28,8 @@ class BinFileHelper;
 BinFileHelper::BinFileHelper()
 {
     fileHandle = nullptr;
+    mappedFile = nullptr;
+    mappedData = nullptr;
     init();
 }
 
@@ -35,12 +38,14 @@ BinFileHelper::~BinFileHelper()
     qDeleteAll(fields);
     if (fileHandle)
         closeFile();
+    unmapFile();
 }
 
 void BinFileHelper::init()
 {
     if (fileHandle)
         fclose(fileHandle);
+    unmapFile();
 
     fileHandle      = nullptr;
     indexUpdated    = false;
@@ -87,6 +92,7 @@ FILE *BinFileHelper::openFile(const QString &fileName)
         errnum = ERR_FILEOPEN;
         return nullptr;
     }
+    filePath = FilePath;
     return fileHandle;
 }
 
@@ -279,6 +285,47 @@ void BinFileHelper::closeFile()
 {
     fclose(fileHandle);
     fileHandle = nullptr;
+    unmapFile();
+}
+
+bool BinFileHelper::mapFile()
+{
+    if (mappedData)
+        return true;
+
+    if (!fileHandle || !indexUpdated)
+        return false;
+
+    mappedFile = new QFile(filePath);
+    if (mappedFile->open(QIODevice::ReadOnly))
+        mappedData = mappedFile->map(0, mappedFile->size());
+
+    if (!mappedData)
+    {
+        unmapFile();
+        return false;
+    }
+
+    // Make sure that no index entry points past the end of the file, since records are not read through fread any more
+    for (int i = 0; i < indexOffset.size(); ++i)
+    {
+        if (indexOffset.at(i) + (qint64)indexCount.at(i) * recordSize > mappedFile->size())
+        {
+            errorMessage.sprintf("Index entry %d lies beyond the end of the file", i);
+            unmapFile();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BinFileHelper::unmapFile()
+{
+    // Closing the file releases its mapping
+    delete mappedFile;
+    mappedFile = nullptr;
+    mappedData = nullptr;
 }
 
 int BinFileHelper::getErrorNumber()
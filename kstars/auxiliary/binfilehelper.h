@@ -23,7 +23,9 @@
 #include <QVector>
 
 #include <cstdio>
+#include <cstring>
 
+class QFile;
 class QString;
 
 /**
@@ -37,6 +39,49 @@ typedef struct dataElement
     qint32 scale; /**< Field scale. The final field value = raw_value * scale */
 } dataElement;
 
+/**
+ *@class BinFileRecords
+ *@short A view of the consecutive records of a memory mapped binary file, without copying them
+ *
+ *Records are stored in the byte order of the file, and need not be aligned in memory,
+ *so they are accessed through copies returned by at().
+ */
+template <typename T>
+class BinFileRecords
+{
+  public:
+    BinFileRecords(const char *data = nullptr, quint32 count = 0) : data(data), count(count) {}
+
+    /**
+         *@return true if the records are available, false if the file is not mapped
+         */
+    inline bool isValid() const { return data != nullptr; }
+
+    /**
+         *@return Number of records in the view
+         */
+    inline quint32 size() const { return count; }
+
+    /**
+         *@return A copy of the i-th record, in the byte order of the file
+         */
+    inline T at(quint32 i) const
+    {
+        T record;
+        memcpy(&record, data + i * sizeof(T), sizeof(T));
+        return record;
+    }
+
+    /**
+         *@return Pointer to the first record
+         */
+    inline const char *constData() const { return data; }
+
+  private:
+    const char *data;
+    quint32 count;
+};
+
 /**
  *@class BinFileHelper
  *This class provides utility functions to handle binary data files in the format prescribed
@@ -90,6 +135,33 @@ class BinFileHelper
 
     void closeFile();
 
+    /**
+         *@short  Map the open file into memory, so that records can be accessed with getRecords()
+         *@note   To be called after readHeader(). The file handle remains usable, and the mapping is
+         *        released by closeFile().
+         *@return true if the file was mapped, false if records have to be read through the file handle
+         */
+    bool mapFile();
+
+    /**
+         *@return true if the file is mapped into memory
+         */
+    inline bool isMapped() const { return mappedData != nullptr; }
+
+    /**
+         *@short  Returns the records under the given index ID, read from the memory mapped file
+         *@param  id  ID of the index entry
+         *@return A view of the records, which is not valid if the file is not mapped, or if T does not
+         *        have the size of the records
+         */
+    template <typename T>
+    BinFileRecords<T> getRecords(int id) const
+    {
+        if (!mappedData || !indexUpdated || sizeof(T) != (size_t)recordSize)
+            return BinFileRecords<T>();
+        return BinFileRecords<T>(reinterpret_cast<const char *>(mappedData) + indexOffset.at(id), indexCount.at(id));
+    }
+
     /**
          *@short   Get error number
          *@return  A number corresponding to the error
@@ -269,7 +341,15 @@ class BinFileHelper
          */
     void init();
 
+    /**
+         *@short  Release the memory mapping of the file, if any
+         */
+    void unmapFile();
+
     FILE *fileHandle;                   // Handle to the file.
+    QString filePath;                   // Path of the open file
+    QFile *mappedFile;                  // The file mapped into memory, if any
+    uchar *mappedData;                  // Start of the memory mapped file
     QVector<unsigned long> indexOffset; // Stores offsets corresponding to each index table entry
     QVector<unsigned int> indexCount;   // Stores number of records under each index table entry
     bool indexUpdated;                  // True if the data from the index, and associated properties have been updated
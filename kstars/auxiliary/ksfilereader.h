@@ -116,6 +116,21 @@ class KSFileReader : public QObject, public QTextStream
         return QTextStream::readLine(m_maxLen);
     }
 
+    /** @short increments the line number and reads the next line from the
+         * file into line, reusing its memory when Qt allows it.
+         * @return false if there was no line to read
+         */
+    inline bool readLineInto(QString &line)
+    {
+        m_curLine++;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 5, 0)
+        return QTextStream::readLineInto(&line, m_maxLen);
+#else
+        line = QTextStream::readLine(m_maxLen);
+        return !line.isNull();
+#endif
+    }
+
     /** @short returns the current line number
          */
     int lineNumber() const { return m_curLine; }
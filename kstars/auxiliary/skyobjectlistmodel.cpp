@@ -31,14 +31,7 @@ QHash<int, QByteArray> SkyObjectListModel::roleNames() const
 
 int SkyObjectListModel::indexOf(QString objectName) const
 {
-    for (int i = 0; i < skyObjects.size(); ++i)
-    {
-        if (skyObjects[i].first == objectName)
-        {
-            return i;
-        }
-    }
-    return -1;
+    return rows.value(objectName, -1);
 }
 
 QVariant SkyObjectListModel::data(const QModelIndex &index, int role) const
@@ -76,5 +69,11 @@ void SkyObjectListModel::setSkyObjectsList(QVector<QPair<QString, const SkyObjec
     emit beginResetModel();
     skyObjects = sObjects;
 
+    rows.clear();
+    rows.reserve(skyObjects.size());
+    // Backwards, so that the first object of a name is kept
+    for (int i = skyObjects.size() - 1; i >= 0; --i)
+        rows.insert(skyObjects[i].first, i);
+
     emit endResetModel();
 }
@@ -48,7 +48,7 @@ class SkyObjectListModel : public QAbstractListModel
 
     /**
          * @return index of object from skyObjects with name objectName. -1 if object with such
-         * name was not found
+         * name was not found. Names are looked up in a hash that is built with the list.
          */
     int indexOf(QString objectName) const;
 
@@ -63,6 +63,8 @@ class SkyObjectListModel : public QAbstractListModel
 
   private:
     QVector<QPair<QString, const SkyObject *>> skyObjects;
+    // Row of the first object of each name
+    QHash<QString, int> rows;
 };
 
 #endif
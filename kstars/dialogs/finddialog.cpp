@@ -22,6 +22,7 @@
 #include "detaildialog.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/deepskyobject.h"
+#include "skycomponents/nameindex.h"
 #include "skycomponents/starcomponent.h"
 #include "skycomponents/syncedcatalogcomponent.h"
 #include "skycomponents/skymapcomposite.h"
@@ -179,74 +180,61 @@ void FindDialog::initSelection()
     listFiltered = true;
 }
 
-void FindDialog::filterByType()
+QList<int> FindDialog::filterTypes() const
 {
-    KStarsData *data = KStarsData::Instance();
-
     switch (ui->FilterType->currentIndex())
     {
-        case 0: // All object types
-        {
-            QVector<QPair<QString, const SkyObject *>> allObjects;
-            foreach (int type, data->skyComposite()->objectLists().keys())
-            {
-                allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
-            }
-            fModel->setSkyObjectsList(allObjects);
-            break;
-        }
         case 1: //Stars
-        {
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-            fModel->setSkyObjectsList(starObjects);
-            break;
-        }
+            return QList<int>() << SkyObject::STAR << SkyObject::CATALOG_STAR;
         case 2: //Solar system
-        {
-            QVector<QPair<QString, const SkyObject *>> ssObjects;
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::PLANET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::COMET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
-
-            fModel->setSkyObjectsList(ssObjects);
-            break;
-        }
+            return QList<int>() << SkyObject::PLANET << SkyObject::COMET << SkyObject::ASTEROID << SkyObject::MOON;
         case 3: //Open Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
-            break;
+            return QList<int>() << SkyObject::OPEN_CLUSTER;
         case 4: //Globular Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GLOBULAR_CLUSTER));
-            break;
+            return QList<int>() << SkyObject::GLOBULAR_CLUSTER;
         case 5: //Gaseous nebulae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GASEOUS_NEBULA));
-            break;
+            return QList<int>() << SkyObject::GASEOUS_NEBULA;
         case 6: //Planetary nebula
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::PLANETARY_NEBULA));
-            break;
+            return QList<int>() << SkyObject::PLANETARY_NEBULA;
         case 7: //Galaxies
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GALAXY));
-            break;
+            return QList<int>() << SkyObject::GALAXY;
         case 8: //Comets
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::COMET));
-            break;
+            return QList<int>() << SkyObject::COMET;
         case 9: //Asteroids
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            break;
+            return QList<int>() << SkyObject::ASTEROID;
         case 10: //Constellations
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::CONSTELLATION));
-            break;
+            return QList<int>() << SkyObject::CONSTELLATION;
         case 11: //Supernovae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SUPERNOVA));
-            break;
+            return QList<int>() << SkyObject::SUPERNOVA;
         case 12: //Satellites
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SATELLITE));
-            break;
+            return QList<int>() << SkyObject::SATELLITE;
+        default: // All object types
+            return QList<int>();
     }
 }
 
+void FindDialog::filterByType()
+{
+    SkyMapComposite *composite = KStarsData::Instance()->skyComposite();
+
+    // Typing in the search box does not change the list, only its filter
+    if (ui->FilterType->currentIndex() == m_ListedFilter && composite->nameIndex().revision() == m_ListedRevision)
+        return;
+
+    QList<int> types = filterTypes();
+    if (types.isEmpty())
+        types = composite->objectLists().keys();
+
+    QVector<QPair<QString, const SkyObject *>> objects;
+    foreach (int type, types)
+        objects.append(composite->objectLists(type));
+
+    fModel->setSkyObjectsList(objects);
+
+    m_ListedFilter   = ui->FilterType->currentIndex();
+    m_ListedRevision = composite->nameIndex().revision();
+}
+
 void FindDialog::filterList()
 {
     QString SearchText = processSearchText();
@@ -258,12 +246,12 @@ void FindDialog::filterList()
     //Select the first item in the list that begins with the filter string
     if (!SearchText.isEmpty())
     {
-        QStringList mItems = fModel->filter(QRegExp('^' + SearchText, Qt::CaseInsensitive));
-        mItems.sort();
+        QString firstName = KStarsData::Instance()->skyComposite()->nameIndex().firstStartingWith(SearchText,
+                                                                                                 filterTypes());
 
-        if (mItems.size())
+        if (!firstName.isEmpty())
         {
-            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0]));
+            QModelIndex qmi        = fModel->index(fModel->indexOf(firstName));
             QModelIndex selectItem = sortModel->mapFromSource(qmi);
 
             if (selectItem.isValid())
@@ -275,8 +263,8 @@ void FindDialog::filterList()
                 okB->setEnabled(true);
             }
         }
-        ui->InternetSearchButton->setEnabled(!mItems.contains(
-            SearchText)); // Disable searching the internet when an exact match for SearchText exists in KStars
+        // Disable searching the internet when an exact match for SearchText exists in KStars
+        ui->InternetSearchButton->setEnabled(firstName.compare(SearchText, Qt::CaseInsensitive) != 0);
     }
     else
         ui->InternetSearchButton->setEnabled(false);
@@ -118,10 +118,14 @@ class FindDialog : public QDialog
     void finishProcessing(SkyObject *selObj = 0, bool resolve = true);
 
     /** @short pre-filter the list of objects according to the
-         * selected object type.
+         * selected object type. The list is only rebuilt when the type
+         * or the names of the objects changed since it was last built.
          */
     void filterByType();
 
+    /** @return the types of the objects of the selected filter, or an empty list for all types */
+    QList<int> filterTypes() const;
+
     FindDialogUI *ui;
     SkyObjectListModel *fModel;
     QSortFilterProxyModel *sortModel;
@@ -129,6 +133,9 @@ class FindDialog : public QDialog
     bool listFiltered;
     QPushButton *okB;
     SkyObject *m_targetObject;
+    // Filter and revision of the name index of the listed objects
+    int m_ListedFilter    = -1;
+    uint m_ListedRevision = 0;
 };
 
 #endif
@@ -0,0 +1,163 @@
+/*  Ekos Captured Frames Index
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "capturedframes.h"
+
+#include "kstars.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+
+namespace
+{
+// Whether the base name of file, up to its first dot, starts with prefix
+bool hasPrefix(const QString &file, const QString &prefix)
+{
+    if (file.startsWith(prefix) == false)
+        return false;
+
+    int dot = file.indexOf('.');
+    return dot < 0 || dot >= prefix.length();
+}
+
+QString cleanPath(const QString &path)
+{
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+}
+
+namespace Ekos
+{
+CapturedFrames *CapturedFrames::_CapturedFrames = nullptr;
+
+CapturedFrames *CapturedFrames::Instance()
+{
+    if (_CapturedFrames == nullptr)
+        _CapturedFrames = new CapturedFrames(KStars::Instance());
+
+    return _CapturedFrames;
+}
+
+CapturedFrames::CapturedFrames(QObject *parent) : QObject(parent)
+{
+    connect(&watcher, SIGNAL(directoryChanged(QString)), this, SLOT(revalidate(QString)));
+}
+
+int CapturedFrames::count(const QString &directory, const QString &prefix)
+{
+    const QString path = cleanPath(directory);
+
+    QMutexLocker locker(&mutex);
+
+    auto entry = directories.find(path);
+
+    if (entry == directories.end() || entry->stale)
+    {
+        bool watched = (entry != directories.end());
+
+        // Other lookups go on while the directory is listed
+        locker.unlock();
+        bool exists      = QFileInfo(path).isDir();
+        Directory listed = exists ? list(path) : Directory();
+        locker.relock();
+
+        if (exists == false)
+        {
+            directories.remove(path);
+            return 0;
+        }
+
+        entry = directories.insert(path, listed);
+
+        // The watcher belongs to the GUI thread
+        if (watched == false)
+            QMetaObject::invokeMethod(this, "watch", Qt::QueuedConnection, Q_ARG(QString, path));
+    }
+
+    auto counted = entry->counts.constFind(prefix);
+    if (counted != entry->counts.constEnd())
+        return counted.value();
+
+    // File names that start with prefix follow each other in the sorted list
+    int frames = 0;
+    for (auto name = std::lower_bound(entry->names.constBegin(), entry->names.constEnd(), prefix);
+         name != entry->names.constEnd() && name->startsWith(prefix); ++name)
+    {
+        if (hasPrefix(*name, prefix))
+            frames++;
+    }
+
+    entry->counts.insert(prefix, frames);
+    return frames;
+}
+
+void CapturedFrames::addFrame(const QString &filename)
+{
+    QFileInfo info(filename);
+    const QString path = cleanPath(info.absolutePath());
+    const QString name = info.fileName();
+    QDateTime modified = QFileInfo(path).lastModified();
+
+    QMutexLocker locker(&mutex);
+
+    auto entry = directories.find(path);
+
+    // Directories that were never counted are listed when they are
+    if (entry == directories.end() || entry->stale)
+        return;
+
+    // The change of the directory comes from this frame, there is no need to list it again
+    entry->modified = modified;
+
+    auto position = std::lower_bound(entry->names.begin(), entry->names.end(), name);
+    if (position != entry->names.end() && *position == name)
+        return;
+
+    entry->names.insert(position, name);
+
+    for (auto counted = entry->counts.begin(); counted != entry->counts.end(); ++counted)
+    {
+        if (hasPrefix(name, counted.key()))
+            counted.value()++;
+    }
+}
+
+void CapturedFrames::watch(const QString &path)
+{
+    if (watcher.directories().contains(path) == false)
+        watcher.addPath(path);
+}
+
+void CapturedFrames::revalidate(const QString &path)
+{
+    QDateTime modified = QFileInfo(path).lastModified();
+
+    QMutexLocker locker(&mutex);
+
+    auto entry = directories.find(path);
+    if (entry != directories.end() && entry->modified != modified)
+        entry->stale = true;
+}
+
+CapturedFrames::Directory CapturedFrames::list(const QString &path)
+{
+    Directory directory;
+    QDir dir(path);
+
+    directory.modified = QFileInfo(path).lastModified();
+    directory.names    = dir.entryList(QDir::Files, QDir::NoSort);
+    directory.stale    = false;
+
+    std::sort(directory.names.begin(), directory.names.end());
+
+    return directory;
+}
+}
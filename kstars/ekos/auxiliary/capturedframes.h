@@ -0,0 +1,79 @@
+/*  Ekos Captured Frames Index
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+
+namespace Ekos
+{
+/**
+ *@class CapturedFrames
+ *@short Index of the frames in the capture directories, to count the frames of a sequence without listing its
+ * directory.
+ *
+ * A directory is listed the first time its frames are counted. It is then kept up to date with the frames that Capture
+ * saves, and listed again only after a change that did not come from Capture, which the index learns about from a file
+ * system watcher. The count of frames for a given prefix is kept until the directory changes. Counting may be called
+ * from any thread, everything else happens on the GUI thread.
+ *
+ *@author agent
+ *@version 1.0
+ */
+class CapturedFrames : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static CapturedFrames *Instance();
+
+    explicit CapturedFrames(QObject *parent = nullptr);
+
+    /**
+     * @brief count Count the frames of a sequence
+     * @param directory Directory the frames are saved to
+     * @param prefix Prefix of the sequence
+     * @return Number of files in the directory whose base name, up to the first dot, starts with prefix
+     */
+    int count(const QString &directory, const QString &prefix);
+
+  public slots:
+    /**
+     * @brief addFrame Record a frame that was just saved
+     * @param filename Full path of the frame
+     */
+    void addFrame(const QString &filename);
+
+  private slots:
+    void watch(const QString &path);
+    void revalidate(const QString &path);
+
+  private:
+    typedef struct
+    {
+        QStringList names;          // File names, sorted
+        QDateTime modified;         // Modification time of the directory when names were last updated
+        QHash<QString, int> counts; // Files for each prefix counted so far
+        bool stale;                 // Changed by something else than Capture since it was listed
+    } Directory;
+
+    static CapturedFrames *_CapturedFrames;
+
+    static Directory list(const QString &path);
+
+    QHash<QString, Directory> directories;
+    QMutex mutex;
+    QFileSystemWatcher watcher;
+};
+}
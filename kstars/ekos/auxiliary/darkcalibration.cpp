@@ -0,0 +1,322 @@
+/*  Ekos Dark Calibration
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "darkcalibration.h"
+
+#include "fitsviewer/fitsdata.h"
+
+#include <QSharedPointer>
+#include <QVarLengthArray>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// Pixels stacked by each task
+#define STACK_BAND_SIZE (64 * 1024)
+
+// Pixels sampled to estimate the noise of a dark
+#define NOISE_SAMPLES 100000
+
+// Standard deviation of normally distributed values from their median absolute deviation
+#define MAD_TO_SIGMA 1.4826
+
+namespace
+{
+template <typename T>
+inline T toPixel(double value)
+{
+    if (std::is_integral<T>::value)
+    {
+        return static_cast<T>(qBound<double>(std::numeric_limits<T>::lowest(), std::round(value),
+                                             std::numeric_limits<T>::max()));
+    }
+
+    return static_cast<T>(value);
+}
+
+// Median of values, which are reordered
+template <typename V>
+double median(V &values)
+{
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+
+    if (values.size() % 2)
+        return *middle;
+
+    // The lower middle value is the largest of the lower half
+    return (*middle + *std::max_element(values.begin(), middle)) / 2.0;
+}
+
+// Median and standard deviation estimated from the median absolute deviation, values are overwritten
+template <typename V>
+void robustStats(V &values, double &center, double &sigma)
+{
+    center = median(values);
+
+    for (auto &value : values)
+        value = std::fabs(value - center);
+
+    sigma = MAD_TO_SIGMA * median(values);
+}
+}
+
+namespace Ekos
+{
+namespace DarkCalibration
+{
+template <typename T>
+QFuture<void> stack(const QVector<const T *> &frames, uint32_t size, StackingMethod method, T *master)
+{
+    // The bands are held by the functor, which lives as long as the stacking
+    QSharedPointer<QVector<uint32_t>> bands(new QVector<uint32_t>());
+    for (uint32_t first = 0; first < size; first += STACK_BAND_SIZE)
+        bands->append(first);
+
+    return QtConcurrent::map(bands->begin(), bands->end(), [bands, frames, size, method, master](uint32_t first) {
+        QVarLengthArray<double, 64> values(frames.count()), deviations(frames.count());
+        const uint32_t last = qMin<uint32_t>(first + STACK_BAND_SIZE, size);
+
+        for (uint32_t i = first; i < last; i++)
+        {
+            for (int frame = 0; frame < frames.count(); frame++)
+                values[frame] = frames[frame][i];
+
+            if (method == STACK_MEDIAN)
+            {
+                master[i] = toPixel<T>(median(values));
+                continue;
+            }
+
+            double center, sigma;
+            deviations = values;
+            robustStats(deviations, center, sigma);
+
+            double sum = 0;
+            int count  = 0;
+
+            for (double value : values)
+            {
+                if (std::fabs(value - center) <= CLIP_SIGMA * sigma)
+                {
+                    sum += value;
+                    count++;
+                }
+            }
+
+            // The median is always kept, so count is never zero
+            master[i] = toPixel<T>(sum / count);
+        }
+    });
+}
+
+template <typename T>
+QVector<uint32_t> findHotPixels(const T *dark, uint32_t size)
+{
+    QVector<uint32_t> hotPixels;
+
+    if (size == 0)
+        return hotPixels;
+
+    const uint32_t step = qMax<uint32_t>(1, size / NOISE_SAMPLES);
+    QVector<double> samples;
+
+    for (uint32_t i = 0; i < size; i += step)
+        samples.append(dark[i]);
+
+    double center, sigma;
+    robustStats(samples, center, sigma);
+
+    // Half of the pixels of a flat integer dark share the median, so its MAD is 0
+    if (std::is_integral<T>::value)
+        sigma = std::max(sigma, 1.0);
+
+    const double threshold      = center + HOT_PIXEL_SIGMA * sigma;
+    const uint32_t maxHotPixels = static_cast<uint32_t>(size * MAX_HOT_PIXEL_FRACTION);
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        if (dark[i] > threshold)
+        {
+            if (static_cast<uint32_t>(hotPixels.size()) >= maxHotPixels)
+                return QVector<uint32_t>();
+
+            hotPixels.append(i);
+        }
+    }
+
+    return hotPixels;
+}
+
+template <typename T>
+void subtract(const T *dark, uint16_t darkWidth, uint16_t offsetX, uint16_t offsetY, T *light, uint16_t lightWidth,
+              uint16_t lightHeight)
+{
+    const T *darkRow = dark + offsetX + offsetY * darkWidth;
+
+    for (int row = 0; row < lightHeight; row++)
+    {
+        T *lightRow = light + row * lightWidth;
+
+        // Pixels darker than the dark become 0
+        for (int column = 0; column < lightWidth; column++)
+            lightRow[column] -= std::min(lightRow[column], darkRow[column]);
+
+        darkRow += darkWidth;
+    }
+}
+
+template <typename T>
+void removeHotPixels(const QVector<uint32_t> &hotPixels, uint16_t darkWidth, uint16_t offsetX, uint16_t offsetY,
+                     T *light, uint16_t lightWidth, uint16_t lightHeight)
+{
+    for (uint32_t hotPixel : hotPixels)
+    {
+        int x = static_cast<int>(hotPixel % darkWidth) - offsetX;
+        int y = static_cast<int>(hotPixel / darkWidth) - offsetY;
+
+        if (x < 0 || y < 0 || x >= lightWidth || y >= lightHeight)
+            continue;
+
+        const int neighbours[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+        double sum                 = 0;
+        int count                  = 0;
+
+        for (const auto &neighbour : neighbours)
+        {
+            int nx = x + neighbour[0], ny = y + neighbour[1];
+
+            if (nx < 0 || ny < 0 || nx >= lightWidth || ny >= lightHeight)
+                continue;
+
+            sum += light[ny * lightWidth + nx];
+            count++;
+        }
+
+        if (count > 0)
+            light[y * lightWidth + x] = toPixel<T>(sum / count);
+    }
+}
+
+namespace
+{
+template <typename T>
+QFuture<void> stackFrames(const QList<FITSData *> &frames, StackingMethod method)
+{
+    QVector<const T *> buffers;
+    for (FITSData *frame : frames)
+        buffers.append(reinterpret_cast<const T *>(frame->getImageBuffer()));
+
+    return stack<T>(buffers, frames.first()->getSize(), method, reinterpret_cast<T *>(frames.first()->getImageBuffer()));
+}
+
+template <typename T>
+QVector<uint32_t> findHotPixelsOf(FITSData *dark)
+{
+    return findHotPixels<T>(reinterpret_cast<const T *>(dark->getImageBuffer()), dark->getSize());
+}
+}
+
+QFuture<void> stack(const QList<FITSData *> &frames, StackingMethod method)
+{
+    if (frames.isEmpty())
+        return QFuture<void>();
+
+    FITSData *master = frames.first();
+
+    for (FITSData *frame : frames)
+    {
+        if (frame->getDataType() != master->getDataType() || frame->getWidth() != master->getWidth() ||
+            frame->getHeight() != master->getHeight())
+            return QFuture<void>();
+    }
+
+    switch (master->getDataType())
+    {
+        case TBYTE:
+            return stackFrames<uint8_t>(frames, method);
+
+        case TSHORT:
+            return stackFrames<int16_t>(frames, method);
+
+        case TUSHORT:
+            return stackFrames<uint16_t>(frames, method);
+
+        case TLONG:
+            return stackFrames<int32_t>(frames, method);
+
+        case TULONG:
+            return stackFrames<uint32_t>(frames, method);
+
+        case TFLOAT:
+            return stackFrames<float>(frames, method);
+
+        case TLONGLONG:
+            return stackFrames<int64_t>(frames, method);
+
+        case TDOUBLE:
+            return stackFrames<double>(frames, method);
+
+        default:
+            return QFuture<void>();
+    }
+}
+
+QVector<uint32_t> findHotPixels(FITSData *dark)
+{
+    switch (dark->getDataType())
+    {
+        case TBYTE:
+            return findHotPixelsOf<uint8_t>(dark);
+
+        case TSHORT:
+            return findHotPixelsOf<int16_t>(dark);
+
+        case TUSHORT:
+            return findHotPixelsOf<uint16_t>(dark);
+
+        case TLONG:
+            return findHotPixelsOf<int32_t>(dark);
+
+        case TULONG:
+            return findHotPixelsOf<uint32_t>(dark);
+
+        case TFLOAT:
+            return findHotPixelsOf<float>(dark);
+
+        case TLONGLONG:
+            return findHotPixelsOf<int64_t>(dark);
+
+        case TDOUBLE:
+            return findHotPixelsOf<double>(dark);
+
+        default:
+            return QVector<uint32_t>();
+    }
+}
+
+#define INSTANTIATE(T)                                                                                                \
+    template QFuture<void> stack<T>(const QVector<const T *> &, uint32_t, StackingMethod, T *);                       \
+    template QVector<uint32_t> findHotPixels<T>(const T *, uint32_t);                                                 \
+    template void subtract<T>(const T *, uint16_t, uint16_t, uint16_t, T *, uint16_t, uint16_t);                      \
+    template void removeHotPixels<T>(const QVector<uint32_t> &, uint16_t, uint16_t, uint16_t, T *, uint16_t, uint16_t);
+
+INSTANTIATE(uint8_t)
+INSTANTIATE(int16_t)
+INSTANTIATE(uint16_t)
+INSTANTIATE(int32_t)
+INSTANTIATE(uint32_t)
+INSTANTIATE(float)
+INSTANTIATE(int64_t)
+INSTANTIATE(double)
+}
+}
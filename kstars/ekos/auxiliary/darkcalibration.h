@@ -0,0 +1,95 @@
+/*  Ekos Dark Calibration
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QList>
+#include <QVector>
+
+#include <cstdint>
+
+class FITSData;
+
+namespace Ekos
+{
+/**
+ * @namespace DarkCalibration
+ * @short Pixel kernels of the dark library: stacking of master darks, hot pixel maps and dark subtraction.
+ *
+ * Frames are stacked pixel by pixel, in bands of pixels that are processed concurrently in the background. Hot pixels are
+ * the pixels of a dark that stand well above its noise, which is estimated from the median absolute deviation of an
+ * evenly strided sample. Subtraction clamps at zero without branching so that the compiler can vectorize it.
+ */
+namespace DarkCalibration
+{
+typedef enum
+{
+    STACK_MEDIAN,
+    STACK_SIGMA_CLIP
+} StackingMethod;
+
+/** Pixels further than this many standard deviations from the median of their stack are rejected by sigma clipping */
+const double CLIP_SIGMA = 3.0;
+
+/** Pixels of a dark this many standard deviations above its median are hot */
+const double HOT_PIXEL_SIGMA = 10.0;
+
+/** Largest fraction of the pixels of a dark that may be hot. Beyond it the noise estimate is wrong and none is kept. */
+const double MAX_HOT_PIXEL_FRACTION = 0.001;
+
+/**
+ * @brief stack Start combining frames of the same size pixel by pixel into master, in the background
+ * @param frames Buffers of the frames, which must be kept until the stacking is finished
+ * @param size Number of pixels of each frame
+ * @param method STACK_MEDIAN keeps the median of each pixel. STACK_SIGMA_CLIP averages the values of each pixel within
+ * CLIP_SIGMA standard deviations of their median, which is less noisy but needs more frames to reject outliers.
+ * @param master Buffer of size pixels to store the result, it may be one of the frames
+ * @return The future of the stacking
+ */
+template <typename T>
+QFuture<void> stack(const QVector<const T *> &frames, uint32_t size, StackingMethod method, T *master);
+
+/**
+ * @brief findHotPixels Find the hot pixels of a dark frame. The noise of integer frames is at least 1 ADU, so that a
+ * flat dark does not turn its quantization noise into hot pixels.
+ * @return Indexes of the hot pixels in the buffer, in increasing order. Empty if more than MAX_HOT_PIXEL_FRACTION of
+ * the pixels would be hot.
+ */
+template <typename T>
+QVector<uint32_t> findHotPixels(const T *dark, uint32_t size);
+
+/**
+ * @brief subtract Subtract dark from light, clamping at zero
+ * @param offsetX Column of the dark where the light frame starts, if it is a subframe
+ * @param offsetY Row of the dark where the light frame starts, if it is a subframe
+ */
+template <typename T>
+void subtract(const T *dark, uint16_t darkWidth, uint16_t offsetX, uint16_t offsetY, T *light, uint16_t lightWidth,
+              uint16_t lightHeight);
+
+/**
+ * @brief removeHotPixels Replace the hot pixels of a dark in light by the average of their neighbours
+ * @param hotPixels Hot pixels of the dark, as found by findHotPixels()
+ */
+template <typename T>
+void removeHotPixels(const QVector<uint32_t> &hotPixels, uint16_t darkWidth, uint16_t offsetX, uint16_t offsetY,
+                     T *light, uint16_t lightWidth, uint16_t lightHeight);
+
+/**
+ * @brief stack Start stacking the first channel of frames into the first one, in the background. All frames must have
+ * the same size and type, and must be kept until the stacking is finished.
+ * @return The future of the stacking, which is canceled if the frames cannot be stacked
+ */
+QFuture<void> stack(const QList<FITSData *> &frames, StackingMethod method);
+
+/** @brief findHotPixels Find the hot pixels of the first channel of dark */
+QVector<uint32_t> findHotPixels(FITSData *dark);
+}
+}
@@ -19,6 +19,15 @@
 #include "fitsviewer/fitsdata.h"
 #include "auxiliary/ksuserdb.h"
 
+namespace
+{
+// Memory held by the image buffer of a dark
+qint64 memorySize(FITSData *darkData)
+{
+    return static_cast<qint64>(darkData->getSize()) * darkData->getNumOfChannels() * darkData->getBytesPerPixel();
+}
+}
+
 namespace Ekos
 {
 DarkLibrary *DarkLibrary::_DarkLibrary = nullptr;
@@ -41,13 +50,20 @@ DarkLibrary::DarkLibrary(QObject *parent) : QObject(parent)
     subtractParams.targetChip  = 0;
     subtractParams.targetImage = 0;
 
+    connect(&stackWatcher, SIGNAL(finished()), this, SLOT(masterDarkStacked()));
+
     QDir writableDir;
     writableDir.mkdir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "darks");
 }
 
 DarkLibrary::~DarkLibrary()
 {
-    qDeleteAll(darkFiles);
+    foreach (const DarkFile &darkFile, darkFiles)
+        delete darkFile.data;
+
+    stackWatcher.cancel();
+    stackWatcher.waitForFinished();
+    qDeleteAll(masterFrames);
 }
 
 void DarkLibrary::refreshFromDB()
@@ -94,17 +110,21 @@ FITSData *DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration)
                     QString filename = map["filename"].toString();
 
                     if (darkFiles.contains(filename))
-                        return darkFiles[filename];
+                    {
+                        // It is now the most recently used
+                        darkFilesUsage.removeOne(filename);
+                        darkFilesUsage.append(filename);
+                        return darkFiles[filename].data;
+                    }
 
                     // Finally we made it, let's put it in the hash
                     bool rc = loadDarkFile(filename);
                     if (rc)
-                        return darkFiles[filename];
+                        return darkFiles[filename].data;
                     else
                     {
                         // Remove bad dark frame
                         emit newLog(i18n("Removing bad dark frame file %1", filename));
-                        darkFiles.remove(filename);
                         QFile::remove(filename);
                         KStarsData::Instance()->userdb()->DeleteDarkFrame(filename);
                         return nullptr;
@@ -124,7 +144,7 @@ bool DarkLibrary::loadDarkFile(const QString &filename)
     bool rc = darkData->loadFITS(filename);
 
     if (rc)
-        darkFiles[filename] = darkData;
+        cacheDarkFile(filename, darkData);
     else
     {
         emit newLog(i18n("Failed to load dark frame file %1", filename));
@@ -148,7 +168,7 @@ bool DarkLibrary::saveDarkFile(FITSData *darkData)
         return false;
     }
 
-    darkFiles[path] = darkData;
+    cacheDarkFile(path, darkData);
 
     QVariantMap map;
     int binX, binY;
@@ -174,44 +194,96 @@ bool DarkLibrary::saveDarkFile(FITSData *darkData)
     return true;
 }
 
+void DarkLibrary::cacheDarkFile(const QString &filename, FITSData *darkData)
+{
+    releaseDarkFile(filename);
+
+    DarkFile darkFile;
+    darkFile.data           = darkData;
+    darkFile.hotPixelsFound = false;
+
+    darkFiles[filename] = darkFile;
+    darkFilesUsage.append(filename);
+    darkFilesSize += memorySize(darkData);
+
+    // The dark that was just cached is kept even if it exceeds the budget on its own
+    const qint64 budget = static_cast<qint64>(Options::darkLibraryCacheSize()) * 1024 * 1024;
+
+    while (darkFilesSize > budget && darkFilesUsage.count() > 1)
+        releaseDarkFile(darkFilesUsage.first());
+}
+
+void DarkLibrary::releaseDarkFile(const QString &filename)
+{
+    if (darkFiles.contains(filename) == false)
+        return;
+
+    DarkFile darkFile = darkFiles.take(filename);
+
+    darkFilesUsage.removeOne(filename);
+    darkFilesSize -= memorySize(darkFile.data);
+
+    delete darkFile.data;
+}
+
 bool DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
                            uint16_t offsetY)
 {
     Q_ASSERT(darkData);
     Q_ASSERT(lightImage);
 
+    QVector<uint32_t> hotPixels;
+
+    // Removing hot pixels alters the light frame beyond the dark, so it is only done on request
+    if (Options::darkLibraryRemoveHotPixels())
+    {
+        for (auto darkFile = darkFiles.begin(); darkFile != darkFiles.end(); ++darkFile)
+        {
+            if (darkFile->data != darkData)
+                continue;
+
+            if (darkFile->hotPixelsFound == false)
+            {
+                darkFile->hotPixels      = DarkCalibration::findHotPixels(darkData);
+                darkFile->hotPixelsFound = true;
+            }
+
+            hotPixels = darkFile->hotPixels;
+        }
+    }
+
     switch (darkData->getDataType())
     {
         case TBYTE:
-            return subtract<uint8_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<uint8_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TSHORT:
-            return subtract<int16_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<int16_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TUSHORT:
-            return subtract<uint16_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<uint16_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TLONG:
-            return subtract<int32_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<int32_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TULONG:
-            return subtract<uint32_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<uint32_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TFLOAT:
-            return subtract<float>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<float>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TLONGLONG:
-            return subtract<int64_t>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<int64_t>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         case TDOUBLE:
-            return subtract<double>(darkData, lightImage, filter, offsetX, offsetY);
+            return subtract<double>(darkData, hotPixels, lightImage, filter, offsetX, offsetY);
             break;
 
         default:
@@ -222,34 +294,20 @@ bool DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale f
 }
 
 template <typename T>
-bool DarkLibrary::subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX,
-                           uint16_t offsetY)
+bool DarkLibrary::subtract(FITSData *darkData, const QVector<uint32_t> &hotPixels, FITSView *lightImage,
+                           FITSScale filter, uint16_t offsetX, uint16_t offsetY)
 {
     FITSData *lightData = lightImage->getImageData();
 
     T *darkBuffer  = reinterpret_cast<T *>(darkData->getImageBuffer());
     T *lightBuffer = reinterpret_cast<T *>(lightData->getImageBuffer());
 
-    int darkoffset = offsetX + offsetY * darkData->getWidth();
-    int darkW      = darkData->getWidth();
+    int darkW  = darkData->getWidth();
+    int lightW = lightData->getWidth();
+    int lightH = lightData->getHeight();
 
-    int lightOffset = 0;
-    int lightW      = lightData->getWidth();
-    int lightH      = lightData->getHeight();
-
-    for (int i = 0; i < lightH; i++)
-    {
-        for (int j = 0; j < lightW; j++)
-        {
-            if (lightBuffer[j + lightOffset] > darkBuffer[j + darkoffset])
-                lightBuffer[j + lightOffset] -= darkBuffer[j + darkoffset];
-            else
-                lightBuffer[j + lightOffset] = 0;
-        }
-
-        lightOffset += lightW;
-        darkoffset += darkW;
-    }
+    DarkCalibration::subtract<T>(darkBuffer, darkW, offsetX, offsetY, lightBuffer, lightW, lightH);
+    DarkCalibration::removeHotPixels<T>(hotPixels, darkW, offsetX, offsetY, lightBuffer, lightW, lightH);
 
     lightData->applyFilter(filter);
     if (filter == FITS_NONE)
@@ -316,9 +374,18 @@ bool DarkLibrary::captureAndSubtract(ISD::CCDChip *targetChip, FITSView *targetI
     subtractParams.offsetX     = offsetX;
     subtractParams.offsetY     = offsetY;
 
+    // A master dark that is still being stacked is dropped
+    stackWatcher.cancel();
+    stackWatcher.waitForFinished();
+    qDeleteAll(masterFrames);
+    masterFrames.clear();
+
     connect(targetChip->getCCD(), SIGNAL(BLOBUpdated(IBLOB *)), this, SLOT(newFITS(IBLOB *)));
 
-    emit newLog(i18n("Capturing dark frame..."));
+    if (Options::darkLibraryFrames() > 1)
+        emit newLog(i18n("Capturing %1 dark frames...", Options::darkLibraryFrames()));
+    else
+        emit newLog(i18n("Capturing dark frame..."));
 
     targetChip->capture(duration);
 
@@ -340,16 +407,67 @@ void DarkLibrary::newFITS(IBLOB *bp)
     FITSData *calibrationData = new FITSData();
 
     // Deep copy of the data
-    if (calibrationData->loadFITS(calibrationView->getImageData()->getFilename()))
-    {
-        saveDarkFile(calibrationData);
-        subtract(calibrationData, subtractParams.targetImage, subtractParams.targetChip->getCaptureFilter(),
-                 subtractParams.offsetX, subtractParams.offsetY);
-    }
-    else
+    if (calibrationData->loadFITS(calibrationView->getImageData()->getFilename()) == false)
     {
+        delete calibrationData;
+        qDeleteAll(masterFrames);
+        masterFrames.clear();
+
         emit darkFrameCompleted(false);
         emit newLog(i18n("Warning: Cannot load calibration file %1", calibrationView->getImageData()->getFilename()));
+        return;
+    }
+
+    masterFrames.append(calibrationData);
+
+    // Capture the remaining frames of the master dark
+    if (masterFrames.count() < static_cast<int>(Options::darkLibraryFrames()))
+    {
+        connect(subtractParams.targetChip->getCCD(), SIGNAL(BLOBUpdated(IBLOB *)), this, SLOT(newFITS(IBLOB *)));
+        subtractParams.targetChip->capture(subtractParams.duration);
+        return;
+    }
+
+    // The master dark replaces the first frame
+    if (masterFrames.count() > 1)
+    {
+        emit newLog(i18n("Stacking %1 dark frames...", masterFrames.count()));
+
+        QFuture<void> stacking = DarkCalibration::stack(
+            masterFrames, static_cast<DarkCalibration::StackingMethod>(Options::darkLibraryStackingMethod()));
+
+        if (stacking.isCanceled() == false)
+        {
+            stackWatcher.setFuture(stacking);
+            return;
+        }
+
+        emit newLog(i18n("Warning: Dark frames differ, only the first one is used."));
     }
+
+    processMasterDark();
+}
+
+void DarkLibrary::masterDarkStacked()
+{
+    // The frames were dropped for a new capture
+    if (stackWatcher.isCanceled() || masterFrames.isEmpty())
+        return;
+
+    masterFrames.first()->calculateStats(true);
+
+    processMasterDark();
+}
+
+void DarkLibrary::processMasterDark()
+{
+    FITSData *calibrationData = masterFrames.first();
+
+    qDeleteAll(masterFrames.mid(1));
+    masterFrames.clear();
+
+    saveDarkFile(calibrationData);
+    subtract(calibrationData, subtractParams.targetImage, subtractParams.targetChip->getCaptureFilter(),
+             subtractParams.offsetX, subtractParams.offsetY);
 }
 }
@@ -10,7 +10,9 @@
 #ifndef DARKLIBRARY_H
 #define DARKLIBRARY_H
 
+#include <QFutureWatcher>
 #include <QObject>
+#include "darkcalibration.h"
 #include "indi/indiccd.h"
 
 namespace Ekos
@@ -19,6 +21,10 @@ namespace Ekos
  *@class DarkLibrary
  *@short Handles aquisition & loading of dark frames for cameras. If a suitable dark frame exists, it is loaded from disk, otherwise it gets captured and saved
  * for later use.
+ *
+ * A new dark is the master of several dark frames when the library is configured so, which are stacked in the
+ * background. Darks in memory are kept with their hot pixels, which are only removed from light frames when the library
+ * is configured so, and the least recently used ones are released once they exceed the memory budget of the library.
  *@author Jasem Mutlaq
  *@version 1.0
  */
@@ -47,6 +53,9 @@ class DarkLibrary : public QObject
          */
     void newFITS(IBLOB *bp);
 
+  private slots:
+    void masterDarkStacked();
+
   private:
     DarkLibrary(QObject *parent);
     ~DarkLibrary();
@@ -55,11 +64,34 @@ class DarkLibrary : public QObject
     bool loadDarkFile(const QString &filename);
     bool saveDarkFile(FITSData *darkData);
 
+    // Keep darkData in memory, and release the least recently used darks beyond the memory budget
+    void cacheDarkFile(const QString &filename, FITSData *darkData);
+    void releaseDarkFile(const QString &filename);
+
+    // Save the master dark, which replaces the first of masterFrames, and subtract it
+    void processMasterDark();
+
     template <typename T>
-    bool subtract(FITSData *darkData, FITSView *lightImage, FITSScale filter, uint16_t offsetX, uint16_t offsetY);
+    bool subtract(FITSData *darkData, const QVector<uint32_t> &hotPixels, FITSView *lightImage, FITSScale filter,
+                  uint16_t offsetX, uint16_t offsetY);
+
+    // A dark in memory, with its hot pixels once they are needed
+    typedef struct
+    {
+        FITSData *data;
+        QVector<uint32_t> hotPixels;
+        bool hotPixelsFound;
+    } DarkFile;
 
     QList<QVariantMap> darkFrames;
-    QHash<QString, FITSData *> darkFiles;
+    QHash<QString, DarkFile> darkFiles;
+    // Least recently used first
+    QStringList darkFilesUsage;
+    qint64 darkFilesSize = 0;
+
+    // Frames captured so far for the next master dark
+    QList<FITSData *> masterFrames;
+    QFutureWatcher<void> stackWatcher;
 
     struct
     {
@@ -38,6 +38,7 @@
 #include "fitsviewer/fitsviewer.h"
 #include "fitsviewer/fitsview.h"
 
+#include "ekos/auxiliary/capturedframes.h"
 #include "ekos/auxiliary/darklibrary.h"
 #include "ekos/ekosmanager.h"
 #include "captureadaptor.h"
@@ -571,6 +572,7 @@ void Capture::checkCCD(int ccdNum)
                    SLOT(processCCDNumber(INumberVectorProperty *)));
         disconnect(ccd, SIGNAL(newTemperatureValue(double)), this, SLOT(updateCCDTemperature(double)));
         disconnect(ccd, SIGNAL(newRemoteFile(QString)), this, SLOT(setNewRemoteFile(QString)));
+        disconnect(ccd, SIGNAL(newLocalFile(QString)), CapturedFrames::Instance(), SLOT(addFrame(QString)));
         disconnect(ccd, SIGNAL(videoStreamToggled(bool)), this, SLOT(setVideoStreamEnabled(bool)));
     }
 
@@ -711,6 +713,7 @@ void Capture::checkCCD(int ccdNum)
         connect(currentCCD, SIGNAL(newTemperatureValue(double)), this, SLOT(updateCCDTemperature(double)),
                 Qt::UniqueConnection);
         connect(currentCCD, SIGNAL(newRemoteFile(QString)), this, SLOT(setNewRemoteFile(QString)));
+        connect(currentCCD, SIGNAL(newLocalFile(QString)), CapturedFrames::Instance(), SLOT(addFrame(QString)));
         connect(currentCCD, SIGNAL(videoStreamToggled(bool)), this, SLOT(setVideoStreamEnabled(bool)));
     }
 }
@@ -13,6 +13,7 @@
 
 #include "gmath.h"
 
+#include <algorithm>
 #include <math.h>
 #include <string.h>
 
@@ -100,10 +101,7 @@ cgmath::~cgmath()
     delete[] drift[GUIDE_RA];
     delete[] drift[GUIDE_DEC];
 
-    foreach (float *region, referenceRegions)
-        delete[] region;
-
-    referenceRegions.clear();
+    freeRegions();
 }
 
 bool cgmath::setVideoParameters(int vid_wd, int vid_ht, int binX, int binY)
@@ -497,12 +495,7 @@ void cgmath::start(void)
     // Create reference Image
     if (imageGuideEnabled)
     {
-        foreach (float *region, referenceRegions)
-            delete[] region;
-
-        referenceRegions.clear();
-
-        referenceRegions = partitionImage();
+        correlator.setReference(partitionImage() ? regions : QVector<float *>(), regionAxis);
 
         reticle_pos = Vector(0, 0, 0);
     }
@@ -533,146 +526,105 @@ void cgmath::setLostStar(bool is_lost)
     lost_star = is_lost;
 }
 
-float *cgmath::createFloatImage() const
+bool cgmath::partitionImage() const
 {
     FITSData *imageData = guideView->getImageData();
 
-    // #1 Convert to float array
-    // We only process 1st plane if it is a color image
-    uint32_t imgSize = imageData->getSize();
-    float *imgFloat  = new float[imgSize];
-    if (imgFloat == nullptr)
+    const uint32_t width  = imageData->getWidth();
+    const uint32_t height = imageData->getHeight();
+
+    uint8_t xRegions = floor(width / regionAxis);
+    uint8_t yRegions = floor(height / regionAxis);
+
+    // Reuse the regions of the previous frame
+    if (regions.count() != xRegions * yRegions)
     {
-        qCritical() << "Not enough memory for float image array!";
-        return nullptr;
+        foreach (float *region, regions)
+            ImageAutoGuiding::Correlator::freeRegion(region);
+
+        regions.clear();
+
+        for (int i = 0; i < xRegions * yRegions; i++)
+            regions.append(ImageAutoGuiding::Correlator::allocateRegion(regionAxis));
     }
 
+    // We only process 1st plane if it is a color image
     switch (imageData->getDataType())
     {
         case TBYTE:
-        {
-            uint8_t *buffer = imageData->getImageBuffer();
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(imageData->getImageBuffer());
+            break;
 
         case TSHORT:
-        {
-            int16_t *buffer = reinterpret_cast<int16_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<int16_t *>(imageData->getImageBuffer()));
+            break;
 
         case TUSHORT:
-        {
-            uint16_t *buffer = reinterpret_cast<uint16_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<uint16_t *>(imageData->getImageBuffer()));
+            break;
 
         case TLONG:
-        {
-            int32_t *buffer = reinterpret_cast<int32_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<int32_t *>(imageData->getImageBuffer()));
+            break;
 
         case TULONG:
-        {
-            uint32_t *buffer = reinterpret_cast<uint32_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<uint32_t *>(imageData->getImageBuffer()));
+            break;
 
         case TFLOAT:
-        {
-            float *buffer = reinterpret_cast<float *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<float *>(imageData->getImageBuffer()));
+            break;
 
         case TLONGLONG:
-        {
-            int64_t *buffer = reinterpret_cast<int64_t *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<int64_t *>(imageData->getImageBuffer()));
+            break;
 
         case TDOUBLE:
-        {
-            double *buffer = reinterpret_cast<double *>(imageData->getImageBuffer());
-            for (uint32_t i = 0; i < imgSize; i++)
-                imgFloat[i] = buffer[i];
-        }
-        break;
+            partitionImage(reinterpret_cast<double *>(imageData->getImageBuffer()));
+            break;
 
         default:
-            return nullptr;
+            return false;
     }
 
-    return imgFloat;
+    return regions.isEmpty() == false;
 }
 
-QVector<float *> cgmath::partitionImage() const
+template <typename T>
+void cgmath::partitionImage(const T *buffer) const
 {
-    QVector<float *> regions;
-
-    FITSData *imageData = guideView->getImageData();
-
-    float *imgFloat = createFloatImage();
-
-    if (imgFloat == nullptr)
-        return regions;
-
-    const uint32_t width  = imageData->getWidth();
-    const uint32_t height = imageData->getHeight();
-
-    uint8_t xRegions = floor(width / regionAxis);
-    uint8_t yRegions = floor(height / regionAxis);
-    // Find number of regions to divide the image
-    //uint8_t regions =  xRegions * yRegions;
+    const uint32_t width    = guideView->getImageData()->getWidth();
+    const uint32_t xRegions = width / regionAxis;
 
-    float *regionPtr = imgFloat;
-
-    for (uint8_t i = 0; i < yRegions; i++)
+    for (int i = 0; i < regions.count(); i++)
     {
-        for (uint8_t j = 0; j < xRegions; j++)
-        {
-            // Allocate space for one region
-            float *oneRegion = new float[regionAxis * regionAxis];
-            // Create points to region and current location of the source image in the desired region
-            float *oneRegionPtr = oneRegion, *imgFloatPtr = regionPtr + j * regionAxis;
-
-            // copy from image to region line by line
-            for (uint32_t line = 0; line < regionAxis; line++)
-            {
-                memcpy(oneRegionPtr, imgFloatPtr, regionAxis);
-                oneRegionPtr += regionAxis;
-                imgFloatPtr += width;
-            }
+        // Top left pixel of the region in the image
+        const T *imgPtr  = buffer + (i / xRegions) * regionAxis * width + (i % xRegions) * regionAxis;
+        float *regionPtr = regions[i];
 
-            regions.append(oneRegion);
+        // copy from image to region line by line
+        for (uint32_t line = 0; line < regionAxis; line++)
+        {
+            std::copy(imgPtr, imgPtr + regionAxis, regionPtr);
+            regionPtr += regionAxis;
+            imgPtr += width;
         }
-
-        // Move regionPtr block by (width * regionAxis) elements
-        regionPtr += width * regionAxis;
     }
+}
 
-    // We're done with imgFloat
-    delete[] imgFloat;
+void cgmath::freeRegions()
+{
+    foreach (float *region, regions)
+        ImageAutoGuiding::Correlator::freeRegion(region);
 
-    return regions;
+    regions.clear();
 }
 
 void cgmath::setRegionAxis(const uint32_t &value)
 {
+    if (value != regionAxis)
+        freeRegions();
+
     regionAxis = value;
 }
 
@@ -692,51 +644,39 @@ Vector cgmath::findLocalStarPosition(void) const
         QVector<Vector> shifts;
         float xsum = 0, ysum = 0;
 
-        QVector<float *> imageParition = partitionImage();
-
-        if (imageParition.isEmpty())
+        if (partitionImage() == false)
         {
             qWarning() << "Failed to partiion regions in image!";
             return Vector(-1, -1, -1);
         }
 
-        if (imageParition.count() != referenceRegions.count())
+        if (regions.count() != correlator.count())
         {
-            qWarning() << "Mismatch between reference regions #" << referenceRegions.count()
-                       << "and image parition regions #" << imageParition.count();
-            // Clear memory in case of mis-match
-            foreach (float *region, imageParition)
-            {
-                delete[] region;
-            }
-
+            qWarning() << "Mismatch between reference regions #" << correlator.count()
+                       << "and image parition regions #" << regions.count();
             return Vector(-1, -1, -1);
         }
 
-        for (uint8_t i = 0; i < imageParition.count(); i++)
+        // Regions are correlated in parallel
+        foreach (const QPointF &regionShift, correlator.shifts(regions))
         {
-            ImageAutoGuiding::ImageAutoGuiding1(referenceRegions[i], imageParition[i], regionAxis, &xshift, &yshift);
+            xshift = regionShift.x();
+            yshift = regionShift.y();
+
             Vector shift(xshift, yshift, -1);
             if (Options::guideLogging())
-                qDebug() << "Guide: Region #" << i << ": X-Shift=" << xshift << "Y-Shift=" << yshift;
+                qDebug() << "Guide: Region #" << shifts.count() << ": X-Shift=" << xshift << "Y-Shift=" << yshift;
 
             xsum += xshift;
             ysum += yshift;
             shifts.append(shift);
         }
 
-        // Delete partitions
-        foreach (float *region, imageParition)
-        {
-            delete[] region;
-        }
-        imageParition.clear();
-
-        float average_x = xsum / referenceRegions.count();
-        float average_y = ysum / referenceRegions.count();
+        float average_x = xsum / shifts.count();
+        float average_y = ysum / shifts.count();
 
-        float median_x = shifts[referenceRegions.count() / 2 - 1].x;
-        float median_y = shifts[referenceRegions.count() / 2 - 1].y;
+        float median_x = shifts[shifts.count() / 2 - 1].x;
+        float median_y = shifts[shifts.count() / 2 - 1].y;
 
         if (Options::guideLogging())
         {
@@ -24,6 +24,7 @@
 
 #include "vect.h"
 #include "matr.h"
+#include "imageautoguiding.h"
 
 typedef struct
 {
@@ -179,6 +180,8 @@ class cgmath : public QObject
     // Templated functions
     template <typename T>
     Vector findLocalStarPosition(void) const;
+    template <typename T>
+    void partitionImage(const T *buffer) const;
     // sys...
     uint32_t ticks;                // global channel ticker
     QPointer<FITSView> guideView;  // pointer to image
@@ -227,13 +230,14 @@ class cgmath : public QObject
 
     // Image Guide
     bool imageGuideEnabled = false;
-    // Creates a new float image from the guideView image data. The returned image MUST be deleted later or memory will leak.
-    float *createFloatImage() const;
-    // Partition guideView image into NxN square regions each of size axis*axis. The returned vector contains pointers to
-    // the newly allocated square images. It MUST be deleted later by delete[] or memory will leak.
-    QVector<float *> partitionImage() const;
+    // Partition guideView image into NxN square regions each of size axis*axis, as floats. The regions are kept from
+    // one frame to the next and only allocated again when their number or size changes.
+    bool partitionImage() const;
+    void freeRegions();
     uint32_t regionAxis = 64;
-    QVector<float *> referenceRegions;
+    mutable QVector<float *> regions;
+    // Keeps the spectra of the reference regions
+    ImageAutoGuiding::Correlator correlator;
 
     // dithering
     double ditherRate[2];
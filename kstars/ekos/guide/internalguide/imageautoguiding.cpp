@@ -9,453 +9,314 @@
 
 #include "imageautoguiding.h"
 
-#include <QtGlobal>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QVarLengthArray>
+#include <QtConcurrent>
 
+#include <algorithm>
 #include <math.h>
-#include <stddef.h>
-#include <stdio.h>
-#include <stdlib.h>
-
-#define SWAP(a, b) \
-    tempr = (a);   \
-    (a)   = (b);   \
-    (b)   = tempr
-#define NR_END   1
-#define FREE_ARG char *
 
 #define TWOPI   6.28318530717959
 #define FFITMAX 0.05
 
-//void ImageAutoGuiding1(float *ref,float *im,int n,float *xshift,float *yshift);
-
-float ***f3tensorSP(long nrl, long nrh, long ncl, long nch, long ndl, long ndh);
-void free_f3tensorSP(float ***t, long nrl, long nrh, long ncl, long nch, long ndl, long ndh);
+namespace ImageAutoGuiding
+{
+// 2 Dimensional FFT of n x n real images, with the tables it needs computed once
+// After rlft3 and fourn, Numerical Recipes in C Second Edition
+// The Art of Scientific Computing
+// 1999
+class Plan
+{
+  public:
+    // Spatial frequency of the spectrum the shifts are estimated from
+    typedef struct
+    {
+        int index; // Real part in the transformed image, followed by the imaginary part
+        double fx, fy;
+    } Term;
 
-float **matrixSP(long nrl, long nrh, long ncl, long nch);
+    explicit Plan(int n);
 
-void free_matrixSP(float **m, long nrl, long nrh, long ncl, long nch);
-void nrerrorNR(void);
+    // The plan of each size is shared by all correlators
+    static QSharedPointer<const Plan> get(int n);
 
-void fournNR(float data[], unsigned long nn[], long ndim, long isign);
+    // Forward transform in place. As in rlft3, row i of the result holds the frequencies 0 to n / 2 - 1 along x of
+    // frequency i along y, as n / 2 complex values
+    void transform(float *image) const;
 
-void rlft3NR(float ***data, float **speq, unsigned long nn1, unsigned long nn2, unsigned long nn3, long isign);
+    int n;
+    QVector<Term> terms; // Low spatial frequencies
 
-void ShiftEST(float ***testimage, float ***refimage, int n, float *xshift, float *yshift, int k);
+  private:
+    // Complex FFT of a given length
+    typedef struct
+    {
+        int length;
+        QVector<QPair<int, int>> swaps; // Bit reversal
+        QVector<float> twiddles;        // exp(2 pi i k / length) for k < length / 2
+    } Radix;
 
-namespace ImageAutoGuiding
-{
-void ImageAutoGuiding1(float *ref, float *im, int n, float *xshift, float *yshift)
-{
-    float ***RefImage, ***TestImage;
-    int i, j, k;
-    float x, y;
+    static Radix radix(int length);
 
-    /* Allocate memory */
+    // Transforms of the batch complex values that follow data, stride complex values apart
+    static void fourier(float *data, const Radix &radix, int stride, int batch);
 
-    RefImage  = f3tensorSP(1, 1, 1, n, 1, n);
-    TestImage = f3tensorSP(1, 1, 1, n, 1, n);
+    Radix rows, columns;
+    QVector<float> unpack; // exp(2 pi i k / n) for k <= n / 4, to untangle the real and imaginary parts
+};
 
-    /* Load Data */
+Plan::Plan(int n) : n(n), rows(radix(n / 2)), columns(radix(n))
+{
+    for (int k = 0; k <= n / 4; ++k)
+        unpack << cos(TWOPI * k / n) << sin(TWOPI * k / n);
 
-    k = 0;
+    const double ff = 1.0 / n, f2limit = FFITMAX * FFITMAX;
 
-    for (j = 1; j <= n; ++j)
+    for (int ix = 0; ix < n; ++ix)
     {
-        for (i = 1; i <= n; ++i)
+        double fx = (ix <= n / 2) ? ff * ix : -ff * (n - ix);
+
+        for (int iy = 0; iy < n / 2; ++iy)
         {
-            RefImage[1][j][i]  = ref[k];
-            TestImage[1][j][i] = im[k];
+            double fy = ff * iy;
 
-            k += 1;
+            /* Limit to Low Spatial Frequencies */
+
+            if (fx * fx + fy * fy < f2limit)
+                terms.append({ ix * n + 2 * iy, fx, fy });
         }
     }
+}
 
-    /* Calculate Image Shifts  */
-
-    ShiftEST(TestImage, RefImage, n, &x, &y, 1);
+QSharedPointer<const Plan> Plan::get(int n)
+{
+    static QMutex mutex;
+    static QHash<int, QSharedPointer<const Plan>> plans;
 
-    *xshift = x;
-    *yshift = y;
+    QMutexLocker locker(&mutex);
 
-    /* free memory */
+    QSharedPointer<const Plan> plan = plans.value(n);
+    if (plan.isNull())
+    {
+        plan = QSharedPointer<const Plan>(new Plan(n));
+        plans.insert(n, plan);
+    }
 
-    free_f3tensorSP(RefImage, 1, 1, 1, n, 1, n);
-    free_f3tensorSP(TestImage, 1, 1, 1, n, 1, n);
+    return plan;
 }
-}
-
-// Calculates Image Shifts
 
-void ShiftEST(float ***testimage, float ***refimage, int n, float *xshift, float *yshift, int k)
+Plan::Radix Plan::radix(int length)
 {
-    int ix, iy, nh, nhplusone;
-    double deltax, deltay, fx2sum, fy2sum, phifxsum, phifysum, fxfysum;
-    double fx, fy, ff, fn, re, im, testre, testim, rev, imv, phi;
-    double power, dem, f2, f2limit;
-    float **speq;
+    Radix radix;
+    radix.length = length;
 
-    f2limit = FFITMAX * FFITMAX;
-
-    speq = matrixSP(1, 1, 1, 2 * n);
+    for (int i = 0, j = 0; i < length; ++i)
+    {
+        if (i < j)
+            radix.swaps.append(qMakePair(i, j));
 
-    nh        = n / 2;
-    nhplusone = nh + 1;
+        int bit = length >> 1;
+        for (; bit > 0 && (j & bit); bit >>= 1)
+            j ^= bit;
+        j |= bit;
+    }
 
-    fn = ((float)n);
-    ff = 1.0 / fn;
+    for (int k = 0; k < length / 2; ++k)
+        radix.twiddles << cos(TWOPI * k / length) << sin(TWOPI * k / length);
 
-    /* FFT of Reference */
+    return radix;
+}
 
-    for (ix = 1; ix <= 2 * n; ++ix)
+void Plan::fourier(float *data, const Radix &radix, int stride, int batch)
+{
+    for (const QPair<int, int> &swap : radix.swaps)
     {
-        speq[1][ix] = 0.0;
+        float *a = data + 2 * swap.first * stride;
+        std::swap_ranges(a, a + 2 * batch, data + 2 * swap.second * stride);
     }
 
-    rlft3NR(refimage, speq, 1, n, n, 1);
-
-    /* FFT of Test Image */
-
-    for (ix = 1; ix <= 2 * n; ++ix)
+    for (int half = 1; half < radix.length; half <<= 1)
     {
-        speq[1][ix] = 0.0;
-    }
+        const int step = radix.length / (2 * half);
 
-    rlft3NR(testimage, speq, 1, n, n, 1);
+        for (int start = 0; start < radix.length; start += 2 * half)
+        {
+            for (int k = 0; k < half; ++k)
+            {
+                const float wr = radix.twiddles[2 * k * step];
+                const float wi = radix.twiddles[2 * k * step + 1];
+                float *a       = data + 2 * (start + k) * stride;
+                float *b       = a + 2 * half * stride;
 
-    /* Solving for slopes  */
+                for (int i = 0; i < 2 * batch; i += 2)
+                {
+                    float tempr = wr * b[i] - wi * b[i + 1];
+                    float tempi = wr * b[i + 1] + wi * b[i];
+                    b[i]        = a[i] - tempr;
+                    b[i + 1]    = a[i + 1] - tempi;
+                    a[i] += tempr;
+                    a[i + 1] += tempi;
+                }
+            }
+        }
+    }
+}
 
-    fx2sum = 0.0;
-    fy2sum = 0.0;
+void Plan::transform(float *image) const
+{
+    const int m = n / 2;
 
-    phifxsum = 0.0;
-    phifysum = 0.0;
+    // The image as n x n / 2 complex values, rows first then columns a whole row at a time
+    for (int row = 0; row < n; ++row)
+        fourier(image + row * n, rows, 1, 1);
+    fourier(image, columns, m, m);
 
-    fxfysum = 0.0;
+    // Frequency n / 2 along x of each row
+    QVarLengthArray<float, 1024> speq(2 * n);
+    for (int row = 0; row < n; ++row)
+    {
+        speq[2 * row]     = image[row * n];
+        speq[2 * row + 1] = image[row * n + 1];
+    }
 
-    for (ix = 1; ix <= n; ++ix)
+    for (int k = 0; k <= n / 4; ++k)
     {
-        if (ix <= nhplusone)
-        {
-            fx = ff * ((float)(ix - 1));
-        }
-        else
-        {
-            fx = -ff * ((float)(n + 1 - ix));
-        }
+        const float wr = unpack[2 * k], wi = unpack[2 * k + 1];
 
-        for (iy = 1; iy <= nh; ++iy)
+        for (int row = 0; row < n; ++row)
         {
-            fy = ff * ((float)(iy - 1));
-
-            f2 = fx * fx + fy * fy;
-
-            /* Limit to Low Spatial Frequencies */
-
-            if (f2 < f2limit)
-            {
-                /* Real part reference image */
+            const int mirror = (n - row) % n;
+            float *a         = image + row * n + 2 * k;
+            float *b         = (k == 0) ? speq.data() + 2 * mirror : image + mirror * n + n - 2 * k;
+
+            float h1r = 0.5f * (a[0] + b[0]);
+            float h1i = 0.5f * (a[1] - b[1]);
+            float h2i = -0.5f * (a[0] - b[0]);
+            float h2r = 0.5f * (a[1] + b[1]);
+
+            a[0] = h1r + wr * h2r - wi * h2i;
+            a[1] = h1i + wr * h2i + wi * h2r;
+            b[0] = h1r - wr * h2r + wi * h2i;
+            b[1] = -h1i + wr * h2i + wi * h2r;
+        }
+    }
+}
 
-                re = refimage[k][ix][2 * iy - 1];
+void Correlator::setReference(const QVector<float *> &regions, int n)
+{
+    typedef struct
+    {
+        float *image;
+        Reference reference;
+    } Region;
 
-                /* Imaginary part reference image */
+    plan = Plan::get(n);
 
-                im = refimage[k][ix][2 * iy];
+    QVector<Region> work;
+    for (float *image : regions)
+        work.append({ image, Reference() });
 
-                power = re * re + im * im;
+    const Plan &fft = *plan;
 
-                /* Real part test image */
+    QtConcurrent::blockingMap(work, [&](Region &region) {
+        /* FFT of Reference */
 
-                testre = testimage[k][ix][2 * iy - 1];
+        fft.transform(region.image);
 
-                /* Imaginary part image */
+        /* Solving for slopes, only the phase of the test image changes from one frame to the next */
 
-                testim = testimage[k][ix][2 * iy];
+        double fx2sum = 0.0, fy2sum = 0.0, fxfysum = 0.0;
+        QVector<double> power;
 
-                rev = re * testre + im * testim;
-                imv = re * testim - im * testre;
+        for (const Plan::Term &term : fft.terms)
+        {
+            float re = region.image[term.index];
+            float im = region.image[term.index + 1];
 
-                /* Find Phase */
+            region.reference.re.append(re);
+            region.reference.im.append(im);
+            power.append(double(re) * re + double(im) * im);
 
-                phi = atan2(imv, rev);
+            fx2sum += power.last() * term.fx * term.fx;
+            fy2sum += power.last() * term.fy * term.fy;
+            fxfysum += power.last() * term.fx * term.fy;
+        }
 
-                fx2sum += power * fx * fx;
-                fy2sum += power * fy * fy;
+        double dem = fx2sum * fy2sum - fxfysum * fxfysum;
 
-                phifxsum += power * fx * phi;
-                phifysum += power * fy * phi;
+        for (int i = 0; i < fft.terms.count(); ++i)
+        {
+            const Plan::Term &term = fft.terms[i];
 
-                fxfysum += power * fx * fy;
-            }
+            region.reference.xWeights.append(power[i] * (term.fx * fy2sum - term.fy * fxfysum) / (dem * TWOPI));
+            region.reference.yWeights.append(power[i] * (term.fy * fx2sum - term.fx * fxfysum) / (dem * TWOPI));
         }
-    }
+    });
 
-    /* calculate subpixel shift */
+    references.clear();
+    for (const Region &region : work)
+        references.append(region.reference);
+}
 
-    dem = fx2sum * fy2sum - fxfysum * fxfysum;
+QVector<QPointF> Correlator::shifts(const QVector<float *> &regions) const
+{
+    typedef struct
+    {
+        float *image;
+        const Reference *reference;
+        QPointF shift;
+    } Region;
 
-    deltax = (phifxsum * fy2sum - fxfysum * phifysum) / (dem * TWOPI);
-    deltay = (phifysum * fx2sum - fxfysum * phifxsum) / (dem * TWOPI);
+    if (references.isEmpty())
+        return QVector<QPointF>();
 
-    free_matrixSP(speq, 1, 1, 1, 2 * n);
+    QVector<Region> work;
+    for (int i = 0; i < regions.count() && i < references.count(); ++i)
+        work.append({ regions[i], &references[i], QPointF() });
 
-    /* You can change the shift mapping here */
+    const Plan &fft = *plan;
 
-    *xshift = deltax;
-    *yshift = deltay;
-}
+    QtConcurrent::blockingMap(work, [&](Region &region) {
+        /* FFT of Test Image */
 
-// 2 and 3 Dimensional FFT Routine for Real Data
-// Numerical Recipes in C Second Edition
-// The Art of Scientific Computing
-// 1999
+        fft.transform(region.image);
 
-void rlft3NR(float ***data, float **speq, unsigned long nn1, unsigned long nn2, unsigned long nn3, long isign)
-{
-    void fournNR(float data[], unsigned long nn[], long ndim, long isign);
-    void nrerror();
-    unsigned long i1, i2, i3, j1, j2, j3, nn[4], ii3;
-    double theta, wpi, wpr, wtemp;
-    float c1, c2, h1r, h1i, h2r, h2i;
-    float wi, wr;
-
-    if ((unsigned long)(1 + &data[nn1][nn2][nn3] - &data[1][1][1]) != nn1 * nn2 * nn3)
-        nrerrorNR();
-    c1    = 0.5;
-    c2    = -0.5 * isign;
-    theta = isign * (6.28318530717959 / nn3);
-    wtemp = sin(0.5 * theta);
-    wpr   = -2.0 * wtemp * wtemp;
-    wpi   = sin(theta);
-    nn[1] = nn1;
-    nn[2] = nn2;
-    nn[3] = nn3 >> 1;
-    if (isign == 1)
-    {
-        fournNR(&data[1][1][1] - 1, nn, 3, isign);
-        for (i1 = 1; i1 <= nn1; i1++)
-            for (i2 = 1, j2 = 0; i2 <= nn2; i2++)
-            {
-                speq[i1][++j2] = data[i1][i2][1];
-                speq[i1][++j2] = data[i1][i2][2];
-            }
-    }
-    for (i1 = 1; i1 <= nn1; i1++)
-    {
-        j1 = (i1 != 1 ? nn1 - i1 + 2 : 1);
-        wr = 1.0;
-        wi = 0.0;
-        for (ii3 = 1, i3 = 1; i3 <= (nn3 >> 2) + 1; i3++, ii3 += 2)
+        double deltax = 0.0, deltay = 0.0;
+
+        for (int i = 0; i < fft.terms.count(); ++i)
         {
-            for (i2 = 1; i2 <= nn2; i2++)
-            {
-                if (i3 == 1)
-                {
-                    j2               = (i2 != 1 ? ((nn2 - i2) << 1) + 3 : 1);
-                    h1r              = c1 * (data[i1][i2][1] + speq[j1][j2]);
-                    h1i              = c1 * (data[i1][i2][2] - speq[j1][j2 + 1]);
-                    h2i              = c2 * (data[i1][i2][1] - speq[j1][j2]);
-                    h2r              = -c2 * (data[i1][i2][2] + speq[j1][j2 + 1]);
-                    data[i1][i2][1]  = h1r + h2r;
-                    data[i1][i2][2]  = h1i + h2i;
-                    speq[j1][j2]     = h1r - h2r;
-                    speq[j1][j2 + 1] = h2i - h1i;
-                }
-                else
-                {
-                    j2                    = (i2 != 1 ? nn2 - i2 + 2 : 1);
-                    j3                    = nn3 + 3 - (i3 << 1);
-                    h1r                   = c1 * (data[i1][i2][ii3] + data[j1][j2][j3]);
-                    h1i                   = c1 * (data[i1][i2][ii3 + 1] - data[j1][j2][j3 + 1]);
-                    h2i                   = c2 * (data[i1][i2][ii3] - data[j1][j2][j3]);
-                    h2r                   = -c2 * (data[i1][i2][ii3 + 1] + data[j1][j2][j3 + 1]);
-                    data[i1][i2][ii3]     = h1r + wr * h2r - wi * h2i;
-                    data[i1][i2][ii3 + 1] = h1i + wr * h2i + wi * h2r;
-                    data[j1][j2][j3]      = h1r - wr * h2r + wi * h2i;
-                    data[j1][j2][j3 + 1]  = -h1i + wr * h2i + wi * h2r;
-                }
-            }
-            wr = (wtemp = wr) * wpr - wi * wpi + wr;
-            wi = wi * wpr + wtemp * wpi + wi;
-        }
-    }
-    if (isign == -1)
-        fournNR(&data[1][1][1] - 1, nn, 3, isign);
-}
+            double re     = region.reference->re[i];
+            double im     = region.reference->im[i];
+            double testre = region.image[fft.terms[i].index];
+            double testim = region.image[fft.terms[i].index + 1];
 
-// Multi-Dimensional FFT Routine for Complex Data
-// Numerical Recipes in C Second Edition
-// The Art of Scientific Computing
-// 1999
-// Used in rlft3
+            /* Find Phase */
 
-void fournNR(float data[], unsigned long nn[], long ndim, long isign)
-{
-    long idim;
-    unsigned long i1, i2rev, i3rev, ip1, ip2, ip3, ifp1, ifp2;
-    unsigned long i2, i3;
-    unsigned long ibit, k1, k2, n, nprev, nrem, ntot;
-    float wi, wr, tempi, tempr;
-    double theta, wpi, wpr, wtemp;
-
-    for (ntot = 1, idim = 1; idim <= ndim; idim++)
-        ntot *= nn[idim];
-    nprev = 1;
-    for (idim = ndim; idim >= 1; idim--)
-    {
-        n     = nn[idim];
-        nrem  = ntot / (n * nprev);
-        ip1   = nprev << 1;
-        ip2   = ip1 * n;
-        ip3   = ip2 * nrem;
-        i2rev = 1;
-        for (i2 = 1; i2 <= ip2; i2 += ip1)
-        {
-            if (i2 < i2rev)
-            {
-                for (i1 = i2; i1 <= i2 + ip1 - 2; i1 += 2)
-                {
-                    for (i3 = i1; i3 <= ip3; i3 += ip2)
-                    {
-                        i3rev = i2rev + i3 - i2;
-                        SWAP(data[i3], data[i3rev]);
-                        SWAP(data[i3 + 1], data[i3rev + 1]);
-                    }
-                }
-            }
-            ibit = ip2 >> 1;
-            while (ibit >= ip1 && i2rev > ibit)
-            {
-                i2rev -= ibit;
-                ibit >>= 1;
-            }
-            i2rev += ibit;
-        }
-        ifp1 = ip1;
-        while (ifp1 < ip2)
-        {
-            ifp2  = ifp1 << 1;
-            theta = isign * 6.28318530717959 / (ifp2 / ip1);
-            wtemp = sin(0.5 * theta);
-            wpr   = -2.0 * wtemp * wtemp;
-            wpi   = sin(theta);
-            wr    = 1.0;
-            wi    = 0.0;
-            for (i3 = 1; i3 <= ifp1; i3 += ip1)
-            {
-                for (i1 = i3; i1 <= i3 + ip1 - 2; i1 += 2)
-                {
-                    for (i2 = i1; i2 <= ip3; i2 += ifp2)
-                    {
-                        k1           = i2;
-                        k2           = k1 + ifp1;
-                        tempr        = (double)wr * data[k2] - (double)wi * data[k2 + 1];
-                        tempi        = (double)wr * data[k2 + 1] + (double)wi * data[k2];
-                        data[k2]     = data[k1] - tempr;
-                        data[k2 + 1] = data[k1 + 1] - tempi;
-                        data[k1] += tempr;
-                        data[k1 + 1] += tempi;
-                    }
-                }
-                wr = (wtemp = wr) * wpr - wi * wpi + wr;
-                wi = wi * wpr + wtemp * wpi + wi;
-            }
-            ifp1 = ifp2;
+            double phi = atan2(re * testim - im * testre, re * testre + im * testim);
+
+            deltax += phi * region.reference->xWeights[i];
+            deltay += phi * region.reference->yWeights[i];
         }
-        nprev *= n;
-    }
-}
 
-void nrerrorNR(void)
-{
-}
+        region.shift = QPointF(deltax, deltay);
+    });
 
-// Numerical Recipes memory allocation routines
-// One based arrays
+    QVector<QPointF> shifts;
+    for (const Region &region : work)
+        shifts.append(region.shift);
 
-float **matrixSP(long nrl, long nrh, long ncl, long nch)
-/* allocate a float matrix with subscript range m[nrl..nrh][ncl..nch] */
-{
-    long i, nrow = nrh - nrl + 1, ncol = nch - ncl + 1;
-    float **m;
-
-    /* allocate pointers to rows */
-    m = (float **)malloc((size_t)((nrow + NR_END) * sizeof(float *)));
-    if (!m)
-        nrerrorNR();
-    m += NR_END;
-    m -= nrl;
-
-    /* allocate rows and set pointers to them */
-    m[nrl] = (float *)malloc((size_t)((nrow * ncol + NR_END) * sizeof(float)));
-    if (!m[nrl])
-        nrerrorNR();
-    m[nrl] += NR_END;
-    m[nrl] -= ncl;
-
-    for (i = nrl + 1; i <= nrh; i++)
-        m[i] = m[i - 1] + ncol;
-
-    /* return pointer to array of pointers to rows */
-    return m;
+    return shifts;
 }
 
-float ***f3tensorSP(long nrl, long nrh, long ncl, long nch, long ndl, long ndh)
-/* allocate a float 3tensor with range t[nrl..nrh][ncl..nch][ndl..ndh] */
+float *Correlator::allocateRegion(int n)
 {
-    long i, j, nrow = nrh - nrl + 1, ncol = nch - ncl + 1, ndep = ndh - ndl + 1;
-    float ***t;
-
-    /* allocate pointers to pointers to rows */
-    t = (float ***)malloc((size_t)((nrow + NR_END) * sizeof(float **)));
-    if (!t)
-        nrerrorNR();
-    t += NR_END;
-    t -= nrl;
-
-    /* allocate pointers to rows and set pointers to them */
-    t[nrl] = (float **)malloc((size_t)((nrow * ncol + NR_END) * sizeof(float *)));
-    if (!t[nrl])
-        nrerrorNR();
-    t[nrl] += NR_END;
-    t[nrl] -= ncl;
-
-    /* allocate rows and set pointers to them */
-    t[nrl][ncl] = (float *)malloc((size_t)((nrow * ncol * ndep + NR_END) * sizeof(float)));
-    if (!t[nrl][ncl])
-        nrerrorNR();
-    t[nrl][ncl] += NR_END;
-    t[nrl][ncl] -= ndl;
-
-    for (j = ncl + 1; j <= nch; j++)
-        t[nrl][j] = t[nrl][j - 1] + ndep;
-    for (i = nrl + 1; i <= nrh; i++)
-    {
-        t[i]      = t[i - 1] + ncol;
-        t[i][ncl] = t[i - 1][ncl] + ncol * ndep;
-        for (j = ncl + 1; j <= nch; j++)
-            t[i][j] = t[i][j - 1] + ndep;
-    }
-
-    /* return pointer to array of pointers to rows */
-    return t;
+    return static_cast<float *>(qMallocAligned(n * n * sizeof(float), 64));
 }
 
-void free_matrixSP(float **m, long nrl, long nrh, long ncl, long nch)
-/* free a float matrix allocated by matrix() */
+void Correlator::freeRegion(float *region)
 {
-    Q_UNUSED(nrh);
-    Q_UNUSED(nch);
-    free((FREE_ARG)(m[nrl] + ncl - NR_END));
-    free((FREE_ARG)(m + nrl - NR_END));
+    qFreeAligned(region);
 }
-
-void free_f3tensorSP(float ***t, long nrl, long nrh, long ncl, long nch, long ndl, long ndh)
-/* free a float f3tensor allocated by f3tensor() */
-{
-    Q_UNUSED(nrh);
-    Q_UNUSED(nch);
-    Q_UNUSED(ndh);
-    free((FREE_ARG)(t[nrl][ncl] + ndl - NR_END));
-    free((FREE_ARG)(t[nrl] + ncl - NR_END));
-    free((FREE_ARG)(t + nrl - NR_END));
 }
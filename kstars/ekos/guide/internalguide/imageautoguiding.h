@@ -9,18 +9,66 @@
 
 // Robert Majewski
 
-// ImageAutoGuiding1 is self contained
-// ref is the reference image
-// im is the test image
+// The Correlator is self contained
+// The reference and test images are zero based one dimensional vectors
 // Image Size n x n
-
-// The Input Image and the Reference images are zero based one dimensional vectors
 // They MUST be Square Images
 // n MUST be a Power of 2  use 128,256,512
 // 256 X 256 is A good Choice
 // These should be portions of the camera imagery
 
+#pragma once
+
+#include <QPointF>
+#include <QSharedPointer>
+#include <QVector>
+
 namespace ImageAutoGuiding
 {
-void ImageAutoGuiding1(float *ref, float *im, int n, float *xshift, float *yshift);
+class Plan;
+
+/**
+ * @class Correlator
+ * @short Estimates the shift of image regions against reference regions from the phase of their low spatial
+ * frequencies.
+ *
+ * The spectra of the reference regions are computed once and kept for all the following frames. The FFT tables of each
+ * region size are computed once and shared by all correlators, and the regions of a frame are processed in parallel.
+ */
+class Correlator
+{
+  public:
+    /**
+     * @brief setReference Transform the reference regions and keep their spectra for the following frames
+     * @param regions Regions of the reference image, as allocated by allocateRegion(). They are overwritten.
+     * @param n Size of the regions
+     */
+    void setReference(const QVector<float *> &regions, int n);
+
+    /** @return Number of reference regions */
+    int count() const { return references.count(); }
+
+    /**
+     * @brief shifts Estimate the shift of each region against its reference
+     * @param regions Regions of the test image, as many as reference regions. They are overwritten.
+     * @return Shift of each region in pixels
+     */
+    QVector<QPointF> shifts(const QVector<float *> &regions) const;
+
+    /** @brief allocateRegion Allocate an aligned buffer of n x n pixels, to be freed with freeRegion() */
+    static float *allocateRegion(int n);
+    static void freeRegion(float *region);
+
+  private:
+    // Spectrum of a reference region at the low spatial frequencies, with the weight of the phase of each frequency
+    // in the least squares fit of the shift
+    typedef struct
+    {
+        QVector<float> re, im;
+        QVector<double> xWeights, yWeights;
+    } Reference;
+
+    QSharedPointer<const Plan> plan;
+    QVector<Reference> references;
+};
 }
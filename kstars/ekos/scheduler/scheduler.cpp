@@ -23,23 +23,23 @@
 
 #include "scheduleradaptor.h"
 #include "dialogs/finddialog.h"
+#include "ekos/auxiliary/capturedframes.h"
 #include "ekos/capture/sequencejob.h"
 #include "ekos/ekosmanager.h"
 #include "kstars.h"
 #include "scheduler.h"
 #include "skymapcomposite.h"
 #include "kstarsdata.h"
-#include "ksmoon.h"
 #include "ksalmanac.h"
 #include "ksutils.h"
 #include "mosaic.h"
+#include "schedulerephemeris.h"
+#include "schedulerevaluation.h"
 #include "skyobjects/starobject.h"
 #include "ksnotification.h"
 
-#define BAD_SCORE               -1000
 #define MAX_FAILURE_ATTEMPTS    3
 #define UPDATE_PERIOD_MS        1000
-#define SETTING_ALTITUDE_CUTOFF 3
 
 #define DEFAULT_CULMINATION_TIME    -60
 #define DEFAULT_MIN_ALTITUDE        15
@@ -57,14 +57,6 @@ bool priorityHigherThan(SchedulerJob *job1, SchedulerJob *job2)
     return job1->getPriority() < job2->getPriority();
 }
 
-bool altitudeHigherThan(SchedulerJob *job1, SchedulerJob *job2)
-{
-    double job1_altitude = Scheduler::findAltitude(job1->getTargetCoords(), job1->getStartupTime());
-    double job2_altitude = Scheduler::findAltitude(job2->getTargetCoords(), job2->getStartupTime());
-
-    return job1_altitude > job2_altitude;
-}
-
 Scheduler::Scheduler()
 {
     setupUi(this);
@@ -72,6 +64,9 @@ Scheduler::Scheduler()
     new SchedulerAdaptor(this);
     QDBusConnection::sessionBus().registerObject("/KStars/Ekos/Scheduler", this);
 
+    // The index of captured frames is used from the threads that evaluate jobs, it must be made on the GUI thread
+    CapturedFrames::Instance();
+
     dirPath   = QUrl::fromLocalFile(QDir::homePath());
     state     = SCHEDULER_IDLE;
     ekosState = EKOS_IDLE;
@@ -137,8 +132,6 @@ Scheduler::Scheduler()
     capInterface     = new QDBusInterface("org.kde.kstars", "/KStars/Ekos/DustCap", "org.kde.kstars.Ekos.DustCap",
                                       QDBusConnection::sessionBus(), this);
 
-    moon = dynamic_cast<KSMoon *>(KStarsData::Instance()->skyComposite()->findByName("Moon"));
-
     sleepLabel->setPixmap(
         QIcon::fromTheme("chronometer", QIcon(":/icons/breeze/default/chronometer.svg")).pixmap(QSize(32, 32)));
     sleepLabel->hide();
@@ -207,6 +200,7 @@ Scheduler::Scheduler()
     connect(addToQueueB, SIGNAL(clicked()), this, SLOT(addJob()));
     connect(removeFromQueueB, SIGNAL(clicked()), this, SLOT(removeJob()));
     connect(evaluateOnlyB, SIGNAL(clicked()), this, SLOT(startJobEvaluation()));
+    connect(&evaluationWatcher, SIGNAL(finished()), this, SLOT(finishEvaluation()));
     connect(queueTable, SIGNAL(clicked(QModelIndex)), this, SLOT(loadJob(QModelIndex)));
     connect(queueTable, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(resetJobState(QModelIndex)));
 
@@ -229,6 +223,9 @@ Scheduler::Scheduler()
 
 Scheduler::~Scheduler()
 {
+    // The evaluations read the scheduler
+    evaluationWatcher.cancel();
+    evaluationWatcher.waitForFinished();
 }
 
 void Scheduler::watchJobChanges(bool enable)
@@ -902,6 +899,7 @@ void Scheduler::stop()
 
     schedulerTimer.stop();
     jobTimer.stop();
+    evaluationWatcher.cancel();
 
     state     = SCHEDULER_IDLE;
     ekosState = EKOS_IDLE;
@@ -1052,200 +1050,67 @@ void Scheduler::pause()
 
 void Scheduler::evaluateJobs()
 {
+    // The jobs of the queue are already being scored, finishEvaluation() will use the scores
+    if (evaluating)
+        return;
+
+    // Jobs are scored on copies, across the threads of the global pool. The queue, its table and the log are only
+    // updated once all of them are scored, in finishEvaluation().
+    evaluations.clear();
+    QDateTime lastStartupTime = KStarsData::Instance()->lt();
+
     foreach (SchedulerJob *job, jobs)
     {
         if (job->getState() > SchedulerJob::JOB_SCHEDULED)
             continue;
 
-        if (job->getState() == SchedulerJob::JOB_IDLE)
-            job->setState(SchedulerJob::JOB_EVALUATION);
-
-        if (job->getCompletionCondition() == SchedulerJob::FINISH_REPEAT)
-        {
-            if (job->getRepeatsRemaining() == 0)
-            {
-                appendLogText(i18n("%1 observation job has no more runs remaining.", job->getName()));
-                job->setState(SchedulerJob::JOB_INVALID);
-                continue;
-            }
-        }
-
-        int16_t score = 0;
-
-        QDateTime now = KStarsData::Instance()->lt();
-
-        // -1 = Job is not estimated yet
-        // -2 = Job is estimated but time is unknown
-        // > 0  Job is estimated and time is known
-        if (job->getEstimatedTime() == -1)
-        {
-            if (estimateJobTime(job) == false)
-            {
-                job->setState(SchedulerJob::JOB_INVALID);
-                continue;
-            }
-
-            if (job->getEstimatedTime() == 0)
-            {
-                job->setState(SchedulerJob::JOB_COMPLETE);
-                continue;
-            }
-        }
+        JobEvaluation evaluation;
+        evaluation.job      = job;
+        evaluation.snapshot = *job;
+        evaluation.snapshot.setStatusCell(nullptr);
+        evaluation.snapshot.setStartupCell(nullptr);
+        evaluation.snapshot.setEstimatedTimeCell(nullptr);
+        evaluations.append(evaluation);
 
-        // #1 Check startup conditions
-        switch (job->getStartupCondition())
-        {
-            // #1.1 ASAP?
-            case SchedulerJob::START_ASAP:
-                // If not light frames are required, run it now
-                if (job->getLightFramesRequired())
-                    score = calculateJobScore(job, now);
-                else
-                    score = 1000;
-
-                job->setScore(score);
-
-                // If we can't start now, let's schedule it
-                if (score < 0)
-                {
-                    // If Altitude or Dark score are negative, we try to schedule a better time for altitude and dark sky period.
-                    if (calculateAltitudeTime(job, job->getMinAltitude() > 0 ? job->getMinAltitude() : 0,
-                                              job->getMinMoonSeparation()))
-                    {
-                        //appendLogText(i18n("%1 observation job is scheduled at %2", job->getName(), job->getStartupTime().toString()));
-                        job->setState(SchedulerJob::JOB_SCHEDULED);
-                        // Since it's scheduled, we need to skip it now and re-check it later since its startup condition changed to START_AT
-                        job->setScore(BAD_SCORE);
-                        continue;
-                    }
-                    else
-                    {
-                        job->setState(SchedulerJob::JOB_INVALID);
-                        appendLogText(i18n("Ekos failed to schedule %1.", job->getName()));
-                    }
-                }
-                else if (isWeatherOK(job) == false)
-                    job->setScore(BAD_SCORE);
-                else
-                    appendLogText(i18n("%1 observation job is due to run as soon as possible.", job->getName()));
-                break;
-
-            // #1.2 Culmination?
-            case SchedulerJob::START_CULMINATION:
-                if (calculateCulmination(job))
-                {
-                    appendLogText(i18n("%1 observation job is scheduled at %2", job->getName(),
-                                       job->getStartupTime().toString()));
-                    job->setState(SchedulerJob::JOB_SCHEDULED);
-                    // Since it's scheduled, we need to skip it now and re-check it later since its startup condition changed to START_AT
-                    job->setScore(BAD_SCORE);
-                    continue;
-                }
-                else
-                    job->setState(SchedulerJob::JOB_INVALID);
-                break;
+        if (job->getStartupCondition() == SchedulerJob::START_AT && job->getStartupTime() > lastStartupTime)
+            lastStartupTime = job->getStartupTime();
+    }
 
-            // #1.3 Start at?
-            case SchedulerJob::START_AT:
-            {
-                if (job->getCompletionCondition() == SchedulerJob::FINISH_AT)
-                {
-                    if (job->getStartupTime().secsTo(job->getCompletionTime()) <= 0)
-                    {
-                        appendLogText(i18n("%1 completion time (%2) is earlier than start up time (%3)", job->getName(),
-                                           job->getCompletionTime().toString(), job->getStartupTime().toString()));
-                        job->setState(SchedulerJob::JOB_INVALID);
-                        continue;
-                    }
-                }
+    prepareEvaluation(lastStartupTime);
 
-                QDateTime startupTime = job->getStartupTime();
-                int timeUntil         = KStarsData::Instance()->lt().secsTo(startupTime);
-                // If starting time already passed by 5 minutes (default), we mark the job as invalid
-                if (timeUntil < (-1 * Options::leadTime() * 60))
-                {
-                    dms passedUp(timeUntil / 3600.0);
-                    if (job->getState() == SchedulerJob::JOB_EVALUATION)
-                    {
-                        appendLogText(i18n("%1 startup time already passed by %2. Job is marked as invalid.",
-                                           job->getName(), passedUp.toHMSString()));
-                        job->setState(SchedulerJob::JOB_INVALID);
-                    }
-                    else
-                    {
-                        appendLogText(i18n("%1 startup time already passed by %2. Aborting job...", job->getName(),
-                                           passedUp.toHMSString()));
-                        job->setState(SchedulerJob::JOB_ABORTED);
-                    }
-
-                    continue;
-                }
-                // Start scoring once we reach startup time
-                else if (timeUntil <= 0)
-                {
-                    /*score += getAltitudeScore(job, now);
-                    score += getMoonSeparationScore(job, now);
-                    score += getDarkSkyScore(now);*/
-                    score = calculateJobScore(job, now);
+    evaluating = true;
+    evaluationWatcher.setFuture(SchedulerEvaluation::evaluate(evaluationContext, evaluations));
+}
 
-                    if (score < 0)
-                    {
-                        if (job->getState() == SchedulerJob::JOB_EVALUATION)
-                        {
-                            appendLogText(
-                                i18n("%1 observation job evaluation failed with a score of %2. Aborting job...",
-                                     job->getName(), score));
-                            job->setState(SchedulerJob::JOB_INVALID);
-                        }
-                        else
-                        {
-                            appendLogText(i18n(
-                                "%1 observation job updated score is %2 %3 seconds after startup time. Aborting job...",
-                                job->getName(), abs(timeUntil), score));
-                            job->setState(SchedulerJob::JOB_ABORTED);
-                        }
+void Scheduler::finishEvaluation()
+{
+    evaluating = false;
 
-                        continue;
-                    }
-                    // If job is already scheduled, we check the weather, and if it is not OK, we set bad score until weather improves.
-                    else if (isWeatherOK(job) == false)
-                        score += BAD_SCORE;
-                }
-                // If it is in the future and originally was designated as ASAP job
-                // Job must be less than 12 hours away to be considered for re-evaluation
-                else if (timeUntil > (Options::leadTime() * 60) && (timeUntil < 12 * 3600) &&
-                         job->getFileStartupCondition() == SchedulerJob::START_ASAP)
-                {
-                    QDateTime nextJobTime = now.addSecs(Options::leadTime() * 60);
-                    if (job->getEnforceTwilight() == false || (now > duskDateTime && now < preDawnDateTime))
-                        job->setStartupTime(nextJobTime);
-                    score += BAD_SCORE;
-                }
-                // If time is far in the future, we make the score negative
-                else
-                {
-                    if (job->getState() == SchedulerJob::JOB_EVALUATION &&
-                        calculateJobScore(job, job->getStartupTime()) < 0)
-                    {
-                        appendLogText(i18n("%1 observation job evaluation failed with a score of %2. Aborting job...",
-                                           job->getName(), score));
-                        job->setState(SchedulerJob::JOB_INVALID);
-                        continue;
-                    }
+    // The scheduler was stopped while the jobs were scored
+    if (evaluationWatcher.isCanceled())
+        return;
 
-                    score += BAD_SCORE;
-                }
+    for (JobEvaluation &evaluation : evaluations)
+    {
+        SchedulerJob *job      = evaluation.job;
+        SchedulerJob &snapshot = evaluation.snapshot;
 
-                job->setScore(score);
-            }
-            break;
-        }
+        // Jobs removed from the queue, or started, while they were scored are left alone
+        if (jobs.contains(job) == false || job->getState() > SchedulerJob::JOB_SCHEDULED)
+            continue;
 
-        // appendLogText(i18n("Job total score is %1", score));
+        foreach (const QString &text, evaluation.log)
+            appendLogText(text);
 
-        //if (score > 0 && job->getState() == SchedulerJob::JOB_EVALUATION)
-        if (job->getState() == SchedulerJob::JOB_EVALUATION)
-            job->setState(SchedulerJob::JOB_SCHEDULED);
+        job->setInSequenceFocus(snapshot.getInSequenceFocus());
+        job->setLightFramesRequired(snapshot.getLightFramesRequired());
+        if (job->getEstimatedTime() != snapshot.getEstimatedTime())
+            job->setEstimatedTime(snapshot.getEstimatedTime());
+        if (job->getStartupTime() != snapshot.getStartupTime())
+            job->setStartupTime(snapshot.getStartupTime());
+        job->setStartupCondition(snapshot.getStartupCondition());
+        job->setScore(snapshot.getScore());
+        job->setState(snapshot.getState());
     }
 
     int invalidJobs = 0, completedJobs = 0, abortedJobs = 0, upcomingJobs = 0;
@@ -1314,8 +1179,14 @@ void Scheduler::evaluateJobs()
 
     QList<SchedulerJob *> sortedJobs = jobs;
 
-    // Order by altitude first
-    qSort(sortedJobs.begin(), sortedJobs.end(), altitudeHigherThan);
+    // Order by altitude first, finding the altitude of each job once rather than on every comparison
+    QHash<SchedulerJob *, double> altitudes;
+    foreach (SchedulerJob *job, jobs)
+        altitudes[job] = findAltitude(job->getTargetCoords(), job->getStartupTime());
+
+    qSort(sortedJobs.begin(), sortedJobs.end(), [&altitudes](SchedulerJob *job1, SchedulerJob *job2) {
+        return altitudes.value(job1) > altitudes.value(job2);
+    });
     // Then by priority
     qSort(sortedJobs.begin(), sortedJobs.end(), priorityHigherThan);
 
@@ -1507,6 +1378,40 @@ void Scheduler::evaluateJobs()
     }
 }
 
+void Scheduler::prepareEvaluation(const QDateTime &lastStartupTime)
+{
+    evaluationContext.now = KStarsData::Instance()->lt();
+
+    // Altitude searches look at the day after now, START_AT jobs are also scored at their startup time
+    KStarsDateTime ut = geo->LTtoUT(evaluationContext.now);
+    KStarsDateTime to = geo->LTtoUT(lastStartupTime);
+    if (to.djd() < ut.djd() + 1)
+        to = KStarsDateTime(ut.djd() + 1);
+    evaluationContext.ephemeris = getEphemeris(ut, to);
+
+    evaluationContext.mountHourAngle = 0;
+    if (indiState == INDI_READY)
+    {
+        QDBusReply<double> haReply = mountInterface->call(QDBus::AutoDetect, "getHourAngle");
+        if (haReply.error().type() == QDBusError::NoError)
+            evaluationContext.mountHourAngle = haReply.value();
+    }
+
+    evaluationContext.geo             = geo;
+    evaluationContext.lst             = *KStarsData::Instance()->lst();
+    evaluationContext.dawn            = Dawn;
+    evaluationContext.dusk            = Dusk;
+    evaluationContext.duskDateTime    = duskDateTime;
+    evaluationContext.preDawnDateTime = preDawnDateTime;
+    evaluationContext.indiReady       = indiState == INDI_READY;
+    evaluationContext.weatherChecked  = weatherCheck->isChecked();
+    evaluationContext.weatherStatus   = weatherStatus;
+    evaluationContext.minAltitude     = minAltitude->minimum();
+    evaluationContext.leadTime        = Options::leadTime();
+    evaluationContext.preDawnTime     = Options::preDawnTime();
+    evaluationContext.estimateJobTime = [this](JobEvaluation &evaluation) { return estimateJobTime(evaluation); };
+}
+
 void Scheduler::wakeUpScheduler()
 {
     sleepLabel->hide();
@@ -1544,113 +1449,6 @@ double Scheduler::findAltitude(const SkyPoint &target, const QDateTime when)
     return p.alt().Degrees();
 }
 
-bool Scheduler::calculateAltitudeTime(SchedulerJob *job, double minAltitude, double minMoonAngle)
-{
-    // We wouldn't stat observation 30 mins (default) before dawn.
-    double earlyDawn = Dawn - Options::preDawnTime() / (60.0 * 24.0);
-    double altitude  = 0;
-    QDateTime lt(KStarsData::Instance()->lt().date(), QTime());
-    KStarsDateTime ut = geo->LTtoUT(lt);
-
-    SkyPoint target = job->getTargetCoords();
-
-    QTime now       = KStarsData::Instance()->lt().time();
-    double fraction = now.hour() + now.minute() / 60.0 + now.second() / 3600;
-    double rawFrac  = 0;
-
-    for (double hour = fraction; hour < (fraction + 24); hour += 1.0 / 60.0)
-    {
-        KStarsDateTime myUT = ut.addSecs(hour * 3600.0);
-
-        rawFrac = (hour > 24 ? (hour - 24) : hour) / 24.0;
-
-        if (rawFrac < Dawn || rawFrac > Dusk)
-        {
-            CachingDms LST = geo->GSTtoLST(myUT.gst());
-            target.EquatorialToHorizontal(&LST, geo->lat());
-            altitude = target.alt().Degrees();
-
-            if (altitude > minAltitude)
-            {
-                QDateTime startTime = geo->UTtoLT(myUT);
-
-                if (rawFrac > earlyDawn && rawFrac < Dawn)
-                {
-                    appendLogText(i18n("%1 reaches an altitude of %2 degrees at %3 but will not be scheduled due to "
-                                       "close proximity to astronomical twilight rise.",
-                                       job->getName(), QString::number(minAltitude, 'g', 3), startTime.toString()));
-                    return false;
-                }
-
-                if (minMoonAngle > 0 && getMoonSeparationScore(job, startTime) < 0)
-                    continue;
-
-                job->setStartupTime(startTime);
-                job->setStartupCondition(SchedulerJob::START_AT);
-                appendLogText(i18n("%1 is scheduled to start at %2 where its altitude is %3 degrees.", job->getName(),
-                                   startTime.toString(), QString::number(altitude, 'g', 3)));
-                return true;
-            }
-        }
-    }
-
-    if (minMoonAngle == -1)
-        appendLogText(i18n("No night time found for %1 to rise above minimum altitude of %2 degrees.", job->getName(),
-                           QString::number(minAltitude, 'g', 3)));
-    else
-        appendLogText(i18n("No night time found for %1 to rise above minimum altitude of %2 degrees with minimum moon "
-                           "separation of %3 degrees.",
-                           job->getName(), QString::number(minAltitude, 'g', 3),
-                           QString::number(minMoonAngle, 'g', 3)));
-    return false;
-}
-
-bool Scheduler::calculateCulmination(SchedulerJob *job)
-{
-    SkyPoint target = job->getTargetCoords();
-
-    SkyObject o;
-
-    o.setRA0(target.ra0());
-    o.setDec0(target.dec0());
-
-    o.EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
-
-    QDateTime midnight(KStarsData::Instance()->lt().date(), QTime());
-    KStarsDateTime dt = geo->LTtoUT(midnight);
-
-    QTime transitTime = o.transitTime(dt, geo);
-
-    appendLogText(i18n("%1 Transit time is %2", job->getName(), transitTime.toString()));
-
-    int dayOffset = 0;
-    if (KStarsData::Instance()->lt().time() > transitTime)
-        dayOffset = 1;
-
-    QDateTime observationDateTime(QDate::currentDate().addDays(dayOffset),
-                                  transitTime.addSecs(job->getCulminationOffset() * 60));
-
-    appendLogText(i18np("%1 Observation time is %2 adjusted for %3 minute.",
-                        "%1 Observation time is %2 adjusted for %3 minutes.", job->getName(),
-                        observationDateTime.toString(), job->getCulminationOffset()));
-
-    if (getDarkSkyScore(observationDateTime) < 0)
-    {
-        appendLogText(i18n("%1 culminates during the day and cannot be scheduled for observation.", job->getName()));
-        return false;
-    }
-
-    if (observationDateTime < (static_cast<QDateTime>(KStarsData::Instance()->lt())))
-    {
-        appendLogText(i18n("Observation time for %1 already passed.", job->getName()));
-        return false;
-    }
-
-    job->setStartupTime(observationDateTime);
-    job->setStartupCondition(SchedulerJob::START_AT);
-    return true;
-}
-
 void Scheduler::checkWeather()
 {
     if (weatherCheck->isEnabled() == false || weatherCheck->isChecked() == false)
@@ -1756,175 +1554,26 @@ int16_t Scheduler::getWeatherScore()
     return 0;
 }
 
-int16_t Scheduler::getDarkSkyScore(const QDateTime &observationDateTime)
-{
-    //  if (job->getStartingCondition() == SchedulerJob::START_CULMINATION)
-    //    return -1000;
-
-    int16_t score      = 0;
-    double dayFraction = 0;
-
-    // Anything half an hour before dawn shouldn't be a good candidate
-    double earlyDawn = Dawn - Options::preDawnTime() / (60.0 * 24.0);
-
-    dayFraction = observationDateTime.time().msecsSinceStartOfDay() / (24.0 * 60.0 * 60.0 * 1000.0);
-
-    // The farther the target from dawn, the better.
-    if (dayFraction > earlyDawn && dayFraction < Dawn)
-        score = BAD_SCORE / 50;
-    else if (dayFraction < Dawn)
-        score = (Dawn - dayFraction) * 100;
-    else if (dayFraction > Dusk)
-    {
-        score = (dayFraction - Dusk) * 100;
-    }
-    else
-        score = BAD_SCORE;
-
-    appendLogText(i18n("Dark sky score is %1 for time %2", score, observationDateTime.toString()));
-
-    return score;
-}
-
-int16_t Scheduler::calculateJobScore(SchedulerJob *job, QDateTime when)
-{
-    int16_t total = 0;
-
-    if (job->getEnforceTwilight())
-        total += getDarkSkyScore(when);
-    if (job->getStepPipeline() != SchedulerJob::USE_NONE)
-        total += getAltitudeScore(job, when);
-    total += getMoonSeparationScore(job, when);
-
-    return total;
-}
-
-int16_t Scheduler::getAltitudeScore(SchedulerJob *job, QDateTime when)
-{
-    int16_t score     = 0;
-    double currentAlt = findAltitude(job->getTargetCoords(), when);
-
-    if (currentAlt < 0)
-        score = BAD_SCORE;
-    // If minimum altitude is specified
-    else if (job->getMinAltitude() > 0)
-    {
-        // if current altitude is lower that's not good
-        if (currentAlt < job->getMinAltitude())
-            score = BAD_SCORE;
-        else
-        {
-            double HA = 0;
-
-            if (indiState == INDI_READY)
-            {
-                QDBusReply<double> haReply = mountInterface->call(QDBus::AutoDetect, "getHourAngle");
-                if (haReply.error().type() == QDBusError::NoError)
-                    HA = haReply.value();
-            }
-
-            // If already passed the merdian and setting we check if it is within setting alttidue cut off value (3 degrees default)
-            // If it is within that value then it is useless to start the job which will end very soon so we better look for a better job.
-            if (HA > 0 && (currentAlt - SETTING_ALTITUDE_CUTOFF) < job->getMinAltitude())
-                score = BAD_SCORE / 2.0;
-            else
-                // Otherwise, adjust score and add current altitude to score weight
-                score = (1.5 * pow(1.06, currentAlt)) - (minAltitude->minimum() / 10.0);
-        }
-    }
-    // If it's below minimum hard altitude (15 degrees now), set score to 10% of altitude value
-    else if (currentAlt < minAltitude->minimum())
-        score = currentAlt / 10.0;
-    // If no minimum altitude, then adjust altitude score to account for current target altitude
-    else
-        score = (1.5 * pow(1.06, currentAlt)) - (minAltitude->minimum() / 10.0);
-
-    appendLogText(i18n("%1 altitude at %2 is %3 degrees. %1 altitude score is %4.", job->getName(), when.toString(),
-                       QString::number(currentAlt, 'g', 3), score));
-
-    return score;
-}
-
 double Scheduler::getCurrentMoonSeparation(SchedulerJob *job)
 {
-    // Get target altitude given the time
-    SkyPoint p = job->getTargetCoords();
-    QDateTime midnight(KStarsData::Instance()->lt().date(), QTime());
-    KStarsDateTime ut   = geo->LTtoUT(midnight);
-    KStarsDateTime myUT = ut.addSecs(KStarsData::Instance()->lt().time().msecsSinceStartOfDay() / 1000);
-    CachingDms LST      = geo->GSTtoLST(myUT.gst());
-    p.EquatorialToHorizontal(&LST, geo->lat());
-
-    // Update moon
-    ut = geo->LTtoUT(KStarsData::Instance()->lt());
-    KSNumbers ksnum(ut.djd());
-    LST = geo->GSTtoLST(ut.gst());
-    moon->updateCoords(&ksnum, true, geo->lat(), &LST, true);
+    KStarsDateTime ut = geo->LTtoUT(KStarsData::Instance()->lt());
 
     // Moon/Sky separation p
-    return moon->angularDistanceTo(&p).Degrees();
+    return getEphemeris(ut, ut)->moonSeparation(job->getTargetCoords(), ut.djd());
 }
 
-int16_t Scheduler::getMoonSeparationScore(SchedulerJob *job, QDateTime when)
+QSharedPointer<const SchedulerEphemeris> Scheduler::getEphemeris(const KStarsDateTime &from, const KStarsDateTime &to)
 {
-    int16_t score = 0;
-
-    // Get target altitude given the time
-    SkyPoint p = job->getTargetCoords();
-    QDateTime midnight(when.date(), QTime());
-    KStarsDateTime ut   = geo->LTtoUT(midnight);
-    KStarsDateTime myUT = ut.addSecs(when.time().msecsSinceStartOfDay() / 1000);
-    CachingDms LST      = geo->GSTtoLST(myUT.gst());
-    p.EquatorialToHorizontal(&LST, geo->lat());
-    double currentAlt = p.alt().Degrees();
-
-    // Update moon
-    ut = geo->LTtoUT(when);
-    KSNumbers ksnum(ut.djd());
-    LST = geo->GSTtoLST(ut.gst());
-    moon->updateCoords(&ksnum, true, geo->lat(), &LST, true);
-
-    double moonAltitude = moon->alt().Degrees();
-
-    // Lunar illumination %
-    double illum = moon->illum() * 100.0;
-
-    // Moon/Sky separation p
-    double separation = moon->angularDistanceTo(&p).Degrees();
-
-    // Zenith distance of the moon
-    double zMoon = (90 - moonAltitude);
-    // Zenith distance of target
-    double zTarget = (90 - currentAlt);
-
-    // If target = Moon, or no illuminiation, or moon below horizon, return static score.
-    if (zMoon == zTarget || illum == 0 || zMoon >= 90)
-        score = 100;
-    else
+    if (ephemeris.isNull() || !ephemeris->covers(geo, from, to))
     {
-        // JM: Some magic voodoo formula I came up with!
-        double moonEffect = (pow(separation, 1.7) * pow(zMoon, 0.5)) / (pow(zTarget, 1.1) * pow(illum, 0.5));
-
-        // Limit to 0 to 100 range.
-        moonEffect = KSUtils::clamp(moonEffect, 0.0, 100.0);
+        // From the local midnight before from, over two days and a bit, which covers a whole evaluation of the jobs
+        KStarsDateTime midnight = geo->LTtoUT(KStarsDateTime(geo->UTtoLT(from).date(), QTime()));
+        double hours            = qMax(50.0, double(to.djd() - midnight.djd()) * 24.0 + 1.0);
 
-        if (job->getMinMoonSeparation() > 0)
-        {
-            if (separation < job->getMinMoonSeparation())
-                score = BAD_SCORE * 5;
-            else
-                score = moonEffect;
-        }
-        else
-            score = moonEffect;
+        ephemeris.reset(new SchedulerEphemeris(geo, midnight, hours));
     }
 
-    // Limit to 0 to 20
-    score /= 5.0;
-
-    appendLogText(i18n("%1 Moon score %2 (separation %3).", job->getName(), score, separation));
-
-    return score;
+    return ephemeris;
 }
 
 void Scheduler::calculateDawnDusk()
@@ -3995,12 +3644,13 @@ void Scheduler::setDirty()
         saveJob();
 }
 
-bool Scheduler::estimateJobTime(SchedulerJob *schedJob)
+bool Scheduler::estimateJobTime(JobEvaluation &evaluation) const
 {
+    SchedulerJob *schedJob = &evaluation.snapshot;
     QList<SequenceJob *> jobs;
     bool hasAutoFocus = false;
 
-    if (loadSequenceQueue(schedJob->getSequenceFile().toLocalFile(), schedJob, jobs, hasAutoFocus) == false)
+    if (loadSequenceQueue(schedJob->getSequenceFile().toLocalFile(), evaluation, jobs, hasAutoFocus) == false)
         return false;
 
     schedJob->setInSequenceFocus(hasAutoFocus);
@@ -4014,7 +3664,7 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob)
     {
         if (job->getUploadMode() == ISD::CCD::UPLOAD_LOCAL)
         {
-            appendLogText(i18n("Cannot estimate time since the sequence saves the files remotely."));
+            evaluation.log << i18n("Cannot estimate time since the sequence saves the files remotely.");
             schedJob->setEstimatedTime(-2);
             // Iterate over all jobs, if just one requires FRAME_LIGHT then we set it as is and return
             foreach (SequenceJob *oneJob, jobs)
@@ -4091,7 +3741,7 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob)
 
     if (totalCompletedCount > 0 && totalCompletedCount >= totalSequenceCount)
     {
-        appendLogText(i18n("%1 observation job is already complete.", schedJob->getName()));
+        evaluation.log << i18n("%1 observation job is already complete.", schedJob->getName());
         schedJob->setEstimatedTime(0);
         return true;
     }
@@ -4116,8 +3766,8 @@ bool Scheduler::estimateJobTime(SchedulerJob *schedJob)
 
     dms estimatedTime;
     estimatedTime.setH(totalImagingTime / 3600.0);
-    appendLogText(i18n("%1 observation job is estimated to take %2 to complete.", schedJob->getName(),
-                       estimatedTime.toHMSString()));
+    evaluation.log << i18n("%1 observation job is estimated to take %2 to complete.", schedJob->getName(),
+                           estimatedTime.toHMSString());
 
     schedJob->setEstimatedTime(totalImagingTime);
 
@@ -4523,37 +4173,6 @@ void Scheduler::updatePreDawn()
     preDawnDateTime.setTime(QTime::fromMSecsSinceStartOfDay(earlyDawn * 24 * 3600 * 1000));
 }
 
-bool Scheduler::isWeatherOK(SchedulerJob *job)
-{
-    if (weatherStatus == IPS_OK || weatherCheck->isChecked() == false)
-        return true;
-    else if (weatherStatus == IPS_IDLE)
-    {
-        if (indiState == INDI_READY)
-            appendLogText(i18n("Weather information is pending..."));
-        return true;
-    }
-
-    // Temporary BUSY is ALSO accepted for now
-    // TODO Figure out how to exactly handle this
-    if (weatherStatus == IPS_BUSY)
-        return true;
-
-    if (weatherStatus == IPS_ALERT)
-    {
-        job->setState(SchedulerJob::JOB_ABORTED);
-        appendLogText(i18n("%1 observation job aborted due to bad weather.", job->getName()));
-    }
-    /*else if (weatherStatus == IPS_BUSY)
-    {
-        appendLogText(i18n("%1 observation job delayed due to bad weather.", job->getName()));
-        schedulerTimer.stop();
-        connect(this, SIGNAL(weatherChanged(IPState)), this, SLOT(resumeCheckStatus()));
-    }*/
-
-    return false;
-}
-
 void Scheduler::resumeCheckStatus()
 {
     disconnect(this, SIGNAL(weatherChanged(IPState)), this, SLOT(resumeCheckStatus()));
@@ -4954,15 +4573,17 @@ void Scheduler::loadProfiles()
     }
 }
 
-bool Scheduler::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs,
-                                  bool &hasAutoFocus)
+bool Scheduler::loadSequenceQueue(const QString &fileURL, JobEvaluation &evaluation, QList<SequenceJob *> &jobs,
+                                  bool &hasAutoFocus) const
 {
+    SchedulerJob *schedJob = &evaluation.snapshot;
+
     QFile sFile;
     sFile.setFileName(fileURL);
 
     if (!sFile.open(QIODevice::ReadOnly))
     {
-        appendLogText(i18n("Unable to open file %1", fileURL));
+        evaluation.log << i18n("Unable to open file %1", fileURL);
         return false;
     }
 
@@ -4989,7 +4610,7 @@ bool Scheduler::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob
         }
         else if (errmsg[0])
         {
-            appendLogText(QString(errmsg));
+            evaluation.log << QString(errmsg);
             delLilXML(xmlParser);
             qDeleteAll(jobs);
             return false;
@@ -4999,7 +4620,7 @@ bool Scheduler::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob
     return true;
 }
 
-SequenceJob *Scheduler::processJobInfo(XMLEle *root, SchedulerJob *schedJob)
+SequenceJob *Scheduler::processJobInfo(XMLEle *root, SchedulerJob *schedJob) const
 {
     XMLEle *ep = nullptr;
     XMLEle *subEP = nullptr;
@@ -5105,26 +4726,8 @@ SequenceJob *Scheduler::processJobInfo(XMLEle *root, SchedulerJob *schedJob)
     return job;
 }
 
-int Scheduler::getCompletedFiles(const QString &path, const QString &seqPrefix)
+int Scheduler::getCompletedFiles(const QString &path, const QString &seqPrefix) const
 {
-    QString tempName;
-    int seqFileCount = 0;
-
-    QDirIterator it(path, QDir::Files);
-
-    while (it.hasNext())
-    {
-        tempName = it.next();
-        QFileInfo info(tempName);
-        tempName = info.baseName();
-
-        // find the prefix first
-        if (tempName.startsWith(seqPrefix) == false)
-            continue;
-
-        seqFileCount++;
-    }
-
-    return seqFileCount;
+    return CapturedFrames::Instance()->count(path, seqPrefix);
 }
 }
@@ -14,16 +14,19 @@
 
 #include <QMainWindow>
 #include <QtDBus/QtDBus>
+#include <QFutureWatcher>
 #include <QProcess>
+#include <QSharedPointer>
 
 #include "ui_scheduler.h"
 #include "scheduler.h"
+#include "schedulerevaluation.h"
 #include "schedulerjob.h"
 #include "auxiliary/QProgressIndicator.h"
 #include "ekos/align/align.h"
 
-class KSMoon;
 class GeoLocation;
+class KStarsDateTime;
 class SkyObject;
 
 namespace Ekos
@@ -301,6 +304,11 @@ class Scheduler : public QWidget, public Ui::Scheduler
          */
     void startJobEvaluation();
 
+    /**
+         * @brief finishEvaluation Merge the evaluated jobs back into the queue, then select the best job to execute
+         */
+    void finishEvaluation();
+
     /**
          * @brief startMosaicTool Start Mosaic tool and create jobs if necessary.
          */
@@ -323,12 +331,22 @@ class Scheduler : public QWidget, public Ui::Scheduler
     void newTarget(const QString &);
 
   private:
+    typedef SchedulerEvaluation::EvaluationContext EvaluationContext;
+    typedef SchedulerEvaluation::JobEvaluation JobEvaluation;
+
     /**
          * @brief evaluateJobs evaluates the current state of each objects and gives each one a score based on the constraints.
-         * Given that score, the scheduler will decide which is the best job that needs to be executed.
+         * Given that score, the scheduler will decide which is the best job that needs to be executed. Jobs are scored
+         * across the global thread pool, and finishEvaluation() is called once all of them are scored.
          */
     void evaluateJobs();
 
+    /**
+         * @brief prepareEvaluation Gather the evaluation context, on the GUI thread
+         * @param lastStartupTime Latest startup time of the jobs to evaluate, in local time
+         */
+    void prepareEvaluation(const QDateTime &lastStartupTime);
+
     /**
          * @brief executeJob After the best job is selected, we call this in order to start the process that will execute the job.
          * checkJobStatus slot will be connected in order to figure the exact state of the current job each second
@@ -338,54 +356,12 @@ class Scheduler : public QWidget, public Ui::Scheduler
 
     void executeScript(const QString &filename);
 
-    int16_t getDarkSkyScore(const QDateTime &observationDateTime);
-
-    /**
-         * @brief getAltitudeScore Get the altitude score of an object. The higher the better
-         * @param job Active job
-         * @param when At what time to check the target altitude
-         * @return Altitude score. Altitude below minimum default of 15 degrees but above horizon get -20 score. Bad altitude below minimum required altitude or below horizon get -1000 score.
-         */
-    int16_t getAltitudeScore(SchedulerJob *job, QDateTime when);
-
-    /**
-         * @brief getMoonSeparationScore Get moon separation score. The further apart, the better, up a maximum score of 20.
-         * @param job Target job
-         * @param when What time to check the moon separation?
-         * @return Moon separation score
-         */
-    int16_t getMoonSeparationScore(SchedulerJob *job, QDateTime when);
-
-    /**
-         * @brief calculateJobScore Calculate job dark sky score, altitude score, and moon separation scores and returns the sum.
-         * @param job job to evaluate
-         * @param when time to evaluate constraints
-         * @return Total score
-         */
-    int16_t calculateJobScore(SchedulerJob *job, QDateTime when);
-
     /**
          * @brief getWeatherScore Get weather condition score.
          * @return If weather condition OK, return 0, if warning return -500, if alert return -1000
          */
     int16_t getWeatherScore();
 
-    /**
-         * @brief calculateAltitudeTime calculate the altitude time given the minimum altitude given.
-         * @param job active target
-         * @param minAltitude minimum altitude required
-         * @param minMoonAngle minimum separation from the moon. -1 to ignore.
-         * @return True if found a time in the night where the object is at or above the minimum altitude, false otherise.
-         */
-    bool calculateAltitudeTime(SchedulerJob *job, double minAltitude, double minMoonAngle = -1);
-
-    /**
-         * @brief calculateCulmination find culmination time adjust for the job offset
-         * @param job Active job
-         * @return True if culmination time adjust for offset is a valid time in the night
-         */
-    bool calculateCulmination(SchedulerJob *job);
-
     /**
          * @brief calculateDawnDusk Get dawn and dusk times for today
          */
@@ -497,6 +473,14 @@ class Scheduler : public QWidget, public Ui::Scheduler
          */
     double getCurrentMoonSeparation(SchedulerJob *job);
 
+    /**
+         * @brief getEphemeris Get the ephemeris of the Moon and local sidereal time over a span of time
+         * @param from Start of the span, in UT
+         * @param to End of the span, in UT
+         * @return An ephemeris that covers the span at the current location, computed again if the last one does not
+         */
+    QSharedPointer<const SchedulerEphemeris> getEphemeris(const KStarsDateTime &from, const KStarsDateTime &to);
+
     /**
          * @brief updatePreDawn Update predawn time depending on current time and user offset
          */
@@ -504,10 +488,10 @@ class Scheduler : public QWidget, public Ui::Scheduler
 
     /**
          * @brief estimateJobTime Estimates the time the job takes to complete based on the sequence file and what modules to utilize during the observation run.
-         * @param job target job
+         * @param evaluation target job
          * @return Estimated time in seconds.
          */
-    bool estimateJobTime(SchedulerJob *schedJob);
+    bool estimateJobTime(JobEvaluation &evaluation) const;
 
     /**
          * @brief createJobSequence Creates a job sequence for the mosaic tool given the prefix and output dir. The currently selected sequence file is modified
@@ -522,12 +506,10 @@ class Scheduler : public QWidget, public Ui::Scheduler
 
     XMLEle *getSequenceJobRoot();
 
-    bool isWeatherOK(SchedulerJob *job);
-
-    SequenceJob *processJobInfo(XMLEle *root, SchedulerJob *schedJob);
-    bool loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs,
-                           bool &hasAutoFocus);
-    int getCompletedFiles(const QString &path, const QString &seqPrefix);
+    SequenceJob *processJobInfo(XMLEle *root, SchedulerJob *schedJob) const;
+    bool loadSequenceQueue(const QString &fileURL, JobEvaluation &evaluation, QList<SequenceJob *> &jobs,
+                           bool &hasAutoFocus) const;
+    int getCompletedFiles(const QString &path, const QString &seqPrefix) const;
 
     Ekos::Scheduler *ui;
 
@@ -564,8 +546,12 @@ class Scheduler : public QWidget, public Ui::Scheduler
     QProgressIndicator *pi; // Busy indicator widget
     int jobUnderEdit;       // Are we editing a job right now? Job row index
 
-    KSMoon *moon;     // Pointer to Moon object
-    GeoLocation *geo; // Pointer to Geograpic locatoin
+    QSharedPointer<const SchedulerEphemeris> ephemeris; // Moon and local sidereal time over the nights being scheduled
+    EvaluationContext evaluationContext;                // Read by the evaluation of jobs
+    QVector<JobEvaluation> evaluations;                 // Jobs being evaluated across the global thread pool
+    QFutureWatcher<void> evaluationWatcher;             // Finishes once all the evaluations are done
+    bool evaluating = false;                            // Whether jobs are being scored, until finishEvaluation()
+    GeoLocation *geo;                                   // Pointer to Geograpic locatoin
 
     uint16_t captureBatch; // How many repeated job batches did we complete thus far?
 
@@ -0,0 +1,186 @@
+/*  Ekos Scheduler Ephemeris
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "schedulerephemeris.h"
+
+#include "geolocation.h"
+#include "ksmoon.h"
+#include "ksnumbers.h"
+#include "kssun.h"
+#include "skypoint.h"
+
+#include <QtMath>
+
+namespace
+{
+// Minutes between two samples. The Moon moves by about 5 arcminutes in that time, along a path that is straight enough
+// for linear interpolation to be good to a few arcseconds.
+const int STEP_MINUTES = 10;
+
+// Times between two checks of the condition in findFirst()
+const int STRIDE = 10;
+}
+
+namespace Ekos
+{
+SchedulerEphemeris::SchedulerEphemeris(const GeoLocation *geo, const KStarsDateTime &start, double hours)
+    : longitude(geo->lng()->Degrees()), latitude(geo->lat()->Degrees())
+{
+    const int count = qCeil(hours * 60.0 / STEP_MINUTES) + 1;
+
+    startJD = start.djd();
+    endJD   = startJD + (count - 1) * STEP_MINUTES / (24.0 * 60.0);
+    geo->lat()->SinCos(sinLat, cosLat);
+
+    lstSamples.reserve(count);
+    moonSamples.reserve(count);
+
+    // Our own Sun and Moon, as KSAlmanac does, so that the ones on the sky map are left alone
+    KSSun sun;
+    KSMoon moon;
+
+    for (int i = 0; i < count; ++i)
+    {
+        KStarsDateTime ut = start.addSecs(i * STEP_MINUTES * 60.0);
+        KSNumbers num(ut.djd());
+        CachingDms LST = geo->GSTtoLST(ut.gst());
+
+        sun.updateCoords(&num, true, geo->lat(), &LST, true);
+        moon.updateCoords(&num, true, geo->lat(), &LST, true);
+        moon.findPhase(&sun);
+
+        double lst = LST.Degrees();
+        while (!lstSamples.isEmpty() && lst < lstSamples.last())
+            lst += 360.0;
+        lstSamples.append(lst);
+
+        double sinRA, cosRA, sinDec, cosDec;
+        moon.ra().SinCos(sinRA, cosRA);
+        moon.dec().SinCos(sinDec, cosDec);
+
+        MoonSample sample;
+        sample.x            = cosDec * cosRA;
+        sample.y            = cosDec * sinRA;
+        sample.z            = sinDec;
+        sample.illumination = moon.illum();
+        moonSamples.append(sample);
+    }
+}
+
+bool SchedulerEphemeris::covers(const GeoLocation *geo, const KStarsDateTime &from, const KStarsDateTime &to) const
+{
+    return geo->lng()->Degrees() == longitude && geo->lat()->Degrees() == latitude && from.djd() >= startJD &&
+           to.djd() <= endJD;
+}
+
+int SchedulerEphemeris::sampleAt(long double jd, double *fraction) const
+{
+    double step = double(jd - startJD) * (24.0 * 60.0) / STEP_MINUTES;
+    int i       = qBound(0, int(floor(step)), lstSamples.size() - 2);
+
+    *fraction = step - i;
+    return i;
+}
+
+double SchedulerEphemeris::lst(long double jd) const
+{
+    double f;
+    int i = sampleAt(jd, &f);
+
+    double lst = lstSamples[i] + f * (lstSamples[i + 1] - lstSamples[i]);
+    return lst - 360.0 * floor(lst / 360.0);
+}
+
+double SchedulerEphemeris::altitude(const SkyPoint &target, long double jd) const
+{
+    double sinDec, cosDec;
+    target.dec().SinCos(sinDec, cosDec);
+
+    double HA     = (lst(jd) - target.ra().Degrees()) * dms::DegToRad;
+    double sinAlt = sinDec * sinLat + cosDec * cosLat * cos(HA);
+
+    return asin(sinAlt) / dms::DegToRad;
+}
+
+SchedulerEphemeris::MoonState SchedulerEphemeris::moon(long double jd) const
+{
+    double f;
+    int i = sampleAt(jd, &f);
+
+    const MoonSample &a = moonSamples[i];
+    const MoonSample &b = moonSamples[i + 1];
+
+    double x = a.x + f * (b.x - a.x), y = a.y + f * (b.y - a.y), z = a.z + f * (b.z - a.z);
+    double r = sqrt(x * x + y * y + z * z);
+
+    MoonState state;
+    state.ra           = atan2(y, x) / dms::DegToRad;
+    state.ra           = state.ra - 360.0 * floor(state.ra / 360.0);
+    state.dec          = asin(z / r) / dms::DegToRad;
+    state.illumination = a.illumination + f * (b.illumination - a.illumination);
+
+    double HA     = (lst(jd) - state.ra) * dms::DegToRad;
+    double sinAlt = (z / r) * sinLat + (sqrt(x * x + y * y) / r) * cosLat * cos(HA);
+
+    state.altitude = asin(sinAlt) / dms::DegToRad;
+
+    return state;
+}
+
+double SchedulerEphemeris::moonSeparation(const SkyPoint &target, long double jd) const
+{
+    double f;
+    int i = sampleAt(jd, &f);
+
+    const MoonSample &a = moonSamples[i];
+    const MoonSample &b = moonSamples[i + 1];
+
+    double x = a.x + f * (b.x - a.x), y = a.y + f * (b.y - a.y), z = a.z + f * (b.z - a.z);
+    double r = sqrt(x * x + y * y + z * z);
+
+    double sinRA, cosRA, sinDec, cosDec;
+    target.ra().SinCos(sinRA, cosRA);
+    target.dec().SinCos(sinDec, cosDec);
+
+    // Half the chord between the two points, to stay accurate for small separations
+    double dx = x / r - cosDec * cosRA, dy = y / r - cosDec * sinRA, dz = z / r - sinDec;
+    double halfChord = 0.5 * sqrt(dx * dx + dy * dy + dz * dz);
+
+    return 2.0 * asin(qMin(halfChord, 1.0)) / dms::DegToRad;
+}
+
+int SchedulerEphemeris::findFirst(int count, const std::function<bool(int)> &condition)
+{
+    // The condition does not hold at previous, or previous is before the first time
+    int previous = -1;
+
+    while (previous < count - 1)
+    {
+        int next = qMin(previous + STRIDE, count - 1);
+
+        if (condition(next))
+        {
+            while (next - previous > 1)
+            {
+                int middle = (previous + next) / 2;
+
+                if (condition(middle))
+                    next = middle;
+                else
+                    previous = middle;
+            }
+            return next;
+        }
+
+        previous = next;
+    }
+
+    return -1;
+}
+}
@@ -0,0 +1,103 @@
+/*  Ekos Scheduler Ephemeris
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include "kstarsdatetime.h"
+
+#include <QVector>
+
+#include <functional>
+
+class GeoLocation;
+class SkyPoint;
+
+namespace Ekos
+{
+/**
+ * @class SchedulerEphemeris
+ * @short Local sidereal time, Moon and Sun over a couple of nights, sampled once for all the jobs of the scheduler.
+ *
+ * The Sun and the Moon are computed every few minutes of the span when the ephemeris is made. The altitude of a
+ * target, and the position of the Moon, at any time of the span are then interpolated from these samples, instead of
+ * updating a KSMoon and converting coordinates every time the scheduler looks at a job. An ephemeris is not changed
+ * after it is made, so that it can be read from several threads.
+ *
+ * @author agent
+ */
+class SchedulerEphemeris
+{
+  public:
+    /** Position and phase of the Moon */
+    typedef struct
+    {
+        double ra;           // Topocentric right ascension, in degrees
+        double dec;          // Topocentric declination, in degrees
+        double altitude;     // In degrees
+        double illumination; // Illuminated fraction of the disk, from 0 to 1
+    } MoonState;
+
+    /**
+     * @brief SchedulerEphemeris Sample the sky over a span of time
+     * @param geo Location of the observatory
+     * @param start Start of the span, in UT
+     * @param hours Length of the span
+     */
+    SchedulerEphemeris(const GeoLocation *geo, const KStarsDateTime &start, double hours);
+
+    /**
+     * @return True if the ephemeris was made for the location of geo, and its span goes from before from to after to
+     */
+    bool covers(const GeoLocation *geo, const KStarsDateTime &from, const KStarsDateTime &to) const;
+
+    /** @return Local sidereal time at jd, in degrees */
+    double lst(long double jd) const;
+
+    /** @return Altitude of target at jd, in degrees, without refraction, as SkyPoint::EquatorialToHorizontal finds */
+    double altitude(const SkyPoint &target, long double jd) const;
+
+    /** @return Position and phase of the Moon at jd */
+    MoonState moon(long double jd) const;
+
+    /** @return Angular distance between target and the Moon at jd, in degrees */
+    double moonSeparation(const SkyPoint &target, long double jd) const;
+
+    /**
+     * @brief findFirst Find the first of count consecutive times at which a condition holds
+     *
+     * The condition is only checked every few times, and where it starts to hold is then found by bisection. A
+     * condition that holds for a shorter while than that may be missed, which does not happen with altitudes and
+     * Moon separations, that change over hours.
+     *
+     * @param count Number of times
+     * @param condition Whether the condition holds at the time of the given index
+     * @return Index of the first time at which the condition holds, or -1 if it never does
+     */
+    static int findFirst(int count, const std::function<bool(int)> &condition);
+
+  private:
+    /** Position of the Moon as a unit vector, and its illuminated fraction */
+    typedef struct
+    {
+        double x, y, z;
+        double illumination;
+    } MoonSample;
+
+    /** Index of the sample just before jd, and fraction of the step from there to jd */
+    int sampleAt(long double jd, double *fraction) const;
+
+    long double startJD, endJD;
+    double longitude, latitude;
+    double sinLat, cosLat;
+
+    /** Local sidereal times of the samples in degrees, growing without wrapping around */
+    QVector<double> lstSamples;
+    QVector<MoonSample> moonSamples;
+};
+}
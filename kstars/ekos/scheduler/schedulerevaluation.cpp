@@ -0,0 +1,550 @@
+/*  Ekos Scheduler Evaluation
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "schedulerevaluation.h"
+
+#include "geolocation.h"
+#include "ksutils.h"
+#include "schedulerephemeris.h"
+#include "skyobjects/skyobject.h"
+
+#include <KLocalizedString>
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+#define SETTING_ALTITUDE_CUTOFF 3
+
+namespace Ekos
+{
+namespace SchedulerEvaluation
+{
+QFuture<void> evaluate(const EvaluationContext &context, QVector<JobEvaluation> &evaluations)
+{
+    return QtConcurrent::map(evaluations, [&context](JobEvaluation &evaluation) { evaluateJob(context, evaluation); });
+}
+
+void evaluateJob(const EvaluationContext &context, JobEvaluation &evaluation)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+
+    if (job->getState() == SchedulerJob::JOB_IDLE)
+        job->setState(SchedulerJob::JOB_EVALUATION);
+
+    if (job->getCompletionCondition() == SchedulerJob::FINISH_REPEAT)
+    {
+        if (job->getRepeatsRemaining() == 0)
+        {
+            evaluation.log << i18n("%1 observation job has no more runs remaining.", job->getName());
+            job->setState(SchedulerJob::JOB_INVALID);
+            return;
+        }
+    }
+
+    int16_t score = 0;
+
+    QDateTime now = context.now;
+
+    // -1 = Job is not estimated yet
+    // -2 = Job is estimated but time is unknown
+    // > 0  Job is estimated and time is known
+    if (job->getEstimatedTime() == -1)
+    {
+        if (context.estimateJobTime(evaluation) == false)
+        {
+            job->setState(SchedulerJob::JOB_INVALID);
+            return;
+        }
+
+        if (job->getEstimatedTime() == 0)
+        {
+            job->setState(SchedulerJob::JOB_COMPLETE);
+            return;
+        }
+    }
+
+    // #1 Check startup conditions
+    switch (job->getStartupCondition())
+    {
+        // #1.1 ASAP?
+        case SchedulerJob::START_ASAP:
+            // If not light frames are required, run it now
+            if (job->getLightFramesRequired())
+                score = calculateJobScore(context, evaluation, now);
+            else
+                score = 1000;
+
+            job->setScore(score);
+
+            // If we can't start now, let's schedule it
+            if (score < 0)
+            {
+                // If Altitude or Dark score are negative, we try to schedule a better time for altitude and dark sky period.
+                if (calculateAltitudeTime(context, evaluation, job->getMinAltitude() > 0 ? job->getMinAltitude() : 0,
+                                          job->getMinMoonSeparation()))
+                {
+                    //appendLogText(i18n("%1 observation job is scheduled at %2", job->getName(), job->getStartupTime().toString()));
+                    job->setState(SchedulerJob::JOB_SCHEDULED);
+                    // Since it's scheduled, we need to skip it now and re-check it later since its startup condition changed to START_AT
+                    job->setScore(BAD_SCORE);
+                    return;
+                }
+                else
+                {
+                    job->setState(SchedulerJob::JOB_INVALID);
+                    evaluation.log << i18n("Ekos failed to schedule %1.", job->getName());
+                }
+            }
+            else if (isWeatherOK(context, evaluation) == false)
+                job->setScore(BAD_SCORE);
+            else
+                evaluation.log << i18n("%1 observation job is due to run as soon as possible.", job->getName());
+            break;
+
+        // #1.2 Culmination?
+        case SchedulerJob::START_CULMINATION:
+            if (calculateCulmination(context, evaluation))
+            {
+                evaluation.log << i18n("%1 observation job is scheduled at %2", job->getName(),
+                                       job->getStartupTime().toString());
+                job->setState(SchedulerJob::JOB_SCHEDULED);
+                // Since it's scheduled, we need to skip it now and re-check it later since its startup condition changed to START_AT
+                job->setScore(BAD_SCORE);
+                return;
+            }
+            else
+                job->setState(SchedulerJob::JOB_INVALID);
+            break;
+
+        // #1.3 Start at?
+        case SchedulerJob::START_AT:
+        {
+            if (job->getCompletionCondition() == SchedulerJob::FINISH_AT)
+            {
+                if (job->getStartupTime().secsTo(job->getCompletionTime()) <= 0)
+                {
+                    evaluation.log << i18n("%1 completion time (%2) is earlier than start up time (%3)",
+                                           job->getName(), job->getCompletionTime().toString(),
+                                           job->getStartupTime().toString());
+                    job->setState(SchedulerJob::JOB_INVALID);
+                    return;
+                }
+            }
+
+            QDateTime startupTime = job->getStartupTime();
+            int timeUntil         = now.secsTo(startupTime);
+            // If starting time already passed by 5 minutes (default), we mark the job as invalid
+            if (timeUntil < (-1 * context.leadTime * 60))
+            {
+                dms passedUp(timeUntil / 3600.0);
+                if (job->getState() == SchedulerJob::JOB_EVALUATION)
+                {
+                    evaluation.log << i18n("%1 startup time already passed by %2. Job is marked as invalid.",
+                                           job->getName(), passedUp.toHMSString());
+                    job->setState(SchedulerJob::JOB_INVALID);
+                }
+                else
+                {
+                    evaluation.log << i18n("%1 startup time already passed by %2. Aborting job...", job->getName(),
+                                           passedUp.toHMSString());
+                    job->setState(SchedulerJob::JOB_ABORTED);
+                }
+
+                return;
+            }
+            // Start scoring once we reach startup time
+            else if (timeUntil <= 0)
+            {
+                /*score += getAltitudeScore(job, now);
+                score += getMoonSeparationScore(job, now);
+                score += getDarkSkyScore(now);*/
+                score = calculateJobScore(context, evaluation, now);
+
+                if (score < 0)
+                {
+                    if (job->getState() == SchedulerJob::JOB_EVALUATION)
+                    {
+                        evaluation.log << i18n(
+                            "%1 observation job evaluation failed with a score of %2. Aborting job...", job->getName(),
+                            score);
+                        job->setState(SchedulerJob::JOB_INVALID);
+                    }
+                    else
+                    {
+                        evaluation.log << i18n(
+                            "%1 observation job updated score is %2 %3 seconds after startup time. Aborting job...",
+                            job->getName(), abs(timeUntil), score);
+                        job->setState(SchedulerJob::JOB_ABORTED);
+                    }
+
+                    return;
+                }
+                // If job is already scheduled, we check the weather, and if it is not OK, we set bad score until weather improves.
+                else if (isWeatherOK(context, evaluation) == false)
+                    score += BAD_SCORE;
+            }
+            // If it is in the future and originally was designated as ASAP job
+            // Job must be less than 12 hours away to be considered for re-evaluation
+            else if (timeUntil > (context.leadTime * 60) && (timeUntil < 12 * 3600) &&
+                     job->getFileStartupCondition() == SchedulerJob::START_ASAP)
+            {
+                QDateTime nextJobTime = now.addSecs(context.leadTime * 60);
+                if (job->getEnforceTwilight() == false ||
+                    (now > context.duskDateTime && now < context.preDawnDateTime))
+                    job->setStartupTime(nextJobTime);
+                score += BAD_SCORE;
+            }
+            // If time is far in the future, we make the score negative
+            else
+            {
+                if (job->getState() == SchedulerJob::JOB_EVALUATION &&
+                    calculateJobScore(context, evaluation, job->getStartupTime()) < 0)
+                {
+                    evaluation.log << i18n("%1 observation job evaluation failed with a score of %2. Aborting job...",
+                                           job->getName(), score);
+                    job->setState(SchedulerJob::JOB_INVALID);
+                    return;
+                }
+
+                score += BAD_SCORE;
+            }
+
+            job->setScore(score);
+        }
+        break;
+    }
+
+    // appendLogText(i18n("Job total score is %1", score));
+
+    //if (score > 0 && job->getState() == SchedulerJob::JOB_EVALUATION)
+    if (job->getState() == SchedulerJob::JOB_EVALUATION)
+        job->setState(SchedulerJob::JOB_SCHEDULED);
+}
+
+double findAltitude(const EvaluationContext &context, const SkyPoint &target, const QDateTime &when)
+{
+    // Make a copy
+    SkyPoint p = target;
+    QDateTime lt(when.date(), QTime());
+    KStarsDateTime ut = context.geo->LTtoUT(lt);
+
+    KStarsDateTime myUT = ut.addSecs(when.time().msecsSinceStartOfDay() / 1000);
+
+    CachingDms LST = context.geo->GSTtoLST(myUT.gst());
+    p.EquatorialToHorizontal(&LST, context.geo->lat());
+
+    return p.alt().Degrees();
+}
+
+bool calculateAltitudeTime(const EvaluationContext &context, JobEvaluation &evaluation, double minAltitude,
+                           double minMoonAngle)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+
+    // We wouldn't stat observation 30 mins (default) before dawn.
+    double earlyDawn = context.dawn - context.preDawnTime / (60.0 * 24.0);
+    QDateTime lt(context.now.date(), QTime());
+    KStarsDateTime ut = context.geo->LTtoUT(lt);
+
+    SkyPoint target = job->getTargetCoords();
+
+    QTime now       = context.now.time();
+    double fraction = now.hour() + now.minute() / 60.0 + now.second() / 3600;
+
+    // Look at each minute of the next 24 hours, through an ephemeris rather than by converting coordinates every time
+    const int minutes                   = 24 * 60;
+    KStarsDateTime startUT              = ut.addSecs(fraction * 3600.0);
+    const SchedulerEphemeris *ephemeris = context.ephemeris.data();
+
+    auto dayFraction = [fraction](int minute) {
+        double hour = fraction + minute / 60.0;
+        return (hour > 24 ? (hour - 24) : hour) / 24.0;
+    };
+    auto julianDay = [&startUT](int minute) { return startUT.djd() + minute / (24.0L * 60.0L); };
+
+    // The first minute of the night where the target is above minAltitude ends the search if it is too close to
+    // dawn. Otherwise the search goes on until the moon is also far enough.
+    int minute = SchedulerEphemeris::findFirst(minutes, [&](int minute) {
+        double rawFrac = dayFraction(minute);
+
+        if ((rawFrac >= context.dawn && rawFrac <= context.dusk) ||
+            ephemeris->altitude(target, julianDay(minute)) <= minAltitude)
+            return false;
+        if (rawFrac > earlyDawn && rawFrac < context.dawn)
+            return true;
+        return minMoonAngle <= 0 || moonSeparationScore(ephemeris, job, julianDay(minute)) >= 0;
+    });
+
+    if (minute >= 0)
+    {
+        KStarsDateTime myUT = startUT.addSecs(minute * 60.0);
+        QDateTime startTime = context.geo->UTtoLT(myUT);
+        double rawFrac      = dayFraction(minute);
+        double altitude     = ephemeris->altitude(target, julianDay(minute));
+
+        if (rawFrac > earlyDawn && rawFrac < context.dawn)
+        {
+            evaluation.log << i18n("%1 reaches an altitude of %2 degrees at %3 but will not be scheduled due to "
+                                   "close proximity to astronomical twilight rise.",
+                                   job->getName(), QString::number(minAltitude, 'g', 3), startTime.toString());
+            return false;
+        }
+
+        job->setStartupTime(startTime);
+        job->setStartupCondition(SchedulerJob::START_AT);
+        evaluation.log << i18n("%1 is scheduled to start at %2 where its altitude is %3 degrees.", job->getName(),
+                               startTime.toString(), QString::number(altitude, 'g', 3));
+        return true;
+    }
+
+    if (minMoonAngle == -1)
+        evaluation.log << i18n("No night time found for %1 to rise above minimum altitude of %2 degrees.",
+                               job->getName(), QString::number(minAltitude, 'g', 3));
+    else
+        evaluation.log << i18n("No night time found for %1 to rise above minimum altitude of %2 degrees with minimum "
+                               "moon separation of %3 degrees.",
+                               job->getName(), QString::number(minAltitude, 'g', 3),
+                               QString::number(minMoonAngle, 'g', 3));
+    return false;
+}
+
+bool calculateCulmination(const EvaluationContext &context, JobEvaluation &evaluation)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+    SkyPoint target   = job->getTargetCoords();
+
+    SkyObject o;
+
+    o.setRA0(target.ra0());
+    o.setDec0(target.dec0());
+
+    o.EquatorialToHorizontal(&context.lst, context.geo->lat());
+
+    QDateTime midnight(context.now.date(), QTime());
+    KStarsDateTime dt = context.geo->LTtoUT(midnight);
+
+    QTime transitTime = o.transitTime(dt, context.geo);
+
+    evaluation.log << i18n("%1 Transit time is %2", job->getName(), transitTime.toString());
+
+    int dayOffset = 0;
+    if (context.now.time() > transitTime)
+        dayOffset = 1;
+
+    QDateTime observationDateTime(QDate::currentDate().addDays(dayOffset),
+                                  transitTime.addSecs(job->getCulminationOffset() * 60));
+
+    evaluation.log << i18np("%1 Observation time is %2 adjusted for %3 minute.",
+                            "%1 Observation time is %2 adjusted for %3 minutes.", job->getName(),
+                            observationDateTime.toString(), job->getCulminationOffset());
+
+    if (getDarkSkyScore(context, evaluation, observationDateTime) < 0)
+    {
+        evaluation.log << i18n("%1 culminates during the day and cannot be scheduled for observation.",
+                               job->getName());
+        return false;
+    }
+
+    if (observationDateTime < context.now)
+    {
+        evaluation.log << i18n("Observation time for %1 already passed.", job->getName());
+        return false;
+    }
+
+    job->setStartupTime(observationDateTime);
+    job->setStartupCondition(SchedulerJob::START_AT);
+    return true;
+}
+
+int16_t getDarkSkyScore(const EvaluationContext &context, JobEvaluation &evaluation,
+                        const QDateTime &observationDateTime)
+{
+    //  if (job->getStartingCondition() == SchedulerJob::START_CULMINATION)
+    //    return -1000;
+
+    int16_t score      = 0;
+    double dayFraction = 0;
+
+    // Anything half an hour before dawn shouldn't be a good candidate
+    double earlyDawn = context.dawn - context.preDawnTime / (60.0 * 24.0);
+
+    dayFraction = observationDateTime.time().msecsSinceStartOfDay() / (24.0 * 60.0 * 60.0 * 1000.0);
+
+    // The farther the target from dawn, the better.
+    if (dayFraction > earlyDawn && dayFraction < context.dawn)
+        score = BAD_SCORE / 50;
+    else if (dayFraction < context.dawn)
+        score = (context.dawn - dayFraction) * 100;
+    else if (dayFraction > context.dusk)
+    {
+        score = (dayFraction - context.dusk) * 100;
+    }
+    else
+        score = BAD_SCORE;
+
+    evaluation.log << i18n("Dark sky score is %1 for time %2", score, observationDateTime.toString());
+
+    return score;
+}
+
+int16_t calculateJobScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+    int16_t total     = 0;
+
+    if (job->getEnforceTwilight())
+        total += getDarkSkyScore(context, evaluation, when);
+    if (job->getStepPipeline() != SchedulerJob::USE_NONE)
+        total += getAltitudeScore(context, evaluation, when);
+    total += getMoonSeparationScore(context, evaluation, when);
+
+    return total;
+}
+
+int16_t getAltitudeScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+    int16_t score     = 0;
+    double currentAlt = findAltitude(context, job->getTargetCoords(), when);
+
+    if (currentAlt < 0)
+        score = BAD_SCORE;
+    // If minimum altitude is specified
+    else if (job->getMinAltitude() > 0)
+    {
+        // if current altitude is lower that's not good
+        if (currentAlt < job->getMinAltitude())
+            score = BAD_SCORE;
+        else
+        {
+            double HA = context.mountHourAngle;
+
+            // If already passed the merdian and setting we check if it is within setting alttidue cut off value (3 degrees default)
+            // If it is within that value then it is useless to start the job which will end very soon so we better look for a better job.
+            if (HA > 0 && (currentAlt - SETTING_ALTITUDE_CUTOFF) < job->getMinAltitude())
+                score = BAD_SCORE / 2.0;
+            else
+                // Otherwise, adjust score and add current altitude to score weight
+                score = (1.5 * pow(1.06, currentAlt)) - (context.minAltitude / 10.0);
+        }
+    }
+    // If it's below minimum hard altitude (15 degrees now), set score to 10% of altitude value
+    else if (currentAlt < context.minAltitude)
+        score = currentAlt / 10.0;
+    // If no minimum altitude, then adjust altitude score to account for current target altitude
+    else
+        score = (1.5 * pow(1.06, currentAlt)) - (context.minAltitude / 10.0);
+
+    evaluation.log << i18n("%1 altitude at %2 is %3 degrees. %1 altitude score is %4.", job->getName(),
+                           when.toString(), QString::number(currentAlt, 'g', 3), score);
+
+    return score;
+}
+
+int16_t getMoonSeparationScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+    KStarsDateTime ut = context.geo->LTtoUT(when);
+    double separation = 0;
+    int16_t score     = moonSeparationScore(context.ephemeris.data(), job, ut.djd(), &separation);
+
+    evaluation.log << i18n("%1 Moon score %2 (separation %3).", job->getName(), score, separation);
+
+    return score;
+}
+
+int16_t moonSeparationScore(const SchedulerEphemeris *ephemeris, SchedulerJob *job, long double jd,
+                            double *separation)
+{
+    int16_t score = 0;
+
+    // Get target altitude given the time
+    SkyPoint p        = job->getTargetCoords();
+    double currentAlt = ephemeris->altitude(p, jd);
+
+    SchedulerEphemeris::MoonState moon = ephemeris->moon(jd);
+
+    double moonAltitude = moon.altitude;
+
+    // Lunar illumination %
+    double illum = moon.illumination * 100.0;
+
+    // Moon/Sky separation p
+    double moonSeparation = ephemeris->moonSeparation(p, jd);
+    if (separation)
+        *separation = moonSeparation;
+
+    // Zenith distance of the moon
+    double zMoon = (90 - moonAltitude);
+    // Zenith distance of target
+    double zTarget = (90 - currentAlt);
+
+    // If target = Moon, or no illuminiation, or moon below horizon, return static score.
+    if (zMoon == zTarget || illum == 0 || zMoon >= 90)
+        score = 100;
+    else
+    {
+        // JM: Some magic voodoo formula I came up with!
+        double moonEffect = (pow(moonSeparation, 1.7) * pow(zMoon, 0.5)) / (pow(zTarget, 1.1) * pow(illum, 0.5));
+
+        // Limit to 0 to 100 range.
+        moonEffect = KSUtils::clamp(moonEffect, 0.0, 100.0);
+
+        if (job->getMinMoonSeparation() > 0)
+        {
+            if (moonSeparation < job->getMinMoonSeparation())
+                score = BAD_SCORE * 5;
+            else
+                score = moonEffect;
+        }
+        else
+            score = moonEffect;
+    }
+
+    // Limit to 0 to 20
+    score /= 5.0;
+
+    return score;
+}
+
+bool isWeatherOK(const EvaluationContext &context, JobEvaluation &evaluation)
+{
+    SchedulerJob *job = &evaluation.snapshot;
+
+    if (context.weatherStatus == IPS_OK || context.weatherChecked == false)
+        return true;
+    else if (context.weatherStatus == IPS_IDLE)
+    {
+        if (context.indiReady)
+            evaluation.log << i18n("Weather information is pending...");
+        return true;
+    }
+
+    // Temporary BUSY is ALSO accepted for now
+    // TODO Figure out how to exactly handle this
+    if (context.weatherStatus == IPS_BUSY)
+        return true;
+
+    if (context.weatherStatus == IPS_ALERT)
+    {
+        job->setState(SchedulerJob::JOB_ABORTED);
+        evaluation.log << i18n("%1 observation job aborted due to bad weather.", job->getName());
+    }
+    /*else if (weatherStatus == IPS_BUSY)
+    {
+        appendLogText(i18n("%1 observation job delayed due to bad weather.", job->getName()));
+        schedulerTimer.stop();
+        connect(this, SIGNAL(weatherChanged(IPState)), this, SLOT(resumeCheckStatus()));
+    }*/
+
+    return false;
+}
+}
+}
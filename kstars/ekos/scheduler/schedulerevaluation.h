@@ -0,0 +1,155 @@
+/*  Ekos Scheduler Evaluation
+    Copyright (C) 2026 agent <agent@local>
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include "cachingdms.h"
+#include "schedulerjob.h"
+
+#include <indiapi.h>
+
+#include <QDateTime>
+#include <QFuture>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+#define BAD_SCORE -1000
+
+class GeoLocation;
+class SkyPoint;
+
+namespace Ekos
+{
+class SchedulerEphemeris;
+
+/**
+ * Scoring of the jobs of the scheduler. It only reads the job it scores and an EvaluationContext that is not changed
+ * while the jobs are scored, so that the jobs of a queue can be scored across the global thread pool.
+ */
+namespace SchedulerEvaluation
+{
+/** A job scored on a thread of the pool */
+typedef struct
+{
+    SchedulerJob *job;     // Job of the queue, left alone until the evaluation is merged back
+    SchedulerJob snapshot; // Copy of the job, without its table cells, that the evaluation reads and updates
+    QStringList log;       // What the evaluation logged, in order
+} JobEvaluation;
+
+/** What scoring jobs reads from outside of the jobs, gathered on the GUI thread before they are evaluated */
+typedef struct
+{
+    QDateTime now;                                      // Local time of the evaluation
+    QSharedPointer<const SchedulerEphemeris> ephemeris; // Covers the day after now, and the startup times of the jobs
+    const GeoLocation *geo;                             // Location of the observatory
+    CachingDms lst;                                     // Local sidereal time of the evaluation
+    double dawn, dusk;                                  // Day fractions of astronomical dawn and dusk
+    QDateTime duskDateTime;                             // Dusk of the night being scheduled
+    QDateTime preDawnDateTime;                          // Jobs are not started after pre-dawn
+    double mountHourAngle;                              // Hour angle of the mount, 0 if INDI is not ready
+    bool indiReady;                                     // Whether the INDI devices are ready
+    bool weatherChecked;                                // Whether jobs wait for good weather
+    IPState weatherStatus;                              // Last weather status
+    double minAltitude;                                 // Hard minimum altitude of targets, in degrees
+    int leadTime;                                       // Minutes between the jobs
+    double preDawnTime;                                 // Minutes before dawn where no job is started
+    std::function<bool(JobEvaluation &)> estimateJobTime; // Estimates the time of a job whose estimate is -1
+} EvaluationContext;
+
+/**
+ * @brief evaluate Start to evaluate each job of a queue across the global thread pool
+ * @param context Read by the evaluations, which must not change until they are finished
+ * @param evaluations Queue of jobs to evaluate, which keeps its order
+ * @return Future that finishes once all the jobs are evaluated
+ */
+QFuture<void> evaluate(const EvaluationContext &context, QVector<JobEvaluation> &evaluations);
+
+/**
+ * @brief evaluateJob Score a job and update its state and startup time
+ * @param context Evaluation context
+ * @param evaluation Job to evaluate, whose snapshot is updated
+ */
+void evaluateJob(const EvaluationContext &context, JobEvaluation &evaluation);
+
+/**
+ * @brief findAltitude Find the altitude of a target at a specific time, as Scheduler::findAltitude at the location of
+ * the context
+ */
+double findAltitude(const EvaluationContext &context, const SkyPoint &target, const QDateTime &when);
+
+int16_t getDarkSkyScore(const EvaluationContext &context, JobEvaluation &evaluation,
+                        const QDateTime &observationDateTime);
+
+/**
+ * @brief getAltitudeScore Get the altitude score of an object. The higher the better
+ * @param context Evaluation context
+ * @param evaluation Active job
+ * @param when At what time to check the target altitude
+ * @return Altitude score. Altitude below minimum default of 15 degrees but above horizon get -20 score. Bad altitude below minimum required altitude or below horizon get -1000 score.
+ */
+int16_t getAltitudeScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when);
+
+/**
+ * @brief getMoonSeparationScore Get moon separation score. The further apart, the better, up a maximum score of 20.
+ * @param context Evaluation context
+ * @param evaluation Target job
+ * @param when What time to check the moon separation?
+ * @return Moon separation score
+ */
+int16_t getMoonSeparationScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when);
+
+/**
+ * @brief moonSeparationScore Compute the moon separation score of getMoonSeparationScore, without logging it
+ * @param ephemeris Ephemeris that covers the time to check
+ * @param job Target job
+ * @param jd What time to check the moon separation?
+ * @param separation If not null, set to the moon separation in degrees
+ * @return Moon separation score
+ */
+int16_t moonSeparationScore(const SchedulerEphemeris *ephemeris, SchedulerJob *job, long double jd,
+                            double *separation = nullptr);
+
+/**
+ * @brief calculateJobScore Calculate job dark sky score, altitude score, and moon separation scores and returns the sum.
+ * @param context Evaluation context
+ * @param evaluation job to evaluate
+ * @param when time to evaluate constraints
+ * @return Total score
+ */
+int16_t calculateJobScore(const EvaluationContext &context, JobEvaluation &evaluation, const QDateTime &when);
+
+/**
+ * @brief calculateAltitudeTime calculate the altitude time given the minimum altitude given.
+ * @param context Evaluation context
+ * @param evaluation active target
+ * @param minAltitude minimum altitude required
+ * @param minMoonAngle minimum separation from the moon. -1 to ignore.
+ * @return True if found a time in the night where the object is at or above the minimum altitude, false otherise.
+ */
+bool calculateAltitudeTime(const EvaluationContext &context, JobEvaluation &evaluation, double minAltitude,
+                           double minMoonAngle = -1);
+
+/**
+ * @brief calculateCulmination find culmination time adjust for the job offset
+ * @param context Evaluation context
+ * @param evaluation Active job
+ * @return True if culmination time adjust for offset is a valid time in the night
+ */
+bool calculateCulmination(const EvaluationContext &context, JobEvaluation &evaluation);
+
+/**
+ * @brief isWeatherOK Check whether the weather lets a job run, and abort the job if it does not
+ * @return True if the job can run
+ */
+bool isWeatherOK(const EvaluationContext &context, JobEvaluation &evaluation);
+}
+}
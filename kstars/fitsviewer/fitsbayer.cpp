@@ -0,0 +1,227 @@
+/***************************************************************************
+                          fitsbayer.cpp  -  FITS Bayer Decoding
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "fitsbayer.h"
+
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <cstring>
+
+namespace
+{
+const uint32_t MIN_BAND_ROWS = 32;
+
+// VNG reads the bilinear estimate two rows around each pixel, which in turn reads one more row
+const uint32_t VNG_BAND_PADDING = 4;
+
+typedef struct
+{
+    uint32_t firstRow;
+    uint32_t lastRow;
+    dc1394error_t error;
+} Band;
+
+QVector<Band> makeBands(uint32_t rows)
+{
+    uint32_t blockCount = qMax(1, QThread::idealThreadCount() * 4);
+    uint32_t bandRows   = qMax(MIN_BAND_ROWS, (rows + blockCount - 1) / blockCount);
+    QVector<Band> bands;
+
+    // Bands never start on an odd row, so that every band sees the same color filter as the whole image
+    bandRows += bandRows & 1;
+
+    for (uint32_t row = 0; row < rows; row += bandRows)
+        bands.append({ row, qMin(row + bandRows, rows), DC1394_SUCCESS });
+
+    return bands;
+}
+
+dc1394error_t decodeInterleaved(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height,
+                                dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    return dc1394_bayer_decoding_8bit(bayer, rgb, width, height, filter, method);
+}
+
+dc1394error_t decodeInterleaved(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height,
+                                dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    return dc1394_bayer_decoding_16bit(bayer, rgb, width, height, filter, method, 16);
+}
+
+/*
+ * One row of the dc1394 bilinear decoding. above, row and below are the bayer rows around the decoded row. far is the
+ * plane of the color found on the diagonals of a red or blue pixel, near the plane of the color of that pixel itself.
+ * The first and last pixels are left black, as dc1394 does.
+ */
+template <typename T>
+void bilinearRow(const T *above, const T *row, const T *below, T *far, T *green, T *near, uint32_t width,
+                 bool startWithGreen)
+{
+    const uint32_t last = width - 1;
+    uint32_t c          = 1;
+
+    far[0] = green[0] = near[0] = 0;
+
+    if (startWithGreen)
+    {
+        far[c]   = static_cast<T>((above[c] + below[c] + 1) >> 1);
+        green[c] = row[c];
+        near[c]  = static_cast<T>((row[c - 1] + row[c + 1] + 1) >> 1);
+        c++;
+    }
+
+    for (; c + 1 < last; c += 2)
+    {
+        far[c]   = static_cast<T>((above[c - 1] + above[c + 1] + below[c - 1] + below[c + 1] + 2) >> 2);
+        green[c] = static_cast<T>((above[c] + row[c - 1] + row[c + 1] + below[c] + 2) >> 2);
+        near[c]  = row[c];
+
+        far[c + 1]   = static_cast<T>((above[c + 1] + below[c + 1] + 1) >> 1);
+        green[c + 1] = row[c + 1];
+        near[c + 1]  = static_cast<T>((row[c] + row[c + 2] + 1) >> 1);
+    }
+
+    if (c < last)
+    {
+        far[c]   = static_cast<T>((above[c - 1] + above[c + 1] + below[c - 1] + below[c + 1] + 2) >> 2);
+        green[c] = static_cast<T>((above[c] + row[c - 1] + row[c + 1] + below[c] + 2) >> 2);
+        near[c]  = row[c];
+    }
+
+    far[last] = green[last] = near[last] = 0;
+}
+
+template <typename T>
+void decodeBilinear(const T *bayer, T *planar, uint32_t width, uint32_t height, uint32_t planeSize,
+                    dc1394color_filter_t filter)
+{
+    const int blue            = (filter == DC1394_COLOR_FILTER_BGGR || filter == DC1394_COLOR_FILTER_GBRG) ? -1 : 1;
+    const bool startWithGreen = (filter == DC1394_COLOR_FILTER_GBRG || filter == DC1394_COLOR_FILTER_GRBG);
+    QVector<Band> bands       = makeBands(height);
+
+    QtConcurrent::blockingMap(bands, [&](Band &band) {
+        for (uint32_t row = band.firstRow; row < band.lastRow; row++)
+        {
+            size_t offset = static_cast<size_t>(row) * width;
+
+            if (row == 0 || row == height - 1)
+            {
+                for (int channel = 0; channel < 3; channel++)
+                    memset(planar + channel * planeSize + offset, 0, width * sizeof(T));
+                continue;
+            }
+
+            // The filter of the first decoded row is the one of the image, and alternates on every row after it
+            const bool odd    = ((row - 1) & 1) != 0;
+            const int rowBlue = odd ? -blue : blue;
+            const T *source   = bayer + offset;
+
+            bilinearRow<T>(source - width, source, source + width, planar + (1 - rowBlue) * planeSize + offset,
+                           planar + planeSize + offset, planar + (1 + rowBlue) * planeSize + offset, width,
+                           startWithGreen != odd);
+        }
+    });
+}
+
+template <typename T>
+dc1394error_t decodeVNG(const T *bayer, T *planar, uint32_t width, uint32_t height, uint32_t planeSize,
+                        dc1394color_filter_t filter)
+{
+    QVector<Band> bands = makeBands(height);
+
+    QtConcurrent::blockingMap(bands, [&](Band &band) {
+        // Decode the band with its padding as a separate image. Its first row is even, so the filter is unchanged.
+        uint32_t first = band.firstRow > VNG_BAND_PADDING ? band.firstRow - VNG_BAND_PADDING : 0;
+        uint32_t last  = qMin(band.lastRow + VNG_BAND_PADDING, height);
+        QVector<T> rgb(static_cast<int>((last - first) * width * 3));
+
+        band.error = decodeInterleaved(bayer + static_cast<size_t>(first) * width, rgb.data(), width, last - first,
+                                       filter, DC1394_BAYER_METHOD_VNG);
+        if (band.error != DC1394_SUCCESS)
+            return;
+
+        for (uint32_t row = band.firstRow; row < band.lastRow; row++)
+        {
+            const T *source = rgb.constData() + static_cast<size_t>(row - first) * width * 3;
+            size_t offset   = static_cast<size_t>(row) * width;
+            T *r            = planar + offset;
+            T *g            = r + planeSize;
+            T *b            = g + planeSize;
+
+            for (uint32_t i = 0; i < width; i++, source += 3)
+            {
+                r[i] = source[0];
+                g[i] = source[1];
+                b[i] = source[2];
+            }
+        }
+    });
+
+    for (const Band &band : bands)
+    {
+        if (band.error != DC1394_SUCCESS)
+            return band.error;
+    }
+
+    return DC1394_SUCCESS;
+}
+}
+
+namespace FITSBayer
+{
+bool isSupported(dc1394bayer_method_t method)
+{
+    return method == DC1394_BAYER_METHOD_BILINEAR || method == DC1394_BAYER_METHOD_VNG;
+}
+
+template <typename T>
+dc1394error_t decode(const T *bayer, T *planar, uint32_t width, uint32_t height, uint32_t planeSize,
+                     dc1394color_filter_t filter, dc1394bayer_method_t method)
+{
+    if (filter < DC1394_COLOR_FILTER_MIN || filter > DC1394_COLOR_FILTER_MAX)
+        return DC1394_INVALID_COLOR_FILTER;
+
+    if (isSupported(method) == false)
+        return DC1394_INVALID_BAYER_METHOD;
+
+    uint32_t decoded = width * height;
+
+    // Too small to have any pixel with all its neighbours, the whole image is border
+    if (width < 3 || height < 3)
+        decoded = 0;
+    else if (method == DC1394_BAYER_METHOD_BILINEAR)
+        decodeBilinear<T>(bayer, planar, width, height, planeSize, filter);
+    else
+    {
+        dc1394error_t error = decodeVNG<T>(bayer, planar, width, height, planeSize, filter);
+        if (error != DC1394_SUCCESS)
+            return error;
+    }
+
+    for (int channel = 0; channel < 3; channel++)
+        memset(planar + channel * planeSize + decoded, 0, (planeSize - decoded) * sizeof(T));
+
+    return DC1394_SUCCESS;
+}
+
+template dc1394error_t decode<uint8_t>(const uint8_t *, uint8_t *, uint32_t, uint32_t, uint32_t,
+                                       dc1394color_filter_t, dc1394bayer_method_t);
+template dc1394error_t decode<uint16_t>(const uint16_t *, uint16_t *, uint32_t, uint32_t, uint32_t,
+                                        dc1394color_filter_t, dc1394bayer_method_t);
+}
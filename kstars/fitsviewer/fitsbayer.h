@@ -0,0 +1,52 @@
+/***************************************************************************
+                          fitsbayer.h  -  FITS Bayer Decoding
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "bayer.h"
+
+#include <cstdint>
+
+/**
+ * @namespace FITSBayer
+ * @short Parallel de-mosaicing of 8 and 16 bit bayer images straight into the planar RGB layout used by FITSData.
+ *
+ * The image is split into bands of rows that are decoded concurrently on the global thread pool. Bilinear decoding is
+ * done natively and writes each plane directly, so no interleaved RGB copy of the image is needed. VNG decoding runs
+ * the dc1394 implementation on each band, padded with enough rows above and below that the result is identical to
+ * decoding the whole image at once.
+ *
+ * @author agent
+ */
+namespace FITSBayer
+{
+/** @return True if method can be decoded by FITSBayer::decode */
+bool isSupported(dc1394bayer_method_t method);
+
+/**
+ * @brief decode De-mosaic a bayer image into three planes.
+ * @param bayer bayer samples, width x height
+ * @param planar Destination for the red, green and blue planes, one after the other. Each plane holds planeSize
+ * samples, at least width x height. Samples of each plane past the decoded rows are cleared.
+ * @param filter Color filter of the first pixel of bayer
+ * @param method Decoding method, must be supported (see isSupported)
+ * @return DC1394_SUCCESS, or the dc1394 error code.
+ */
+template <typename T>
+dc1394error_t decode(const T *bayer, T *planar, uint32_t width, uint32_t height, uint32_t planeSize,
+                     dc1394color_filter_t filter, dc1394bayer_method_t method);
+}
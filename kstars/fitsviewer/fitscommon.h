@@ -36,6 +36,11 @@ typedef enum {
     FITS_SQRT,
     FITS_CUSTOM
 } FITSScale;
+typedef struct
+{
+    float ra;
+    float dec;
+} wcs_point;
 typedef enum { ZOOM_FIT_WINDOW, ZOOM_KEEP_LEVEL, ZOOM_FULL } FITSZoom;
 typedef enum { HFR_AVERAGE, HFR_MAX } HFRType;
 typedef enum { ALGORITHM_GRADIENT, ALGORITHM_CENTROID, ALGORITHM_THRESHOLD } StarAlgorithm;
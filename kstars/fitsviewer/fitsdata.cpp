@@ -19,6 +19,10 @@
 
 #include "fitsdata.h"
 
+#include "fitsbayer.h"
+#include "fitsstatistics.h"
+#include "fitsstretch.h"
+
 #include "auxiliary/ksnotification.h"
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -26,8 +30,12 @@
 #include "skymapcomposite.h"
 
 #include <QApplication>
+#include <QtConcurrent>
+#include <QtEndian>
 
 #if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+#include "fitswcsgrid.h"
+
 #include <wcshdr.h>
 #include <wcsfix.h>
 #endif
@@ -48,8 +56,56 @@ const int MINIMUM_ROWS_PER_CENTER = 3;
 #define LOW_EDGE_CUTOFF_1  50
 #define LOW_EDGE_CUTOFF_2  10
 #define MINIMUM_EDGE_LIMIT 2
+// Minimum cell size in pixels of the grid edges are bucketed in to find the edges of a centroid
+#define EDGE_GRID_CELL 16
 #define SMALL_SCALE_SQUARE 256
 
+// Size in bytes of the row bands an uncompressed image is mapped and converted in
+#define MAPPED_BAND_SIZE (4 * 1024 * 1024)
+
+namespace
+{
+// FITS data is big endian. Unsigned data stored with a BZERO offset is restored by flipping the sign bit.
+void convertBigEndian(const uchar *source, uint8_t *target, qint64 count, int bytesPerPixel, quint64 signFlip)
+{
+    switch (bytesPerPixel)
+    {
+        case 1:
+            memcpy(target, source, count);
+            break;
+
+        case 2:
+        {
+            uint16_t *pixel = reinterpret_cast<uint16_t *>(target);
+            uint16_t flip   = signFlip;
+            for (qint64 i = 0; i < count; i++)
+                pixel[i] = qFromBigEndian<quint16>(source + i * 2) ^ flip;
+        }
+        break;
+
+        case 4:
+        {
+            uint32_t *pixel = reinterpret_cast<uint32_t *>(target);
+            uint32_t flip   = signFlip;
+            for (qint64 i = 0; i < count; i++)
+                pixel[i] = qFromBigEndian<quint32>(source + i * 4) ^ flip;
+        }
+        break;
+
+        case 8:
+        {
+            uint64_t *pixel = reinterpret_cast<uint64_t *>(target);
+            for (qint64 i = 0; i < count; i++)
+                pixel[i] = qFromBigEndian<quint64>(source + i * 8) ^ signFlip;
+        }
+        break;
+
+        default:
+            break;
+    }
+}
+}
+
 bool greaterThan(Edge *s1, Edge *s2)
 {
     //return s1->width > s2->width;
@@ -59,7 +115,6 @@ bool greaterThan(Edge *s1, Edge *s2)
 FITSData::FITSData(FITSMode fitsMode)
 {
     channels      = 0;
-    wcs_coord     = nullptr;
     fptr          = nullptr;
     maxHFRStar    = nullptr;
     tempFile      = false;
@@ -87,7 +142,9 @@ FITSData::~FITSData()
     if (starCenters.count() > 0)
         qDeleteAll(starCenters);
 
-    delete[] wcs_coord;
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    delete wcsGrid;
+#endif
 
     if (objList.count() > 0)
         qDeleteAll(objList);
@@ -95,13 +152,27 @@ FITSData::~FITSData()
     if (fptr)
     {
         fits_close_file(fptr, &status);
-
-        if (tempFile && autoRemoveTemporaryFITS)
-            QFile::remove(filename);
+        removeTemporaryFile();
     }
 }
 
 bool FITSData::loadFITS(const QString &inFilename, bool silent)
+{
+    return loadImage(inFilename, QByteArray(), silent);
+}
+
+bool FITSData::loadFITSFromMemory(const QString &inFilename, const QByteArray &buffer, bool silent)
+{
+    if (buffer.isEmpty())
+    {
+        lastError = i18n("No FITS data received for %1", inFilename);
+        return false;
+    }
+
+    return loadImage(inFilename, buffer, silent);
+}
+
+bool FITSData::loadImage(const QString &inFilename, const QByteArray &buffer, bool silent)
 {
     int status = 0, anynull = 0;
     long naxes[3];
@@ -114,19 +185,26 @@ bool FITSData::loadFITS(const QString &inFilename, bool silent)
     if (fptr)
     {
         fits_close_file(fptr, &status);
-
-        if (tempFile && autoRemoveTemporaryFITS)
-            QFile::remove(filename);
+        removeTemporaryFile();
     }
 
     filename = inFilename;
 
-    if (filename.startsWith("/tmp/") || filename.contains("/Temp"))
+    // The previous buffer, if any, is released only now that cfitsio is done with it
+    fitsBuffer   = buffer;
+    fileWrite    = QFuture<bool>();
+    fileDeferred = false;
+
+    // Images received in memory belong to whoever writes them to disk
+    if (fitsBuffer.isEmpty() == false)
+        tempFile = false;
+    else if (filename.startsWith("/tmp/") || filename.contains("/Temp"))
         tempFile = true;
     else
         tempFile = false;
 
-    if (fits_open_image(&fptr, filename.toLatin1(), READONLY, &status))
+    if (fitsBuffer.isEmpty() ? fits_open_image(&fptr, filename.toLatin1(), READONLY, &status) :
+                               openMemoryImage(&status))
     {
         fits_report_error(stderr, status);
         fits_get_errstatus(status, error_status);
@@ -247,20 +325,29 @@ bool FITSData::loadFITS(const QString &inFilename, bool silent)
     flipVCounter   = 0;
     long nelements = stats.samples_per_channel * channels;
 
-    if (fits_read_img(fptr, data_type, 1, nelements, 0, imageBuffer, &anynull, &status))
+    // Uncompressed images are memory mapped and converted in row bands, with statistics calculated as bands arrive.
+    if (loadMappedImage())
     {
-        char errmsg[512];
-        fits_get_errstatus(status, errmsg);
-        errMessage = i18n("Error reading image: %1", QString(errmsg));
-        if (silent == false)
-            KSNotification::error(errMessage, i18n("FITS Open"));
-        fits_report_error(stderr, status);
-        if (Options::fITSLogging())
-            qDebug() << errMessage;
-        return false;
+        readMinMaxKeywords();
+        stats.SNR = stats.mean[0] / stats.stddev[0];
     }
+    else
+    {
+        if (fits_read_img(fptr, data_type, 1, nelements, 0, imageBuffer, &anynull, &status))
+        {
+            char errmsg[512];
+            fits_get_errstatus(status, errmsg);
+            errMessage = i18n("Error reading image: %1", QString(errmsg));
+            if (silent == false)
+                KSNotification::error(errMessage, i18n("FITS Open"));
+            fits_report_error(stderr, status);
+            if (Options::fITSLogging())
+                qDebug() << errMessage;
+            return false;
+        }
 
-    calculateStats();
+        calculateStats();
+    }
 
     if (Options::autoDebayer() && checkDebayer())
     {
@@ -269,6 +356,10 @@ bool FITSData::loadFITS(const QString &inFilename, bool silent)
     }
 
     WCSLoaded = false;
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    delete wcsGrid;
+    wcsGrid = nullptr;
+#endif
 
     if (mode == FITS_NORMAL || mode == FITS_ALIGN)
         checkForWCS();
@@ -278,6 +369,211 @@ bool FITSData::loadFITS(const QString &inFilename, bool silent)
     return true;
 }
 
+int FITSData::openMemoryImage(int *status)
+{
+    int naxis = 0, hdutype = IMAGE_HDU;
+
+    fitsMemory     = const_cast<char *>(fitsBuffer.constData());
+    fitsMemorySize = fitsBuffer.size();
+
+    // The buffer is only read, so cfitsio never has to reallocate it
+    if (fits_open_memfile(&fptr, filename.toLatin1(), READONLY, &fitsMemory, &fitsMemorySize, 0, nullptr, status))
+        return *status;
+
+    // Like fits_open_image, skip a primary HDU without data
+    if (fits_get_img_dim(fptr, &naxis, status) == 0 && naxis == 0)
+        fits_movrel_hdu(fptr, 1, &hdutype, status);
+
+    if (*status == 0 && hdutype != IMAGE_HDU)
+        *status = NOT_IMAGE;
+
+    if (*status)
+    {
+        int closeStatus = 0;
+        fits_close_file(fptr, &closeStatus);
+        fptr = nullptr;
+    }
+
+    return *status;
+}
+
+bool FITSData::loadMappedImage()
+{
+    int status = 0;
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    double bzero = 0, bscale = 1;
+    quint64 signFlip = 0;
+
+    // Compressed images and files cfitsio unpacks in memory must go through cfitsio
+    if ((fitsBuffer.isEmpty() &&
+         (filename.endsWith(".gz", Qt::CaseInsensitive) || filename.endsWith(".fz", Qt::CaseInsensitive))) ||
+        fits_is_compressed_image(fptr, &status) || status)
+        return false;
+
+    if (fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status))
+        return false;
+
+    if (fits_read_key_dbl(fptr, "BZERO", &bzero, nullptr, &status))
+    {
+        bzero  = 0;
+        status = 0;
+    }
+    if (fits_read_key_dbl(fptr, "BSCALE", &bscale, nullptr, &status))
+    {
+        bscale = 1;
+        status = 0;
+    }
+
+    if (bscale != 1)
+        return false;
+
+    // Signed data with the standard BZERO offset is read as unsigned, which amounts to flipping the sign bit.
+    // Any other offset is left to cfitsio.
+    switch (stats.bitpix)
+    {
+        case BYTE_IMG:
+        case FLOAT_IMG:
+        case DOUBLE_IMG:
+            if (bzero != 0)
+                return false;
+            break;
+
+        case SHORT_IMG:
+            if (bzero != 32768)
+                return false;
+            signFlip = 0x8000;
+            break;
+
+        case LONG_IMG:
+            if (bzero != 2147483648.0)
+                return false;
+            signFlip = 0x80000000;
+            break;
+
+        default:
+            return false;
+    }
+
+    qint64 nbytes = static_cast<qint64>(stats.samples_per_channel) * channels * stats.bytesPerPixel;
+    QFile file(filename);
+    uchar *fileMap   = nullptr;
+    const uchar *map = nullptr;
+
+    // Images received in memory are converted straight from their buffer
+    if (fitsBuffer.isEmpty() == false)
+    {
+        if (dataStart + nbytes > fitsBuffer.size())
+            return false;
+
+        map = reinterpret_cast<const uchar *>(fitsBuffer.constData()) + dataStart;
+    }
+    else
+    {
+        if (file.open(QIODevice::ReadOnly) == false || dataStart + nbytes > file.size())
+            return false;
+
+        map = fileMap = file.map(dataStart, nbytes);
+        if (map == nullptr)
+            return false;
+    }
+
+    switch (data_type)
+    {
+        case TBYTE:
+            loadMappedBands<uint8_t>(map, signFlip);
+            break;
+
+        case TUSHORT:
+            loadMappedBands<uint16_t>(map, signFlip);
+            break;
+
+        case TULONG:
+            loadMappedBands<uint32_t>(map, signFlip);
+            break;
+
+        case TFLOAT:
+            loadMappedBands<float>(map, signFlip);
+            break;
+
+        case TDOUBLE:
+            loadMappedBands<double>(map, signFlip);
+            break;
+
+        default:
+            if (fileMap)
+                file.unmap(fileMap);
+            return false;
+    }
+
+    if (fileMap)
+        file.unmap(fileMap);
+
+    if (Options::fITSLogging())
+        qDebug() << "FITSData: Loaded" << nbytes << "bytes of" << filename
+                 << (fileMap ? "through memory mapping." : "from memory.");
+
+    return true;
+}
+
+template <typename T>
+void FITSData::loadMappedBands(const uchar *map, quint64 signFlip)
+{
+    typedef struct
+    {
+        int firstRow;
+        int lastRow;
+        FITSStatistics::BandStats channel[3];
+    } Band;
+
+    int width = stats.width, height = stats.height;
+    int bandRows = qMax(1, MAPPED_BAND_SIZE / (width * stats.bytesPerPixel));
+    QVector<Band> bands;
+
+    for (int row = 0; row < height; row += bandRows)
+    {
+        Band band;
+        band.firstRow = row;
+        band.lastRow  = qMin(row + bandRows, height);
+        bands.append(band);
+    }
+
+    // Each band is byte swapped from the mapping as soon as it is paged in, and accumulated into the statistics
+    // right away, while the pages of the following bands are still being read by other threads.
+    QtConcurrent::blockingMap(bands, [&](Band &band) {
+        for (int ch = 0; ch < channels; ch++)
+        {
+            qint64 first = static_cast<qint64>(ch) * stats.samples_per_channel + band.firstRow * width;
+            qint64 count = static_cast<qint64>(band.lastRow - band.firstRow) * width;
+
+            convertBigEndian(map + first * sizeof(T), imageBuffer + first * sizeof(T), count, sizeof(T), signFlip);
+        }
+
+        FITSStatistics::calculateBand<T>(reinterpret_cast<T *>(imageBuffer), width, height, channels, band.firstRow,
+                                         band.lastRow, band.channel);
+    });
+
+    FITSStatistics::BandStats total[3];
+    FITSStatistics::ChannelStats channelStats[3];
+
+    for (const Band &band : bands)
+    {
+        for (int ch = 0; ch < qMin(channels, 3); ch++)
+            total[ch].merge(band.channel[ch]);
+    }
+
+    FITSStatistics::finish<T>(reinterpret_cast<T *>(imageBuffer), width, height, channels, total, channelStats);
+
+    for (int i = 0; i < qMin(channels, 3); i++)
+    {
+        stats.min[i]    = channelStats[i].min;
+        stats.max[i]    = channelStats[i].max;
+        stats.mean[i]   = channelStats[i].mean;
+        stats.stddev[i] = channelStats[i].stddev;
+        stats.median[i] = channelStats[i].median;
+        stats.mad[i]    = channelStats[i].mad;
+    }
+}
+
 int FITSData::saveFITS(const QString &newFilename)
 {
     if (newFilename == filename)
@@ -304,18 +600,26 @@ int FITSData::saveFITS(const QString &newFilename)
         // Remove first otherwise copy will fail below if file exists
         QFile::remove(finalFileName);
 
-        if (QFile::copy(filename, finalFileName) == false)
+        if (fitsBuffer.isEmpty() == false)
+        {
+            // The image was never read from disk, write what was received
+            QFile finalFile(finalFileName);
+            if (finalFile.open(QIODevice::WriteOnly) == false || finalFile.write(fitsBuffer) != fitsBuffer.size())
+            {
+                qCritical() << "FITS: Failed to write " << filename << " to " << finalFileName;
+                fptr = nullptr;
+                return -1;
+            }
+            fitsBuffer.clear();
+        }
+        else if (QFile::copy(filename, finalFileName) == false)
         {
             qCritical() << "FITS: Failed to copy " << filename << " to " << finalFileName;
             fptr = nullptr;
             return -1;
         }
 
-        if (tempFile && autoRemoveTemporaryFITS)
-        {
-            QFile::remove(filename);
-            tempFile = false;
-        }
+        removeTemporaryFile();
 
         filename = finalFileName;
 
@@ -362,6 +666,9 @@ int FITSData::saveFITS(const QString &newFilename)
 
     fptr = new_fptr;
 
+    // The image now lives in the new file
+    fitsBuffer.clear();
+
     if (fits_movabs_hdu(fptr, 1, &exttype, &status))
     {
         fits_report_error(stderr, status);
@@ -436,11 +743,7 @@ int FITSData::saveFITS(const QString &newFilename)
 
     rotCounter = flipHCounter = flipVCounter = 0;
 
-    if (tempFile && autoRemoveTemporaryFITS)
-    {
-        QFile::remove(filename);
-        tempFile = false;
-    }
+    removeTemporaryFile();
 
     filename = newFilename;
 
@@ -456,187 +759,99 @@ void FITSData::clearImageBuffers()
 
 void FITSData::calculateStats(bool refresh)
 {
-    // Calculate min max
-    calculateMinMax(refresh);
-
-    // Get standard deviation and mean in one run
+    // Min, max, mean, standard deviation, median and MAD of all channels in one run
     switch (data_type)
     {
         case TBYTE:
-            runningAverageStdDev<uint8_t>();
+            calculateChannelStats<uint8_t>(true);
             break;
 
         case TSHORT:
-            runningAverageStdDev<int16_t>();
+            calculateChannelStats<int16_t>(true);
             break;
 
         case TUSHORT:
-            runningAverageStdDev<uint16_t>();
+            calculateChannelStats<uint16_t>(true);
             break;
 
         case TLONG:
-            runningAverageStdDev<int32_t>();
+            calculateChannelStats<int32_t>(true);
             break;
 
         case TULONG:
-            runningAverageStdDev<uint32_t>();
+            calculateChannelStats<uint32_t>(true);
             break;
 
         case TFLOAT:
-            runningAverageStdDev<float>();
+            calculateChannelStats<float>(true);
             break;
 
         case TLONGLONG:
-            runningAverageStdDev<int64_t>();
+            calculateChannelStats<int64_t>(true);
             break;
 
         case TDOUBLE:
-            runningAverageStdDev<double>();
+            calculateChannelStats<double>(true);
             break;
 
         default:
             return;
     }
 
+    // Use min and max from the header if available
+    if (refresh == false)
+        readMinMaxKeywords();
+
     stats.SNR = stats.mean[0] / stats.stddev[0];
 
     if (refresh && markStars)
         // Let's try to find star positions again after transformation
         starsSearched = false;
 }
-int FITSData::calculateMinMax(bool refresh)
-{
-    int status, nfound = 0;
-
-    status = 0;
 
-    if (fptr && refresh == false)
-    {
-        if (fits_read_key_dbl(fptr, "DATAMIN", &(stats.min[0]), nullptr, &status) == 0)
-            nfound++;
-
-        if (fits_read_key_dbl(fptr, "DATAMAX", &(stats.max[0]), nullptr, &status) == 0)
-            nfound++;
-
-        // If we found both keywords, no need to calculate them, unless they are both zeros
-        if (nfound == 2 && !(stats.min[0] == 0 && stats.max[0] == 0))
-            return 0;
-    }
+void FITSData::readMinMaxKeywords()
+{
+    int status = 0, nfound = 0;
+    double dataMin = 0, dataMax = 0;
 
-    stats.min[0] = 1.0E30;
-    stats.max[0] = -1.0E30;
+    if (fptr == nullptr)
+        return;
 
-    stats.min[1] = 1.0E30;
-    stats.max[1] = -1.0E30;
+    if (fits_read_key_dbl(fptr, "DATAMIN", &dataMin, nullptr, &status) == 0)
+        nfound++;
 
-    stats.min[2] = 1.0E30;
-    stats.max[2] = -1.0E30;
+    if (fits_read_key_dbl(fptr, "DATAMAX", &dataMax, nullptr, &status) == 0)
+        nfound++;
 
-    switch (data_type)
+    // Only use the keywords if we found both, unless they are both zeros
+    if (nfound == 2 && !(dataMin == 0 && dataMax == 0))
     {
-        case TBYTE:
-            calculateMinMax<uint8_t>();
-            break;
-
-        case TSHORT:
-            calculateMinMax<int16_t>();
-            break;
-
-        case TUSHORT:
-            calculateMinMax<uint16_t>();
-            break;
-
-        case TLONG:
-            calculateMinMax<int32_t>();
-            break;
-
-        case TULONG:
-            calculateMinMax<uint32_t>();
-            break;
-
-        case TFLOAT:
-            calculateMinMax<float>();
-            break;
-
-        case TLONGLONG:
-            calculateMinMax<int64_t>();
-            break;
-
-        case TDOUBLE:
-            calculateMinMax<double>();
-            break;
-
-        default:
-            break;
+        stats.min[0] = dataMin;
+        stats.max[0] = dataMax;
     }
-
-    //qDebug() << "DATAMIN: " << stats.min << " - DATAMAX: " << stats.max;
-    return 0;
 }
 
 template <typename T>
-void FITSData::calculateMinMax()
+void FITSData::calculateChannelStats(bool updateMinMax)
 {
-    T *buffer = reinterpret_cast<T *>(imageBuffer);
+    FITSStatistics::ChannelStats channelStats[3];
 
-    if (channels == 1)
-    {
-        for (unsigned int i = 0; i < stats.samples_per_channel; i++)
-        {
-            if (buffer[i] < stats.min[0])
-                stats.min[0] = buffer[i];
-            else if (buffer[i] > stats.max[0])
-                stats.max[0] = buffer[i];
-        }
-    }
-    else
-    {
-        int g_offset = stats.samples_per_channel;
-        int b_offset = stats.samples_per_channel * 2;
+    FITSStatistics::calculate<T>(reinterpret_cast<T *>(imageBuffer), stats.width, stats.height, channels,
+                                 channelStats);
 
-        for (unsigned int i = 0; i < stats.samples_per_channel; i++)
+    for (int i = 0; i < qMin(channels, 3); i++)
+    {
+        if (updateMinMax)
         {
-            if (buffer[i] < stats.min[0])
-                stats.min[0] = buffer[i];
-            else if (buffer[i] > stats.max[0])
-                stats.max[0] = buffer[i];
-
-            if (buffer[i + g_offset] < stats.min[1])
-                stats.min[1] = buffer[i + g_offset];
-            else if (buffer[i + g_offset] > stats.max[1])
-                stats.max[1] = buffer[i + g_offset];
-
-            if (buffer[i + b_offset] < stats.min[2])
-                stats.min[2] = buffer[i + b_offset];
-            else if (buffer[i + b_offset] > stats.max[2])
-                stats.max[2] = buffer[i + b_offset];
+            stats.min[i] = channelStats[i].min;
+            stats.max[i] = channelStats[i].max;
         }
-    }
-}
 
-template <typename T>
-void FITSData::runningAverageStdDev()
-{
-    T *buffer = reinterpret_cast<T *>(imageBuffer);
-
-    int m_n       = 2;
-    double m_oldM = 0, m_newM = 0, m_oldS = 0, m_newS = 0;
-    m_oldM = m_newM = buffer[0];
-
-    for (unsigned int i = 1; i < stats.samples_per_channel; i++)
-    {
-        m_newM = m_oldM + (buffer[i] - m_oldM) / m_n;
-        m_newS = m_oldS + (buffer[i] - m_oldM) * (buffer[i] - m_newM);
-
-        m_oldM = m_newM;
-        m_oldS = m_newS;
-        m_n++;
+        stats.mean[i]   = channelStats[i].mean;
+        stats.stddev[i] = channelStats[i].stddev;
+        stats.median[i] = channelStats[i].median;
+        stats.mad[i]    = channelStats[i].mad;
     }
-
-    double variance = m_newS / (m_n - 2);
-
-    stats.mean[0]   = m_newM;
-    stats.stddev[0] = sqrt(variance);
 }
 
 void FITSData::setMinMax(double newMin, double newMax, uint8_t channel)
@@ -1195,12 +1410,121 @@ void FITSData::findCentroid(const QRectF &boundary, int initStdDev, int minEdgeW
     }
 }
 
+template <typename T>
+void FITSData::findEdges(int subX, int subY, int subW, int subH, double threshold, double min, int minEdgeWidth,
+                         float dispersion_ratio, QList<Edge *> &edges)
+{
+    typedef struct
+    {
+        int firstRow;
+        int lastRow;
+        QList<Edge *> edges;
+    } EdgeBand;
+
+    T *buffer = reinterpret_cast<T *>(imageBuffer);
+    int rows  = subH - subY;
+
+    if (rows <= 0)
+        return;
+
+    // Rows are independent, so they are scanned in bands on the thread pool. Edges are concatenated in row order.
+    int bandCount = qMin(rows, QThread::idealThreadCount() * 4);
+    int bandRows  = (rows + bandCount - 1) / bandCount;
+    QVector<EdgeBand> bands;
+
+    for (int row = subY; row < subH; row += bandRows)
+    {
+        EdgeBand band;
+        band.firstRow = row;
+        band.lastRow  = qMin(row + bandRows, subH);
+        bands.append(band);
+    }
+
+    QAtomicInt edgeCount(0);
+
+    QtConcurrent::blockingMap(bands, [&](EdgeBand &band) {
+        for (int i = band.firstRow; i < band.lastRow; i++)
+        {
+            // The caller gives up once there are too many edges, no need to look for more
+            if (edgeCount.load() >= MAX_EDGE_LIMIT)
+                return;
+
+            double avg = 0, sum = 0;
+            int starDiameter = 0;
+            int pixVal       = 0;
+
+            for (int j = subX; j < subW; j++)
+            {
+                pixVal = buffer[j + (i * stats.width)] - min;
+
+                // If pixel value > threshold, let's get its weighted average
+                if (pixVal >= threshold)
+                {
+                    avg += j * pixVal;
+                    sum += pixVal;
+                    starDiameter++;
+                }
+                // Value < threshold but avg exists
+                else if (sum > 0)
+                {
+                    // We found a potential centroid edge
+                    if (starDiameter >= minEdgeWidth)
+                    {
+                        float center = avg / sum + 0.5;
+                        if (center > 0)
+                        {
+                            int i_center = floor(center);
+
+                            // Check if center is 10% or more brighter than edge, if not skip
+                            if (((buffer[i_center + (i * stats.width)] - min) /
+                                     (buffer[i_center + (i * stats.width) - starDiameter / 2] - min) >=
+                                 dispersion_ratio) &&
+                                ((buffer[i_center + (i * stats.width)] - min) /
+                                     (buffer[i_center + (i * stats.width) + starDiameter / 2] - min) >=
+                                 dispersion_ratio))
+                            {
+                                if (Options::fITSLogging())
+                                {
+                                    qDebug()
+                                        << "Edge center is " << buffer[i_center + (i * stats.width)] - min
+                                        << " Edge is " << buffer[i_center + (i * stats.width) - starDiameter / 2] - min
+                                        << " and ratio is "
+                                        << ((buffer[i_center + (i * stats.width)] - min) /
+                                            (buffer[i_center + (i * stats.width) - starDiameter / 2] - min))
+                                        << " located at X: " << center << " Y: " << i + 0.5;
+                                }
+
+                                Edge *newEdge = new Edge();
+
+                                newEdge->x       = center;
+                                newEdge->y       = i + 0.5;
+                                newEdge->scanned = 0;
+                                newEdge->val     = buffer[i_center + (i * stats.width)] - min;
+                                newEdge->width   = starDiameter;
+                                newEdge->HFR     = 0;
+                                newEdge->sum     = sum;
+
+                                band.edges.append(newEdge);
+                                edgeCount.ref();
+                            }
+                        }
+                    }
+
+                    // Reset
+                    avg = sum = starDiameter = 0;
+                }
+            }
+        }
+    });
+
+    for (const EdgeBand &band : bands)
+        edges.append(band.edges);
+}
+
 template <typename T>
 void FITSData::findCentroid(const QRectF &boundary, int initStdDev, int minEdgeWidth)
 {
-    double threshold = 0, sum = 0, avg = 0, min = 0;
-    int starDiameter     = 0;
-    int pixVal           = 0;
+    double threshold = 0, sum = 0, min = 0;
     int minimumEdgeCount = MINIMUM_EDGE_LIMIT;
 
     T *buffer = reinterpret_cast<T *>(imageBuffer);
@@ -1293,71 +1617,7 @@ void FITSData::findCentroid(const QRectF &boundary, int initStdDev, int minEdgeW
         }
 
         // Detect "edges" that are above threshold
-        for (int i = subY; i < subH; i++)
-        {
-            starDiameter = 0;
-
-            for (int j = subX; j < subW; j++)
-            {
-                pixVal = buffer[j + (i * stats.width)] - min;
-
-                // If pixel value > threshold, let's get its weighted average
-                if (pixVal >= threshold)
-                {
-                    avg += j * pixVal;
-                    sum += pixVal;
-                    starDiameter++;
-                }
-                // Value < threshold but avg exists
-                else if (sum > 0)
-                {
-                    // We found a potential centroid edge
-                    if (starDiameter >= minEdgeWidth)
-                    {
-                        float center = avg / sum + 0.5;
-                        if (center > 0)
-                        {
-                            int i_center = floor(center);
-
-                            // Check if center is 10% or more brighter than edge, if not skip
-                            if (((buffer[i_center + (i * stats.width)] - min) /
-                                     (buffer[i_center + (i * stats.width) - starDiameter / 2] - min) >=
-                                 dispersion_ratio) &&
-                                ((buffer[i_center + (i * stats.width)] - min) /
-                                     (buffer[i_center + (i * stats.width) + starDiameter / 2] - min) >=
-                                 dispersion_ratio))
-                            {
-                                if (Options::fITSLogging())
-                                {
-                                    qDebug()
-                                        << "Edge center is " << buffer[i_center + (i * stats.width)] - min
-                                        << " Edge is " << buffer[i_center + (i * stats.width) - starDiameter / 2] - min
-                                        << " and ratio is "
-                                        << ((buffer[i_center + (i * stats.width)] - min) /
-                                            (buffer[i_center + (i * stats.width) - starDiameter / 2] - min))
-                                        << " located at X: " << center << " Y: " << i + 0.5;
-                                }
-
-                                Edge *newEdge = new Edge();
-
-                                newEdge->x       = center;
-                                newEdge->y       = i + 0.5;
-                                newEdge->scanned = 0;
-                                newEdge->val     = buffer[i_center + (i * stats.width)] - min;
-                                newEdge->width   = starDiameter;
-                                newEdge->HFR     = 0;
-                                newEdge->sum     = sum;
-
-                                edges.append(newEdge);
-                            }
-                        }
-                    }
-
-                    // Reset
-                    avg = sum = starDiameter = 0;
-                }
-            }
-        }
+        findEdges<T>(subX, subY, subW, subH, threshold, min, minEdgeWidth, dispersion_ratio, edges);
 
         if (Options::fITSLogging())
             qDebug() << "Total number of edges found is: " << edges.count();
@@ -1396,6 +1656,20 @@ void FITSData::findCentroid(const QRectF &boundary, int initStdDev, int minEdgeW
     // Let's sort edges, starting with widest
     qSort(edges.begin(), edges.end(), greaterThan);
 
+    // Bucket the edges in a grid so that each edge is only compared with the edges around it instead of all of them.
+    // Candidates are visited in list order, as a scan over the whole list would, so the centroids are the same.
+    float maxWidth = 0;
+    for (Edge *edge : edges)
+        maxWidth = qMax(maxWidth, edge->width);
+
+    int cellSize = qMax(EDGE_GRID_CELL, static_cast<int>(maxWidth) + 2);
+    QHash<QPair<int, int>, QVector<int>> edgeGrid;
+
+    for (int i = 0; i < edges.count(); i++)
+        edgeGrid[qMakePair(static_cast<int>(floor(edges[i]->x / cellSize)),
+                           static_cast<int>(floor(edges[i]->y / cellSize)))]
+            .append(i);
+
     // Now, let's scan the edges and find the maximum centroid vertically
     for (int i = 0; i < edges.count(); i++)
     {
@@ -1428,8 +1702,22 @@ void FITSData::findCentroid(const QRectF &boundary, int initStdDev, int minEdgeW
         sum       = 0;
         cen_count = 0;
 
+        // Edges further apart than their half widths plus the rounding of checkCollision cannot collide
+        float radius = edges[i]->width / 2 + maxWidth / 2 + 5;
+        QVector<int> candidates;
+
+        for (int cellY = floor((edges[i]->y - radius) / cellSize); cellY <= floor((edges[i]->y + radius) / cellSize);
+             cellY++)
+        {
+            for (int cellX = floor((edges[i]->x - radius) / cellSize);
+                 cellX <= floor((edges[i]->x + radius) / cellSize); cellX++)
+                candidates += edgeGrid.value(qMakePair(cellX, cellY));
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+
         // Now let's compare to other edges until we hit a maxima
-        for (int j = 0; j < edges.count(); j++)
+        for (int j : candidates)
         {
             if (edges[j]->scanned)
                 continue;
@@ -1628,11 +1916,8 @@ double FITSData::getHFR(int x, int y)
     return -1;
 }
 
-void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *max)
+void FITSData::getFilterLimits(FITSScale type, float *min, float *max)
 {
-    if (type == FITS_NONE)
-        return;
-
     float dataMin = stats.min[0], dataMax = stats.max[0];
 
     if (min && *min != -1)
@@ -1677,7 +1962,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < 0 ? 0 : dataMin;
             dataMax = dataMax > UINT8_MAX ? UINT8_MAX : dataMax;
-            applyFilter<uint8_t>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1685,16 +1969,13 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < INT16_MIN ? INT16_MIN : dataMin;
             dataMax = dataMax > INT16_MAX ? INT16_MAX : dataMax;
-            applyFilter<uint16_t>(type, image, dataMin, dataMax);
         }
-
         break;
 
         case TUSHORT:
         {
             dataMin = dataMin < 0 ? 0 : dataMin;
             dataMax = dataMax > UINT16_MAX ? UINT16_MAX : dataMax;
-            applyFilter<uint16_t>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1702,7 +1983,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < INT_MIN ? INT_MIN : dataMin;
             dataMax = dataMax > INT_MAX ? INT_MAX : dataMax;
-            applyFilter<uint16_t>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1710,7 +1990,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < 0 ? 0 : dataMin;
             dataMax = dataMax > UINT_MAX ? UINT_MAX : dataMax;
-            applyFilter<uint16_t>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1718,7 +1997,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < FLT_MIN ? FLT_MIN : dataMin;
             dataMax = dataMax > FLT_MAX ? FLT_MAX : dataMax;
-            applyFilter<float>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1726,7 +2004,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < LLONG_MIN ? LLONG_MIN : dataMin;
             dataMax = dataMax > LLONG_MAX ? LLONG_MAX : dataMax;
-            applyFilter<long>(type, image, dataMin, dataMax);
         }
         break;
 
@@ -1734,11 +2011,62 @@ void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *ma
         {
             dataMin = dataMin < DBL_MIN ? DBL_MIN : dataMin;
             dataMax = dataMax > DBL_MAX ? DBL_MAX : dataMax;
-            applyFilter<double>(type, image, dataMin, dataMax);
         }
-
         break;
 
+        default:
+            break;
+    }
+
+    if (min)
+        *min = dataMin;
+    if (max)
+        *max = dataMax;
+}
+
+void FITSData::applyFilter(FITSScale type, uint8_t *image, float *min, float *max)
+{
+    if (type == FITS_NONE)
+        return;
+
+    float dataMin = min ? *min : -1, dataMax = max ? *max : -1;
+
+    getFilterLimits(type, &dataMin, &dataMax);
+
+    switch (data_type)
+    {
+        case TBYTE:
+            applyFilter<uint8_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TSHORT:
+            applyFilter<int16_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TUSHORT:
+            applyFilter<uint16_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TLONG:
+            applyFilter<int32_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TULONG:
+            applyFilter<uint32_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TFLOAT:
+            applyFilter<float>(type, image, dataMin, dataMax);
+            break;
+
+        case TLONGLONG:
+            applyFilter<int64_t>(type, image, dataMin, dataMax);
+            break;
+
+        case TDOUBLE:
+            applyFilter<double>(type, image, dataMin, dataMax);
+            break;
+
         default:
             return;
     }
@@ -1779,113 +2107,24 @@ void FITSData::applyFilter(FITSScale type, uint8_t *targetImage, float image_min
     int size  = stats.samples_per_channel;
     int index = 0;
 
-    switch (type)
+    // Point filters are handled by the parallel stretch engine
+    if (FITSStretch::isPointFilter(type))
     {
-        case FITS_AUTO:
-        case FITS_LINEAR:
-        {
-            for (int i = 0; i < channels; i++)
-            {
-                offset = i * size;
-                for (int j = 0; j < height; j++)
-                {
-                    row = offset + j * width;
-                    for (int k = 0; k < width; k++)
-                    {
-                        index        = k + row;
-                        image[index] = qBound(min, image[index], max);
-                    }
-                }
-            }
-
-            if (calcStats)
-            {
-                stats.min[0] = min;
-                stats.max[0] = max;
-            }
-        }
-        break;
-
-        case FITS_LOG:
-        {
-            coeff = max / log(1 + max);
-
-            for (int i = 0; i < channels; i++)
-            {
-                offset = i * size;
-                for (int j = 0; j < height; j++)
-                {
-                    row = offset + j * width;
-                    for (int k = 0; k < width; k++)
-                    {
-                        index        = k + row;
-                        ival         = coeff * log(1 + qBound(min, image[index], max));
-                        image[index] = qBound(min, static_cast<T>(round(ival)), max);
-                    }
-                }
-            }
-
-            if (calcStats)
-            {
-                stats.min[0] = min;
-                stats.max[0] = max;
-                runningAverageStdDev<T>();
-            }
-        }
-        break;
+        FITSStretch(type, min, max).apply<T>(image, image, width, height, channels);
 
-        case FITS_SQRT:
+        if (calcStats)
         {
-            coeff = max / sqrt(max);
-
-            for (int i = 0; i < channels; i++)
-            {
-                offset = i * size;
-                for (int j = 0; j < height; j++)
-                {
-                    row = offset + j * width;
-                    for (int k = 0; k < width; k++)
-                    {
-                        index        = k + row;
-                        ival         = coeff * image[index];
-                        image[index] = qBound(min, static_cast<T>(round(ival)), max);
-                    }
-                }
-            }
-
-            if (calcStats)
-            {
-                stats.min[0] = min;
-                stats.max[0] = max;
-                runningAverageStdDev<T>();
-            }
+            stats.min[0] = min;
+            stats.max[0] = max;
+            if (type != FITS_AUTO && type != FITS_LINEAR)
+                calculateChannelStats<T>(false);
         }
-        break;
-
-        // Only difference is how min and max are set
-        case FITS_AUTO_STRETCH:
-        case FITS_HIGH_CONTRAST:
-        {
-            for (int i = 0; i < channels; i++)
-            {
-                offset = i * size;
-                for (int j = 0; j < height; j++)
-                {
-                    row = offset + j * width;
-                    for (int k = 0; k < width; k++)
-                        image[k + row] = qBound(min, image[k + row], max);
-                }
-            }
 
-            if (calcStats)
-            {
-                stats.min[0] = min;
-                stats.max[0] = max;
-                runningAverageStdDev<T>();
-            }
-        }
-        break;
+        return;
+    }
 
+    switch (type)
+    {
         case FITS_EQUALIZE:
         {
 #ifndef KSTARS_LITE
@@ -1921,32 +2160,6 @@ void FITSData::applyFilter(FITSScale type, uint8_t *targetImage, float image_min
                 calculateStats(true);
             break;
 
-        case FITS_HIGH_PASS:
-        {
-            min = stats.mean[0];
-            for (int i = 0; i < channels; i++)
-            {
-                offset = i * size;
-                for (int j = 0; j < height; j++)
-                {
-                    row = offset + j * width;
-                    for (int k = 0; k < width; k++)
-                    {
-                        index        = k + row;
-                        image[index] = qBound(min, image[index], max);
-                    }
-                }
-            }
-
-            if (calcStats)
-            {
-                stats.min[0] = min;
-                stats.max[0] = max;
-                runningAverageStdDev<T>();
-            }
-        }
-        break;
-
         // Based on http://www.librow.com/articles/article-1
         case FITS_MEDIAN:
         {
@@ -2008,7 +2221,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t *targetImage, float image_min
             delete[] extension;
 
             if (calcStats)
-                runningAverageStdDev<T>();
+                calculateChannelStats<T>(false);
         }
         break;
 
@@ -2145,10 +2358,7 @@ bool FITSData::loadWCS()
 
     int status = 0;
     char *header;
-    int nkeyrec, nreject, nwcs, stat[2];
-    double imgcrd[2], phi, pixcrd[2], theta, world[2];
-    int width  = getWidth();
-    int height = getHeight();
+    int nkeyrec, nreject, nwcs;
 
     if (fits_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
     {
@@ -2187,40 +2397,11 @@ bool FITSData::loadWCS()
         return false;
     }
 
-    delete[] wcs_coord;
-
-    wcs_coord = new wcs_point[width * height];
-
-    if (wcs_coord == nullptr)
-    {
-        lastError = "Not enough memory for WCS data!";
-        return false;
-    }
-
-    wcs_point *p = wcs_coord;
+    // Coordinates are no longer computed for every pixel up front. The grid evaluates them on demand.
+    delete wcsGrid;
+    wcsGrid = new FITSWCSGrid(wcs, getWidth(), getHeight());
 
-    for (int i = 0; i < height; i++)
-    {
-        for (int j = 0; j < width; j++)
-        {
-            pixcrd[0] = j;
-            pixcrd[1] = i;
-
-            if ((status = wcsp2s(wcs, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0])))
-            {
-                lastError = QString("wcsp2s error %1: %2.").arg(status).arg(wcs_errmsg[status]);
-            }
-            else
-            {
-                p->ra  = world[0];
-                p->dec = world[1];
-
-                p++;
-            }
-        }
-    }
-
-    findObjectsInImage(&world[0], phi, theta, &imgcrd[0], &pixcrd[0], &stat[0]);
+    findObjectsInImage();
 
     WCSLoaded = true;
 
@@ -2284,6 +2465,21 @@ bool FITSData::pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord)
         return false;
     }
 
+    if (WCSLoaded && wcsGrid)
+    {
+        wcs_point coord;
+
+        if (wcsGrid->pixelToWCS(wcsPixelPoint.x(), wcsPixelPoint.y(), coord) == false)
+        {
+            lastError = i18n("Failed to convert pixel coordinates to WCS.");
+            return false;
+        }
+
+        wcsCoord.setRA0(coord.ra / 15.0);
+        wcsCoord.setDec0(coord.dec);
+        return true;
+    }
+
     pixcrd[0] = wcsPixelPoint.x();
     pixcrd[1] = wcsPixelPoint.y();
 
@@ -2308,12 +2504,13 @@ bool FITSData::pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord)
 
 #ifndef KSTARS_LITE
 #ifdef HAVE_WCSLIB
-void FITSData::findObjectsInImage(double world[], double phi, double theta, double imgcrd[], double pixcrd[],
-                                  int stat[])
+void FITSData::findObjectsInImage()
 {
     int width  = getWidth();
     int height = getHeight();
     int status = 0;
+    int stat[2];
+    double imgcrd[2], phi, pixcrd[2], theta, world[2];
     char date[64];
     KSNumbers *num = nullptr;
 
@@ -2332,20 +2529,19 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
 
     SkyMapComposite *map = KStarsData::Instance()->skyComposite();
 
-    wcs_point *wcs_coord = getWCSCoord();
-    if (wcs_coord)
+    wcs_point topLeft, bottomRight;
+    if (wcsGrid && wcsGrid->exactPixelToWCS(0, 0, topLeft) &&
+        wcsGrid->exactPixelToWCS(width - 1, height - 1, bottomRight))
     {
-        int size = width * height;
-
         objList.clear();
 
         SkyPoint p1;
-        p1.setRA0(dms(wcs_coord[0].ra));
-        p1.setDec0(dms(wcs_coord[0].dec));
+        p1.setRA0(dms(topLeft.ra));
+        p1.setDec0(dms(topLeft.dec));
         p1.updateCoordsNow(num);
         SkyPoint p2;
-        p2.setRA0(dms(wcs_coord[size - 1].ra));
-        p2.setDec0(dms(wcs_coord[size - 1].dec));
+        p2.setRA0(dms(bottomRight.ra));
+        p2.setDec0(dms(bottomRight.dec));
         p2.updateCoordsNow(num);
         QList<SkyObject *> list = map->findObjectsInArea(p1, p2);
 
@@ -2385,6 +2581,38 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
 #endif
 #endif
 
+bool FITSData::getWCSCoord(double x, double y, wcs_point &coord)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (WCSLoaded && wcsGrid)
+        return wcsGrid->pixelToWCS(x, y, coord);
+#else
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(coord);
+#endif
+
+    return false;
+}
+
+bool FITSData::getWCSBounds(double *minRA, double *maxRA, double *minDE, double *maxDE)
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (WCSLoaded && wcsGrid)
+    {
+        wcsGrid->getBounds(minRA, maxRA, minDE, maxDE);
+        return true;
+    }
+#else
+    Q_UNUSED(minRA);
+    Q_UNUSED(maxRA);
+    Q_UNUSED(minDE);
+    Q_UNUSED(maxDE);
+#endif
+
+    return false;
+}
+
 QList<FITSSkyObject *> FITSData::getSkyObjects()
 {
     return objList;
@@ -3104,6 +3332,9 @@ bool FITSData::debayer()
 
 bool FITSData::debayer_8bit()
 {
+    if (FITSBayer::isSupported(debayerParams.method))
+        return debayer<uint8_t>();
+
     dc1394error_t error_code;
 
     int rgb_size               = stats.samples_per_channel * 3 * stats.bytesPerPixel;
@@ -3175,6 +3406,9 @@ bool FITSData::debayer_8bit()
 
 bool FITSData::debayer_16bit()
 {
+    if (FITSBayer::isSupported(debayerParams.method))
+        return debayer<uint16_t>();
+
     dc1394error_t error_code;
 
     int rgb_size               = stats.samples_per_channel * 3 * stats.bytesPerPixel;
@@ -3249,6 +3483,50 @@ bool FITSData::debayer_16bit()
     return true;
 }
 
+template <typename T>
+bool FITSData::debayer()
+{
+    uint32_t planeSize = stats.samples_per_channel;
+    uint8_t *rgbBuffer = new uint8_t[planeSize * 3 * sizeof(T)];
+
+    if (rgbBuffer == nullptr)
+    {
+        KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
+        return false;
+    }
+
+    uint32_t height = stats.height;
+    const T *source = reinterpret_cast<T *>(bayerBuffer);
+
+    if (debayerParams.offsetY == 1)
+    {
+        source += stats.width;
+        height--;
+    }
+
+    if (debayerParams.offsetX == 1)
+        source++;
+
+    dc1394error_t error_code = FITSBayer::decode<T>(source, reinterpret_cast<T *>(rgbBuffer), stats.width, height,
+                                                    planeSize, debayerParams.filter, debayerParams.method);
+
+    if (error_code != DC1394_SUCCESS)
+    {
+        KSNotification::error(i18n("Debayer failed (%1)", error_code), i18n("Debayer error"));
+        channels = 1;
+        delete[] rgbBuffer;
+        return false;
+    }
+
+    // The bayer samples may live in imageBuffer, so it can only be replaced once decoding is done
+    delete[] imageBuffer;
+    imageBuffer = rgbBuffer;
+
+    channels    = 3;
+    bayerBuffer = nullptr;
+    return true;
+}
+
 double FITSData::getADU()
 {
     double adu = 0;
@@ -3505,6 +3783,44 @@ QString FITSData::getLastError() const
     return lastError;
 }
 
+const QString &FITSData::getFilename()
+{
+    if (fileDeferred && fitsBuffer.isEmpty() == false)
+    {
+        fileDeferred = false;
+
+        QFile file(filename);
+        if (file.open(QIODevice::WriteOnly) && file.write(fitsBuffer) == fitsBuffer.size())
+            tempFile = true;
+        else
+            qWarning() << "FITS: Unable to write" << filename << file.errorString();
+    }
+
+    fileWrite.waitForFinished();
+    return filename;
+}
+
+void FITSData::setFileWrite(const QFuture<bool> &write)
+{
+    fileWrite = write;
+}
+
+void FITSData::deferFileWrite()
+{
+    fileDeferred = true;
+}
+
+void FITSData::removeTemporaryFile()
+{
+    if (tempFile == false || autoRemoveTemporaryFITS == false)
+        return;
+
+    // A file written in the background is removed once it is complete, or it would be left behind
+    fileWrite.waitForFinished();
+    QFile::remove(filename);
+    tempFile = false;
+}
+
 bool FITSData::getAutoRemoveTemporaryFITS() const
 {
     return autoRemoveTemporaryFITS;
@@ -3813,16 +4129,15 @@ bool FITSData::createWCSFile(const QString &newWCSFile, double orientation, doub
 
     status = 0;
 
-    if (tempFile && autoRemoveTemporaryFITS)
-    {
-        QFile::remove(filename);
-        tempFile = false;
-    }
+    removeTemporaryFile();
 
     filename = newWCSFile;
 
     fptr = new_fptr;
 
+    // The image now lives in the new file
+    fitsBuffer.clear();
+
     if (fits_movabs_hdu(fptr, 1, &exttype, &status))
     {
         fits_get_errstatus(status, errMsg);
@@ -29,6 +29,9 @@
 
 #include <fitsio.h>
 
+#include <QByteArray>
+#include <QFuture>
+
 #ifndef KSTARS_LITE
 #include "fitshistogram.h"
 
@@ -48,12 +51,7 @@
 #define MINIMUM_STDVAR      5
 
 class QProgressDialog;
-
-typedef struct
-{
-    float ra;
-    float dec;
-} wcs_point;
+class FITSWCSGrid;
 
 class Edge
 {
@@ -94,6 +92,9 @@ class FITSData
 
     /* Loads FITS image, scales it, and displays it in the GUI */
     bool loadFITS(const QString &filename, bool silent = true);
+    /* Loads a FITS image received in memory, without reading it from disk. filename is only used as its name.
+       The buffer is shared, not copied, and kept until another image is loaded. */
+    bool loadFITSFromMemory(const QString &filename, const QByteArray &buffer, bool silent = true);
     /* Save FITS */
     int saveFITS(const QString &filename);
     /* Rescale image lineary from image_buffer, fit to window if desired */
@@ -147,6 +148,7 @@ class FITSData
     double getMean(uint8_t channel = 0) { return stats.mean[channel]; }
     void setMedian(double val, uint8_t channel = 0) { stats.median[channel] = val; }
     double getMedian(uint8_t channel = 0) { return stats.median[channel]; }
+    double getMAD(uint8_t channel = 0) { return stats.mad[channel]; }
 
     int getBytesPerPixel() { return stats.bytesPerPixel; }
     void setSNR(double val) { stats.SNR = val; }
@@ -189,7 +191,21 @@ class FITSData
     // Is WCS Image loaded?
     bool isWCSLoaded() { return WCSLoaded; }
 
-    wcs_point *getWCSCoord() { return wcs_coord; }
+    /**
+         * @brief getWCSCoord Get J2000 world coordinates of an image pixel. Coordinates are computed on demand
+         * and interpolated from a cached coarse grid, see FITSWCSGrid.
+         * @param x X image coordinate
+         * @param y Y image coordinate
+         * @param coord Store back RA and DE in degrees
+         * @return True if WCS is loaded and conversion is successful, false otherwise.
+         */
+    bool getWCSCoord(double x, double y, wcs_point &coord);
+
+    /**
+         * @brief getWCSBounds Get the range of J2000 world coordinates covered by the image, in degrees.
+         * @return True if WCS is loaded, false otherwise.
+         */
+    bool getWCSBounds(double *minRA, double *maxRA, double *minDE, double *maxDE);
 
     /**
          * @brief wcsToPixel Given J2000 (RA0,DE0) coordinates. Find in the image the corresponding pixel coordinates.
@@ -240,13 +256,21 @@ class FITSData
 
     // Filter
     void applyFilter(FITSScale type, uint8_t *image = nullptr, float *min = nullptr, float *max = nullptr);
+    // Clipping limits applyFilter would use for the filter type, without touching the image. -1 selects data min/max.
+    void getFilterLimits(FITSScale type, float *min, float *max);
 
     // Rotation counter. We keep count to rotate WCS keywords on save
     int getRotCounter() const;
     void setRotCounter(int value);
 
-    // Filename
-    const QString &getFilename() { return filename; }
+    // Filename. If the image was loaded from memory, waits until its file is written, or writes it.
+    const QString &getFilename();
+    // Was the image loaded from memory rather than from its file?
+    bool isInMemory() const { return fitsBuffer.isEmpty() == false; }
+    // Background write of the file of an image loaded from memory
+    void setFileWrite(const QFuture<bool> &write);
+    // The file of an image loaded from memory is only written when getFilename() is called, and removed with the image
+    void deferFileWrite();
 
     // Horizontal flip counter. We keep count to rotate WCS keywords on save
     int getFlipHCounter() const;
@@ -258,7 +282,7 @@ class FITSData
 
 #ifndef KSTARS_LITE
 #ifdef HAVE_WCSLIB
-    void findObjectsInImage(double world[], double phi, double theta, double imgcrd[], double pixcrd[], int stat[]);
+    void findObjectsInImage();
 #endif
 #endif
     QList<FITSSkyObject *> getSkyObjects();
@@ -275,12 +299,17 @@ class FITSData
   private:
     void rotWCSFITS(int angle, int mirror);
     bool checkCollision(Edge *s1, Edge *s2);
-    int calculateMinMax(bool refresh = false);
+    void readMinMaxKeywords();
+    bool loadImage(const QString &inFilename, const QByteArray &buffer, bool silent);
+    int openMemoryImage(int *status);
+    void removeTemporaryFile();
+    bool loadMappedImage();
     bool checkDebayer();
     void readWCSKeys();
 
     // Templated functions
 
+    // Debayer with FITSBayer straight into a new planar buffer
     template <typename T>
     bool debayer();
 
@@ -293,15 +322,21 @@ class FITSData
     // Star Detect - Centroid
     template <typename T>
     void findCentroid(const QRectF &boundary, int initStdDev, int minEdgeWidth);
+    // Scan rows [subY, subH) of columns [subX, subW) for runs above threshold, concurrently
+    template <typename T>
+    void findEdges(int subX, int subY, int subW, int subH, double threshold, double min, int minEdgeWidth,
+                   float dispersion_ratio, QList<Edge *> &edges);
     // Star Detect - Threshold
     template <typename T>
     int findOneStar(const QRectF &boundary);
 
+    // Convert a memory mapped image in row bands and calculate statistics as the bands are ready
     template <typename T>
-    void calculateMinMax();
-    /* Calculate running average & standard deviation using Welford’s method for computing variance */
+    void loadMappedBands(const uchar *map, quint64 signFlip);
+
+    /* Calculate mean, standard deviation, median and MAD of all channels, and optionally min & max, in a single pass */
     template <typename T>
-    void runningAverageStdDev();
+    void calculateChannelStats(bool updateMinMax);
 
     // Sobel detector by Gonzalo Exequiel Pedone
     template <typename T>
@@ -322,6 +357,15 @@ class FITSData
 #endif
     fitsfile *fptr; // Pointer to CFITSIO FITS file struct
 
+    // FITS file received in memory, if any. cfitsio reads it through fitsMemory and fitsMemorySize while fptr is open.
+    QByteArray fitsBuffer;
+    void *fitsMemory      = nullptr;
+    size_t fitsMemorySize = 0;
+    // Write of the file of the image received in memory, if it is written in the background
+    QFuture<bool> fileWrite;
+    // Whether the file of the image received in memory is still to be written by getFilename()
+    bool fileDeferred = false;
+
     int data_type;                  // FITS image data type (TBYTE, TUSHORT, TINT, TFLOAT, TLONG, TDOUBLE)
     int channels;                   // Number of channels
     uint8_t *imageBuffer = nullptr; // Generic data image buffer
@@ -340,7 +384,7 @@ class FITSData
     int flipHCounter; // How many times the image was flipped horizontally?
     int flipVCounter; // How many times the image was flipped vertically?
 
-    wcs_point *wcs_coord;      // Pointer to WCS coordinate data, if any.
+    FITSWCSGrid *wcsGrid = nullptr; // On demand WCS coordinates, if any.
     struct wcsprm *wcs = 0;    // WCS Struct
     QList<Edge *> starCenters; // All the stars we detected, if any.
     Edge *maxHFRStar;          // The biggest fattest star in the image.
@@ -355,6 +399,7 @@ class FITSData
         double mean[3];
         double stddev[3];
         double median[3];
+        double mad[3];
         double SNR;
         int bitpix;
         int bytesPerPixel;
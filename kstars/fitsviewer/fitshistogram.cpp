@@ -13,10 +13,12 @@
 #include "fitstab.h"
 #include "fitsview.h"
 #include "fitsdata.h"
+#include "fitsimagedelta.h"
+#include "fitsstatistics.h"
 
 #include <cmath>
 #include <cstdlib>
-#include <zlib.h>
+#include <numeric>
 
 #include <QPainter>
 #include <QSlider>
@@ -27,6 +29,7 @@
 #include <QPushButton>
 #include <QMouseEvent>
 #include <QPaintEvent>
+#include <QHideEvent>
 
 #include <QUndoStack>
 #include <QDebug>
@@ -169,40 +172,19 @@ void FITSHistogram::constructHistogram()
     for (int i = 0; i < binCount; i++)
         intensity[i] = fits_min + (binWidth * i);
 
-    uint16_t r_id = 0, g_id = 0, b_id = 0;
+    FITSStatistics::histogram<T>(buffer, samples, fits_min, binWidth, binCount, r_frequency.data());
 
-    if (image_data->getNumOfChannels() == 1)
-    {
-        for (uint32_t i = 0; i < samples; i++)
-        {
-            r_id = round((buffer[i] - fits_min) / binWidth);
-            r_frequency[r_id >= binCount ? binCount - 1 : r_id]++;
-        }
-    }
-    else
+    if (image_data->getNumOfChannels() > 1)
     {
         g_frequency.fill(0, binCount);
         b_frequency.fill(0, binCount);
 
-        int g_offset = samples;
-        int b_offset = samples * 2;
-        for (uint32_t i = 0; i < samples; i++)
-        {
-            r_id = round((buffer[i] - fits_min) / binWidth);
-            r_frequency[r_id >= binCount ? binCount - 1 : r_id]++;
-
-            g_id = round((buffer[i + g_offset] - fits_min) / binWidth);
-            g_frequency[g_id >= binCount ? binCount - 1 : g_id]++;
-
-            b_id = round((buffer[i + b_offset] - fits_min) / binWidth);
-            b_frequency[b_id >= binCount ? binCount - 1 : b_id]++;
-        }
+        FITSStatistics::histogram<T>(buffer + samples, samples, fits_min, binWidth, binCount, g_frequency.data());
+        FITSStatistics::histogram<T>(buffer + samples * 2, samples, fits_min, binWidth, binCount, b_frequency.data());
     }
 
     // Cumuliative Frequency
-    for (int i = 0; i < binCount; i++)
-        for (int j = 0; j <= i; j++)
-            cumulativeFrequency[i] += r_frequency[j];
+    std::partial_sum(r_frequency.constBegin(), r_frequency.constEnd(), cumulativeFrequency.begin());
 
     int maxFrequency = 0;
     if (image_data->getNumOfChannels() == 1)
@@ -304,6 +286,27 @@ void FITSHistogram::updateLimits(double value)
             ui->maxEdit->setValue(value + 1);
         }
     }
+
+    // Preview the limits on the display image, the data is only modified once the scale is applied
+    if (isVisible())
+    {
+        tab->getView()->previewStretch(ui->logR->isChecked() ? FITS_LOG : FITS_LINEAR, ui->minEdit->value(),
+                                       ui->maxEdit->value());
+        previewing = true;
+    }
+}
+
+void FITSHistogram::hideEvent(QHideEvent *event)
+{
+    // Restore the display image if the previewed limits were not applied
+    if (previewing)
+    {
+        previewing = false;
+        tab->getView()->rescale(ZOOM_KEEP_LEVEL);
+        tab->getView()->updateFrame();
+    }
+
+    QDialog::hideEvent(event);
 }
 
 void FITSHistogram::checkRangeLimit(const QCPRange &range)
@@ -333,6 +336,7 @@ void FITSHistogram::applyScale()
 
     histC = new FITSHistogramCommand(tab, this, type, min, max);
 
+    previewing = false;
     tab->getUndoStack()->push(histC);
 }
 
@@ -387,6 +391,7 @@ FITSHistogramCommand::FITSHistogramCommand(QWidget *parent, FITSHistogram *inHis
     histogram       = inHisto;
     delta           = nullptr;
     original_buffer = nullptr;
+    filterKept      = false;
 
     min = lmin;
     max = lmax;
@@ -394,100 +399,34 @@ FITSHistogramCommand::FITSHistogramCommand(QWidget *parent, FITSHistogram *inHis
 
 FITSHistogramCommand::~FITSHistogramCommand()
 {
-    delete (delta);
+    delete delta;
+    delete[] original_buffer;
 }
 
-bool FITSHistogramCommand::calculateDelta(uint8_t *buffer)
+void FITSHistogramCommand::applyFilter()
 {
     FITSData *image_data = tab->getView()->getImageData();
+    float dataMin = min, dataMax = max;
 
-    uint8_t *image_buffer    = image_data->getImageBuffer();
-    int totalPixels          = image_data->getSize() * image_data->getNumOfChannels();
-    unsigned long totalBytes = totalPixels * image_data->getBytesPerPixel();
-
-    uint8_t *raw_delta = new uint8_t[totalBytes];
-
-    if (raw_delta == nullptr)
-    {
-        qWarning() << "Error! not enough memory to create image delta" << endl;
-        return false;
-    }
-
-    for (unsigned int i = 0; i < totalBytes; i++)
-        raw_delta[i] = buffer[i] ^ image_buffer[i];
-
-    compressedBytes = sizeof(uint8_t) * totalBytes + totalBytes / 64 + 16 + 3;
-    delete[] delta;
-    delta = new uint8_t[compressedBytes];
-
-    if (delta == nullptr)
-    {
-        delete[] raw_delta;
-        qDebug() << "FITSHistogram Error: Ran out of memory compressing delta" << endl;
-        return false;
-    }
-
-    int r = compress2(delta, &compressedBytes, raw_delta, totalBytes, 5);
-    if (r != Z_OK)
-    {
-        /* this should NEVER happen */
-        qDebug() << "FITSHistogram Error: Failed to compress raw_delta" << endl;
-        return false;
-    }
-
-    //qDebug() << "compressed bytes size " << compressedBytes << " bytes" << endl;
-
-    delete[] raw_delta;
-
-    return true;
-}
-
-bool FITSHistogramCommand::reverseDelta()
-{
-    FITSView *image       = tab->getView();
-    FITSData *image_data  = image->getImageData();
-    uint8_t *image_buffer = (image_data->getImageBuffer());
-
-    unsigned int size = image_data->getSize();
-    int channels      = image_data->getNumOfChannels();
-
-    int totalPixels          = size * channels;
-    unsigned long totalBytes = totalPixels * image_data->getBytesPerPixel();
-
-    uint8_t *output_image = new uint8_t[totalBytes];
-
-    if (output_image == nullptr)
+    switch (type)
     {
-        qWarning() << "Error! not enough memory to create output image" << endl;
-        return false;
-    }
+        case FITS_AUTO:
+        case FITS_LINEAR:
+            image_data->applyFilter(FITS_LINEAR, nullptr, &dataMin, &dataMax);
+            break;
 
-    uint8_t *raw_delta = new uint8_t[totalBytes];
+        case FITS_LOG:
+            image_data->applyFilter(FITS_LOG, nullptr, &dataMin, &dataMax);
+            break;
 
-    if (raw_delta == nullptr)
-    {
-        delete[] output_image;
-        qWarning() << "Error! not enough memory to create image delta" << endl;
-        return false;
-    }
+        case FITS_SQRT:
+            image_data->applyFilter(FITS_SQRT, nullptr, &dataMin, &dataMax);
+            break;
 
-    int r = uncompress(raw_delta, &totalBytes, delta, compressedBytes);
-    if (r != Z_OK)
-    {
-        qDebug() << "FITSHistogram compression error in reverseDelta()" << endl;
-        delete[] output_image;
-        delete[] raw_delta;
-        return false;
+        default:
+            image_data->applyFilter(type);
+            break;
     }
-
-    for (unsigned int i = 0; i < totalBytes; i++)
-        output_image[i] = raw_delta[i] ^ image_buffer[i];
-
-    image_data->setImageBuffer(output_image);
-
-    delete[] raw_delta;
-
-    return true;
 }
 
 void FITSHistogramCommand::redo()
@@ -502,68 +441,50 @@ void FITSHistogramCommand::redo()
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
-    if (delta != nullptr)
+    // The image still holds the result of the filter, and its statistics
+    if (filterKept)
     {
-        double min, max, stddev, average, median, snr;
-        min     = image_data->getMin();
-        max     = image_data->getMax();
-        stddev  = image_data->getStdDev();
-        average = image_data->getMean();
-        median  = image_data->getMedian();
-        snr     = image_data->getSNR();
-
-        reverseDelta();
+        filterKept = false;
+        QApplication::restoreOverrideCursor();
+        return;
+    }
 
-        restoreStats();
+    saveStats(image_data->getMin(), image_data->getMax(), image_data->getStdDev(), image_data->getMean(),
+              image_data->getMedian(), image_data->getSNR());
 
-        saveStats(min, max, stddev, average, median, snr);
+    // Rotation and flip are undone by their inverse, and filters are deterministic, so redo simply applies the
+    // operation again. Only the first application records the tiles it changed.
+    if ((type >= FITS_ROTATE_CW && type <= FITS_FLIP_V) || delta != nullptr || original_buffer != nullptr)
+    {
+        applyFilter();
     }
     else
     {
-        saveStats(image_data->getMin(), image_data->getMax(), image_data->getStdDev(), image_data->getMean(),
-                  image_data->getMedian(), image_data->getSNR());
+        uint8_t *buffer = new uint8_t[size * channels * BBP];
 
-        // If it's rotation of flip, no need to calculate delta
-        if (type >= FITS_ROTATE_CW && type <= FITS_FLIP_V)
+        if (buffer == nullptr)
         {
-            image_data->applyFilter(type, image_buffer);
+            qWarning() << "Error! not enough memory to create image buffer in redo()" << endl;
+            QApplication::restoreOverrideCursor();
+            return;
         }
+
+        memcpy(buffer, image_buffer, size * channels * BBP);
+
+        applyFilter();
+
+        uint16_t w = 0, h = 0;
+        image_data->getDimensions(&w, &h);
+
+        delta = new FITSImageDelta();
+
+        if (delta->record(buffer, image_data->getImageBuffer(), w, h, channels, BBP))
+            delete[] buffer;
         else
         {
-            uint8_t *buffer = new uint8_t[size * channels * BBP];
-
-            if (buffer == nullptr)
-            {
-                qWarning() << "Error! not enough memory to create image buffer in redo()" << endl;
-                QApplication::restoreOverrideCursor();
-                return;
-            }
-
-            memcpy(buffer, image_buffer, size * channels * BBP);
-            float dataMin = min, dataMax = max;
-
-            switch (type)
-            {
-                case FITS_AUTO:
-                case FITS_LINEAR:
-                    image_data->applyFilter(FITS_LINEAR, nullptr, &dataMin, &dataMax);
-                    break;
-
-                case FITS_LOG:
-                    image_data->applyFilter(FITS_LOG, nullptr, &dataMin, &dataMax);
-                    break;
-
-                case FITS_SQRT:
-                    image_data->applyFilter(FITS_SQRT, nullptr, &dataMin, &dataMax);
-                    break;
-
-                default:
-                    image_data->applyFilter(type);
-                    break;
-            }
-
-            calculateDelta(buffer);
-            delete[] buffer;
+            delete delta;
+            delta           = nullptr;
+            original_buffer = buffer;
         }
     }
 
@@ -589,21 +510,21 @@ void FITSHistogramCommand::undo()
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
-    if (delta != nullptr)
+    if (delta != nullptr || original_buffer != nullptr)
     {
-        double min, max, stddev, average, median, snr;
-        min     = image_data->getMin();
-        max     = image_data->getMax();
-        stddev  = image_data->getStdDev();
-        average = image_data->getMean();
-        median  = image_data->getMedian();
-        snr     = image_data->getSNR();
+        if (delta != nullptr && delta->restore(image_data->getImageBuffer()) == false)
+        {
+            qWarning() << "Error! failed to restore the image, the filter cannot be undone" << endl;
+            filterKept = true;
+            QApplication::restoreOverrideCursor();
+            return;
+        }
 
-        reverseDelta();
+        if (original_buffer != nullptr)
+            memcpy(image_data->getImageBuffer(), original_buffer,
+                   image_data->getSize() * image_data->getNumOfChannels() * image_data->getBytesPerPixel());
 
         restoreStats();
-
-        saveStats(min, max, stddev, average, median, snr);
     }
     else
     {
@@ -25,6 +25,7 @@
 
 const int INITIAL_MAXIMUM_WIDTH = 500;
 
+class FITSImageDelta;
 class FITSTab;
 class QPixmap;
 
@@ -70,6 +71,9 @@ class FITSHistogram : public QDialog
     void updateLimits(double value);
     void checkRangeLimit(const QCPRange &range);
 
+  protected:
+    void hideEvent(QHideEvent *event);
+
   private:
     template <typename T>
     void constructHistogram();
@@ -88,6 +92,7 @@ class FITSHistogram : public QDialog
     uint16_t binCount;
     FITSScale type;
     QCustomPlot *customPlot;
+    bool previewing = false;
 };
 
 class FITSHistogramCommand : public QUndoCommand
@@ -115,8 +120,7 @@ class FITSHistogramCommand : public QUndoCommand
         long dim[2];
     } stats;
 
-    bool calculateDelta(uint8_t *buffer);
-    bool reverseDelta();
+    void applyFilter();
     void saveStats(double min, double max, double stddev, double mean, double median, double SNR);
     void restoreStats();
 
@@ -124,9 +128,12 @@ class FITSHistogramCommand : public QUndoCommand
     FITSScale type;
     double min, max;
 
-    unsigned char *delta;
-    unsigned long compressedBytes;
+    // Tiles changed by the filter, nullptr for rotation and flip which are undone by their inverse
+    FITSImageDelta *delta;
+    // Whole image before the filter, kept instead of the delta if the tiles could not be recorded
     uint8_t *original_buffer;
+    // Undo could not restore the image, so the filter is still applied
+    bool filterKept;
     FITSTab *tab;
 };
 
@@ -0,0 +1,230 @@
+/***************************************************************************
+                          fitsimagedelta.cpp  -  FITS Image Delta
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "fitsimagedelta.h"
+
+#include "Options.h"
+
+#include <QDebug>
+#include <QTemporaryFile>
+#include <QtConcurrent>
+
+#include <cstring>
+
+// zlib level of the stored tiles, fast enough to keep up with the comparison of the tiles
+#define DELTA_COMPRESSION_LEVEL 1
+
+namespace
+{
+typedef struct
+{
+    int tile;
+    bool changed;
+    QByteArray content;
+} TileCheck;
+}
+
+QList<FITSImageDelta *> FITSImageDelta::resident;
+qint64 FITSImageDelta::memoryUsed = 0;
+
+FITSImageDelta::FITSImageDelta()
+{
+}
+
+FITSImageDelta::~FITSImageDelta()
+{
+    release();
+}
+
+void FITSImageDelta::release()
+{
+    if (resident.removeOne(this))
+        memoryUsed -= bytes;
+
+    delete file;
+    file = nullptr;
+
+    tiles.clear();
+    tileBytes.clear();
+    data.clear();
+    bytes = 0;
+}
+
+FITSImageDelta::TileRect FITSImageDelta::getTileRect(int tile) const
+{
+    int channel = tile / tilesPerPlane;
+    int plane   = tile % tilesPerPlane;
+    int x       = (plane % tilesPerRow) * TILE_SIZE;
+    int y       = (plane / tilesPerRow) * TILE_SIZE;
+
+    TileRect rect;
+    rect.offset  = ((channel * height + y) * static_cast<size_t>(width) + x) * bytesPerPixel;
+    rect.stride  = static_cast<size_t>(width) * bytesPerPixel;
+    rect.rowSize = qMin(TILE_SIZE, width - x) * bytesPerPixel;
+    rect.rows    = qMin(TILE_SIZE, height - y);
+
+    return rect;
+}
+
+bool FITSImageDelta::record(const uint8_t *before, const uint8_t *after, uint16_t imageWidth, uint16_t imageHeight,
+                            int imageChannels, int imageBytesPerPixel)
+{
+    release();
+
+    width         = imageWidth;
+    height        = imageHeight;
+    channels      = imageChannels;
+    bytesPerPixel = imageBytesPerPixel;
+    tilesPerRow   = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesPerPlane = tilesPerRow * ((height + TILE_SIZE - 1) / TILE_SIZE);
+
+    QVector<TileCheck> checks(tilesPerPlane * channels);
+    for (int i = 0; i < checks.count(); i++)
+        checks[i].tile = i;
+
+    // Compare all tiles concurrently, row by row, and compress the original content of those that changed
+    QtConcurrent::blockingMap(checks, [&](TileCheck &check) {
+        TileRect rect = getTileRect(check.tile);
+        const uint8_t *a = before + rect.offset, *b = after + rect.offset;
+
+        check.changed = false;
+        for (int row = 0; row < rect.rows && check.changed == false; row++)
+            check.changed = memcmp(a + row * rect.stride, b + row * rect.stride, rect.rowSize) != 0;
+
+        if (check.changed == false)
+            return;
+
+        QByteArray content(rect.rowSize * rect.rows, Qt::Uninitialized);
+        for (int row = 0; row < rect.rows; row++)
+            memcpy(content.data() + row * rect.rowSize, a + row * rect.stride, rect.rowSize);
+
+        check.content = qCompress(content, DELTA_COMPRESSION_LEVEL);
+    });
+
+    for (const TileCheck &check : checks)
+    {
+        if (check.changed == false)
+            continue;
+
+        // qCompress returns nothing if it runs out of memory
+        if (check.content.isEmpty())
+        {
+            qWarning() << "Error! not enough memory to record image delta";
+            release();
+            return false;
+        }
+
+        tiles.append(check.tile);
+        tileBytes.append(check.content.size());
+        bytes += check.content.size();
+    }
+
+    if (bytes == 0)
+        return true;
+
+    data.reserve(bytes);
+    for (const TileCheck &check : checks)
+        data.append(check.content);
+
+    resident.append(this);
+    memoryUsed += bytes;
+
+    enforceBudget();
+
+    return true;
+}
+
+bool FITSImageDelta::restore(uint8_t *buffer)
+{
+    // Spilled deltas are read back on every restore rather than held in memory again
+    QByteArray stored = data;
+
+    if (file)
+    {
+        if (file->seek(0) == false)
+            return false;
+
+        stored = file->readAll();
+        if (stored.size() != bytes)
+        {
+            qWarning() << "Error! failed to read back image delta from" << file->fileName();
+            return false;
+        }
+    }
+
+    // Every tile is uncompressed before buffer is changed, so that a delta that cannot be read leaves it untouched
+    QVector<QByteArray> contents(tiles.count());
+    const uchar *storage = reinterpret_cast<const uchar *>(stored.constData());
+
+    for (int i = 0; i < tiles.count(); i++)
+    {
+        TileRect rect = getTileRect(tiles[i]);
+
+        contents[i] = qUncompress(storage, tileBytes[i]);
+        storage += tileBytes[i];
+
+        if (contents[i].size() != rect.rowSize * rect.rows)
+        {
+            qWarning() << "Error! failed to uncompress image delta";
+            return false;
+        }
+    }
+
+    for (int i = 0; i < tiles.count(); i++)
+    {
+        TileRect rect = getTileRect(tiles[i]);
+        const uint8_t *content = reinterpret_cast<const uint8_t *>(contents[i].constData());
+
+        for (int row = 0; row < rect.rows; row++, content += rect.rowSize)
+            memcpy(buffer + rect.offset + row * rect.stride, content, rect.rowSize);
+    }
+
+    return true;
+}
+
+bool FITSImageDelta::spill()
+{
+    QTemporaryFile *spillFile = new QTemporaryFile();
+
+    if (spillFile->open() == false || spillFile->write(data) != bytes || spillFile->flush() == false)
+    {
+        qWarning() << "Error! failed to write image delta to a temporary file";
+        delete spillFile;
+        return false;
+    }
+
+    file = spillFile;
+    data.clear();
+    data.squeeze();
+
+    resident.removeOne(this);
+    memoryUsed -= bytes;
+
+    return true;
+}
+
+void FITSImageDelta::enforceBudget()
+{
+    qint64 budget = static_cast<qint64>(Options::fITSUndoMemory()) * 1024 * 1024;
+
+    // Spill the oldest deltas first, they are the least likely to be undone
+    while (memoryUsed > budget && resident.isEmpty() == false)
+    {
+        if (resident.first()->spill() == false)
+            break;
+    }
+}
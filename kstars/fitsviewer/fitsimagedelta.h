@@ -0,0 +1,107 @@
+/***************************************************************************
+                          fitsimagedelta.h  -  FITS Image Delta
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+#include <cstdint>
+
+class QTemporaryFile;
+
+/**
+ * @class FITSImageDelta
+ * @short Original content of the image tiles changed by an operation, kept to undo it.
+ *
+ * The image is compared in tiles of TILE_SIZE x TILE_SIZE pixels of each channel, and only tiles that differ are
+ * stored, compressed with zlib, so the cost of undoing an operation depends on how much of the image it changed. All
+ * deltas share one memory budget, set by the FITSUndoMemory option. Once the budget is exceeded, the oldest deltas are
+ * moved to temporary files until they are restored or deleted.
+ *
+ * @author agent
+ */
+class FITSImageDelta
+{
+  public:
+    FITSImageDelta();
+    ~FITSImageDelta();
+
+    /**
+     * @brief record Store the tiles of before that differ in after. Any previously recorded tiles are discarded.
+     * @param before image buffer before the operation
+     * @param after image buffer after the operation, with the same dimensions
+     * @return True if successful, false if the tiles could not be stored.
+     */
+    bool record(const uint8_t *before, const uint8_t *after, uint16_t width, uint16_t height, int channels,
+                int bytesPerPixel);
+
+    /**
+     * @brief restore Copy the recorded tiles back into buffer, which must have the dimensions given to record.
+     * @return True if successful, false if the tiles could not be read back, in which case buffer is left untouched.
+     */
+    bool restore(uint8_t *buffer);
+
+    /** @return Number of tiles that changed */
+    int getTileCount() const { return tiles.count(); }
+
+    /** @return Size of the stored tiles in bytes, once compressed */
+    qint64 getSize() const { return bytes; }
+
+    /** @return True if the tiles were moved to a temporary file to stay within the memory budget */
+    bool isSpilled() const { return file != nullptr; }
+
+    /** @return Memory used by all deltas that are not spilled, in bytes */
+    static qint64 getMemoryUsed() { return memoryUsed; }
+
+    static const int TILE_SIZE = 64;
+
+  private:
+    // Position of a tile within the image buffer, in bytes
+    typedef struct
+    {
+        size_t offset;
+        size_t stride;
+        int rowSize;
+        int rows;
+    } TileRect;
+
+    TileRect getTileRect(int tile) const;
+    bool spill();
+    void release();
+
+    static void enforceBudget();
+
+    // Deltas kept in memory, oldest first
+    static QList<FITSImageDelta *> resident;
+    static qint64 memoryUsed;
+
+    uint16_t width    = 0;
+    uint16_t height   = 0;
+    int channels      = 0;
+    int bytesPerPixel = 0;
+    int tilesPerRow   = 0;
+    int tilesPerPlane = 0;
+
+    // Indexes of the changed tiles, the size of their compressed original content, and that content one after the other
+    QVector<int> tiles;
+    QVector<int> tileBytes;
+    QByteArray data;
+    qint64 bytes         = 0;
+    QTemporaryFile *file = nullptr;
+};
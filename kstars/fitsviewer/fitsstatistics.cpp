@@ -0,0 +1,418 @@
+/***************************************************************************
+                          fitsstatistics.cpp  -  FITS Statistics
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "fitsstatistics.h"
+
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// Sums of a single row, relative to shift to avoid cancellation for floating point data
+typedef struct
+{
+    double min;
+    double max;
+    double shift;
+    double sum;
+    double sumSq;
+} RowSums;
+
+typedef struct
+{
+    int firstRow;
+    int lastRow;
+    FITSStatistics::BandStats channel[3];
+} Block;
+
+// Samples counted per thread before it is worth splitting a histogram, the bins of every block are merged afterwards
+#define MIN_HISTOGRAM_BLOCK 65536
+
+// Range of samples [first, last) counted into private bins
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+    std::vector<uint32_t> bins;
+} HistogramBlock;
+
+template <typename T>
+void accumulateRow(const T *row, int n, RowSums &sums)
+{
+    T rowMin = row[0], rowMax = row[0];
+    double shift = row[0], sum = 0, sumSq = 0;
+
+    // Branch free so that the compiler is free to vectorize it
+    for (int i = 0; i < n; i++)
+    {
+        T value = row[i];
+        rowMin  = value < rowMin ? value : rowMin;
+        rowMax  = value > rowMax ? value : rowMax;
+
+        double delta = value - shift;
+        sum += delta;
+        sumSq += delta * delta;
+    }
+
+    sums.min   = rowMin;
+    sums.max   = rowMax;
+    sums.shift = shift;
+    sums.sum   = sum;
+    sums.sumSq = sumSq;
+}
+
+#if defined(__SSE2__)
+// Integer sums are exact, so no shift is needed. Lane accumulators cannot overflow
+// since rows are at most UINT16_MAX pixels wide.
+template <>
+void accumulateRow<uint8_t>(const uint8_t *row, int n, RowSums &sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i vmin       = _mm_set1_epi8(static_cast<char>(0xFF));
+    __m128i vmax       = zero;
+    __m128i vsum       = zero;
+    __m128i vsumSq     = zero;
+
+    int i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+
+        vmin = _mm_min_epu8(vmin, value);
+        vmax = _mm_max_epu8(vmax, value);
+        vsum = _mm_add_epi64(vsum, _mm_sad_epu8(value, zero));
+
+        __m128i low  = _mm_unpacklo_epi8(value, zero);
+        __m128i high = _mm_unpackhi_epi8(value, zero);
+        vsumSq       = _mm_add_epi32(vsumSq, _mm_add_epi32(_mm_madd_epi16(low, low), _mm_madd_epi16(high, high)));
+    }
+
+    alignas(16) uint8_t mins[16], maxs[16];
+    alignas(16) uint64_t sum64[2];
+    alignas(16) uint32_t sumSq32[4];
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(mins), vmin);
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxs), vmax);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sum64), vsum);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sumSq32), vsumSq);
+
+    uint8_t rowMin = UINT8_MAX, rowMax = 0;
+    uint64_t sum = sum64[0] + sum64[1];
+    uint64_t sumSq = static_cast<uint64_t>(sumSq32[0]) + sumSq32[1] + sumSq32[2] + sumSq32[3];
+
+    if (i > 0)
+    {
+        rowMin = *std::min_element(mins, mins + 16);
+        rowMax = *std::max_element(maxs, maxs + 16);
+    }
+
+    for (; i < n; i++)
+    {
+        uint8_t value = row[i];
+        rowMin        = std::min(rowMin, value);
+        rowMax        = std::max(rowMax, value);
+        sum += value;
+        sumSq += value * value;
+    }
+
+    sums.min   = rowMin;
+    sums.max   = rowMax;
+    sums.shift = 0;
+    sums.sum   = sum;
+    sums.sumSq = sumSq;
+}
+
+template <>
+void accumulateRow<uint16_t>(const uint16_t *row, int n, RowSums &sums)
+{
+    // SSE2 only has signed 16 bit min/max, so values are compared with their sign bit flipped
+    const __m128i signFlip = _mm_set1_epi16(static_cast<short>(0x8000));
+    const __m128i zero     = _mm_setzero_si128();
+    __m128i vmin           = _mm_set1_epi16(0x7FFF);
+    __m128i vmax           = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i vsum           = zero;
+    __m128i vsumSq         = zero;
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i value   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        __m128i flipped = _mm_xor_si128(value, signFlip);
+
+        vmin = _mm_min_epi16(vmin, flipped);
+        vmax = _mm_max_epi16(vmax, flipped);
+
+        vsum = _mm_add_epi32(vsum, _mm_add_epi32(_mm_unpacklo_epi16(value, zero), _mm_unpackhi_epi16(value, zero)));
+
+        // 32 bit squares from the low and high halves of the 16x16 products
+        __m128i productLow  = _mm_mullo_epi16(value, value);
+        __m128i productHigh = _mm_mulhi_epu16(value, value);
+        __m128i square0     = _mm_unpacklo_epi16(productLow, productHigh);
+        __m128i square1     = _mm_unpackhi_epi16(productLow, productHigh);
+
+        vsumSq = _mm_add_epi64(vsumSq, _mm_unpacklo_epi32(square0, zero));
+        vsumSq = _mm_add_epi64(vsumSq, _mm_unpackhi_epi32(square0, zero));
+        vsumSq = _mm_add_epi64(vsumSq, _mm_unpacklo_epi32(square1, zero));
+        vsumSq = _mm_add_epi64(vsumSq, _mm_unpackhi_epi32(square1, zero));
+    }
+
+    alignas(16) uint16_t mins[8], maxs[8];
+    alignas(16) uint32_t sum32[4];
+    alignas(16) uint64_t sumSq64[2];
+
+    _mm_store_si128(reinterpret_cast<__m128i *>(mins), _mm_xor_si128(vmin, signFlip));
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxs), _mm_xor_si128(vmax, signFlip));
+    _mm_store_si128(reinterpret_cast<__m128i *>(sum32), vsum);
+    _mm_store_si128(reinterpret_cast<__m128i *>(sumSq64), vsumSq);
+
+    uint16_t rowMin = UINT16_MAX, rowMax = 0;
+    uint64_t sum   = static_cast<uint64_t>(sum32[0]) + sum32[1] + sum32[2] + sum32[3];
+    uint64_t sumSq = sumSq64[0] + sumSq64[1];
+
+    if (i > 0)
+    {
+        rowMin = *std::min_element(mins, mins + 8);
+        rowMax = *std::max_element(maxs, maxs + 8);
+    }
+
+    for (; i < n; i++)
+    {
+        uint16_t value = row[i];
+        rowMin         = std::min(rowMin, value);
+        rowMax         = std::max(rowMax, value);
+        sum += value;
+        sumSq += static_cast<uint64_t>(value) * value;
+    }
+
+    sums.min   = rowMin;
+    sums.max   = rowMax;
+    sums.shift = 0;
+    sums.sum   = sum;
+    sums.sumSq = sumSq;
+}
+#endif
+
+template <typename T>
+void estimateMedian(const T *buffer, uint32_t samples, FITSStatistics::ChannelStats &stats)
+{
+    uint32_t stride = std::max<uint32_t>(1, samples / FITSStatistics::MAX_MEDIAN_SAMPLES);
+    std::vector<T> sample;
+
+    sample.reserve(samples / stride + 1);
+    for (uint32_t i = 0; i < samples; i += stride)
+        sample.push_back(buffer[i]);
+
+    auto middle = sample.begin() + sample.size() / 2;
+    std::nth_element(sample.begin(), middle, sample.end());
+    stats.median = *middle;
+
+    std::vector<double> deviation(sample.size());
+    for (size_t i = 0; i < sample.size(); i++)
+        deviation[i] = std::abs(static_cast<double>(sample[i]) - stats.median);
+
+    auto middleDeviation = deviation.begin() + deviation.size() / 2;
+    std::nth_element(deviation.begin(), middleDeviation, deviation.end());
+    stats.mad = *middleDeviation;
+}
+}
+
+namespace FITSStatistics
+{
+void BandStats::addRow(double n, double rowMin, double rowMax, double rowMean, double rowM2)
+{
+    BandStats row;
+
+    row.count = n;
+    row.mean  = rowMean;
+    row.m2    = rowM2;
+    row.min   = rowMin;
+    row.max   = rowMax;
+
+    merge(row);
+}
+
+void BandStats::merge(const BandStats &other)
+{
+    if (other.count == 0)
+        return;
+
+    // Chan et al. pairwise update
+    double total = count + other.count;
+    double delta = other.mean - mean;
+
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count = total;
+
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+template <typename T>
+void calculateBand(const T *buffer, uint16_t width, uint16_t height, int channels, int firstRow, int lastRow,
+                   BandStats *bandStats)
+{
+    uint32_t samples = width * height;
+    RowSums sums;
+
+    for (int ch = 0; ch < std::min(channels, 3); ch++)
+    {
+        const T *channel = buffer + ch * samples;
+
+        for (int row = firstRow; row < lastRow; row++)
+        {
+            accumulateRow<T>(channel + row * width, width, sums);
+            bandStats[ch].addRow(width, sums.min, sums.max, sums.shift + sums.sum / width,
+                                 sums.sumSq - sums.sum * sums.sum / width);
+        }
+    }
+}
+
+template <typename T>
+void finish(const T *buffer, uint16_t width, uint16_t height, int channels, const BandStats *bandStats,
+            ChannelStats *stats)
+{
+    uint32_t samples = width * height;
+
+    for (int ch = 0; ch < std::min(channels, 3); ch++)
+    {
+        const BandStats &total = bandStats[ch];
+
+        stats[ch].min    = total.min;
+        stats[ch].max    = total.max;
+        stats[ch].mean   = total.mean;
+        stats[ch].stddev = total.count > 1 ? sqrt(std::max(0.0, total.m2 / (total.count - 1))) : 0;
+
+        estimateMedian<T>(buffer + ch * samples, samples, stats[ch]);
+    }
+}
+
+template <typename T>
+void calculate(const T *buffer, uint16_t width, uint16_t height, int channels, ChannelStats *stats)
+{
+    if (width == 0 || height == 0 || channels < 1)
+        return;
+
+    // Several blocks per core so that a slow core does not hold the rest
+    int blockCount = std::min<int>(height, QThread::idealThreadCount() * 4);
+    int blockRows  = (height + blockCount - 1) / blockCount;
+    QVector<Block> blocks;
+
+    for (int row = 0; row < height; row += blockRows)
+    {
+        Block block;
+        block.firstRow = row;
+        block.lastRow  = std::min<int>(row + blockRows, height);
+        blocks.append(block);
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](Block &block) {
+        calculateBand<T>(buffer, width, height, channels, block.firstRow, block.lastRow, block.channel);
+    });
+
+    BandStats total[3];
+    for (const Block &block : blocks)
+    {
+        for (int ch = 0; ch < std::min(channels, 3); ch++)
+            total[ch].merge(block.channel[ch]);
+    }
+
+    finish<T>(buffer, width, height, channels, total, stats);
+}
+
+template <typename T>
+void histogram(const T *buffer, uint32_t samples, double min, double binWidth, int binCount, double *frequency)
+{
+    std::fill(frequency, frequency + binCount, 0);
+
+    if (samples == 0 || binCount < 1)
+        return;
+
+    int blockCount  = std::max<int>(1, std::min<int>(QThread::idealThreadCount(), samples / MIN_HISTOGRAM_BLOCK));
+    uint32_t blockN = (samples + blockCount - 1) / blockCount;
+    QVector<HistogramBlock> blocks;
+
+    for (uint32_t first = 0; first < samples; first += blockN)
+    {
+        HistogramBlock block;
+        block.first = first;
+        block.last  = std::min(first + blockN, samples);
+        blocks.append(block);
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](HistogramBlock &block) {
+        block.bins.assign(binCount, 0);
+        uint32_t *bins = block.bins.data();
+
+        for (uint32_t k = block.first; k < block.last; k++)
+        {
+            uint16_t id = round((buffer[k] - min) / binWidth);
+            bins[id >= binCount ? binCount - 1 : id]++;
+        }
+    });
+
+    for (const HistogramBlock &block : blocks)
+    {
+        for (int i = 0; i < binCount; i++)
+            frequency[i] += block.bins[i];
+    }
+}
+
+template void calculate<uint8_t>(const uint8_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<int16_t>(const int16_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<uint16_t>(const uint16_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<int32_t>(const int32_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<uint32_t>(const uint32_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<float>(const float *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<int64_t>(const int64_t *, uint16_t, uint16_t, int, ChannelStats *);
+template void calculate<double>(const double *, uint16_t, uint16_t, int, ChannelStats *);
+
+template void calculateBand<uint8_t>(const uint8_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<int16_t>(const int16_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<uint16_t>(const uint16_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<int32_t>(const int32_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<uint32_t>(const uint32_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<float>(const float *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<int64_t>(const int64_t *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void calculateBand<double>(const double *, uint16_t, uint16_t, int, int, int, BandStats *);
+template void finish<uint8_t>(const uint8_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<int16_t>(const int16_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<uint16_t>(const uint16_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<int32_t>(const int32_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<uint32_t>(const uint32_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<float>(const float *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<int64_t>(const int64_t *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+template void finish<double>(const double *, uint16_t, uint16_t, int, const BandStats *, ChannelStats *);
+
+template void histogram<uint8_t>(const uint8_t *, uint32_t, double, double, int, double *);
+template void histogram<int16_t>(const int16_t *, uint32_t, double, double, int, double *);
+template void histogram<uint16_t>(const uint16_t *, uint32_t, double, double, int, double *);
+template void histogram<int32_t>(const int32_t *, uint32_t, double, double, int, double *);
+template void histogram<uint32_t>(const uint32_t *, uint32_t, double, double, int, double *);
+template void histogram<float>(const float *, uint32_t, double, double, int, double *);
+template void histogram<int64_t>(const int64_t *, uint32_t, double, double, int, double *);
+template void histogram<double>(const double *, uint32_t, double, double, int, double *);
+}
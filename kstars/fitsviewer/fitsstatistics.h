@@ -0,0 +1,100 @@
+/***************************************************************************
+                          fitsstatistics.h  -  FITS Statistics
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace FITSStatistics
+ * @short Single pass statistics kernel for FITS image buffers.
+ *
+ * Minimum, maximum, mean and standard deviation of all channels are computed in one pass over
+ * the buffer. The rows are split in blocks that are processed concurrently, each row is
+ * accumulated by a vectorized kernel (SSE2 for 8 and 16 bit data, scalar otherwise), and the
+ * partial results are merged with Chan's parallel variance algorithm. Median and median absolute
+ * deviation are estimated from an evenly strided sample of each channel.
+ */
+namespace FITSStatistics
+{
+typedef struct
+{
+    double min;
+    double max;
+    double mean;
+    double stddev;
+    double median;
+    double mad;
+} ChannelStats;
+
+/**
+ * @class BandStats
+ * @short Running statistics of one channel over a band of rows. Bands are merged with Chan's parallel variance update.
+ */
+class BandStats
+{
+  public:
+    void addRow(double n, double rowMin, double rowMax, double rowMean, double rowM2);
+    void merge(const BandStats &other);
+
+    double count = 0;
+    double mean  = 0;
+    double m2    = 0;
+    double min   = 1.0E300;
+    double max   = -1.0E300;
+};
+
+/** Maximum number of pixels per channel sampled to estimate median and MAD. Smaller images are exact. */
+const uint32_t MAX_MEDIAN_SAMPLES = 500000;
+
+/**
+ * @brief calculate Calculate statistics of each channel of a planar image buffer.
+ * @param buffer image buffer, channels are stored one after the other
+ * @param width image width in pixels
+ * @param height image height in pixels
+ * @param channels number of channels
+ * @param stats array of at least channels elements to store the statistics
+ */
+template <typename T>
+void calculate(const T *buffer, uint16_t width, uint16_t height, int channels, ChannelStats *stats);
+
+/**
+ * @brief calculateBand Accumulate statistics of rows [firstRow, lastRow) of each channel. Bands may be calculated
+ * concurrently, for example while the remaining rows of the image are still being loaded.
+ * @param bandStats array of at least channels elements
+ */
+template <typename T>
+void calculateBand(const T *buffer, uint16_t width, uint16_t height, int channels, int firstRow, int lastRow,
+                   BandStats *bandStats);
+
+/**
+ * @brief finish Turn the merged statistics of all bands into channel statistics, and estimate median and MAD from the
+ * buffer, which must be complete by then.
+ */
+template <typename T>
+void finish(const T *buffer, uint16_t width, uint16_t height, int channels, const BandStats *bandStats,
+            ChannelStats *stats);
+
+/**
+ * @brief histogram Count the samples of one channel into binCount bins of binWidth starting at min. A sample goes to
+ * the nearest bin, samples beyond the last bin are counted in it. Each thread counts into its own bins, which are
+ * merged at the end.
+ * @param frequency array of binCount elements to store the counts
+ */
+template <typename T>
+void histogram(const T *buffer, uint32_t samples, double min, double binWidth, int binCount, double *frequency);
+}
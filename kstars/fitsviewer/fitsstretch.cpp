@@ -0,0 +1,219 @@
+/***************************************************************************
+                          fitsstretch.cpp  -  FITS Stretch
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "fitsstretch.h"
+
+#include <QImage>
+#include <QPair>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+// Run function(firstRow, lastRow) over blocks of rows on the global thread pool
+template <typename F>
+void forEachRowBlock(uint32_t rows, F function)
+{
+    uint32_t blockCount = qMax<uint32_t>(1, qMin<uint32_t>(rows, QThread::idealThreadCount() * 4));
+    uint32_t blockRows  = (rows + blockCount - 1) / blockCount;
+    QVector<QPair<uint32_t, uint32_t>> blocks;
+
+    for (uint32_t row = 0; row < rows; row += blockRows)
+        blocks.append(qMakePair(row, qMin(row + blockRows, rows)));
+
+    QtConcurrent::blockingMap(blocks, [&](QPair<uint32_t, uint32_t> &block) { function(block.first, block.second); });
+}
+
+// Render rows through a functor mapping a sample to its 8 bit display value
+template <typename T, typename F>
+void renderRows(const T *source, uint32_t width, uint32_t height, int channels, QImage *image, F pixel)
+{
+    uint8_t *bits       = image->bits();
+    int bytesPerLine    = image->bytesPerLine();
+    uint32_t samples    = width * height;
+
+    forEachRowBlock(height, [&](uint32_t firstRow, uint32_t lastRow) {
+        for (uint32_t row = firstRow; row < lastRow; row++)
+        {
+            const T *r = source + row * width;
+
+            if (channels == 1)
+            {
+                uint8_t *scanLine = bits + row * bytesPerLine;
+
+                for (uint32_t i = 0; i < width; i++)
+                    scanLine[i] = pixel(r[i]);
+            }
+            else
+            {
+                QRgb *scanLine = reinterpret_cast<QRgb *>(bits + row * bytesPerLine);
+                const T *g     = r + samples;
+                const T *b     = r + samples * 2;
+
+                for (uint32_t i = 0; i < width; i++)
+                    scanLine[i] = qRgb(pixel(r[i]), pixel(g[i]), pixel(b[i]));
+            }
+        }
+    });
+}
+}
+
+FITSStretch::FITSStretch(FITSScale type, double min, double max) : type(type), min(min), max(max)
+{
+    switch (type)
+    {
+        case FITS_LOG:
+            coeff = max / log(1 + max);
+            break;
+
+        case FITS_SQRT:
+            coeff = max / sqrt(max);
+            break;
+
+        default:
+            break;
+    }
+
+    if (max > min)
+    {
+        scale = 255.0 / (max - min);
+        zero  = -min * scale;
+    }
+}
+
+bool FITSStretch::isPointFilter(FITSScale type)
+{
+    switch (type)
+    {
+        case FITS_AUTO:
+        case FITS_LINEAR:
+        case FITS_LOG:
+        case FITS_SQRT:
+        case FITS_AUTO_STRETCH:
+        case FITS_HIGH_CONTRAST:
+        case FITS_HIGH_PASS:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+T FITSStretch::transfer(T value) const
+{
+    T low = static_cast<T>(min), high = static_cast<T>(max);
+
+    switch (type)
+    {
+        case FITS_LOG:
+            return qBound(low, static_cast<T>(round(coeff * log(1 + qBound(low, value, high)))), high);
+
+        case FITS_SQRT:
+            return qBound(low, static_cast<T>(round(coeff * value)), high);
+
+        default:
+            return qBound(low, value, high);
+    }
+}
+
+template <typename T>
+uint8_t FITSStretch::display(T value) const
+{
+    return static_cast<uint8_t>(qBound(0.0, value * scale + zero, 255.0));
+}
+
+template <typename T>
+void FITSStretch::apply(const T *source, T *target, uint32_t width, uint32_t height, int channels) const
+{
+    forEachRowBlock(height * channels, [&](uint32_t firstRow, uint32_t lastRow) {
+        const T *in = source + firstRow * width;
+        T *out      = target + firstRow * width;
+        uint32_t n  = (lastRow - firstRow) * width;
+
+        if (type == FITS_LOG || type == FITS_SQRT)
+        {
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = transfer<T>(in[i]);
+        }
+        else
+        {
+            // Plain clipping, kept branch free so that it vectorizes
+            T low = static_cast<T>(min), high = static_cast<T>(max);
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                T value = in[i];
+                value   = value < low ? low : value;
+                out[i]  = value > high ? high : value;
+            }
+        }
+    });
+}
+
+template <typename T>
+void FITSStretch::render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image) const
+{
+    render(source, width, height, channels, image,
+           std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) <= 2>());
+}
+
+template <typename T>
+void FITSStretch::render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image,
+                         std::true_type) const
+{
+    // 8 and 16 bit data: fold the transfer function and the display scaling into one lookup table
+    const int32_t lowest = std::numeric_limits<T>::lowest();
+    const int32_t range  = static_cast<int32_t>(std::numeric_limits<T>::max()) - lowest + 1;
+    QVector<uint8_t> table(range);
+    uint8_t *lut = table.data();
+
+    for (int32_t i = 0; i < range; i++)
+        lut[i] = display<T>(transfer<T>(static_cast<T>(i + lowest)));
+
+    renderRows(source, width, height, channels, image, [lut, lowest](T value) { return lut[value - lowest]; });
+}
+
+template <typename T>
+void FITSStretch::render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image,
+                         std::false_type) const
+{
+    renderRows(source, width, height, channels, image, [this](T value) { return display<T>(transfer<T>(value)); });
+}
+
+template void FITSStretch::apply<uint8_t>(const uint8_t *, uint8_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<int16_t>(const int16_t *, int16_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<uint16_t>(const uint16_t *, uint16_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<int32_t>(const int32_t *, int32_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<uint32_t>(const uint32_t *, uint32_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<float>(const float *, float *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<int64_t>(const int64_t *, int64_t *, uint32_t, uint32_t, int) const;
+template void FITSStretch::apply<double>(const double *, double *, uint32_t, uint32_t, int) const;
+
+template void FITSStretch::render<uint8_t>(const uint8_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<int16_t>(const int16_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<uint16_t>(const uint16_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<int32_t>(const int32_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<uint32_t>(const uint32_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<float>(const float *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<int64_t>(const int64_t *, uint32_t, uint32_t, int, QImage *) const;
+template void FITSStretch::render<double>(const double *, uint32_t, uint32_t, int, QImage *) const;
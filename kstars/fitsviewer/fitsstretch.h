@@ -0,0 +1,79 @@
+/***************************************************************************
+                          fitsstretch.h  -  FITS Stretch
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "fitscommon.h"
+
+#include <cstdint>
+#include <type_traits>
+
+class QImage;
+
+/**
+ * @class FITSStretch
+ * @short Point transfer functions (linear, log, sqrt and the clipping filters) applied in parallel over row blocks.
+ *
+ * A stretch can either transform FITS data, which is what FITSData::applyFilter does for the point filters, or render
+ * the stretched data straight into an 8 bit display image without modifying the source buffer. For 8 and 16 bit data
+ * the transfer function and the display scaling are folded into a single lookup table.
+ *
+ * @author agent
+ */
+class FITSStretch
+{
+  public:
+    /**
+     * @param type Filter type, must be a point filter (see isPointFilter)
+     * @param min Lower clipping limit of the data, already adjusted for the filter type
+     * @param max Upper clipping limit of the data, already adjusted for the filter type
+     */
+    FITSStretch(FITSScale type, double min, double max);
+
+    /** @return True if the filter only depends on the value of each pixel, and hence can be handled by FITSStretch */
+    static bool isPointFilter(FITSScale type);
+
+    /**
+     * @brief apply Transform samples from source into target. Both may point to the same buffer.
+     */
+    template <typename T>
+    void apply(const T *source, T *target, uint32_t width, uint32_t height, int channels) const;
+
+    /**
+     * @brief render Stretch source into an 8 bit display image. Grayscale images must be Format_Indexed8, color images
+     * Format_RGB32 with the same dimensions as the data. The display range is [min, max] after the transfer function.
+     */
+    template <typename T>
+    void render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image) const;
+
+  private:
+    template <typename T>
+    void render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image, std::true_type) const;
+    template <typename T>
+    void render(const T *source, uint32_t width, uint32_t height, int channels, QImage *image, std::false_type) const;
+    template <typename T>
+    T transfer(T value) const;
+    template <typename T>
+    uint8_t display(T value) const;
+
+    FITSScale type;
+    double min   = 0;
+    double max   = 0;
+    double coeff = 1;
+    double scale = 0;
+    double zero  = 0;
+};
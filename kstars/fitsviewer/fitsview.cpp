@@ -47,6 +47,7 @@
 #include "kstarsdata.h"
 #include "ksutils.h"
 #include "fitslabel.h"
+#include "fitsstretch.h"
 
 #ifdef HAVE_INDI
 #include "basedevice.h"
@@ -191,6 +192,16 @@ void FITSView::resizeEvent(QResizeEvent *event)
 }*/
 
 bool FITSView::loadFITS(const QString &inFilename, bool silent)
+{
+    return loadImage(inFilename, QByteArray(), silent);
+}
+
+bool FITSView::loadFITSFromMemory(const QString &inFilename, const QByteArray &buffer, bool silent)
+{
+    return loadImage(inFilename, buffer, silent);
+}
+
+bool FITSView::loadImage(const QString &inFilename, const QByteArray &buffer, bool silent)
 {
     if (floatingToolBar)
         floatingToolBar->setVisible(true);
@@ -228,7 +239,8 @@ bool FITSView::loadFITS(const QString &inFilename, bool silent)
         qApp->processEvents();
     }
 
-    if (imageData->loadFITS(inFilename, silent) == false)
+    if (buffer.isEmpty() ? imageData->loadFITS(inFilename, silent) == false :
+                           imageData->loadFITSFromMemory(inFilename, buffer, silent) == false)
         return false;
 
     if (mode == FITS_NORMAL)
@@ -385,38 +397,35 @@ void FITSView::leaveEvent(QEvent *)
     }
 }
 
+template <typename T>
+void FITSView::renderStretch(const FITSStretch &stretch)
+{
+    stretch.render<T>(reinterpret_cast<T *>(imageData->getImageBuffer()), image_width, image_height,
+                      imageData->getNumOfChannels(), display_image);
+}
+
 template <typename T>
 int FITSView::rescale(FITSZoom type)
 {
-    double val = 0;
-    double bscale, bzero;
     double min, max;
-    bool displayBuffer = false;
+    FITSScale stretch = FITS_LINEAR;
 
     if (display_image == nullptr)
         return -1;
 
-    uint8_t *image_buffer = imageData->getImageBuffer();
-
-    uint32_t size = imageData->getSize();
-    int BBP       = imageData->getBytesPerPixel();
-
     filter = filterStack.last();
 
     if (Options::autoStretch() && (filter == FITS_NONE || (filter >= FITS_ROTATE_CW && filter <= FITS_FLIP_V)))
     {
-        image_buffer = new uint8_t[imageData->getSize() * imageData->getNumOfChannels() * BBP];
-        memcpy(image_buffer, imageData->getImageBuffer(), imageData->getSize() * imageData->getNumOfChannels() * BBP);
-
-        displayBuffer = true;
-
+        // The stretch is rendered straight from the image buffer, which is left untouched
         float data_min = -1;
         float data_max = -1;
 
-        imageData->applyFilter(FITS_AUTO_STRETCH, image_buffer, &data_min, &data_max);
+        imageData->getFilterLimits(FITS_AUTO_STRETCH, &data_min, &data_max);
 
-        min = data_min;
-        max = data_max;
+        stretch = FITS_AUTO_STRETCH;
+        min     = data_min;
+        max     = data_max;
     }
     else
     {
@@ -424,8 +433,6 @@ int FITSView::rescale(FITSZoom type)
         imageData->getMinMax(&min, &max);
     }
 
-    T *buffer = reinterpret_cast<T *>(image_buffer);
-
     if (min == max)
     {
         display_image->fill(Qt::white);
@@ -433,9 +440,6 @@ int FITSView::rescale(FITSZoom type)
     }
     else
     {
-        bscale = 255. / (max - min);
-        bzero  = (-min) * (255. / (max - min));
-
         if (image_height != imageData->getHeight() || image_width != imageData->getWidth())
         {
             image_width  = imageData->getWidth();
@@ -451,46 +455,9 @@ int FITSView::rescale(FITSZoom type)
         currentWidth  = display_image->width();
         currentHeight = display_image->height();
 
-        if (imageData->getNumOfChannels() == 1)
-        {
-            /* Fill in pixel values using indexed map, linear scale */
-            for (int j = 0; j < image_height; j++)
-            {
-                unsigned char *scanLine = display_image->scanLine(j);
-
-                for (int i = 0; i < image_width; i++)
-                {
-                    val         = buffer[j * image_width + i] * bscale + bzero;
-                    scanLine[i] = qBound(0.0, val, 255.0);
-                }
-            }
-        }
-        else
-        {
-            double rval = 0, gval = 0, bval = 0;
-            QRgb value;
-            /* Fill in pixel values using indexed map, linear scale */
-            for (int j = 0; j < image_height; j++)
-            {
-                QRgb *scanLine = reinterpret_cast<QRgb *>((display_image->scanLine(j)));
-
-                for (int i = 0; i < image_width; i++)
-                {
-                    rval = buffer[j * image_width + i];
-                    gval = buffer[j * image_width + i + size];
-                    bval = buffer[j * image_width + i + size * 2];
-
-                    value = qRgb(rval * bscale + bzero, gval * bscale + bzero, bval * bscale + bzero);
-
-                    scanLine[i] = value;
-                }
-            }
-        }
+        renderStretch<T>(FITSStretch(stretch, min, max));
     }
 
-    if (displayBuffer)
-        delete[] image_buffer;
-
     switch (type)
     {
         case ZOOM_FIT_WINDOW:
@@ -545,6 +512,55 @@ int FITSView::rescale(FITSZoom type)
     return 0;
 }
 
+void FITSView::previewStretch(FITSScale type, double min, double max)
+{
+    if (display_image == nullptr || min >= max || image_width != imageData->getWidth() ||
+        image_height != imageData->getHeight())
+        return;
+
+    FITSStretch stretch(type, min, max);
+
+    switch (imageData->getDataType())
+    {
+        case TBYTE:
+            renderStretch<uint8_t>(stretch);
+            break;
+
+        case TSHORT:
+            renderStretch<int16_t>(stretch);
+            break;
+
+        case TUSHORT:
+            renderStretch<uint16_t>(stretch);
+            break;
+
+        case TLONG:
+            renderStretch<int32_t>(stretch);
+            break;
+
+        case TULONG:
+            renderStretch<uint32_t>(stretch);
+            break;
+
+        case TFLOAT:
+            renderStretch<float>(stretch);
+            break;
+
+        case TLONGLONG:
+            renderStretch<int64_t>(stretch);
+            break;
+
+        case TDOUBLE:
+            renderStretch<double>(stretch);
+            break;
+
+        default:
+            return;
+    }
+
+    updateFrame();
+}
+
 void FITSView::ZoomIn()
 {
     if (currentZoom >= ZOOM_DEFAULT && Options::limitedResourcesMode())
@@ -853,28 +869,13 @@ void FITSView::drawEQGrid(QPainter *painter)
 
     if (imageData->hasWCS())
     {
-        wcs_point *wcs_coord = imageData->getWCSCoord();
-        if (wcs_coord)
-        {
-            int size      = image_width * image_height;
-            double maxRA  = -1000;
-            double minRA  = 1000;
-            double maxDec = -1000;
-            double minDec = 1000;
+        double maxRA  = -1000;
+        double minRA  = 1000;
+        double maxDec = -1000;
+        double minDec = 1000;
 
-            for (int i = 0; i < (size); i++)
-            {
-                double ra  = wcs_coord[i].ra;
-                double dec = wcs_coord[i].dec;
-                if (ra > maxRA)
-                    maxRA = ra;
-                if (ra < minRA)
-                    minRA = ra;
-                if (dec > maxDec)
-                    maxDec = dec;
-                if (dec < minDec)
-                    minDec = dec;
-            }
+        if (imageData->getWCSBounds(&minRA, &maxRA, &minDec, &maxDec))
+        {
             int minDecMinutes = (int)(minDec * 12); //This will force the Dec Scale to 5 arc minutes in the loop
             int maxDecMinutes = (int)(maxDec * 12);
 
@@ -45,6 +45,7 @@
 #define MINIMUM_STDVAR      5
 
 class FITSLabel;
+class FITSStretch;
 
 class FITSView : public QScrollArea
 {
@@ -55,10 +56,14 @@ class FITSView : public QScrollArea
 
     /* Loads FITS image, scales it, and displays it in the GUI */
     bool loadFITS(const QString &filename, bool silent = true);
+    /* Loads a FITS image received in memory, see FITSData::loadFITSFromMemory */
+    bool loadFITSFromMemory(const QString &filename, const QByteArray &buffer, bool silent = true);
     /* Save FITS */
     int saveFITS(const QString &filename);
     /* Rescale image lineary from image_buffer, fit to window if desired */
     int rescale(FITSZoom type);
+    /* Render the display image through a point filter without modifying the image data */
+    void previewStretch(FITSScale type, double min, double max);
 
     void setImageData(FITSData *d) { imageData = d; }
 
@@ -175,12 +180,15 @@ class FITSView : public QScrollArea
     QLabel *noImageLabel = new QLabel();
     QPixmap noImage;
 
+    bool loadImage(const QString &inFilename, const QByteArray &buffer, bool silent);
     bool event(QEvent *event);
     bool gestureEvent(QGestureEvent *event);
     void pinchTriggered(QPinchGesture *gesture);
 
     template <typename T>
     int rescale(FITSZoom type);
+    template <typename T>
+    void renderStretch(const FITSStretch &stretch);
 
     double average();
     double stddev();
@@ -0,0 +1,337 @@
+/***************************************************************************
+                          fitswcsgrid.cpp  -  FITS WCS Grid
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "fitswcsgrid.h"
+
+#include <QMutexLocker>
+
+#include <wcs.h>
+
+#include <cmath>
+
+// Default memory budget of the tile cache. A tile with the finest step holds (TILE_SIZE+1)^2 nodes of 16 bytes.
+#define WCS_GRID_CACHE_LIMIT (16 * 1024 * 1024)
+
+namespace
+{
+// Bring RA to within 180 degrees of the reference RA so that interpolation does not break at 0h.
+inline double unwrapRA(double ra, double reference)
+{
+    if (ra - reference > 180)
+        return ra - 360;
+    if (reference - ra > 180)
+        return ra + 360;
+    return ra;
+}
+
+inline double normalizeRA(double ra)
+{
+    if (ra < 0)
+        return ra + 360;
+    if (ra >= 360)
+        return ra - 360;
+    return ra;
+}
+}
+
+FITSWCSGrid::FITSWCSGrid(struct wcsprm *wcsStruct, int imageWidth, int imageHeight)
+    : wcs(wcsStruct), width(imageWidth), height(imageHeight)
+{
+    tilesPerRow = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tiles.setMaxCost(WCS_GRID_CACHE_LIMIT);
+}
+
+void FITSWCSGrid::setMaxError(double arcsecs)
+{
+    QMutexLocker locker(&gridMutex);
+
+    maxError = arcsecs;
+    tiles.clear();
+}
+
+void FITSWCSGrid::setCacheLimit(int bytes)
+{
+    QMutexLocker locker(&gridMutex);
+
+    tiles.setMaxCost(bytes);
+}
+
+void FITSWCSGrid::clear()
+{
+    QMutexLocker locker(&gridMutex);
+
+    tiles.clear();
+    boundsValid = false;
+}
+
+int FITSWCSGrid::evaluate(const QVector<double> &pixcrd, QVector<Node> &world)
+{
+    int ncoord = pixcrd.size() / 2;
+    QVector<double> imgcrd(ncoord * 2), worldcrd(ncoord * 2), phi(ncoord), theta(ncoord);
+    QVector<int> stat(ncoord);
+
+    world.resize(ncoord);
+
+    int status = wcsp2s(wcs, ncoord, 2, pixcrd.constData(), imgcrd.data(), phi.data(), theta.data(), worldcrd.data(),
+                        stat.data());
+
+    // WCSERR_BAD_PIX only flags the individual coordinates that failed, everything else is fatal.
+    if (status != 0 && status != WCSERR_BAD_PIX)
+        return status;
+
+    for (int i = 0; i < ncoord; i++)
+    {
+        if (stat[i])
+        {
+            world[i].ra  = NAN;
+            world[i].dec = NAN;
+        }
+        else
+        {
+            world[i].ra  = worldcrd[i * 2];
+            world[i].dec = worldcrd[i * 2 + 1];
+        }
+    }
+
+    return 0;
+}
+
+bool FITSWCSGrid::exactPixelToWCS(double x, double y, wcs_point &coord)
+{
+    QVector<double> pixcrd(2);
+    QVector<Node> world;
+
+    pixcrd[0] = x;
+    pixcrd[1] = y;
+
+    QMutexLocker locker(&gridMutex);
+
+    if (evaluate(pixcrd, world) != 0 || std::isnan(world[0].ra))
+        return false;
+
+    coord.ra  = world[0].ra;
+    coord.dec = world[0].dec;
+    return true;
+}
+
+bool FITSWCSGrid::buildTile(int tileX, int tileY, int step, Tile *tile)
+{
+    int nodesPerRow = TILE_SIZE / step + 1;
+    int originX     = tileX * TILE_SIZE;
+    int originY     = tileY * TILE_SIZE;
+
+    QVector<double> pixcrd(nodesPerRow * nodesPerRow * 2);
+    double *p = pixcrd.data();
+
+    for (int i = 0; i < nodesPerRow; i++)
+    {
+        for (int j = 0; j < nodesPerRow; j++)
+        {
+            *p++ = originX + j * step;
+            *p++ = originY + i * step;
+        }
+    }
+
+    tile->step        = step;
+    tile->nodesPerRow = nodesPerRow;
+
+    if (evaluate(pixcrd, tile->node) != 0)
+        return false;
+
+    // A single node is exact, there is nothing to verify.
+    if (step == 1)
+        return true;
+
+    // Verify the interpolation at the center of every grid cell, where the bilinear error peaks.
+    int cellsPerRow = nodesPerRow - 1;
+    QVector<double> centers(cellsPerRow * cellsPerRow * 2);
+    QVector<Node> exact;
+
+    p = centers.data();
+    for (int i = 0; i < cellsPerRow; i++)
+    {
+        for (int j = 0; j < cellsPerRow; j++)
+        {
+            *p++ = originX + (j + 0.5) * step;
+            *p++ = originY + (i + 0.5) * step;
+        }
+    }
+
+    if (evaluate(centers, exact) != 0)
+        return false;
+
+    for (int i = 0; i < cellsPerRow; i++)
+    {
+        for (int j = 0; j < cellsPerRow; j++)
+        {
+            const Node &truth = exact[i * cellsPerRow + j];
+            Node estimate;
+
+            // Cells that cannot be interpolated fall back to wcsp2s in pixelToWCS
+            if (std::isnan(truth.ra) || interpolate(tile, j + 0.5, i + 0.5, estimate) == false)
+                continue;
+
+            double dRA  = (unwrapRA(estimate.ra, truth.ra) - truth.ra) * cos(truth.dec * M_PI / 180.0);
+            double dDE  = estimate.dec - truth.dec;
+            double diff = sqrt(dRA * dRA + dDE * dDE) * 3600.0;
+
+            if (diff > maxError)
+                return buildTile(tileX, tileY, step / 2, tile);
+        }
+    }
+
+    return true;
+}
+
+FITSWCSGrid::Tile *FITSWCSGrid::getTile(int tileX, int tileY)
+{
+    int key    = tileY * tilesPerRow + tileX;
+    Tile *tile = tiles.object(key);
+
+    if (tile)
+        return tile;
+
+    tile = new Tile;
+    if (buildTile(tileX, tileY, MAX_GRID_STEP, tile) == false)
+    {
+        delete tile;
+        return nullptr;
+    }
+
+    int cost = tile->node.size() * sizeof(Node);
+    // QCache deletes the tile right away if it exceeds the limit on its own
+    if (tiles.insert(key, tile, cost) == false)
+        return nullptr;
+
+    return tile;
+}
+
+bool FITSWCSGrid::interpolate(const Tile *tile, double cellX, double cellY, Node &coord) const
+{
+    int column = qMin(static_cast<int>(cellX), tile->nodesPerRow - 2);
+    int row    = qMin(static_cast<int>(cellY), tile->nodesPerRow - 2);
+    double fx  = cellX - column;
+    double fy  = cellY - row;
+
+    const Node &n00 = tile->node[row * tile->nodesPerRow + column];
+    const Node &n10 = tile->node[row * tile->nodesPerRow + column + 1];
+    const Node &n01 = tile->node[(row + 1) * tile->nodesPerRow + column];
+    const Node &n11 = tile->node[(row + 1) * tile->nodesPerRow + column + 1];
+
+    if (std::isnan(n00.ra) || std::isnan(n10.ra) || std::isnan(n01.ra) || std::isnan(n11.ra))
+        return false;
+
+    double ra00 = n00.ra;
+    double ra10 = unwrapRA(n10.ra, ra00);
+    double ra01 = unwrapRA(n01.ra, ra00);
+    double ra11 = unwrapRA(n11.ra, ra00);
+
+    double ra  = (ra00 * (1 - fx) + ra10 * fx) * (1 - fy) + (ra01 * (1 - fx) + ra11 * fx) * fy;
+    double dec = (n00.dec * (1 - fx) + n10.dec * fx) * (1 - fy) + (n01.dec * (1 - fx) + n11.dec * fx) * fy;
+
+    coord.ra  = normalizeRA(ra);
+    coord.dec = dec;
+
+    return true;
+}
+
+bool FITSWCSGrid::pixelToWCS(double x, double y, wcs_point &coord)
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return exactPixelToWCS(x, y, coord);
+
+    int tileX = static_cast<int>(x) / TILE_SIZE;
+    int tileY = static_cast<int>(y) / TILE_SIZE;
+
+    {
+        QMutexLocker locker(&gridMutex);
+
+        Tile *tile = getTile(tileX, tileY);
+        Node node;
+
+        if (tile && interpolate(tile, (x - tileX * TILE_SIZE) / tile->step, (y - tileY * TILE_SIZE) / tile->step, node))
+        {
+            coord.ra  = node.ra;
+            coord.dec = node.dec;
+            return true;
+        }
+    }
+
+    return exactPixelToWCS(x, y, coord);
+}
+
+void FITSWCSGrid::calculateBounds()
+{
+    QVector<double> pixcrd;
+    QVector<Node> world;
+
+    for (int x = 0; x < width; x += MAX_GRID_STEP)
+        pixcrd << x << 0 << x << height - 1;
+    for (int y = 0; y < height; y += MAX_GRID_STEP)
+        pixcrd << 0 << y << width - 1 << y;
+    pixcrd << width - 1 << height - 1;
+
+    minRA = minDE = 1000;
+    maxRA = maxDE = -1000;
+
+    if (evaluate(pixcrd, world) == 0)
+    {
+        for (const Node &point : world)
+        {
+            if (std::isnan(point.ra))
+                continue;
+
+            minRA = qMin(minRA, point.ra);
+            maxRA = qMax(maxRA, point.ra);
+            minDE = qMin(minDE, point.dec);
+            maxDE = qMax(maxDE, point.dec);
+        }
+    }
+
+    // The border alone misses the extremes if a celestial pole is within the image
+    for (double poleDE : { 90.0, -90.0 })
+    {
+        double worldcrd[2] = { 0, poleDE }, imgcrd[2], pixel[2], phi, theta;
+        int stat[1];
+
+        if (wcss2p(wcs, 1, 2, worldcrd, &phi, &theta, imgcrd, pixel, stat) == 0 && pixel[0] >= 0 &&
+            pixel[1] >= 0 && pixel[0] < width && pixel[1] < height)
+        {
+            minRA = 0;
+            maxRA = 360;
+            if (poleDE > 0)
+                maxDE = poleDE;
+            else
+                minDE = poleDE;
+        }
+    }
+
+    boundsValid = true;
+}
+
+void FITSWCSGrid::getBounds(double *minRAOut, double *maxRAOut, double *minDEOut, double *maxDEOut)
+{
+    QMutexLocker locker(&gridMutex);
+
+    if (boundsValid == false)
+        calculateBounds();
+
+    *minRAOut = minRA;
+    *maxRAOut = maxRA;
+    *minDEOut = minDE;
+    *maxDEOut = maxDE;
+}
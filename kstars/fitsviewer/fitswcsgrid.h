@@ -0,0 +1,123 @@
+/***************************************************************************
+                          fitswcsgrid.h  -  FITS WCS Grid
+                             -------------------
+    begin                : Sun Oct 18 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "fitscommon.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QVector>
+
+struct wcsprm;
+
+/**
+ * @class FITSWCSGrid
+ * @short On-demand pixel to world coordinate conversion for WCS images.
+ *
+ * Instead of evaluating wcsp2s for every pixel of the image up front, the image is divided
+ * into square tiles. The first time a pixel within a tile is queried, the world coordinates
+ * are computed on a coarse grid of nodes covering that tile, and intermediate pixels are
+ * bilinearly interpolated. The grid step of each tile is refined until the interpolation error,
+ * measured at the center of every grid cell, is below the maximum allowed error. Nodes are kept
+ * in double precision, since a float only resolves ~0.11 arcsecs of RA near 360 degrees. Tiles
+ * are kept in a cache bounded by a memory limit and rebuilt when needed.
+ *
+ * @author agent
+ */
+class FITSWCSGrid
+{
+  public:
+    /**
+     * @param wcs Pointer to a WCS struct that was already set by wcsset. It is not owned by the grid
+     * and must remain valid for as long as the grid is used.
+     * @param width image width in pixels
+     * @param height image height in pixels
+     */
+    FITSWCSGrid(struct wcsprm *wcs, int width, int height);
+    ~FITSWCSGrid() = default;
+
+    /**
+     * @brief pixelToWCS Interpolate J2000 world coordinates of a pixel from the cached tile grid.
+     * @param x X pixel coordinate
+     * @param y Y pixel coordinate
+     * @param coord Store back RA and DE in degrees. They are rounded to float on top of the interpolation error.
+     * @return True if successful, false otherwise.
+     */
+    bool pixelToWCS(double x, double y, wcs_point &coord);
+
+    /**
+     * @brief exactPixelToWCS Evaluate J2000 world coordinates of a pixel directly through wcsp2s.
+     */
+    bool exactPixelToWCS(double x, double y, wcs_point &coord);
+
+    /**
+     * @brief getBounds Get minimum and maximum RA and DE covered by the image, all in degrees.
+     * The bounds are calculated once from the image border, and extended to the full RA range
+     * if a celestial pole lies within the image.
+     */
+    void getBounds(double *minRA, double *maxRA, double *minDE, double *maxDE);
+
+    /** @return Maximum allowed interpolation error in arcseconds */
+    double getMaxError() const { return maxError; }
+    /** Set maximum allowed interpolation error in arcseconds. Cached tiles are discarded. */
+    void setMaxError(double arcsecs);
+
+    /** @return Memory limit of the tile cache in bytes */
+    int getCacheLimit() const { return tiles.maxCost(); }
+    void setCacheLimit(int bytes);
+
+    /** @return Memory used by the cached tiles in bytes */
+    int getCacheSize() const { return tiles.totalCost(); }
+
+    void clear();
+
+    static const int TILE_SIZE     = 256;
+    static const int MAX_GRID_STEP = 32;
+
+  private:
+    typedef struct
+    {
+        double ra;
+        double dec;
+    } Node;
+
+    typedef struct
+    {
+        int step;           // Distance between grid nodes in pixels
+        int nodesPerRow;    // Number of nodes in each row of the tile grid
+        QVector<Node> node; // World coordinates of each node, NaN if the node could not be converted
+    } Tile;
+
+    Tile *getTile(int tileX, int tileY);
+    bool buildTile(int tileX, int tileY, int step, Tile *tile);
+    bool interpolate(const Tile *tile, double cellX, double cellY, Node &coord) const;
+    int evaluate(const QVector<double> &pixcrd, QVector<Node> &world);
+    void calculateBounds();
+
+    struct wcsprm *wcs = nullptr;
+    int width          = 0;
+    int height         = 0;
+    int tilesPerRow    = 0;
+    double maxError    = 0.1;
+
+    bool boundsValid = false;
+    double minRA = 0, maxRA = 0, minDE = 0, maxDE = 0;
+
+    QCache<int, Tile> tiles;
+    QMutex gridMutex;
+};
@@ -14,6 +14,8 @@
 #include <KMessageBox>
 #include <QStatusBar>
 #include <QImageReader>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <KNotifications/KNotification>
 
 #include <basedevice.h>
@@ -845,10 +847,17 @@ CCD::CCD(GDInterface *iPtr) : DeviceDecorator(iPtr)
     guideChip                                                             = nullptr;
 
     transferFormat = targetTransferFormat = FORMAT_FITS;
+
+    frameWriter.setMaxThreadCount(1);
 }
 
 CCD::~CCD()
 {
+    // Finish writing frames, and remove the temporary ones that no view took
+    frameWriter.waitForDone();
+    for (const QString &temporaryFrame : temporaryFrames)
+        QFile::remove(temporaryFrame);
+
 #ifdef HAVE_CFITSIO
     delete (fv);
 #endif
@@ -1267,6 +1276,12 @@ void CCD::processBLOB(IBLOB *bp)
 
     int nr, n = 0;
     QTemporaryFile tmpFile(QDir::tempPath() + "/fitsXXXXXX");
+    QByteArray fitsBuffer;
+
+    // The INDI client reuses the BLOB memory, so frames loaded from memory need their own copy
+    bool inMemory = loadsFromMemory(targetChip);
+    if (inMemory)
+        fitsBuffer = QByteArray(static_cast<const char *>(bp->blob), bp->size);
 
     //if (currentDir.endsWith('/'))
     //currentDir.truncate(currentDir.size()-1);
@@ -1281,7 +1296,18 @@ void CCD::processBLOB(IBLOB *bp)
     // Create temporary name if ANY of the following conditions are met:
     // 1. file is preview or batch mode is not enabled
     // 2. file type is not FITS_NORMAL (focus, guide..etc)
-    if (targetChip->isBatchMode() == false || targetChip->getCaptureMode() != FITS_NORMAL)
+    bool temporary = targetChip->isBatchMode() == false || targetChip->getCaptureMode() != FITS_NORMAL;
+
+    if (temporary && inMemory)
+    {
+        // Only named for now, the file is written after the frame is loaded
+        static QAtomicInt memoryFrameID;
+        filename = QString("%1/fits_%2_%3")
+                       .arg(QDir::tempPath())
+                       .arg(QCoreApplication::applicationPid())
+                       .arg(memoryFrameID.fetchAndAddRelaxed(1));
+    }
+    else if (temporary)
     {
         //tmpFile.setPrefix("fits");
         tmpFile.setAutoRemove(false);
@@ -1319,24 +1345,44 @@ void CCD::processBLOB(IBLOB *bp)
             filename += seqPrefix + (seqPrefix.isEmpty() ? "" : "_") +
                         QString("%1.%2").arg(QString().sprintf("%03d", nextSequenceID)).arg(QString(fmt));
 
-        QFile fits_temp_file(filename);
-        if (!fits_temp_file.open(QIODevice::WriteOnly))
+        if (inMemory == false)
         {
-            qDebug() << "ISD:CCD Error: Unable to open " << fits_temp_file.fileName() << endl;
-            emit BLOBUpdated(nullptr);
-            return;
-        }
+            QFile fits_temp_file(filename);
+            if (!fits_temp_file.open(QIODevice::WriteOnly))
+            {
+                qDebug() << "ISD:CCD Error: Unable to open " << fits_temp_file.fileName() << endl;
+                emit BLOBUpdated(nullptr);
+                return;
+            }
 
-        QDataStream out(&fits_temp_file);
+            QDataStream out(&fits_temp_file);
 
-        for (nr = 0; nr < (int)bp->size; nr += n)
-            n = out.writeRawData(static_cast<char *>(bp->blob) + nr, bp->size - nr);
+            for (nr = 0; nr < (int)bp->size; nr += n)
+                n = out.writeRawData(static_cast<char *>(bp->blob) + nr, bp->size - nr);
 
-        fits_temp_file.close();
+            fits_temp_file.close();
+        }
+    }
+
+    // Captured frames are written in the background. Focus and guide frames are only written if their file is needed.
+    QFuture<bool> frameWrite;
+    bool frameTaken = false;
+
+    if (inMemory && temporary == false)
+    {
+        frameWrite = writeFrame(filename, fitsBuffer, false);
+        announceFrame(filename, frameWrite, filter);
+    }
+    else if (inMemory == false)
+    {
+        if (BType == BLOB_FITS)
+            addFITSKeywords(filename, filter);
+        if (temporary == false)
+            emit newLocalFile(filename);
     }
 
     if (BType == BLOB_FITS)
-        addFITSKeywords(filename);
+        filter = "";
 
     // store file name
     strncpy(BLOBFilename, filename.toLatin1(), MAXINDIFILENAME);
@@ -1492,9 +1538,14 @@ void CCD::processBLOB(IBLOB *bp)
                 if (previewView)
                 {
                     previewView->setFilter(captureFilter);
-                    bool imageLoad = previewView->loadFITS(filename, true);
+                    bool imageLoad = inMemory ? previewView->loadFITSFromMemory(filename, fitsBuffer, true) :
+                                     previewView->loadFITS(filename, true);
                     if (imageLoad)
+                    {
+                        if (inMemory)
+                            previewView->getImageData()->setFileWrite(frameWrite);
                         previewView->updateFrame();
+                    }
                 }
                 if (Options::useFITSViewerInCapture() || !targetChip->isBatchMode())
                 {
@@ -1565,9 +1616,15 @@ void CCD::processBLOB(IBLOB *bp)
                     if (focusView)
                     {
                         focusView->setFilter(captureFilter);
-                        bool imageLoad = focusView->loadFITS(filename, true);
+                        bool imageLoad = inMemory ? focusView->loadFITSFromMemory(filename, fitsBuffer, true) :
+                                         focusView->loadFITS(filename, true);
                         if (imageLoad)
                         {
+                            if (inMemory)
+                            {
+                                deferFrame(focusView);
+                                frameTaken = true;
+                            }
                             //focusView->rescale(ZOOM_FIT_WINDOW);
                             focusView->updateFrame();
                             emit newImage(focusView->getDisplayImage(), targetChip);
@@ -1610,9 +1667,15 @@ void CCD::processBLOB(IBLOB *bp)
                     if (guideView)
                     {
                         guideView->setFilter(captureFilter);
-                        bool imageLoad = guideView->loadFITS(filename, true);
+                        bool imageLoad = inMemory ? guideView->loadFITSFromMemory(filename, fitsBuffer, true) :
+                                         guideView->loadFITS(filename, true);
                         if (imageLoad)
                         {
+                            if (inMemory)
+                            {
+                                deferFrame(guideView);
+                                frameTaken = true;
+                            }
                             //guideView->rescale(ZOOM_FIT_WINDOW);
                             guideView->updateFrame();
                             emit newImage(guideView->getDisplayImage(), targetChip);
@@ -1708,18 +1771,101 @@ void CCD::processBLOB(IBLOB *bp)
     }
 #endif
 
+    // A focus or guide frame that no view took is written in the background, for the D-Bus interface
+    if (inMemory && temporary && frameTaken == false)
+        writeFrame(filename, fitsBuffer, true);
+
     emit BLOBUpdated(bp);
 }
 
-void CCD::addFITSKeywords(QString filename)
+bool CCD::loadsFromMemory(CCDChip *targetChip)
+{
+#ifdef HAVE_CFITSIO
+    if (BType != BLOB_FITS)
+        return false;
+
+    // Focus and guide frames only go to their Ekos view. Captured frames too, unless the FITS Viewer opens their file.
+    switch (targetChip->getCaptureMode())
+    {
+        case FITS_FOCUS:
+        case FITS_GUIDE:
+            return true;
+
+        case FITS_NORMAL:
+            return targetChip->isBatchMode() && Options::useFITSViewerInCapture() == false;
+
+        default:
+            return false;
+    }
+#else
+    Q_UNUSED(targetChip);
+    return false;
+#endif
+}
+
+QFuture<bool> CCD::writeFrame(const QString &filename, const QByteArray &buffer, bool temporary)
+{
+    // A temporary frame is removed when the CCD is
+    if (temporary)
+        temporaryFrames.append(filename);
+
+    // The buffer is shared with the view that loaded it, not copied
+    return QtConcurrent::run(&frameWriter, [filename, buffer]() {
+        QFile file(filename);
+        bool written = file.open(QIODevice::WriteOnly) && file.write(buffer) == buffer.size();
+
+        if (written == false)
+            qWarning() << "ISD:CCD Error: Unable to write" << filename << file.errorString();
+
+        return written;
+    });
+}
+
+void CCD::deferFrame(FITSView *view)
+{
+    // The view writes the frame if its file is asked for, and removes the file along with its image
+    view->getImageData()->deferFileWrite();
+    deferredFrameView = view;
+}
+
+void CCD::announceFrame(const QString &filename, const QFuture<bool> &frameWrite, const QString &frameFilter)
+{
+    QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+
+    // Keywords are added with cfitsio on the main thread, once the file is complete
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, filename, frameFilter]() {
+        watcher->deleteLater();
+
+        if (watcher->result() == false)
+        {
+            KStars::Instance()->statusBar()->showMessage(i18n("Unable to save %1", filename), 0);
+            return;
+        }
+
+        addFITSKeywords(filename, frameFilter);
+        emit newLocalFile(filename);
+    });
+
+    watcher->setFuture(frameWrite);
+}
+
+void CCD::flushFrames()
+{
+    frameWriter.waitForDone();
+
+    if (deferredFrameView)
+        deferredFrameView->getImageData()->getFilename();
+}
+
+void CCD::addFITSKeywords(const QString &filename, QString filterName)
 {
 #ifdef HAVE_CFITSIO
     int status = 0;
 
-    if (filter.isEmpty() == false)
+    if (filterName.isEmpty() == false)
     {
         QString key_comment("Filter name");
-        filter.replace(" ", "_");
+        filterName.replace(" ", "_");
 
         fitsfile *fptr = nullptr;
 
@@ -1729,16 +1875,18 @@ void CCD::addFITSKeywords(QString filename)
             return;
         }
 
-        if (fits_update_key_str(fptr, "FILTER", filter.toLatin1().data(), key_comment.toLatin1().data(), &status))
+        if (fits_update_key_str(fptr, "FILTER", filterName.toLatin1().data(), key_comment.toLatin1().data(),
+                                &status))
         {
             fits_report_error(stderr, status);
             return;
         }
 
         fits_close_file(fptr, &status);
-
-        filter = "";
     }
+#else
+    Q_UNUSED(filename);
+    Q_UNUSED(filterName);
 #endif
 }
 
@@ -12,8 +12,10 @@
 
 #include "indistd.h"
 
+#include <QFuture>
 #include <QStringList>
 #include <QPointer>
+#include <QThreadPool>
 
 #include <fitsviewer/fitsviewer.h>
 #include <fitsviewer/fitsdata.h>
@@ -217,6 +219,9 @@ class CCD : public DeviceDecorator
     TransferFormat getTargetTransferFormat() const;
     void setTargetTransferFormat(const TransferFormat &value);
 
+    // Write the frames received in memory whose files are not on disk yet, so that the BLOB file names can be read
+    void flushFrames();
+
   public slots:
     void FITSViewerDestroyed();
     void StreamWindowHidden();
@@ -227,13 +232,18 @@ class CCD : public DeviceDecorator
     void newExposureValue(ISD::CCDChip *chip, double value, IPState state);
     void newGuideStarData(ISD::CCDChip *chip, double dx, double dy, double fit);
     void newRemoteFile(QString);
+    void newLocalFile(QString);
     void newImage(QImage *image, ISD::CCDChip *targetChip);
     void videoStreamToggled(bool enabled);
     void videoRecordToggled(bool enabled);
     void newFPS(double instantFPS, double averageFPS);
 
   private:
-    void addFITSKeywords(QString filename);
+    void addFITSKeywords(const QString &filename, QString filterName);
+    bool loadsFromMemory(CCDChip *targetChip);
+    QFuture<bool> writeFrame(const QString &filename, const QByteArray &buffer, bool temporary);
+    void deferFrame(FITSView *view);
+    void announceFrame(const QString &filename, const QFuture<bool> &frameWrite, const QString &frameFilter);
     QString filter;
 
     bool ISOMode;
@@ -258,6 +268,13 @@ class CCD : public DeviceDecorator
 
     QPointer<FITSViewer> fv;
     QPointer<ImageViewer> imageViewer;
+
+    // Frames loaded from memory are written to disk one at a time, off the event loop
+    QThreadPool frameWriter;
+    // Temporary files written for focus and guide frames that no view took, removed on destruction
+    QStringList temporaryFrames;
+    // Last view that took a focus or guide frame without its file
+    QPointer<FITSView> deferredFrameView;
 };
 }
 #endif // INDICCD_H
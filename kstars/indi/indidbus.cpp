@@ -16,6 +16,7 @@
 #include "indi/clientmanager.h"
 #include "indi/indilistener.h"
 #include "indi/deviceinfo.h"
+#include "indi/indiccd.h"
 
 #include "nan.h"
 
@@ -607,6 +608,11 @@ QString INDIDBus::getBLOBFile(const QString &device, const QString &property, co
                 IBLOB *b = IUFindBLOB(bp, blobName.toLatin1());
                 if (b)
                 {
+                    // Frames received in memory may not be on disk yet
+                    ISD::CCD *ccd = dynamic_cast<ISD::CCD *>(gd);
+                    if (ccd)
+                        ccd->flushFrames();
+
                     filename   = QString(((char *)b->aux2));
                     size       = b->bloblen;
                     blobFormat = QString(b->format).trimmed();
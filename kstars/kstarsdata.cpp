@@ -268,6 +268,8 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 
         emit skyUpdate(clock()->isManualMode());
     }
+
+    FullTimeUpdate = false;
 }
 
 void KStarsData::syncUpdateIDs()
@@ -294,6 +296,7 @@ void KStarsData::setFullTimeUpdate()
     LastPlanetUpdate = QDateTime();
     LastMoonUpdate   = QDateTime();
     LastNumUpdate    = QDateTime();
+    FullTimeUpdate   = true;
 }
 
 void KStarsData::syncLST()
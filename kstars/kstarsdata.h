@@ -132,6 +132,11 @@ class KStarsData : public QObject
          */
     void setFullTimeUpdate();
 
+    /** @return true while updateTime() performs the update requested by setFullTimeUpdate(). Its results are
+         * needed at once, for instance because the date was changed, so it must not be deferred.
+         */
+    bool isFullTimeUpdate() const { return FullTimeUpdate; }
+
     /**change the current simulation date/time to the KStarsDateTime argument.
          * Specified DateTime is always universal time.
          * @param newDate the DateTime to set.
@@ -377,6 +382,7 @@ class KStarsData : public QObject
     QList<FOV *> visibleFOVs; // List of visible FOVs. Cached from Options::FOVNames
 
     KStarsDateTime LastNumUpdate, LastSkyUpdate, LastPlanetUpdate, LastMoonUpdate;
+    bool FullTimeUpdate { false };
     KStarsDateTime NextDSTChange;
     // FIXME: Used in kstarsdcop.cpp only
     KStarsDateTime StoredDate;
@@ -196,6 +196,9 @@ void OpsSatellites::saveSatellitesList()
     }
 
     Options::setSelectedSatellites(selected_satellites);
+
+    // Only the selected satellites are drawn and searched
+    data->skyComposite()->satellites()->indexSatellites();
 }
 
 void OpsSatellites::slotApply()
@@ -36,6 +36,7 @@ class AzimuthalEquidistantProjector : public Projector
     double radius() const Q_DECL_OVERRIDE;
     double projectionK(double x) const Q_DECL_OVERRIDE;
     double projectionL(double x) const Q_DECL_OVERRIDE;
+    void projectionKBatch(int count, double *x) const Q_DECL_OVERRIDE;
 };
 
 #endif // AZIMUTHALEQUIDISTANTPROJECTOR_H
@@ -71,6 +71,59 @@ Vector2f EquirectangularProjector::toScreenVec(const SkyPoint *o, bool oRefract,
     return p;
 }
 
+void EquirectangularProjector::toScreenBatch(int count, const double *ra, const double *dec, const double *alt,
+                                             const double *az, float *x, float *y, quint8 *flags) const
+{
+    const bool refract = m_vp.useAltAz && m_vp.useRefraction;
+    double focusX, focusY;
+
+    if (m_vp.useAltAz)
+    {
+        focusX = m_vp.focus->az().reduce().radians();
+        focusY = m_vp.focus->alt().radians();
+    }
+    else
+    {
+        focusX = m_vp.focus->ra().reduce().radians();
+        focusY = m_vp.focus->dec().radians();
+    }
+
+    checkVisibilityBatch(count, ra, dec, alt, az, flags);
+
+    for (int i = 0; i < count; ++i)
+    {
+        double Y, dX;
+
+        // Only the points that pass checkVisibility() are projected
+        if (!flags[i])
+        {
+            x[i] = y[i] = 0;
+            continue;
+        }
+
+        if (m_vp.useAltAz)
+        {
+            Y  = (refract ? SkyPoint::refract(alt[i]) : alt[i]) * dms::DegToRad;
+            dX = focusX - KSUtils::reduceAngle(az[i], 0.0, 360.0) * dms::DegToRad;
+        }
+        else
+        {
+            Y  = dec[i] * dms::DegToRad;
+            dX = KSUtils::reduceAngle(ra[i] * 15.0, 0.0, 360.0) * dms::DegToRad - focusX;
+        }
+
+        dX = KSUtils::reduceAngle(dX, -dms::PI, dms::PI);
+
+        x[i] = 0.5 * m_vp.width - m_vp.zoomFactor * dX;
+        y[i] = 0.5 * m_vp.height - m_vp.zoomFactor * (Y - focusY);
+
+        if (!(x[i] > 0 && x[i] < m_vp.width))
+            flags[i] &= ~PointVisible;
+        if (0 <= x[i] && x[i] <= m_vp.width && 0 <= y[i] && y[i] <= m_vp.height)
+            flags[i] |= PointOnScreen;
+    }
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const dms *lat) const
 {
     SkyPoint result;
@@ -39,6 +39,12 @@ double GnomonicProjector::projectionK(double x) const
     return 1.0 / x;
 }
 
+void GnomonicProjector::projectionKBatch(int count, double *x) const
+{
+    for (int i = 0; i < count; ++i)
+        x[i] = 1.0 / x[i];
+}
+
 double GnomonicProjector::projectionL(double x) const
 {
     return atan(x);
@@ -39,6 +39,12 @@ double LambertProjector::projectionK(double x) const
     return sqrt(2.0 / (1.0 + x));
 }
 
+void LambertProjector::projectionKBatch(int count, double *x) const
+{
+    for (int i = 0; i < count; ++i)
+        x[i] = sqrt(2.0 / (1.0 + x[i]));
+}
+
 double LambertProjector::projectionL(double x) const
 {
     return 2.0 * asin(0.5 * x);
@@ -27,6 +27,45 @@
 
 namespace
 {
+// Points carried through the stages of toScreenBatch together, few enough for the intermediate arrays to stay in
+// the L1 cache, and a multiple of the widest vector
+const int BATCH = 256;
+
+// Nearest integer to x, for |x| < 2^51, without a call to a library function
+inline double roundToInteger(double x)
+{
+    return (x + 6755399441055744.0) - 6755399441055744.0;
+}
+
+// Sine and cosine of x, for |x| up to a few turns. Unlike sincos() from the C library, this has no branches and no
+// calls, so that the loops of toScreenBatch() are vectorized. The polynomials are those of fdlibm, and the result is
+// within an ulp or two of sincos().
+inline void sinCos(double x, double &s, double &c)
+{
+    const double n  = roundToInteger(x * (2.0 / dms::PI));
+    const double r  = (x - n * 1.57079632673412561417e+00) - n * 6.07710050650619224932e-11; // n * PI / 2 in two parts
+    const double z  = r * r;
+    const double sr = r + r * z * (-1.66666666666666324348e-01 +
+                                   z * (8.33333333332248946124e-03 +
+                                        z * (-1.98412698298579493134e-04 +
+                                             z * (2.75573137070700676789e-06 +
+                                                  z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+    const double cr = 1.0 - 0.5 * z +
+                      z * z * (4.16666666666666019037e-02 +
+                               z * (-1.38888888888741095749e-03 +
+                                    z * (2.48015872894767294178e-05 +
+                                         z * (-2.75573143513906633035e-07 +
+                                              z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+    // Quadrant of x
+    const int q     = int(n);
+    const double sq = (q & 1) ? cr : sr;
+    const double cq = (q & 1) ? sr : cr;
+
+    s = (q & 2) ? -sq : sq;
+    c = ((q + 1) & 2) ? -cq : cq;
+}
+
 void toXYZ(const SkyPoint *p, double *x, double *y, double *z)
 {
     double sinRa, sinDec, cosRa, cosDec;
@@ -562,3 +601,149 @@ Vector2f Projector::toScreenVec(const SkyPoint *o, bool oRefract, bool *onVisibl
 #endif
     return Vector2f(x, y);
 }
+
+void Projector::projectionKBatch(int count, double *x) const
+{
+    for (int i = 0; i < count; ++i)
+        x[i] = projectionK(x[i]);
+}
+
+void Projector::checkVisibilityBatch(int count, const double *ra, const double *dec, const double *alt,
+                                     const double *az, quint8 *flags) const
+{
+    const double focusX = m_vp.useAltAz ? m_vp.focus->az().Degrees() : m_vp.focus->ra().Degrees();
+    const double focusY = m_vp.useAltAz ? m_vp.focus->alt().Degrees() : m_vp.focus->dec().Degrees();
+
+    // Same heuristics as checkVisibility(), with the 2-degree safety factor for refraction in horizontal coordinates
+    const double margin = m_vp.useAltAz ? 2. : 0.;
+    const double scaleY = m_isPoleVisible ? 0.75 : 1.;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double X = m_vp.useAltAz ? az[i] : ra[i] * 15.0;
+        const double Y = m_vp.useAltAz ? alt[i] : dec[i];
+
+        double dX = fabs(X - focusX);
+        if (dX > 180.0)
+            dX = 360.0 - dX; // take shorter distance around sky
+
+        bool visible = !(m_vp.fillGround && alt[i] < -1.0);
+        visible &= (fabs(Y - focusY) - margin) * scaleY <= m_fov;
+        visible &= m_isPoleVisible || dX < m_xrange;
+
+        flags[i] = visible ? PointVisible : 0;
+    }
+}
+
+void Projector::toScreenBatch(int count, const double *ra, const double *dec, const double *alt, const double *az,
+                              float *x, float *y, quint8 *flags) const
+{
+    const bool refract   = m_vp.useAltAz && m_vp.useRefraction;
+    const double focusX  = m_vp.useAltAz ? m_vp.focus->az().radians() : m_vp.focus->ra().radians();
+    const double cosMax  = cosMaxFieldAngle();
+    const double origX   = m_vp.width / 2;
+    const double origY   = m_vp.height / 2;
+    const double zoom    = m_vp.zoomFactor;
+    const double cosY0   = m_cosY0;
+    const double sinY0   = m_sinY0;
+    const double signedX = m_vp.useAltAz ? -1. : 1.; // Azimuth goes in opposite direction compared to RA
+
+#ifdef KSTARS_LITE
+    double sinT = 0, cosT = 1;
+    double skyRotation = SkyMapLite::Instance()->getSkyRotation();
+    if (skyRotation != 0)
+        dms(skyRotation).SinCos(sinT, cosT);
+#endif
+
+    double Y[BATCH], dX[BATCH], sindX[BATCH], cosdX[BATCH], sinY[BATCH], cosY[BATCH], c[BATCH], k[BATCH];
+    int index[BATCH];
+
+    checkVisibilityBatch(count, ra, dec, alt, az, flags);
+
+    for (int first = 0; first < count; first += BATCH)
+    {
+        const int batch = (count - first < BATCH) ? count - first : BATCH;
+        int n           = 0;
+
+        // Only the points that pass checkVisibility() are projected
+        for (int i = first; i < first + batch; ++i)
+        {
+            if (flags[i])
+                index[n++] = i;
+            else
+                x[i] = y[i] = 0;
+        }
+
+        // Angular offsets from the focus, as in toScreenVec()
+        for (int i = 0; i < n; ++i)
+        {
+            const int point = index[i];
+
+            if (m_vp.useAltAz)
+            {
+                Y[i]  = (refract ? SkyPoint::refract(alt[point]) : alt[point]) * dms::DegToRad;
+                dX[i] = az[point] * dms::DegToRad;
+            }
+            else
+            {
+                Y[i]  = dec[point] * dms::DegToRad;
+                dX[i] = ra[point] * 15.0 * dms::DegToRad;
+            }
+        }
+
+        // Whole vectors of points go through the loops below, with harmless values after the last point
+        const int padded = (n + 3) & ~3;
+        for (int i = n; i < padded; ++i)
+            Y[i] = dX[i] = 0;
+
+        for (int i = 0; i < padded; ++i)
+        {
+            // KSUtils::reduceAngle( dX, -dms::PI, dms::PI ), with a rounding that does not need floor()
+            double offset = signedX * (dX[i] - focusX);
+            offset -= 2 * dms::PI * roundToInteger(offset * (0.5 / dms::PI));
+
+            sinCos(offset, sindX[i], cosdX[i]);
+            sinCos(Y[i], sinY[i], cosY[i]);
+        }
+
+        //c is the cosine of the angular distance from the center
+        for (int i = 0; i < padded; ++i)
+        {
+            c[i] = sinY0 * sinY[i] + cosY0 * cosY[i] * cosdX[i];
+            k[i] = c[i];
+        }
+
+        projectionKBatch(n, k);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const int point = index[i];
+
+            double px = origX - zoom * k[i] * cosY[i] * sindX[i];
+            double py = origY - zoom * k[i] * (cosY0 * sinY[i] - sinY0 * cosY[i] * cosdX[i]);
+
+#ifdef KSTARS_LITE
+            double rx = origX + (px - origX) * cosT - (py - origY) * sinT;
+            double ry = origY + (px - origX) * sinT + (py - origY) * cosT;
+
+            px = rx;
+            py = ry;
+#endif
+
+            if (!(std::isfinite(px) && std::isfinite(py)))
+            {
+                x[point] = y[point] = 0;
+                flags[point]        = 0;
+                continue;
+            }
+
+            x[point] = px;
+            y[point] = py;
+
+            if (!(c[i] > cosMax))
+                flags[point] &= ~PointVisible;
+            if (0 <= x[point] && x[point] <= m_vp.width && 0 <= y[point] && y[point] <= m_vp.height)
+                flags[point] |= PointOnScreen;
+        }
+    }
+}
@@ -91,6 +91,13 @@ class Projector
     };
     Q_ENUM(Projection)
 
+    /** Flags set by toScreenBatch() for each point */
+    enum PointFlag
+    {
+        PointVisible  = 0x1, ///< The point passes checkVisibility() and is on the visible part of the sky
+        PointOnScreen = 0x2  ///< The projected point is within the sky map, as onScreen() tells
+    };
+
     /** Return the type of this projection */
     Q_INVOKABLE virtual Projection type() const = 0;
 
@@ -138,6 +145,30 @@ class Projector
      */
     QPointF toScreen(const SkyPoint *o, bool oRefract = true, bool *onVisibleHemisphere = 0) const;
 
+    /**
+     * @short Project many point sources at once
+     *
+     * This gives for each point what toScreenVec(), checkVisibility() and onScreen() give for a SkyPoint, with
+     * refraction as Options::useRefraction() asks. Points go through the projection in stages over contiguous
+     * arrays, and the projection-specific part is done by projectionKBatch(), so that the compiler can vectorize
+     * each stage instead of making several virtual calls per point.
+     *
+     * ra and dec are only read for an equatorial view, and az for a horizontal one. alt is always read, since
+     * points below the horizon are hidden by the ground. Points that checkVisibility() rejects are not projected,
+     * their flags are 0 and their screen coordinates are left at 0.
+     *
+     * @param count number of points
+     * @param ra right ascensions, in hours
+     * @param dec declinations, in degrees
+     * @param alt altitudes, without refraction, in degrees
+     * @param az azimuths, in degrees
+     * @param x screen x coordinates of the points
+     * @param y screen y coordinates of the points
+     * @param flags PointFlag values of the points
+     */
+    virtual void toScreenBatch(int count, const double *ra, const double *dec, const double *alt, const double *az,
+                               float *x, float *y, quint8 *flags) const;
+
     /**
      * @short Determine RA, Dec coordinates of the pixel at (dx, dy), which are the
      * screen pixel coordinate offsets from the center of the Sky pixmap.
@@ -269,6 +300,19 @@ class Projector
      */
     virtual double projectionL(double x) const { return x; }
 
+    /**
+     * Replace each of the count values of x by projectionK() of it. Projections override this with a loop
+     * that does not call projectionK(), for toScreenBatch().
+     */
+    virtual void projectionKBatch(int count, double *x) const;
+
+    /**
+     * Set flags to PointVisible for the points of a batch that pass checkVisibility(), and to 0 for the others.
+     * @see toScreenBatch()
+     */
+    void checkVisibilityBatch(int count, const double *ra, const double *dec, const double *alt, const double *az,
+                              quint8 *flags) const;
+
     /**
      * This function returns the cosine of the maximum field angle, i.e., the maximum angular
      * distance from the focus for which a point should be projected. Default is 0, i.e.,
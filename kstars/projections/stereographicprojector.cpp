@@ -39,6 +39,12 @@ double StereographicProjector::projectionK(double x) const
     return 2.0 / (1.0 + x);
 }
 
+void StereographicProjector::projectionKBatch(int count, double *x) const
+{
+    for (int i = 0; i < count; ++i)
+        x[i] = 2.0 / (1.0 + x[i]);
+}
+
 double StereographicProjector::projectionL(double x) const
 {
     return 2.0 * atan2(x, 2.0);
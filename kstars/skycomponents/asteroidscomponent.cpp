@@ -39,10 +39,41 @@
 #include "Options.h"
 #include "skyobjects/ksasteroid.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "ksfilereader.h"
 #include "auxiliary/kspaths.h"
 #include "auxiliary/ksnotification.h"
 
+namespace
+{
+// Row of asteroids.dat
+typedef struct
+{
+    QString full_name;
+    int epoch_mjd;
+    double q, a, e, i, w, om, ma;
+    QString orbit_id;
+    double H, G;
+    QString neo;
+    float diameter;
+    QString extent;
+    float albedo, rot_period, per_y;
+    double moid;
+    QString orbit_class;
+} AsteroidRow;
+
+const KSParser::Column<AsteroidRow> ASTEROID_COLUMNS[] = {
+    &AsteroidRow::full_name, &AsteroidRow::epoch_mjd, &AsteroidRow::q, &AsteroidRow::a, &AsteroidRow::e,
+    &AsteroidRow::i, &AsteroidRow::w, &AsteroidRow::om, &AsteroidRow::ma,
+    {}, // tp_calc
+    &AsteroidRow::orbit_id, &AsteroidRow::H, &AsteroidRow::G, &AsteroidRow::neo,
+    {}, // M1
+    {}, // M2
+    &AsteroidRow::diameter, &AsteroidRow::extent, &AsteroidRow::albedo, &AsteroidRow::rot_period,
+    &AsteroidRow::per_y, &AsteroidRow::moid, &AsteroidRow::orbit_class
+};
+}
+
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
     loadData();
@@ -98,48 +129,23 @@ void AsteroidsComponent::loadData()
     emitProgressText(i18n("Loading asteroids"));
 
     // Clear lists
+    cancelPositions();
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
 
     objectLists(SkyObject::ASTEROID).clear();
     objectNames(SkyObject::ASTEROID).clear();
-
-    QList<QPair<QString, KSParser::DataTypes>> sequence;
-    sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
-    sequence.append(qMakePair(QString("q"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("a"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("e"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("i"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("w"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("om"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("ma"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("tp_calc"), KSParser::D_SKIP));
-    sequence.append(qMakePair(QString("orbit_id"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("H"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("G"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("neo"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("tp_calc"), KSParser::D_SKIP));
-    sequence.append(qMakePair(QString("M2"), KSParser::D_SKIP));
-    sequence.append(qMakePair(QString("diameter"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("extent"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("albedo"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("rot_period"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("per_y"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("moid"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("class"), KSParser::D_QSTRING));
+    nameIndex().removeType(SkyObject::ASTEROID);
 
     //QString file_name = KSPaths::locate( QStandardPaths::DataLocation,  );
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("asteroids.dat"));
-    KSParser asteroid_parser(file_name, '#', sequence);
+    KSParser asteroid_parser(file_name, '#');
 
-    QHash<QString, QVariant> row_content;
-    while (asteroid_parser.HasNextRow())
+    AsteroidRow row;
+    while (asteroid_parser.ReadNextRow(row, ASTEROID_COLUMNS))
     {
-        row_content = asteroid_parser.ReadNextRow();
-        full_name   = row_content["full name"].toString();
-        full_name   = full_name.trimmed();
-        int catN    = full_name.section(' ', 0, 0).toInt();
+        full_name = row.full_name.trimmed();
+        int catN  = full_name.section(' ', 0, 0).toInt();
 
         name = full_name.section(' ', 1, -1);
 
@@ -147,25 +153,25 @@ void AsteroidsComponent::loadData()
         if (name == "Europa" || name == "Io" || name == "Asterope")
             name += i18n(" (Asteroid)");
 
-        mJD         = row_content["epoch_mjd"].toInt();
-        q           = row_content["q"].toDouble();
-        a           = row_content["a"].toDouble();
-        e           = row_content["e"].toDouble();
-        dble_i      = row_content["i"].toDouble();
-        dble_w      = row_content["w"].toDouble();
-        dble_N      = row_content["om"].toDouble();
-        dble_M      = row_content["ma"].toDouble();
-        orbit_id    = row_content["orbit_id"].toString();
-        H           = row_content["H"].toDouble();
-        G           = row_content["G"].toDouble();
-        neo         = row_content["neo"].toString() == "Y";
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
+        mJD         = row.epoch_mjd;
+        q           = row.q;
+        a           = row.a;
+        e           = row.e;
+        dble_i      = row.i;
+        dble_w      = row.w;
+        dble_N      = row.om;
+        dble_M      = row.ma;
+        orbit_id    = row.orbit_id;
+        H           = row.H;
+        G           = row.G;
+        neo         = row.neo == "Y";
+        diameter    = row.diameter;
+        dimensions  = row.extent;
+        albedo      = row.albedo;
+        rot_period  = row.rot_period;
+        period      = row.per_y;
+        earth_moid  = row.moid;
+        orbit_class = row.orbit_class;
 
         JD = static_cast<double>(mJD) + 2400000.5;
 
@@ -200,6 +206,8 @@ void AsteroidsComponent::loadData()
         // Add name to the list of object names
         objectNames(SkyObject::ASTEROID).append(name);
         objectLists(SkyObject::ASTEROID).append(QPair<QString, const SkyObject *>(name, new_asteroid));
+        nameIndex().add(name, new_asteroid);
+        nameIndex().addAliases(new_asteroid);
     }
 }
 
@@ -223,13 +231,13 @@ void AsteroidsComponent::draw(SkyPainter *skyp)
 
     skyp->setBrush(QBrush(QColor("gray")));
 
-    foreach (SkyObject *so, m_ObjectList)
-    {
+    // Only the asteroids of the trixels around the focus may be visible
+    m_ObjectIndex.visit(NO_PRECESS_BUF, [&](SkyObject *so) {
         // FIXME: God help us!
         KSAsteroid *ast = (KSAsteroid *)so;
 
         if (ast->mag() > Options::magLimitAsteroid() || std::isnan(ast->mag()) != 0)
-            continue;
+            return;
 
         bool drawn = false;
 
@@ -240,7 +248,7 @@ void AsteroidsComponent::draw(SkyPainter *skyp)
 
         if (drawn && !(hideLabels || ast->mag() >= labelMagLimit))
             SkyLabeler::AddLabel(ast, SkyLabeler::ASTEROID_LABEL);
-    }
+    });
 #endif
 }
 
@@ -251,10 +259,11 @@ SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return 0;
 
-    foreach (SkyObject *o, m_ObjectList)
-    {
-        if (o->mag() > Options::magLimitAsteroid())
-            continue;
+    const double magLimit = Options::magLimitAsteroid();
+
+    m_ObjectIndex.visit(OBJ_NEAREST_NO_PRECESS_BUF, [&](SkyObject *o) {
+        if (o->mag() > magLimit)
+            return;
 
         double r = o->angularDistanceTo(p).Degrees();
         if (r < maxrad)
@@ -262,7 +271,7 @@ SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
             oBest  = o;
             maxrad = r;
         }
-    }
+    });
 
     return oBest;
 }
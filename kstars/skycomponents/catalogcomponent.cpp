@@ -39,6 +39,7 @@
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
 #include "catalogdb.h"
+#include "nameindex.h"
 
 QStringList CatalogComponent::m_Columns =
     QString("ID RA Dc Tp Nm Mg Flux Mj Mn PA Ig").split(' ', QString::SkipEmptyParts);
@@ -119,10 +120,6 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
         Q_ASSERT(obj);
         if (obj->type() <= SkyObject::TYPE_UNKNOWN)
         {
-            QVector<QPair<QString, const SkyObject *>> &objects = objectLists(obj->type());
-            bool dupName                                        = false;
-            bool dupLongname                                    = false;
-
             QString name     = obj->name();
             QString longname = obj->longname();
 
@@ -136,23 +133,21 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
             // miscellaneous catalog), then disabling one catalog
             // removes the name entirely from the list.
 
-            for (int i = 0; i < objects.size(); ++i)
-            {
-                if (name == objects.at(i).first)
-                    dupName = true;
-                if (longname == objects.at(i).first)
-                    dupLongname = true;
-            }
-
-            if (!dupName)
+            // The name index tells whether a name is listed for the type already
+            if (!nameIndex().contains(name, obj->type()))
             {
                 objectLists(obj->type()).append(QPair<QString, const SkyObject *>(name, obj));
+                nameIndex().add(name, obj);
             }
 
-            if (!longname.isEmpty() && !dupLongname && name != longname)
+            if (!longname.isEmpty() && name != longname && !nameIndex().contains(longname, obj->type()))
             {
                 objectLists(obj->type()).append(QPair<QString, const SkyObject *>(longname, obj));
+                nameIndex().add(longname, obj);
             }
+
+            // Duplicate names are still found by SkyMapComposite::findByName()
+            nameIndex().addAliases(obj);
         }
     }
 
@@ -29,6 +29,7 @@
 #include "skyobjects/kscomet.h"
 #include "ksutils.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "ksfilereader.h"
 #include "auxiliary/kspaths.h"
 #ifndef KSTARS_LITE
@@ -43,6 +44,32 @@
 #include "kspaths.h"
 #include "ksutils.h"
 
+namespace
+{
+// Row of comets.dat
+typedef struct
+{
+    QString full_name;
+    int epoch_mjd;
+    double q, e, i, w, om, tp_calc;
+    QString orbit_id;
+    QString neo;
+    float M1, M2, diameter;
+    QString extent;
+    float albedo, rot_period, per_y;
+    double moid;
+    QString orbit_class;
+    float K1, K2;
+} CometRow;
+
+const KSParser::Column<CometRow> COMET_COLUMNS[] = {
+    &CometRow::full_name, &CometRow::epoch_mjd, &CometRow::q, &CometRow::e, &CometRow::i, &CometRow::w,
+    &CometRow::om, &CometRow::tp_calc, &CometRow::orbit_id, &CometRow::neo, &CometRow::M1, &CometRow::M2,
+    &CometRow::diameter, &CometRow::extent, &CometRow::albedo, &CometRow::rot_period, &CometRow::per_y,
+    &CometRow::moid, &CometRow::orbit_class, &CometRow::K1, &CometRow::K2
+};
+}
+
 CometsComponent::CometsComponent(SolarSystemComposite *parent) : SolarSystemListComponent(parent)
 {
     loadData();
@@ -97,74 +124,51 @@ void CometsComponent::loadData()
 
     emitProgressText(i18n("Loading comets"));
 
+    cancelPositions();
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
 
     objectNames(SkyObject::COMET).clear();
     objectLists(SkyObject::COMET).clear();
-
-    QList<QPair<QString, KSParser::DataTypes>> sequence;
-    sequence.append(qMakePair(QString("full name"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("epoch_mjd"), KSParser::D_INT));
-    sequence.append(qMakePair(QString("q"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("e"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("i"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("w"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("om"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("tp_calc"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("orbit_id"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("neo"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("M1"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("M2"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("diameter"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("extent"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("albedo"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("rot_period"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("per_y"), KSParser::D_FLOAT));
-    sequence.append(qMakePair(QString("moid"), KSParser::D_DOUBLE));
-    sequence.append(qMakePair(QString("class"), KSParser::D_QSTRING));
-    sequence.append(qMakePair(QString("H"), KSParser::D_SKIP));
-    sequence.append(qMakePair(QString("G"), KSParser::D_SKIP));
+    nameIndex().removeType(SkyObject::COMET);
 
     QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("comets.dat"));
-    KSParser cometParser(file_name, '#', sequence);
+    KSParser cometParser(file_name, '#');
 
-    QHash<QString, QVariant> row_content;
-    while (cometParser.HasNextRow())
+    CometRow row;
+    while (cometParser.ReadNextRow(row, COMET_COLUMNS))
     {
         KSComet *com = 0;
-        row_content  = cometParser.ReadNextRow();
-        name         = row_content["full name"].toString();
-        name         = name.trimmed();
-        mJD          = row_content["epoch_mjd"].toInt();
-        q            = row_content["q"].toDouble();
-        e            = row_content["e"].toDouble();
-        dble_i       = row_content["i"].toDouble();
-        dble_w       = row_content["w"].toDouble();
-        dble_N       = row_content["om"].toDouble();
-        Tp           = row_content["tp_calc"].toDouble();
-        orbit_id     = row_content["orbit_id"].toString();
-        neo          = row_content["neo"] == "Y";
-
-        if (row_content["M1"].toFloat() == 0.0)
+        name         = row.full_name.trimmed();
+        mJD          = row.epoch_mjd;
+        q            = row.q;
+        e            = row.e;
+        dble_i       = row.i;
+        dble_w       = row.w;
+        dble_N       = row.om;
+        Tp           = row.tp_calc;
+        orbit_id     = row.orbit_id;
+        neo          = row.neo == "Y";
+
+        if (row.M1 == 0.0)
             M1 = 101.0;
         else
-            M1 = row_content["M1"].toFloat();
+            M1 = row.M1;
 
-        if (row_content["M2"].toFloat() == 0.0)
+        if (row.M2 == 0.0)
             M2 = 101.0;
         else
-            M2 = row_content["M2"].toFloat();
-
-        diameter    = row_content["diameter"].toFloat();
-        dimensions  = row_content["extent"].toString();
-        albedo      = row_content["albedo"].toFloat();
-        rot_period  = row_content["rot_period"].toFloat();
-        period      = row_content["per_y"].toFloat();
-        earth_moid  = row_content["moid"].toDouble();
-        orbit_class = row_content["class"].toString();
-        K1          = row_content["H"].toFloat();
-        K2          = row_content["G"].toFloat();
+            M2 = row.M2;
+
+        diameter    = row.diameter;
+        dimensions  = row.extent;
+        albedo      = row.albedo;
+        rot_period  = row.rot_period;
+        period      = row.per_y;
+        earth_moid  = row.moid;
+        orbit_class = row.orbit_class;
+        K1          = row.K1;
+        K2          = row.K2;
 
         JD = static_cast<double>(mJD) + 2400000.5;
 
@@ -184,6 +188,8 @@ void CometsComponent::loadData()
         // Add *short* name to the list of object names
         objectNames(SkyObject::COMET).append(com->name());
         objectLists(SkyObject::COMET).append(QPair<QString, const SkyObject *>(com->name(), com));
+        nameIndex().add(com->name(), com);
+        nameIndex().addAliases(com);
     }
 }
 
@@ -201,8 +207,8 @@ void CometsComponent::draw(SkyPainter *skyp)
     skyp->setPen(QPen(QColor("transparent")));
     skyp->setBrush(QBrush(QColor("white")));
 
-    foreach (SkyObject *so, m_ObjectList)
-    {
+    // Only the comets of the trixels around the focus may be visible
+    m_ObjectIndex.visit(NO_PRECESS_BUF, [&](SkyObject *so) {
         KSComet *com = (KSComet *)so;
         double mag   = com->mag();
         if (std::isnan(mag) == 0)
@@ -211,7 +217,7 @@ void CometsComponent::draw(SkyPainter *skyp)
             if (drawn && !(hideLabels || com->rsun() >= rsunLabelLimit))
                 SkyLabeler::AddLabel(com, SkyLabeler::COMET_LABEL);
         }
-    }
+    });
 #endif
 }
 
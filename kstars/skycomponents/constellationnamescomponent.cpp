@@ -20,6 +20,7 @@
 #include <QtConcurrent>
 
 #include "kstarsdata.h"
+#include "nameindex.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
@@ -103,6 +104,8 @@ void ConstellationNamesComponent::loadData(CultureList *cultures)
             //Add name to the list of object names
             objectNames(SkyObject::CONSTELLATION).append(name);
             objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
+            nameIndex().add(name, o);
+            nameIndex().addAliases(o);
         }
     }
 }
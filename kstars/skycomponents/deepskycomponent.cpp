@@ -27,6 +27,7 @@
 #include "dms.h"
 #include "ksfilereader.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "auxiliary/kspaths.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
@@ -353,6 +354,7 @@ void DeepSkyComponent::loadData()
         {
             objectNames(type).append(name);
             objectLists(type).append(QPair<QString, SkyObject *>(name, o));
+            nameIndex().add(name, o);
         }
 
         //Add long name to the list of object names
@@ -361,8 +363,12 @@ void DeepSkyComponent::loadData()
         {
             objectNames(type).append(longname);
             objectLists(type).append(QPair<QString, SkyObject *>(longname, o));
+            nameIndex().add(longname, o);
         }
 
+        if (hasName)
+            nameIndex().addAliases(o);
+
         deep_sky_parser.ShowProgress();
     }
 
@@ -743,6 +749,7 @@ void DeepSkyComponent::clearList(QList<DeepSkyObject *> &list)
     {
         SkyObject *o = list.takeFirst();
         removeFromNames(o);
+        nameIndex().removeNames(o);
         delete o;
     }
 }
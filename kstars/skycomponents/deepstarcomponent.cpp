@@ -33,12 +33,16 @@
 
 #include <QPixmap>
 #include <QRectF>
+#include <QSet>
 #include <QFontMetricsF>
 #include <QtConcurrent>
 
 //NOTE Added this for QT_FSEEK, should we be including another file?
 #include <qplatformdefs.h>
 
+// Number of frames ahead of the current one for which stars are read in the background
+#define PREFETCH_FRAMES 3
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -121,10 +125,15 @@ bool DeepStarComponent::loadStaticStars()
 
             m_starBlockList.at(trixel)->setStaticBlock(SB);
 
+            const BinFileRecords<starData> mapped = starReader.getRecords<starData>(i);
+
             for (quint64 j = 0; j < records; ++j)
             {
-                bool fread_success = false;
-                fread_success      = fread(&stardata, sizeof(starData), 1, dataFile);
+                bool fread_success = true;
+                if (mapped.isValid())
+                    stardata = mapped.at(j);
+                else
+                    fread_success = fread(&stardata, sizeof(starData), 1, dataFile);
 
                 if (!fread_success)
                 {
@@ -137,19 +146,13 @@ bool DeepStarComponent::loadStaticStars()
                     byteSwap(&stardata);
 
                 /* Initialize star with data just read. */
-                StarObject *star;
-#ifdef KSTARS_LITE
-                star = &(SB->addStar(stardata)->star);
-#else
-                star = SB->addStar(stardata);
-#endif
-                if (star)
+                if (SB->addStar(stardata))
                 {
                     //KStarsData* data = KStarsData::Instance();
                     //star->EquatorialToHorizontal( data->lst(), data->geo()->lat() );
                     //if( star->getHDIndex() != 0 )
                     if (stardata.HD)
-                        m_CatalogNumber.insert(stardata.HD, star);
+                        m_CatalogNumber.insert(stardata.HD, qMakePair(SB, SB->getStarCount() - 1));
                 }
                 else
                 {
@@ -173,10 +176,15 @@ bool DeepStarComponent::loadStaticStars()
 
             m_starBlockList.at(trixel)->setStaticBlock(SB);
 
+            const BinFileRecords<deepStarData> mapped = starReader.getRecords<deepStarData>(i);
+
             for (quint64 j = 0; j < records; ++j)
             {
-                bool fread_success = false;
-                fread_success      = fread(&deepstardata, sizeof(deepStarData), 1, dataFile);
+                bool fread_success = true;
+                if (mapped.isValid())
+                    deepstardata = mapped.at(j);
+                else
+                    fread_success = fread(&deepstardata, sizeof(deepStarData), 1, dataFile);
 
                 if (!fread_success)
                 {
@@ -189,19 +197,13 @@ bool DeepStarComponent::loadStaticStars()
                     byteSwap(&deepstardata);
 
                 /* Initialize star with data just read. */
-                StarObject *star;
-#ifdef KSTARS_LITE
-                star = &(SB->addStar(stardata)->star);
-#else
-                star = SB->addStar(deepstardata);
-#endif
-                if (star)
+                if (SB->addStar(deepstardata))
                 {
                     //KStarsData* data = KStarsData::Instance();
                     //star->EquatorialToHorizontal( data->lst(), data->geo()->lat() );
                     //if( star->getHDIndex() != 0 )
                     if (stardata.HD)
-                        m_CatalogNumber.insert(stardata.HD, star);
+                        m_CatalogNumber.insert(stardata.HD, qMakePair(SB, SB->getStarCount() - 1));
                 }
                 else
                 {
@@ -217,6 +219,7 @@ bool DeepStarComponent::loadStaticStars()
 
 DeepStarComponent::~DeepStarComponent()
 {
+    delete m_starLoader;
     if (fileOpened)
         starReader.closeFile();
     fileOpened = false;
@@ -258,12 +261,18 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 #endif
 
 #ifdef PROFILE_UPDATECOORDS
-    StarObject::updateCoordsCpuTime = 0.;
-    StarObject::starsUpdated        = 0;
+    StarObject::updateCoordsCpuTime      = 0.;
+    StarObject::starsUpdated             = 0;
+    StarObject::batchUpdateCoordsCpuTime = 0.;
+    StarObject::starsBatchUpdated        = 0;
+    StarObject::batchHorizontalCpuTime   = 0.;
+    StarObject::starsBatchHorizontal     = 0;
 #endif
-    SkyMap *map       = SkyMap::Instance();
-    KStarsData *data  = KStarsData::Instance();
-    UpdateID updateID = data->updateID();
+    SkyMap *map = SkyMap::Instance();
+
+    // Stars are packed in their StarBlock, and projected a block at a time into these
+    QVector<float> screenX, screenY;
+    QVector<quint8> screenFlags;
 
     //FIXME_FOV -- maybe not clamp like that...
     float radius = map->projector()->fov();
@@ -318,6 +327,9 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 
     visibleStarCount = 0;
 
+    bool prefetch = m_starLoader && Options::starPrefetch();
+    QList<StarBlockLoader::Request> requests;
+
     t.start();
 
     // Mark used blocks in the LRU Cache. Not required for static stars
@@ -354,8 +366,13 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         // TODO: Is there a better way? We may have to change the magnitude tolerance if the catalog changes
         // Static stars need not execute fillToMag
 
-        if (!staticStars && !m_starBlockList.at(currentRegion)->fillToMag(maglim) &&
-            maglim <= m_FaintMagnitude * (1 - 1.5 / 16))
+        // With the background loader, the trixel is drawn with the stars that are already loaded
+        if (!staticStars && prefetch)
+        {
+            fillFromLoader(currentRegion, maglim, requests);
+        }
+        else if (!staticStars && !m_starBlockList.at(currentRegion)->fillToMag(maglim) &&
+                 maglim <= m_FaintMagnitude * (1 - 1.5 / 16))
         {
             qDebug() << "SBL::fillToMag( " << maglim << " ) failed for trixel " << currentRegion << " !" << endl;
         }
@@ -365,16 +382,8 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //        qDebug() << "Drawing SBL for trixel " << currentRegion << ", SBL has "
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks" << endl;
 
-        // REMARK: The following should never carry state, except for const parameters like updateID and maglim
-        std::function<void(StarBlock *)> mapFunction = [&updateID, &maglim](StarBlock *myBlock) {
-            for (StarObject &star : myBlock->contents())
-            {
-                if (star.updateID != updateID)
-                    star.JITupdate();
-                if (star.mag() > maglim)
-                    break;
-            }
-        };
+        // REMARK: The following should never carry state, except for const parameters like maglim
+        std::function<void(StarBlock *)> mapFunction = [&maglim](StarBlock *myBlock) { myBlock->JITupdate(maglim); };
 
         QtConcurrent::blockingMap(m_starBlockList.at(currentRegion)->contents(), mapFunction);
 
@@ -383,19 +392,24 @@ void DeepStarComponent::draw(SkyPainter *skyp)
             StarBlock *block = m_starBlockList.at(currentRegion)->block(i);
             //            qDebug() << "---> Drawing stars from block " << i << " of trixel " <<
             //                currentRegion << ". SB has " << block->getStarCount() << " stars" << endl;
-            for (int j = 0; j < block->getStarCount(); j++)
-            {
-                StarObject *curStar = block->star(j);
+            // Stars are sorted by magnitude within a block
+            int count = 0;
+            while (count < block->getStarCount() && block->mag(count) <= maglim)
+                ++count;
 
-                //                qDebug() << "We claim that he's from trixel " << currentRegion
-                //<< ", and indexStar says he's from " << m_skyMesh->indexStar( curStar );
-
-                float mag = curStar->mag();
+            if (screenX.size() < count)
+            {
+                screenX.resize(count);
+                screenY.resize(count);
+                screenFlags.resize(count);
+            }
 
-                if (mag > maglim)
-                    break;
+            block->toScreen(map->projector(), count, screenX.data(), screenY.data(), screenFlags.data());
 
-                if (skyp->drawPointSource(curStar, mag, curStar->spchar()))
+            for (int j = 0; j < count; j++)
+            {
+                if (skyp->drawProjectedPointSource(QPointF(screenX[j], screenY[j]), screenFlags[j], block->mag(j),
+                                                   block->spchar(j)))
                     visibleStarCount++;
             }
         }
@@ -404,6 +418,13 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //        verifySBLIntegrity();
         t_drawUnnamed += t.restart();
     }
+
+    if (prefetch)
+    {
+        predictRequests(focus, radius, maglim, requests);
+        m_starLoader->submit(requests);
+    }
+
     m_skyMesh->inDraw(false);
 #ifdef PROFILE_SINCOS
     trig_calls_here += dms::trig_function_calls;
@@ -422,6 +443,14 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     qDebug() << "Spent " << StarObject::updateCoordsCpuTime << " seconds updating " << StarObject::starsUpdated
              << " stars' coordinates (StarObject::updateCoords) for an average of "
              << double(StarObject::updateCoordsCpuTime) / double(StarObject::starsUpdated) * 1.e6 << " us per star.";
+    qDebug() << "Spent " << StarObject::batchUpdateCoordsCpuTime << " seconds updating "
+             << StarObject::starsBatchUpdated << " stars' coordinates in batches (ApparentPlace::fromCatalog) for an"
+             << " average of " << StarObject::batchUpdateCoordsCpuTime / double(StarObject::starsBatchUpdated) * 1.e6
+             << " us per star.";
+    qDebug() << "Spent " << StarObject::batchHorizontalCpuTime << " seconds converting "
+             << StarObject::starsBatchHorizontal << " stars to horizontal coordinates in batches"
+             << " (ApparentPlace::toHorizontal) for an average of "
+             << StarObject::batchHorizontalCpuTime / double(StarObject::starsBatchHorizontal) * 1.e6 << " us per star.";
 #endif
 
 #else
@@ -470,6 +499,10 @@ bool DeepStarComponent::openDataFile()
         if (starReader.getByteSwap())
             MSpT = bswap_16(MSpT);
         fileOpened = true;
+
+        // Records are then read straight from memory, the file handle is only used if mapping fails
+        if (!starReader.mapFile())
+            qDebug() << "Could not map" << dataFileName << "into memory, reading it through the file instead";
         qDebug() << "  Sky Mesh Size: " << m_skyMesh->size();
         for (long int i = 0; i < m_skyMesh->size(); i++)
         {
@@ -481,15 +514,97 @@ bool DeepStarComponent::openDataFile()
             m_starBlockList.append(sbl);
         }
         m_zoomMagLimit = 0.06;
+
+#ifndef KSTARS_LITE
+        if (!staticStars)
+        {
+            // Redraw once stars that were missing from the view have been read
+            m_starLoader = new StarBlockLoader(dataFileName, &starReader, m_skyMesh->size(), []() {
+                if (SkyMap::Instance())
+                    QMetaObject::invokeMethod(SkyMap::Instance(), "forceUpdate", Qt::QueuedConnection);
+            });
+            if (!m_starLoader->isOpen())
+            {
+                delete m_starLoader;
+                m_starLoader = nullptr;
+            }
+        }
+#endif
     }
 
     return fileOpened;
 }
 
+void DeepStarComponent::fillFromLoader(Trixel trixel, float maglim, QList<StarBlockLoader::Request> &requests)
+{
+    StarBlockList *sbl            = m_starBlockList.at(trixel);
+    StarBlockLoader::Chunk *chunk = m_starLoader->take(trixel);
+
+    // Stars may have been loaded or released since the records were requested, in which case they are read again
+    if (chunk && chunk->firstRecord == (quint32)sbl->getStarCount())
+        sbl->addRecords(chunk->records.constData(), chunk->count);
+    delete chunk;
+
+    if (sbl->getFaintMag() < maglim && (quint32)sbl->getStarCount() < starReader.getRecordCount(trixel))
+        requests.append({ trixel, (quint32)sbl->getStarCount(), maglim });
+}
+
+void DeepStarComponent::predictRequests(SkyPoint *focus, float radius, float maglim,
+                                        QList<StarBlockLoader::Request> &requests)
+{
+    double ra  = focus->ra().Degrees();
+    double dec = focus->dec().Degrees();
+
+    if (m_hasLastFocus)
+    {
+        double dRA  = dms(ra - m_lastFocusRA + 180.0).reduce().Degrees() - 180.0;
+        double dDec = dec - m_lastFocusDec;
+        float dMag  = qMax(0.0f, maglim - m_lastMagLim);
+
+        if (dRA != 0 || dDec != 0 || dMag != 0)
+        {
+            SkyPoint ahead(dms(ra + PREFETCH_FRAMES * dRA).reduce(),
+                           dms(qBound(-90.0, dec + PREFETCH_FRAMES * dDec, 90.0)));
+            float aheadMag = qMin(maglim + PREFETCH_FRAMES * dMag, m_FaintMagnitude);
+            QSet<Trixel> queued;
+
+            for (const StarBlockLoader::Request &request : requests)
+                queued.insert(request.trixel);
+
+            m_skyMesh->aperture(&ahead, radius + 1.0, OBJ_NEAREST_BUF);
+            MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+
+            while (region.hasNext())
+            {
+                Trixel trixel      = region.next();
+                StarBlockList *sbl = m_starBlockList.at(trixel);
+
+                if (!queued.contains(trixel) && sbl->getFaintMag() < aheadMag &&
+                    (quint32)sbl->getStarCount() < starReader.getRecordCount(trixel))
+                    requests.append({ trixel, (quint32)sbl->getStarCount(), aheadMag });
+            }
+        }
+    }
+
+    m_lastFocusRA  = ra;
+    m_lastFocusDec = dec;
+    m_lastMagLim   = maglim;
+    m_hasLastFocus = true;
+}
+
 StarObject *DeepStarComponent::findByHDIndex(int HDnum)
 {
     // Currently, we only handle HD catalog indexes
-    return m_CatalogNumber.value(HDnum, nullptr); // TODO: Maybe, make this more general.
+    // TODO: Maybe, make this more general.
+    if (!m_CatalogNumber.contains(HDnum))
+        return nullptr;
+
+    const QPair<StarBlock *, int> &location = m_CatalogNumber[HDnum];
+#ifdef KSTARS_LITE
+    return &(location.first->star(location.second)->star);
+#else
+    return location.first->star(location.second);
+#endif
 }
 
 // This uses the main star index for looking up nearby stars but then
@@ -504,6 +619,10 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
 
 #ifdef KSTARS_LITE
     m_zoomMagLimit = StarComponent::zoomMagnitudeLimit();
+#else
+    StarBlock *bestBlock = nullptr;
+    int bestIndex        = 0;
+    SkyPoint point;
 #endif
     if (!fileOpened)
         return nullptr;
@@ -522,9 +641,7 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
             {
 #ifdef KSTARS_LITE
                 StarObject *star = &(block->star(j)->star);
-#else
-                StarObject *star = block->star(j);
-#endif
+
                 if (!star)
                     continue;
                 if (star->mag() > m_zoomMagLimit)
@@ -536,10 +653,29 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
                     oBest  = star;
                     maxrad = r;
                 }
+#else
+                if (block->mag(j) > m_zoomMagLimit)
+                    continue;
+
+                // Only the nearest star is made into a StarObject
+                block->equatorialCoords(j, &point);
+                double r = point.angularDistanceTo(p).Degrees();
+                if (r < maxrad)
+                {
+                    bestBlock = block;
+                    bestIndex = j;
+                    maxrad    = r;
+                }
+#endif
             }
         }
     }
 
+#ifndef KSTARS_LITE
+    if (bestBlock)
+        oBest = bestBlock->star(bestIndex);
+#endif
+
     // TODO: What if we are looking around a point that's not on
     // screen? objectNearest() will need to keep on filling up all
     // trixels around the SkyPoint to find the best match in case it
@@ -572,6 +708,10 @@ bool DeepStarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoin
     if (maglim < -28)
         maglim = m_FaintMagnitude;
 
+#ifndef KSTARS_LITE
+    SkyPoint point;
+#endif
+
     while (region.hasNext())
     {
         Trixel currentRegion = region.next();
@@ -586,13 +726,17 @@ bool DeepStarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoin
             {
 #ifdef KSTARS_LITE
                 StarObject *star = &(block->star(j)->star);
-#else
-                StarObject *star = block->star(j);
-#endif
                 if (star->mag() > maglim)
                     break; // Stars are organized by magnitude, so this should work
                 if (star->angularDistanceTo(&center).Degrees() <= radius)
                     list.append(star);
+#else
+                if (block->mag(j) > maglim)
+                    break; // Stars are organized by magnitude, so this should work
+                block->equatorialCoords(j, &point);
+                if (point.angularDistanceTo(&center).Degrees() <= radius)
+                    list.append(block->star(j));
+#endif
             }
         }
     }
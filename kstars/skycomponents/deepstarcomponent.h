@@ -38,6 +38,7 @@
 #include "starblockfactory.h"
 #include "skyobjects/deepstardata.h"
 #include "starblocklist.h"
+#include "starblockloader.h"
 
 class SkyMesh;
 class StarObject;
@@ -120,6 +121,16 @@ class DeepStarComponent : public ListComponent
     static StarBlockFactory m_StarBlockFactory;
 
   private:
+    /**
+     * @short Add stars read by the background loader to a trixel, and queue it if stars down to maglim are missing
+     */
+    void fillFromLoader(Trixel trixel, float maglim, QList<StarBlockLoader::Request> &requests);
+
+    /**
+     * @short Queue the trixels around where the focus is heading, down to where the magnitude limit is heading
+     */
+    void predictRequests(SkyPoint *focus, float radius, float maglim, QList<StarBlockLoader::Request> &requests);
+
     SkyMesh *m_skyMesh;
     KSNumbers m_reindexNum;
     int meshLevel;
@@ -139,7 +150,8 @@ class DeepStarComponent : public ListComponent
     long unsigned t_updateCache;
 
     QVector<StarBlockList *> m_starBlockList;
-    QHash<int, StarObject *> m_CatalogNumber;
+    // Static stars with an HD number, by the block they are in and their index in it
+    QHash<int, QPair<StarBlock *, int>> m_CatalogNumber;
 
     bool staticStars;
 
@@ -148,6 +160,13 @@ class DeepStarComponent : public ListComponent
     starData stardata;
     BinFileHelper starReader;
     QString dataFileName;
+
+    // Background reader of dynamically loaded stars, and the view it last read ahead for
+    StarBlockLoader *m_starLoader = nullptr;
+    double m_lastFocusRA          = 0;
+    double m_lastFocusDec         = 0;
+    float m_lastMagLim            = 0;
+    bool m_hasLastFocus           = false;
 };
 
 #endif
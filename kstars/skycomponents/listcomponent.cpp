@@ -20,6 +20,7 @@
 #include <QList>
 
 #include "kstarsdata.h"
+#include "nameindex.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
@@ -40,6 +41,7 @@ void ListComponent::clear()
     {
         SkyObject *o = m_ObjectList.takeFirst();
         removeFromNames(o);
+        nameIndex().removeNames(o);
         delete o;
     }
 }
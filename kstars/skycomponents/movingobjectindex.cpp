@@ -0,0 +1,73 @@
+/***************************************************************************
+              movingobjectindex.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "movingobjectindex.h"
+
+#include "skyobjects/skyobject.h"
+
+MovingObjectIndex::MovingObjectIndex() : m_SkyMesh(SkyMesh::Instance())
+{
+}
+
+void MovingObjectIndex::update(SkyObject *object)
+{
+    // Coordinates of date, see SkyMesh::index(const SkyPoint *, double, MeshBufNum_t)
+    const Trixel trixel = m_SkyMesh->HTMesh::index(object->ra().Degrees(), object->dec().Degrees());
+
+    auto indexed = m_Trixels.find(object);
+    if (indexed != m_Trixels.end())
+    {
+        if (indexed.value() == trixel)
+            return;
+
+        removeFromBucket(indexed.value(), object);
+        indexed.value() = trixel;
+    }
+    else
+        m_Trixels.insert(object, trixel);
+
+    m_Buckets[trixel].append(object);
+}
+
+void MovingObjectIndex::remove(const SkyObject *object)
+{
+    auto indexed = m_Trixels.find(object);
+    if (indexed == m_Trixels.end())
+        return;
+
+    removeFromBucket(indexed.value(), object);
+    m_Trixels.erase(indexed);
+}
+
+void MovingObjectIndex::removeFromBucket(Trixel trixel, const SkyObject *object)
+{
+    auto bucket  = m_Buckets.find(trixel);
+    int position = bucket->indexOf(const_cast<SkyObject *>(object));
+
+    // Order does not matter, the last object takes its place
+    (*bucket)[position] = bucket->last();
+    bucket->removeLast();
+
+    if (bucket->isEmpty())
+        m_Buckets.erase(bucket);
+}
+
+void MovingObjectIndex::clear()
+{
+    m_Buckets.clear();
+    m_Trixels.clear();
+}
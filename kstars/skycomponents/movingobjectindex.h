@@ -0,0 +1,93 @@
+/***************************************************************************
+               movingobjectindex.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "skymesh.h"
+#include "typedef.h"
+
+#include <QHash>
+#include <QVector>
+
+class SkyObject;
+
+/**
+ * @class MovingObjectIndex
+ * @short Index of the objects that move across the sky, such as asteroids, comets and satellites, by trixel.
+ *
+ * Objects must be updated in the index whenever their coordinates change. Asteroids and comets do so themselves once
+ * they are given the index with KSPlanetBase::setIndex(), satellites are indexed again by their component. An object
+ * only changes bucket when it leaves its trixel, which moving objects seldom do from one update to the next.
+ *
+ * Moving objects have no catalog coordinates, so they are indexed by their coordinates of date. They are looked up in
+ * apertures that SkyMesh::index() computes from coordinates of date, such as NO_PRECESS_BUF while the sky is drawn
+ * and OBJ_NEAREST_NO_PRECESS_BUF while the nearest object is searched, rather than the precessed apertures of
+ * SkyMesh::aperture().
+ *
+ * @author agent
+ */
+class MovingObjectIndex
+{
+  public:
+    MovingObjectIndex();
+
+    /** @short Index object at its current position, moving it to another trixel if it left its trixel */
+    void update(SkyObject *object);
+
+    /** @short Remove object from the index */
+    void remove(const SkyObject *object);
+
+    /** @short Remove all the objects, which may be deleted already */
+    void clear();
+
+    /** @return the number of indexed objects */
+    int count() const { return m_Trixels.size(); }
+
+    /** @short Call visitor with each object of the trixels of buffer bufNum of the sky mesh */
+    template <typename Visitor>
+    void visit(MeshBufNum_t bufNum, Visitor visitor) const;
+
+  private:
+    /** @short Remove object from the bucket of trixel, which must hold it */
+    void removeFromBucket(Trixel trixel, const SkyObject *object);
+
+    SkyMesh *m_SkyMesh;
+
+    // Objects of each trixel, in no particular order
+    QHash<Trixel, QVector<SkyObject *>> m_Buckets;
+
+    // Trixel of each object
+    QHash<const SkyObject *, Trixel> m_Trixels;
+};
+
+template <typename Visitor>
+void MovingObjectIndex::visit(MeshBufNum_t bufNum, Visitor visitor) const
+{
+    if (m_Buckets.isEmpty())
+        return;
+
+    MeshIterator region(m_SkyMesh, bufNum);
+    while (region.hasNext())
+    {
+        auto bucket = m_Buckets.constFind(region.next());
+        if (bucket == m_Buckets.constEnd())
+            continue;
+
+        for (SkyObject *object : bucket.value())
+            visitor(object);
+    }
+}
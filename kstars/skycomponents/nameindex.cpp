@@ -0,0 +1,241 @@
+/***************************************************************************
+                   nameindex.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nameindex.h"
+
+#include "skyobject.h"
+
+#include <algorithm>
+
+NameIndex::NameIndex()
+{
+}
+
+void NameIndex::add(const QString &name, SkyObject *object)
+{
+    insert(name, object, false);
+}
+
+void NameIndex::addAlias(const QString &name, SkyObject *object)
+{
+    const QVector<Entry> entries = m_Names.value(name.toCaseFolded());
+    auto indexed = std::find_if(entries.constBegin(), entries.constEnd(),
+                                [object](const Entry &entry) { return entry.object == object; });
+
+    if (indexed == entries.constEnd())
+        insert(name, object, true);
+}
+
+void NameIndex::addAliases(SkyObject *object)
+{
+    if (object->hasName())
+        addAlias(object->name(), object);
+    if (object->hasLongName())
+        addAlias(object->longname(), object);
+    if (object->hasName2())
+        addAlias(object->name2(), object);
+}
+
+void NameIndex::insert(const QString &name, SkyObject *object, bool alias)
+{
+    if (name.isEmpty())
+        return;
+
+    Entry entry;
+    entry.name   = name;
+    entry.object = object;
+    entry.type   = object->type();
+    entry.rank   = rank(entry.type);
+    entry.alias  = alias;
+
+    // Objects of the same rank stay in the order they were added
+    QVector<Entry> &entries = m_Names[name.toCaseFolded()];
+    auto position           = std::upper_bound(entries.begin(), entries.end(), entry,
+                                     [](const Entry &a, const Entry &b) { return a.rank < b.rank; });
+    entries.insert(position, entry);
+
+    m_Count++;
+    m_Revision++;
+    if (alias == false)
+        m_Sorted = false;
+}
+
+void NameIndex::remove(const QString &name, const SkyObject *object)
+{
+    auto names = m_Names.find(name.toCaseFolded());
+    if (names == m_Names.end())
+        return;
+
+    QVector<Entry> &entries = names.value();
+    for (int i = entries.size() - 1; i >= 0; i--)
+    {
+        if (entries[i].object == object && entries[i].name == name)
+        {
+            if (entries[i].alias == false)
+                m_Sorted = false;
+
+            entries.remove(i);
+            m_Count--;
+            m_Revision++;
+        }
+    }
+
+    if (entries.isEmpty())
+        m_Names.erase(names);
+}
+
+void NameIndex::removeNames(const SkyObject *object)
+{
+    if (object->hasName())
+        remove(object->name(), object);
+    if (object->hasLongName())
+        remove(object->longname(), object);
+    if (object->hasName2())
+        remove(object->name2(), object);
+}
+
+void NameIndex::removeType(int type)
+{
+    for (auto names = m_Names.begin(); names != m_Names.end();)
+    {
+        QVector<Entry> &entries = names.value();
+        for (int i = entries.size() - 1; i >= 0; i--)
+        {
+            if (entries[i].type == type)
+            {
+                entries.remove(i);
+                m_Count--;
+                m_Revision++;
+                m_Sorted = false;
+            }
+        }
+
+        if (entries.isEmpty())
+            names = m_Names.erase(names);
+        else
+            ++names;
+    }
+}
+
+bool NameIndex::contains(const QString &name, int type) const
+{
+    const QVector<Entry> entries = m_Names.value(name.toCaseFolded());
+
+    return std::any_of(entries.constBegin(), entries.constEnd(), [&](const Entry &entry) {
+        return entry.alias == false && entry.type == type && entry.name == name;
+    });
+}
+
+SkyObject *NameIndex::find(const QString &name) const
+{
+    auto names = m_Names.constFind(name.toCaseFolded());
+    if (names == m_Names.constEnd())
+        return nullptr;
+
+    return names->first().object;
+}
+
+QString NameIndex::firstStartingWith(const QString &prefix, const QList<int> &types) const
+{
+    sortNames();
+
+    const QString key = prefix.toCaseFolded();
+    auto name = std::lower_bound(m_SortedNames.constBegin(), m_SortedNames.constEnd(), key,
+                                 [](const QPair<QString, Entry> &a, const QString &b) { return a.first < b; });
+
+    // Names starting with key follow each other
+    for (; name != m_SortedNames.constEnd() && name->first.startsWith(key); ++name)
+    {
+        if (types.isEmpty() || types.contains(name->second.type))
+            return name->second.name;
+    }
+
+    return QString();
+}
+
+QStringList NameIndex::startingWith(const QString &prefix) const
+{
+    sortNames();
+
+    QStringList names;
+    const QString key = prefix.toCaseFolded();
+    auto name = std::lower_bound(m_SortedNames.constBegin(), m_SortedNames.constEnd(), key,
+                                 [](const QPair<QString, Entry> &a, const QString &b) { return a.first < b; });
+
+    for (; name != m_SortedNames.constEnd() && name->first.startsWith(key); ++name)
+        names.append(name->second.name);
+
+    return names;
+}
+
+void NameIndex::sortNames() const
+{
+    if (m_Sorted)
+        return;
+
+    m_SortedNames.clear();
+    m_SortedNames.reserve(m_Count);
+
+    for (auto names = m_Names.constBegin(); names != m_Names.constEnd(); ++names)
+    {
+        for (const Entry &entry : names.value())
+        {
+            if (entry.alias == false)
+                m_SortedNames.append(qMakePair(names.key(), entry));
+        }
+    }
+
+    // Names that fold the same are ordered by rank, then by name
+    std::sort(m_SortedNames.begin(), m_SortedNames.end(),
+              [](const QPair<QString, Entry> &a, const QPair<QString, Entry> &b) {
+                  if (a.first != b.first)
+                      return a.first < b.first;
+                  if (a.second.rank != b.second.rank)
+                      return a.second.rank < b.second.rank;
+                  return a.second.name < b.second.name;
+              });
+
+    m_Sorted = true;
+}
+
+int NameIndex::rank(int type)
+{
+    switch (type)
+    {
+        case SkyObject::PLANET:
+        case SkyObject::MOON:
+        case SkyObject::ASTEROID:
+        case SkyObject::COMET:
+            return 0;
+
+        case SkyObject::CONSTELLATION:
+            return 2;
+
+        case SkyObject::STAR:
+            return 3;
+
+        case SkyObject::SUPERNOVA:
+            return 4;
+
+        case SkyObject::SATELLITE:
+            return 5;
+
+        // Deep-sky objects, and the objects of catalogs
+        default:
+            return 1;
+    }
+}
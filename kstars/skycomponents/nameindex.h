@@ -0,0 +1,118 @@
+/***************************************************************************
+                    nameindex.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class SkyObject;
+
+/**
+ * @class NameIndex
+ * @short Case-insensitive index of the names of the sky objects of every component.
+ *
+ * Components add the names of their objects when they load them, and remove them before they drop them. Names are
+ * looked up in a hash, keyed by their case folding. The names that the find dialog lists are also kept in a vector,
+ * sorted when it is first searched after a change, so that the names starting with a prefix are found by a binary
+ * search. Aliases, such as the alternate names of objects, are only found by their full name.
+ *
+ * When objects share a name, find() returns them in the order SkyMapComposite::findByName() used to search its
+ * components: solar system bodies, deep-sky and catalog objects, constellations, stars, supernovae and satellites.
+ * Objects of the same kind come in the order they were added.
+ *
+ * @author agent
+ */
+class NameIndex
+{
+  public:
+    NameIndex();
+
+    /** @short Add a name of object, which the find dialog lists. Empty names are ignored. */
+    void add(const QString &name, SkyObject *object);
+
+    /**
+     * @short Add an alternate name of object, which is only found by find(), unless the name is indexed for object
+     * already. Empty names are ignored.
+     */
+    void addAlias(const QString &name, SkyObject *object);
+
+    /** @short Add the name, long name and alternate name of object as aliases. Components call it after add(). */
+    void addAliases(SkyObject *object);
+
+    /** @short Remove name of object, whether it is listed or an alias. */
+    void remove(const QString &name, const SkyObject *object);
+
+    /** @short Remove the name, long name and alternate name of object */
+    void removeNames(const SkyObject *object);
+
+    /** @short Remove the names of all the objects of type. The objects may be deleted already. */
+    void removeType(int type);
+
+    /** @return true if name, with this case, is listed for an object of type */
+    bool contains(const QString &name, int type) const;
+
+    /** @return the object named name, regardless of case, or nullptr if there is none */
+    SkyObject *find(const QString &name) const;
+
+    /**
+     * @return the first listed name that starts with prefix regardless of case, in case-insensitive alphabetical
+     * order, or an empty string if there is none
+     * @param types Types of the objects to consider, all types if it is empty
+     */
+    QString firstStartingWith(const QString &prefix, const QList<int> &types = QList<int>()) const;
+
+    /** @return the listed names of the objects that start with prefix regardless of case, in alphabetical order */
+    QStringList startingWith(const QString &prefix) const;
+
+    /** @return the number of names, including aliases */
+    int count() const { return m_Count; }
+
+    /** @return a number that changes whenever names are added or removed */
+    uint revision() const { return m_Revision; }
+
+  private:
+    typedef struct
+    {
+        QString name;
+        SkyObject *object;
+        int type;
+        int rank; // Rank of the kind of object, see find()
+        bool alias;
+    } Entry;
+
+    void insert(const QString &name, SkyObject *object, bool alias);
+
+    /** @short Sort the listed names if they changed since they were last sorted */
+    void sortNames() const;
+
+    static int rank(int type);
+
+    // Entries of each folded name, by increasing rank
+    QHash<QString, QVector<Entry>> m_Names;
+
+    // Folded listed names and their entries, sorted on demand
+    mutable QVector<QPair<QString, Entry>> m_SortedNames;
+    mutable bool m_Sorted = true;
+
+    int m_Count     = 0;
+    uint m_Revision = 0;
+};
@@ -20,6 +20,7 @@
 #include "ksfilereader.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymap.h"
@@ -62,6 +63,7 @@ void SatellitesComponent::loadData()
 
     objectNames(SkyObject::SATELLITE).clear();
     objectLists(SkyObject::SATELLITE).clear();
+    nameIndex().removeType(SkyObject::SATELLITE);
 
     foreach (SatelliteGroup *group, m_groups)
     {
@@ -73,6 +75,7 @@ void SatellitesComponent::loadData()
             {
                 objectNames(SkyObject::SATELLITE).append(sat->name());
                 objectLists(SkyObject::SATELLITE).append(QPair<QString, const SkyObject *>(sat->name(), sat));
+                nameIndex().add(sat->name(), sat);
                 nameHash[sat->name().toLower()] = sat;
             }
         }
@@ -94,16 +97,13 @@ void SatellitesComponent::update(KSNumbers *)
     {
         group->updateSatellitesPos();
     }
+
+    indexSatellites();
 }
 
-void SatellitesComponent::draw(SkyPainter *skyp)
+void SatellitesComponent::indexSatellites()
 {
-#ifndef KSTARS_LITE
-    // Return if satellites must not be draw
-    if (!selected())
-        return;
-
-    bool hideLabels = (!Options::showSatellitesLabels() || (SkyMap::Instance()->isSlewing() && Options::hideLabels()));
+    m_index.clear();
 
     foreach (SatelliteGroup *group, m_groups)
     {
@@ -112,23 +112,42 @@ void SatellitesComponent::draw(SkyPainter *skyp)
             Satellite *sat = group->at(i);
 
             if (sat->selected())
-            {
-                bool drawn = false;
-                if (Options::showVisibleSatellites())
-                {
-                    if (sat->isVisible())
-                        drawn = skyp->drawSatellite(sat);
-                }
-                else
-                {
-                    drawn = skyp->drawSatellite(sat);
-                }
-
-                if (drawn && !hideLabels)
-                    SkyLabeler::AddLabel(sat, SkyLabeler::SATELLITE_LABEL);
-            }
+                m_index.update(sat);
         }
     }
+}
+
+void SatellitesComponent::draw(SkyPainter *skyp)
+{
+#ifndef KSTARS_LITE
+    // Return if satellites must not be draw
+    if (!selected())
+        return;
+
+    bool hideLabels = (!Options::showSatellitesLabels() || (SkyMap::Instance()->isSlewing() && Options::hideLabels()));
+
+    // Only the satellites of the trixels around the focus may be visible
+    m_index.visit(NO_PRECESS_BUF, [&](SkyObject *o) {
+        Satellite *sat = static_cast<Satellite *>(o);
+
+        // Satellites unselected since they were indexed
+        if (!sat->selected())
+            return;
+
+        bool drawn = false;
+        if (Options::showVisibleSatellites())
+        {
+            if (sat->isVisible())
+                drawn = skyp->drawSatellite(sat);
+        }
+        else
+        {
+            drawn = skyp->drawSatellite(sat);
+        }
+
+        if (drawn && !hideLabels)
+            SkyLabeler::AddLabel(sat, SkyLabeler::SATELLITE_LABEL);
+    });
 #endif
 }
 
@@ -179,6 +198,7 @@ void SatellitesComponent::updateTLEs()
                 file.close();
                 group->readTLE();
                 group->updateSatellitesPos();
+                indexSatellites();
                 progressDlg.setValue(++i);
             }
             else
@@ -226,25 +246,21 @@ SkyObject *SatellitesComponent::objectNearest(SkyPoint *p, double &maxrad)
     double rBest     = maxrad;
     double r;
 
-    foreach (SatelliteGroup *group, m_groups)
-    {
-        for (int i = 0; i < group->size(); i++)
+    m_index.visit(OBJ_NEAREST_NO_PRECESS_BUF, [&](SkyObject *o) {
+        Satellite *sat = static_cast<Satellite *>(o);
+        if (!sat->selected())
+            return;
+
+        r = sat->angularDistanceTo(p).Degrees();
+        //qDebug() << sat->name();
+        //qDebug() << "r = " << r << " - max = " << rBest;
+        //qDebug() << "ra2=" << sat->ra().Degrees() << " - dec2=" << sat->dec().Degrees();
+        if (r < rBest)
         {
-            Satellite *sat = group->at(i);
-            if (!sat->selected())
-                continue;
-
-            r = sat->angularDistanceTo(p).Degrees();
-            //qDebug() << sat->name();
-            //qDebug() << "r = " << r << " - max = " << rBest;
-            //qDebug() << "ra2=" << sat->ra().Degrees() << " - dec2=" << sat->dec().Degrees();
-            if (r < rBest)
-            {
-                rBest = r;
-                oBest = sat;
-            }
+            rBest = r;
+            oBest = sat;
         }
-    }
+    });
 
     maxrad = rBest;
     return oBest;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "movingobjectindex.h"
 #include "satellitegroup.h"
 #include "skycomponent.h"
 
@@ -68,6 +69,12 @@ class SatellitesComponent : public SkyComponent
      */
     void updateTLEs();
 
+    /**
+     * Index the selected satellites of all groups from scratch, as groups drop and replace satellites.
+     * This must be called whenever satellites move or are selected.
+     */
+    void indexSatellites();
+
     /**
      * @return The list of all groups
      */
@@ -109,4 +116,5 @@ class SatellitesComponent : public SkyComponent
   private:
     QList<SatelliteGroup *> m_groups; // List of all groups
     QHash<QString, Satellite *> nameHash;
+    MovingObjectIndex m_index; // Selected satellites, by trixel
 };
@@ -17,6 +17,7 @@
 
 #include "skycomponent.h"
 
+#include "nameindex.h"
 #include "Options.h"
 #include "skycomposite.h"
 #include "skyobjects/skyobject.h"
@@ -63,6 +64,11 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyComponent::getObjectL
     return parent()->objectLists();
 }
 
+NameIndex &SkyComponent::getNameIndex()
+{
+    return parent()->nameIndex();
+}
+
 void SkyComponent::removeFromNames(const SkyObject *obj)
 {
     QStringList &names = getObjectNames()[obj->type()];
@@ -87,4 +93,6 @@ void SkyComponent::removeFromLists(const SkyObject *obj)
     i = names.indexOf(QPair<QString, const SkyObject *>(obj->longname(), obj));
     if (i >= 0)
         names.removeAt(i);
+
+    getNameIndex().removeNames(obj);
 }
@@ -22,6 +22,7 @@
 
 class QString;
 
+class NameIndex;
 class SkyObject;
 class SkyPoint;
 class SkyComposite;
@@ -196,6 +197,9 @@ class SkyComponent
 
     inline QVector<QPair<QString, const SkyObject *>> &objectLists(int type) { return getObjectLists()[type]; }
 
+    /** @return the index of the names of the objects of all components, see SkyMapComposite::findByName() */
+    inline NameIndex &nameIndex() { return getNameIndex(); }
+
   protected:
     void removeFromNames(const SkyObject *obj);
     void removeFromLists(const SkyObject *obj);
@@ -203,6 +207,7 @@ class SkyComponent
   private:
     virtual QHash<int, QStringList> &getObjectNames();
     virtual QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists();
+    virtual NameIndex &getNameIndex();
 
     // Disallow copying and assignment
     SkyComponent(const SkyComponent &);
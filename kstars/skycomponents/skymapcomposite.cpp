@@ -289,12 +289,8 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     SkyPoint *focus = map->focus();
     m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
 
-    // create the no-precess aperture if needed
-    if (Options::showEquatorialGrid() || Options::showHorizontalGrid() || Options::showCBounds() ||
-        Options::showEquator())
-    {
-        m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
-    }
+    // create the no-precess aperture, for the grids and the moving objects
+    m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
 
     // clear marks from old labels and prep fonts
     m_skyLabeler->reset(map);
@@ -427,6 +423,7 @@ SkyObject *SkyMapComposite::objectNearest(SkyPoint *p, double &maxrad)
 
     //printf("%.1f %.1f\n", p->ra().Degrees(), p->dec().Degrees() );
     m_skyMesh->aperture(p, maxrad + 1.0, OBJ_NEAREST_BUF);
+    m_skyMesh->index(p, maxrad + 1.0, OBJ_NEAREST_NO_PRECESS_BUF);
 
     oBest = m_Stars->objectNearest(p, rBest);
     //reduce rBest by 0.75 for stars brighter than 4th mag
@@ -575,6 +572,11 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyMapComposite::getObje
     return m_ObjectLists;
 }
 
+NameIndex &SkyMapComposite::getNameIndex()
+{
+    return m_NameIndex;
+}
+
 QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const SkyPoint &p2)
 {
     const SkyRegion &region = m_skyMesh->skyRegion(p1, p2);
@@ -590,40 +592,7 @@ QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const
 
 SkyObject *SkyMapComposite::findByName(const QString &name)
 {
-    //We search the children in an "intelligent" order (most-used
-    //object types first), in order to avoid wasting too much time
-    //looking for a match.  The most important part of this ordering
-    //is that stars should be last (because the stars list is so long)
-    SkyObject *o = 0;
-    o            = m_SolarSystem->findByName(name);
-    if (o)
-        return o;
-    o = m_DeepSky->findByName(name);
-    if (o)
-        return o;
-    o = m_CustomCatalogs->findByName(name);
-    if (o)
-        return o;
-    o = m_internetResolvedComponent->findByName(name);
-    if (o)
-        return o;
-    o = m_manualAdditionsComponent->findByName(name);
-    if (o)
-        return o;
-    o = m_CNames->findByName(name);
-    if (o)
-        return o;
-    o = m_Stars->findByName(name);
-    if (o)
-        return o;
-    o = m_Supernovae->findByName(name);
-    if (o)
-        return o;
-    o = m_Satellites->findByName(name);
-    if (o)
-        return o;
-
-    return 0;
+    return m_NameIndex.find(name);
 }
 
 SkyObject *SkyMapComposite::findStarByGenetiveName(const QString name)
@@ -708,6 +677,8 @@ void SkyMapComposite::reloadCNames()
     //     m_CNames = new ConstellationNamesComponent( this, m_Cultures );
     //     SkyMapDrawAbstract::setDrawLock( false );
     objectNames(SkyObject::CONSTELLATION).clear();
+    objectLists(SkyObject::CONSTELLATION).clear();
+    nameIndex().removeType(SkyObject::CONSTELLATION);
     delete m_CNames;
     m_CNames = new ConstellationNamesComponent(this, m_Cultures);
 }
@@ -22,6 +22,7 @@
 
 #include "skycomposite.h"
 #include "ksnumbers.h"
+#include "nameindex.h"
 #include "skyobject.h"
 
 class SkyMesh;
@@ -143,8 +144,9 @@ class SkyMapComposite : public QObject, public SkyComposite
         	*
         	*The objects' primary, secondary and long-form names will
         	*all be checked for a match.
-        	*@note Overloaded from SkyComposite.  In this version, we search
-        	*the most likely object classes first to be more efficient.
+        	*@note Overloaded from SkyComposite.  In this version, the name
+        	*is looked up in the index of the names of all components, see
+        	*NameIndex for the order in which objects sharing a name are found.
         	*@p name the name to be matched
         	*@return a pointer to the SkyObject whose name matches
         	*the argument, or a nullptr pointer if no match was found.
@@ -235,6 +237,7 @@ class SkyMapComposite : public QObject, public SkyComposite
   private:
     QHash<int, QStringList> &getObjectNames() Q_DECL_OVERRIDE;
     QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() Q_DECL_OVERRIDE;
+    NameIndex &getNameIndex() Q_DECL_OVERRIDE;
 
     CultureList *m_Cultures;
     ConstellationBoundaryLines *m_CBoundLines;
@@ -272,6 +275,7 @@ class SkyMapComposite : public QObject, public SkyComposite
     QList<SkyObject *> m_LabeledObjects;
     QHash<int, QStringList> m_ObjectNames;
     QHash<int, QVector<QPair<QString, const SkyObject *>>> m_ObjectLists;
+    NameIndex m_NameIndex;
     QHash<QString, QString> m_ConstellationNames;
     QString m_internetResolvedCat; // Holds the name of the internet resolved catalog
     QString m_manualAdditionsCat;
@@ -53,6 +53,8 @@ enum MeshBufNum_t
     NO_PRECESS_BUF  = 1,
     OBJ_NEAREST_BUF = 2,
     IN_CONSTELL_BUF = 3,
+    // Aperture of the nearest object search in coordinates of date, see MovingObjectIndex
+    OBJ_NEAREST_NO_PRECESS_BUF = 4,
     NUM_MESH_BUF
 };
 
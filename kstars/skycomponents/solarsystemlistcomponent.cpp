@@ -19,6 +19,7 @@
 #include "solarsystemcomposite.h"
 
 #include <QPen>
+#include <QtConcurrent>
 #include <KLocalizedString>
 
 #include "Options.h"
@@ -27,15 +28,20 @@
 #include "kstarsdata.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
+#else
+#include "skymaplite.h"
 #endif
 
-SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p) : ListComponent(p), m_Earth(p->earth())
+SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p)
+    : ListComponent(p), m_Earth(p->earth()), m_PositionNumbers(J2000), m_PendingNumbers(J2000)
 {
+    QObject::connect(&m_PositionWatcher, &QFutureWatcher<void>::finished, [this]() { applyPositions(); });
 }
 
 SolarSystemListComponent::~SolarSystemListComponent()
 {
-    //Object deletes handled by parent class (ListComponent)
+    //Object deletes handled by parent class (ListComponent), once the workers are done with them
+    m_PositionWatcher.waitForFinished();
 }
 
 void SolarSystemListComponent::update(KSNumbers *)
@@ -60,11 +66,130 @@ void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
         foreach (SkyObject *o, m_ObjectList)
         {
             KSPlanetBase *p = (KSPlanetBase *)o;
-            p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
-            p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
 
             if (p->hasTrail())
+            {
+                p->setIndex(&m_ObjectIndex);
+                p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
+                p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
                 p->updateTrail(data->lst(), data->geo()->lat());
+            }
+        }
+
+        // Only the latest date matters for the positions to compute next
+        m_PendingNumbers    = *num;
+        m_HasPendingNumbers = true;
+
+        // After the date is changed, the bodies are moved before the sky is drawn or searched again. Positions
+        // computed for the previous date are dropped.
+        if (data->isFullTimeUpdate())
+        {
+            m_PositionWatcher.waitForFinished();
+            m_PositionJobs.resize(0);
+            applyPositions(true);
+        }
+        else if (m_PositionWatcher.isRunning() == false)
+            applyPositions();
+    }
+}
+
+SkyObject *SolarSystemListComponent::objectNearest(SkyPoint *p, double &maxrad)
+{
+    if (!selected())
+        return 0;
+
+    SkyObject *oBest = 0;
+    m_ObjectIndex.visit(OBJ_NEAREST_NO_PRECESS_BUF, [&](SkyObject *o) {
+        double r = o->angularDistanceTo(p).Degrees();
+        if (r < maxrad)
+        {
+            oBest  = o;
+            maxrad = r;
+        }
+    });
+    return oBest;
+}
+
+void SolarSystemListComponent::cancelPositions()
+{
+    m_PositionWatcher.waitForFinished();
+
+    foreach (SkyObject *o, m_ObjectList)
+        ((KSPlanetBase *)o)->setIndex(nullptr);
+    m_ObjectIndex.clear();
+    m_PositionJobs.clear();
+    m_HasPendingNumbers = false;
+    m_Positioned        = false;
+}
+
+void SolarSystemListComponent::computePositions(const KSNumbers &num)
+{
+    KStarsData *data = KStarsData::Instance();
+
+    m_PositionJobs.resize(0);
+    foreach (SkyObject *o, m_ObjectList)
+    {
+        KSPlanetBase *p = (KSPlanetBase *)o;
+
+        if (p->hasTrail() == false)
+            m_PositionJobs.append({ p, KSPlanetBase::Position(), false });
+    }
+
+    m_PositionNumbers = num;
+
+    // The workers work on copies of the date, location and Earth, which the GUI thread keeps updating
+    const EclipticPosition earth(m_Earth->ecLong(), m_Earth->ecLat(), m_Earth->rsun());
+    const CachingDms lat(*data->geo()->lat()), lst(*data->lst());
+
+    m_PositionWatcher.setFuture(QtConcurrent::map(m_PositionJobs, [num, earth, lat, lst](PositionJob &job) {
+        job.computed = job.body->computePosition(&num, &lat, &lst, earth, job.position);
+    }));
+}
+
+void SolarSystemListComponent::applyPositions(bool synchronous)
+{
+    // Stale notification of positions that were replaced
+    if (m_PositionWatcher.isRunning())
+        return;
+
+    KStarsData *data = KStarsData::Instance();
+
+    for (const PositionJob &job : m_PositionJobs)
+    {
+        // From its first position on, the body follows wherever it is moved in the index
+        job.body->setIndex(&m_ObjectIndex);
+
+        // Bodies that cannot be moved by the workers are moved here, as they were before
+        if (job.computed)
+            job.body->setPosition(job.position);
+        else
+            job.body->findPosition(&m_PositionNumbers, data->geo()->lat(), data->lst(), m_Earth);
+
+        job.body->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
+
+    if (m_PositionJobs.isEmpty() == false)
+    {
+        m_PositionJobs.resize(0);
+        m_Positioned = true;
+
+#ifndef KSTARS_LITE
+        SkyMap::Instance()->forceUpdate();
+#else
+        SkyMapLite::Instance()->forceUpdate();
+#endif
+    }
+
+    if (m_HasPendingNumbers)
+    {
+        m_HasPendingNumbers = false;
+        computePositions(m_PendingNumbers);
+
+        // Bodies are never drawn before they have a position
+        if (m_Positioned == false || synchronous)
+        {
+            m_PositionWatcher.waitForFinished();
+            applyPositions();
         }
     }
 }
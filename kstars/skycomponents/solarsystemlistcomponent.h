@@ -19,6 +19,12 @@
 #define SOLARSYSTEMLISTCOMPONENT_H
 
 #include "listcomponent.h"
+#include "ksnumbers.h"
+#include "movingobjectindex.h"
+#include "skyobjects/ksplanetbase.h"
+
+#include <QFutureWatcher>
+#include <QVector>
 
 class KSPlanet;
 class SolarSystemComposite;
@@ -26,6 +32,14 @@ class SolarSystemComposite;
 /**
  *@class SolarSystemListComponent
  *
+ *The positions of the bodies are computed on worker threads into a back buffer, while the sky map keeps drawing
+ *them where they were, and the bodies are moved to their new positions at once when they are all computed.
+ *Bodies with a trail are moved at once on the GUI thread, which owns their trails.
+ *Full updates, such as the one after the date is changed, wait for the positions instead.
+ *
+ *Bodies are indexed by trixel from their first position on, and follow in the index wherever they are moved, also by
+ *tools and dialogs, so that they are only drawn and searched near the focus of the sky map.
+ *
  *@author Jason Harris
  *@version 1.0
  */
@@ -46,11 +60,51 @@ class SolarSystemListComponent : public ListComponent
          */
     void updateSolarSystemBodies(KSNumbers *num) Q_DECL_OVERRIDE;
 
+    /** @short Search the bodies of the trixels of OBJ_NEAREST_NO_PRECESS_BUF */
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad) Q_DECL_OVERRIDE;
+
   protected:
     void drawTrails(SkyPainter *skyp) Q_DECL_OVERRIDE;
 
+    /** @short Wait for the positions being computed, and forget them.
+         *
+         * This must be called before bodies are removed from the component. The next update then moves the bodies
+         * at once, so that new bodies are never drawn before they have a position.
+         */
+    void cancelPositions();
+
+    // Bodies that have a position, by trixel
+    MovingObjectIndex m_ObjectIndex;
+
   private:
+    /** @short Compute the positions of the bodies without a trail on worker threads, for the date of num */
+    void computePositions(const KSNumbers &num);
+
+    /** @short Move the bodies to their computed positions, then compute the pending positions if any
+         * @param synchronous Whether to wait for the pending positions and move the bodies to them too
+         */
+    void applyPositions(bool synchronous = false);
+
+    typedef struct
+    {
+        KSPlanetBase *body;
+        KSPlanetBase::Position position;
+        bool computed;
+    } PositionJob;
+
     KSPlanet *m_Earth;
+
+    // Back buffer of the positions, only touched by the workers while they run
+    QVector<PositionJob> m_PositionJobs;
+    QFutureWatcher<void> m_PositionWatcher;
+    KSNumbers m_PositionNumbers;
+
+    // Date of the latest update received while positions were computed
+    KSNumbers m_PendingNumbers;
+    bool m_HasPendingNumbers = false;
+
+    // Whether the bodies were ever moved to a position
+    bool m_Positioned = false;
 };
 
 #endif
@@ -21,6 +21,7 @@
 
 #include "dms.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "skyobjects/starobject.h"
 #include "skyobjects/ksplanetbase.h"
 #include "skyobjects/ksplanet.h"
@@ -45,12 +46,15 @@ SolarSystemSingleComponent::SolarSystemSingleComponent(SolarSystemComposite *par
     {
         objectNames(m_Planet->type()).append(m_Planet->name());
         objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->name(), m_Planet));
+        nameIndex().add(m_Planet->name(), m_Planet);
     }
     if (!m_Planet->longname().isEmpty() && m_Planet->longname() != m_Planet->name())
     {
         objectNames(m_Planet->type()).append(m_Planet->longname());
         objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->longname(), m_Planet));
+        nameIndex().add(m_Planet->longname(), m_Planet);
     }
+    nameIndex().addAliases(m_Planet);
 }
 
 SolarSystemSingleComponent::~SolarSystemSingleComponent()
@@ -18,11 +18,21 @@
 #include <QDebug>
 
 #include "starblock.h"
+#include "kstarsdata.h"
+#include "Options.h"
+#include "projections/projector.h"
+#include "skyobjects/apparentplace.h"
 #include "skyobjects/starobject.h"
 #include "starcomponent.h"
 #include "skyobjects/stardata.h"
 #include "skyobjects/deepstardata.h"
 
+#include <cmath>
+#include <cstring>
+#ifdef PROFILE_UPDATECOORDS
+#include <ctime>
+#endif
+
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
 #include "kstarslite/skyitems/skynodes/pointsourcenode.h"
@@ -41,37 +51,73 @@ StarNode::~StarNode()
 }
 #endif
 
-StarBlock::StarBlock(int nstars)
-    : faintMag(-5), brightMag(35), parent(0), prev(0), next(0), drawID(0), nStars(0),
+#ifndef KSTARS_LITE
+namespace
+{
+/**
+ * StarObjects of stars whose block was reset or deleted, by catalog record. They may still be pointed at, as the
+ * selected object, a label or an observing list entry, so they are neither deleted nor reused for another star.
+ * StarBlock::star() hands the same object back when the star is loaded again.
+ */
+struct DetachedObjects
+{
+    ~DetachedObjects() { qDeleteAll(objects); }
+
+    QMultiHash<QByteArray, StarObject *> objects;
+};
+
+DetachedObjects detached;
+}
+#endif
+
 #ifdef KSTARS_LITE
-      stars(nstars, StarNode())
+StarBlock::StarBlock(int nstars)
+    : faintMag(-5), brightMag(35), parent(0), prev(0), next(0), drawID(0), nStars(0), stars(nstars, StarNode())
+{
+}
 #else
-      stars(nstars, StarObject())
-#endif
+StarBlock::StarBlock(int nstars)
+    : faintMag(-5), brightMag(35), parent(0), prev(0), next(0), drawID(0), nStars(0), recordSize(0),
+      magnitudes(nstars), spectralClasses(nstars), ra(nstars), dec(nstars), alt(nstars), az(nstars), updateNumID(0),
+      precessJD(0), precessedCount(0), updateID(0), horizontalCount(0)
 {
 }
+#endif
 
 void StarBlock::reset()
 {
     if (parent)
         parent->releaseBlock(this);
 
+#ifndef KSTARS_LITE
+    detachObjects();
+#endif
+
     parent    = nullptr;
     faintMag  = -5.0;
     brightMag = 35.0;
     nStars    = 0;
+
+#ifndef KSTARS_LITE
+    precessedCount  = 0;
+    horizontalCount = 0;
+#endif
 }
 
 StarBlock::~StarBlock()
 {
     if (parent)
         parent->releaseBlock(this);
+
+#ifndef KSTARS_LITE
+    detachObjects();
+#endif
 }
 #ifdef KSTARS_LITE
-StarNode *StarBlock::addStar(const starData &data)
+bool StarBlock::addStar(const starData &data)
 {
     if (isFull())
-        return 0;
+        return false;
     StarNode &node   = stars[nStars++];
     StarObject &star = node.star;
 
@@ -80,13 +126,13 @@ StarNode *StarBlock::addStar(const starData &data)
         faintMag = star.mag();
     if (star.mag() < brightMag)
         brightMag = star.mag();
-    return &node;
+    return true;
 }
 
-StarNode *StarBlock::addStar(const deepStarData &data)
+bool StarBlock::addStar(const deepStarData &data)
 {
     if (isFull())
-        return 0;
+        return false;
     StarNode &node   = stars[nStars++];
     StarObject &star = node.star;
 
@@ -95,34 +141,235 @@ StarNode *StarBlock::addStar(const deepStarData &data)
         faintMag = star.mag();
     if (star.mag() < brightMag)
         brightMag = star.mag();
-    return &node;
+    return true;
 }
 #else
-StarObject *StarBlock::addStar(const starData &data)
+template <typename T>
+bool StarBlock::addRecord(const T &data)
 {
     if (isFull())
-        return 0;
-    StarObject &star = stars[nStars++];
+        return false;
 
-    star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
-    return &star;
+    if (recordSize != static_cast<int>(sizeof(T)))
+    {
+        // Blocks of the StarBlockFactory serve catalogs of either kind of record, but one block never mixes them
+        if (nStars > 0)
+            return false;
+        recordSize = sizeof(T);
+        records.resize(size() * recordSize);
+    }
+
+    memcpy(records.data() + nStars * recordSize, &data, sizeof(T));
+
+    float mag               = StarObject::magnitude(&data);
+    magnitudes[nStars]      = mag;
+    spectralClasses[nStars] = StarObject::spectralClass(&data);
+
+    // Until the star is first updated, its coordinates are the catalog ones, as after StarObject::init
+    ra[nStars]  = data.RA / 1000000.0;
+    dec[nStars] = data.Dec / 100000.0;
+    alt[nStars] = 0;
+    az[nStars]  = 0;
+
+    nStars++;
+
+    if (mag > faintMag)
+        faintMag = mag;
+    if (mag < brightMag)
+        brightMag = mag;
+    return true;
 }
 
-StarObject *StarBlock::addStar(const deepStarData &data)
+bool StarBlock::addStar(const starData &data)
 {
-    if (isFull())
-        return 0;
-    StarObject &star = stars[nStars++];
+    return addRecord(data);
+}
 
-    star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
-    return &star;
+bool StarBlock::addStar(const deepStarData &data)
+{
+    return addRecord(data);
+}
+
+void StarBlock::initStar(int i, StarObject *star) const
+{
+    if (recordSize == sizeof(starData))
+    {
+        starData data;
+        memcpy(&data, records.constData() + i * recordSize, sizeof(starData));
+        star->init(&data);
+    }
+    else
+    {
+        deepStarData data;
+        memcpy(&data, records.constData() + i * recordSize, sizeof(deepStarData));
+        star->init(&data);
+    }
+}
+
+QByteArray StarBlock::record(int i) const
+{
+    return records.mid(i * recordSize, recordSize);
+}
+
+void StarBlock::detachObjects()
+{
+    for (auto it = objects.constBegin(); it != objects.constEnd(); ++it)
+        detached.objects.insert(record(it.key()), it.value());
+
+    objects.clear();
+}
+
+StarObject *StarBlock::star(int i)
+{
+    StarObject *&object = objects[i];
+
+    if (!object)
+    {
+        // A star that was loaded before gets its StarObject back, so that pointers to it stay right
+        object = detached.objects.take(record(i));
+        if (!object)
+        {
+            object = new StarObject;
+            initStar(i, object);
+        }
+    }
+
+    if (object->updateID != KStarsData::Instance()->updateID())
+        object->JITupdate();
+
+    return object;
+}
+
+void StarBlock::equatorialCoords(int i, SkyPoint *point) const
+{
+    point->setRA(ra[i]);
+    point->setDec(dec[i]);
+}
+
+void StarBlock::horizontalCoords(int i, SkyPoint *point) const
+{
+    point->setAlt(alt[i]);
+    point->setAz(az[i]);
+}
+
+void StarBlock::toScreen(const Projector *proj, int count, float *x, float *y, quint8 *flags) const
+{
+    proj->toScreenBatch(count, ra.constData(), dec.constData(), alt.constData(), az.constData(), x, y, flags);
+}
+
+void StarBlock::catalogCoords(int first, int count, double *ra0, double *dec0, double *pmRA, double *pmDec) const
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const char *record = records.constData() + (first + i) * recordSize;
+
+        // Same scales as StarObject::init
+        if (recordSize == sizeof(starData))
+        {
+            starData data;
+            memcpy(&data, record, sizeof(starData));
+            ra0[i]   = data.RA / 1000000.0;
+            dec0[i]  = data.Dec / 100000.0;
+            pmRA[i]  = data.dRA / 10.0;
+            pmDec[i] = data.dDec / 10.0;
+        }
+        else
+        {
+            deepStarData data;
+            memcpy(&data, record, sizeof(deepStarData));
+            ra0[i]   = data.RA / 1000000.0;
+            dec0[i]  = data.Dec / 100000.0;
+            pmRA[i]  = data.dRA / 100.0;
+            pmDec[i] = data.dDec / 100.0;
+        }
+    }
+}
+
+void StarBlock::JITupdate(float maglim)
+{
+    static KStarsData *data = KStarsData::Instance();
+
+    SkyPoint point;
+
+    // Stars whose light passes close to the sun are bent, which only StarObject::updateCoords does
+    auto bendLight = [&](int first, int last) {
+        if (!Options::useRelativistic())
+            return;
+
+        StarObject star;
+
+        for (int i = first; i < last; ++i)
+        {
+            equatorialCoords(i, &point);
+            if (!point.checkBendLight())
+                continue;
+
+            initStar(i, &star);
+            star.updateCoords(data->updateNum());
+            ra[i]  = star.ra().Hours();
+            dec[i] = star.dec().Degrees();
+        }
+    };
+
+    // Stars are sorted by magnitude, those fainter than maglim are not drawn
+    int count = 0;
+    while (count < nStars && magnitudes[count] <= maglim)
+        count++;
+
+    if (updateNumID != data->updateNumID())
+    {
+        if (Options::alwaysRecomputeCoordinates() ||
+            std::abs(precessJD - data->updateNum()->getJD()) >= 0.00069444) // Update is once per solar minute
+        {
+            precessedCount = 0;
+            precessJD      = data->updateNum()->getJD();
+        }
+        else
+            bendLight(0, precessedCount);
+
+        horizontalCount = 0;
+        updateNumID     = data->updateNumID();
+    }
+
+    if (precessedCount < count)
+    {
+#ifdef PROFILE_UPDATECOORDS
+        std::clock_t start = std::clock();
+#endif
+        const int n = count - precessedCount;
+        QVector<double> catalog(4 * n);
+        double *ra0 = catalog.data(), *dec0 = ra0 + n, *pmRA = dec0 + n, *pmDec = pmRA + n;
+
+        catalogCoords(precessedCount, n, ra0, dec0, pmRA, pmDec);
+        ApparentPlace::fromCatalog(data->updateNum(), n, ra0, dec0, pmRA, pmDec, ra.data() + precessedCount,
+                                   dec.data() + precessedCount);
+        bendLight(precessedCount, count);
+#ifdef PROFILE_UPDATECOORDS
+        StarObject::batchUpdateCoordsCpuTime += double(std::clock() - start) / double(CLOCKS_PER_SEC);
+        StarObject::starsBatchUpdated += n;
+#endif
+        precessedCount = count;
+    }
+
+    if (updateID != data->updateID())
+    {
+        horizontalCount = 0;
+        updateID        = data->updateID();
+    }
+
+    if (horizontalCount < count)
+    {
+#ifdef PROFILE_UPDATECOORDS
+        std::clock_t start = std::clock();
+#endif
+        ApparentPlace::toHorizontal(data->lst(), data->geo()->lat(), count - horizontalCount,
+                                    ra.constData() + horizontalCount, dec.constData() + horizontalCount,
+                                    alt.data() + horizontalCount, az.data() + horizontalCount);
+#ifdef PROFILE_UPDATECOORDS
+        StarObject::batchHorizontalCpuTime += double(std::clock() - start) / double(CLOCKS_PER_SEC);
+        StarObject::starsBatchHorizontal += count - horizontalCount;
+#endif
+        horizontalCount = count;
+    }
 }
 #endif
@@ -21,11 +21,15 @@
 #include "typedef.h"
 #include "starblocklist.h"
 
+#include <QByteArray>
+#include <QHash>
 #include <QVector>
 
+class SkyPoint;
 class StarObject;
 class StarBlockList;
 class PointSourceNode;
+class Projector;
 struct starData;
 struct deepStarData;
 
@@ -46,6 +50,10 @@ struct StarNode
  *@class StarBlock
  *Holds a block of stars and various peripheral variables to mark its place in data structures
  *
+ *Except in KStars Lite, the stars are not kept as StarObjects. The block keeps the catalog records it was filled with,
+ *and packs what drawing needs (magnitude, spectral class, apparent and horizontal coordinates) into one array per
+ *quantity. A StarObject is only made for a star that is asked for with star(), when it is selected or queried.
+ *
  *@author  Akarsh Simha
  *@version 1.0
  */
@@ -53,11 +61,9 @@ struct StarNode
 class StarBlock
 {
   public:
-// StarBlockEntry is the data type held by the StarBlock's QVector
 #ifdef KSTARS_LITE
+    // StarBlockEntry is the data type held by the StarBlock's QVector
     typedef StarNode StarBlockEntry;
-#else
-    typedef StarObject StarBlockEntry;
 #endif
 
     /** Constructor
@@ -79,10 +85,10 @@ class StarBlock
          *  have names.
          *
          *@param  data    data to initialize star with.
-         *@return pointer to star initialized with data. nullptr if block is full.
+         *@return true if the star was added, false if block is full.
          */
-    StarBlockEntry *addStar(const starData &data);
-    StarBlockEntry *addStar(const deepStarData &data);
+    bool addStar(const starData &data);
+    bool addStar(const deepStarData &data);
 
     /**
          *@short Returns true if the StarBlock is full
@@ -100,8 +106,13 @@ class StarBlock
          *
          *@return The number of stars that this StarBlock can hold
          */
+#ifdef KSTARS_LITE
     inline int size() const { return stars.size(); }
+#else
+    inline int size() const { return magnitudes.size(); }
+#endif
 
+#ifdef KSTARS_LITE
     /**
          *@short  Return the i-th star in this StarBlock
          *
@@ -116,6 +127,51 @@ class StarBlock
          */
 
     inline QVector<StarBlockEntry> &contents() { return stars; }
+#else
+    /**
+         *@short  Return the i-th star in this StarBlock as a StarObject
+         *
+         *The StarObject is made the first time it is asked for, and updated to the current time and place. When the
+         *block is reset or deleted, the StarObject is detached rather than deleted, and the same one is returned if
+         *the star is loaded again. A pointer to it therefore stays valid and always points to this star.
+         *
+         *@param  Index of StarBlock to return
+         *@return A pointer to the i-th StarObject
+         */
+    StarObject *star(int i);
+
+    /** @return The magnitude of the i-th star */
+    inline float mag(int i) const { return magnitudes[i]; }
+
+    /** @return The first character of the spectral type of the i-th star */
+    inline char spchar(int i) const { return spectralClasses[i]; }
+
+    /**
+         *@short  Update the coordinates of the stars up to a magnitude to the current time and place
+         *
+         *This does what StarObject::JITupdate does for each star, for all the stars of the block that are brighter
+         *than maglim, in one batch through ApparentPlace. Apparent coordinates are only recomputed when the time
+         *changed, horizontal coordinates on every update. Blocks are independent, so that this can be called on
+         *several blocks concurrently.
+         */
+    void JITupdate(float maglim);
+
+    /** @short Set point to the apparent RA and Dec of the i-th star, as of the last JITupdate */
+    void equatorialCoords(int i, SkyPoint *point) const;
+
+    /** @short Set point to the altitude and azimuth of the i-th star, as of the last JITupdate */
+    void horizontalCoords(int i, SkyPoint *point) const;
+
+    /**
+         *@short  Project the first count stars, as of the last JITupdate, with Projector::toScreenBatch
+         *
+         *@param  proj    Projector of the sky map
+         *@param  count   Number of stars to project
+         *@param  x, y    Screen coordinates of the stars
+         *@param  flags   Projector::PointFlag values of the stars
+         */
+    void toScreen(const Projector *proj, int count, float *x, float *y, quint8 *flags) const;
+#endif
 
     // These methods are there because we might want to make faintMag and brightMag private at some point
     /**
@@ -157,8 +213,47 @@ class StarBlock
 
     /** Number of initialized stars in StarBlock. */
     int nStars;
+#ifdef KSTARS_LITE
     /** Array of stars. */
     QVector<StarBlockEntry> stars;
+#else
+    template <typename T>
+    bool addRecord(const T &data);
+
+    /** Initialize star with the catalog record of the i-th star */
+    void initStar(int i, StarObject *star) const;
+
+    /** @return The catalog record of the i-th star */
+    QByteArray record(int i) const;
+
+    /** Hand the StarObjects of this block over to the detached ones, see star() */
+    void detachObjects();
+
+    /** Fill arrays with the J2000 coordinates (RA in hours) and proper motions of count stars from first on */
+    void catalogCoords(int first, int count, double *ra0, double *dec0, double *pmRA, double *pmDec) const;
+
+    /** Catalog records of the stars, all either starData or deepStarData */
+    QByteArray records;
+    int recordSize;
+
+    QVector<float> magnitudes;
+    QVector<char> spectralClasses;
+
+    /** Apparent RA of the stars in hours, and their apparent Dec, altitude and azimuth in degrees */
+    QVector<double> ra, dec, alt, az;
+
+    /** The first precessedCount stars have apparent coordinates for precessJD */
+    UpdateID updateNumID;
+    double precessJD;
+    int precessedCount;
+
+    /** The first horizontalCount stars have horizontal coordinates for updateID */
+    UpdateID updateID;
+    int horizontalCount;
+
+    /** Stars that were asked for with star() */
+    QHash<int, StarObject *> objects;
+#endif
 };
 
 #endif
@@ -28,6 +28,8 @@
 
 #include <QDebug>
 
+#include <cstring>
+
 StarBlockList::StarBlockList(Trixel tr, DeepStarComponent *parent)
 {
     trixel       = tr;
@@ -84,14 +86,12 @@ bool StarBlockList::fillToMag(float maglim)
 {
     // TODO: Remove staticity of BinFileHelper
     BinFileHelper *dSReader;
-    StarBlockFactory *SBFactory;
     starData stardata;
     deepStarData deepstardata;
     FILE *dataFile;
 
-    dSReader  = parent->getStarReader();
-    dataFile  = dSReader->getFileHandle();
-    SBFactory = StarBlockFactory::Instance();
+    dSReader = parent->getStarReader();
+    dataFile = dSReader->getFileHandle();
 
     if (staticStars)
         return false;
@@ -113,7 +113,12 @@ bool StarBlockList::fillToMag(float maglim)
 
     Q_ASSERT(nBlocks == (unsigned int)blocks.size());
 
-    BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
+    // Records of the trixel in the memory mapped file, if any. They are indexed by nStars, as readOffset is.
+    const BinFileRecords<starData> shallowRecords = dSReader->getRecords<starData>(trixelId);
+    const BinFileRecords<deepStarData> deepRecords = dSReader->getRecords<deepStarData>(trixelId);
+
+    if (!shallowRecords.isValid() && !deepRecords.isValid())
+        BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
 
     /*
     qDebug() << "Reading trixel" << trixel << ", id on disk =" << trixelId << ", currently nStars =" << nStars
@@ -125,29 +130,16 @@ bool StarBlockList::fillToMag(float maglim)
     {
         int ret = 0;
 
-        if (nBlocks == 0 || blocks[nBlocks - 1]->isFull())
-        {
-            StarBlock *newBlock;
-            newBlock = SBFactory->getBlock();
-            if (!newBlock)
-            {
-                qWarning() << "ERROR: Could not get a new block from StarBlockFactory::getBlock() in trixel " << trixel
-                           << ", while trying to create block #" << nBlocks + 1 << endl;
-                return false;
-            }
-            blocks.append(newBlock);
-            blocks[nBlocks]->parent = this;
-            if (nBlocks == 0)
-                SBFactory->markFirst(blocks[0]);
-            else if (!SBFactory->markNext(blocks[nBlocks - 1], blocks[nBlocks]))
-                qWarning() << "ERROR: markNext() failed on block #" << nBlocks + 1 << "in trixel" << trixel;
-
-            ++nBlocks;
-        }
+        if (!reserveBlock())
+            return false;
+
         // TODO: Make this more general
         if (dSReader->guessRecordSize() == 32)
         {
-            ret = fread(&stardata, sizeof(starData), 1, dataFile);
+            if (shallowRecords.isValid())
+                stardata = shallowRecords.at(nStars);
+            else
+                ret = fread(&stardata, sizeof(starData), 1, dataFile);
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&stardata);
             readOffset += sizeof(starData);
@@ -155,7 +147,10 @@ bool StarBlockList::fillToMag(float maglim)
         }
         else
         {
-            ret = fread(&deepstardata, sizeof(deepStarData), 1, dataFile);
+            if (deepRecords.isValid())
+                deepstardata = deepRecords.at(nStars);
+            else
+                ret = fread(&deepstardata, sizeof(deepStarData), 1, dataFile);
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&deepstardata);
             readOffset += sizeof(deepStarData);
@@ -175,6 +170,72 @@ bool StarBlockList::fillToMag(float maglim)
     return ((maglim < faintMag) ? true : false);
 }
 
+bool StarBlockList::addRecords(const char *records, quint32 count)
+{
+    BinFileHelper *dSReader = parent->getStarReader();
+    int recordSize          = dSReader->guessRecordSize();
+    starData stardata;
+    deepStarData deepstardata;
+
+    if (staticStars)
+        return false;
+
+    if (readOffset <= 0)
+        readOffset = dSReader->getOffset(trixel);
+
+    for (quint32 i = 0; i < count; ++i, records += recordSize)
+    {
+        unsigned long loaded = nStars;
+
+        // The cache may recycle a block of this very list, after which the records no longer follow the last star
+        if (!reserveBlock() || nStars != loaded)
+            return false;
+
+        if (recordSize == 32)
+        {
+            memcpy(&stardata, records, sizeof(starData));
+            blocks[nBlocks - 1]->addStar(stardata);
+        }
+        else
+        {
+            memcpy(&deepstardata, records, sizeof(deepStarData));
+            blocks[nBlocks - 1]->addStar(deepstardata);
+        }
+
+        readOffset += recordSize;
+        faintMag = blocks[nBlocks - 1]->getFaintMag();
+        nStars++;
+    }
+
+    return true;
+}
+
+bool StarBlockList::reserveBlock()
+{
+    StarBlockFactory *SBFactory = StarBlockFactory::Instance();
+
+    if (nBlocks > 0 && !blocks[nBlocks - 1]->isFull())
+        return true;
+
+    StarBlock *newBlock;
+    newBlock = SBFactory->getBlock();
+    if (!newBlock)
+    {
+        qWarning() << "ERROR: Could not get a new block from StarBlockFactory::getBlock() in trixel " << trixel
+                   << ", while trying to create block #" << nBlocks + 1 << endl;
+        return false;
+    }
+    blocks.append(newBlock);
+    blocks[nBlocks]->parent = this;
+    if (nBlocks == 0)
+        SBFactory->markFirst(blocks[0]);
+    else if (!SBFactory->markNext(blocks[nBlocks - 1], blocks[nBlocks]))
+        qWarning() << "ERROR: markNext() failed on block #" << nBlocks + 1 << "in trixel" << trixel;
+
+    ++nBlocks;
+    return true;
+}
+
 void StarBlockList::setStaticBlock(StarBlock *block)
 {
     if (!block)
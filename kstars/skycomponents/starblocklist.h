@@ -58,6 +58,15 @@ class StarBlockList
      */
     bool fillToMag(float maglim);
 
+    /**
+     * @short Appends stars read ahead of time by StarBlockLoader
+     *
+     * @param records Star records following the last star loaded, in the byte order of the host
+     * @param count Number of records
+     * @return true on success, false if a StarBlock could not be allocated
+     */
+    bool addRecords(const char *records, quint32 count);
+
     /**
      * @short Sets the first StarBlock in the list to point to the given StarBlock
      *
@@ -114,6 +123,12 @@ class StarBlockList
     inline Trixel getTrixel() const { return trixel; }
 
   private:
+    /**
+     * @short Ensures that the last StarBlock in the list has room for one more star
+     * @return true on success, false if a StarBlock could not be allocated
+     */
+    bool reserveBlock();
+
     Trixel trixel;
     unsigned long nStars;
     long readOffset;
@@ -0,0 +1,207 @@
+/***************************************************************************
+                 starblockloader.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "starblockloader.h"
+
+#include "binfilehelper.h"
+#include "deepstarcomponent.h"
+#include "auxiliary/kspaths.h"
+#include "skyobjects/deepstardata.h"
+#include "skyobjects/stardata.h"
+#include "skyobjects/starobject.h"
+
+#include <QDebug>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+#include <cstring>
+
+// Number of records read from the file at once
+#define READ_BATCH 256
+
+namespace
+{
+// Magnitude of a record, as StarObject::init computes it
+float recordMagnitude(const char *record, int recordSize)
+{
+    if (recordSize == 32)
+    {
+        starData data;
+        memcpy(&data, record, sizeof(starData));
+        return StarObject::magnitude(&data);
+    }
+
+    deepStarData data;
+    memcpy(&data, record, sizeof(deepStarData));
+    return StarObject::magnitude(&data);
+}
+}
+
+StarBlockLoader::StarBlockLoader(const QString &fileName, const BinFileHelper *reader, int trixels,
+                                 std::function<void()> loaded)
+    : reader(reader), loaded(loaded), ready(trixels)
+{
+    QString filePath = KSPaths::locate(QStandardPaths::GenericDataLocation, fileName);
+
+    dataFile = fopen(filePath.toLatin1().constData(), "rb");
+    if (!dataFile)
+        qWarning() << "Could not open" << fileName << "to load stars in the background";
+
+    // A single reader, so that the file is read sequentially and the global pool stays free for drawing
+    pool.setMaxThreadCount(1);
+}
+
+StarBlockLoader::~StarBlockLoader()
+{
+    mutex.lock();
+    queue.clear();
+    mutex.unlock();
+
+    pool.waitForDone();
+
+    for (QAtomicPointer<Chunk> &chunk : ready)
+        delete chunk.fetchAndStoreOrdered(nullptr);
+
+    if (dataFile)
+        fclose(dataFile);
+}
+
+void StarBlockLoader::submit(const QList<Request> &requests)
+{
+    if (!dataFile)
+        return;
+
+    // Records read ahead for a view that is no longer expected would otherwise pile up
+    QVector<bool> requested(ready.size(), false);
+
+    for (const Request &request : requests)
+        requested[request.trixel] = true;
+
+    for (int i = 0; i < ready.size(); i++)
+    {
+        if (!requested[i] && ready[i].load())
+            delete ready[i].fetchAndStoreOrdered(nullptr);
+    }
+
+    QMutexLocker locker(&mutex);
+
+    queue = requests;
+
+    if (!running && !queue.isEmpty())
+    {
+        running = true;
+        QtConcurrent::run(&pool, [this]() { run(); });
+    }
+}
+
+StarBlockLoader::Chunk *StarBlockLoader::take(Trixel trixel)
+{
+    return ready[trixel].fetchAndStoreAcquire(nullptr);
+}
+
+void StarBlockLoader::run()
+{
+    bool loadedAny = false;
+
+    forever
+    {
+        Request request;
+
+        {
+            QMutexLocker locker(&mutex);
+            if (queue.isEmpty())
+            {
+                running = false;
+                break;
+            }
+            request = queue.takeFirst();
+        }
+
+        Chunk *chunk = read(request);
+        if (chunk)
+        {
+            // An older chunk of the same trixel was never taken, it is superseded by this one
+            delete ready[request.trixel].fetchAndStoreRelease(chunk);
+            loadedAny = true;
+        }
+    }
+
+    if (loadedAny && loaded)
+        loaded();
+}
+
+StarBlockLoader::Chunk *StarBlockLoader::read(const Request &request)
+{
+    const int recordSize = reader->guessRecordSize();
+    const quint32 total  = reader->getRecordCount(request.trixel);
+
+    if (request.firstRecord >= total || (recordSize != 16 && recordSize != 32))
+        return nullptr;
+
+    // Records of the memory mapped file are copied instead, it is only read here and never unmapped while loading
+    const char *mapped = nullptr;
+
+    if (recordSize == 32)
+        mapped = reader->getRecords<starData>(request.trixel).constData();
+    else
+        mapped = reader->getRecords<deepStarData>(request.trixel).constData();
+
+    quint32 offset = reader->getOffset(request.trixel) + request.firstRecord * recordSize;
+
+    if (!mapped && BinFileHelper::unsigned_KDE_fseek(dataFile, offset, SEEK_SET))
+        return nullptr;
+
+    Chunk *chunk       = new Chunk;
+    chunk->firstRecord = request.firstRecord;
+    chunk->count       = 0;
+
+    // Records are sorted by magnitude within a trixel, stop after the first batch that reaches maglim
+    while (request.firstRecord + chunk->count < total)
+    {
+        quint32 batch = qMin<quint32>(READ_BATCH, total - request.firstRecord - chunk->count);
+
+        chunk->records.resize((chunk->count + batch) * recordSize);
+        char *records = chunk->records.data() + chunk->count * recordSize;
+
+        if (mapped)
+            memcpy(records, mapped + (request.firstRecord + chunk->count) * recordSize, batch * recordSize);
+        else if (fread(records, recordSize, batch, dataFile) != batch)
+        {
+            qWarning() << "Could not read stars of trixel" << request.trixel << "in the background";
+            delete chunk;
+            return nullptr;
+        }
+
+        if (reader->getByteSwap())
+        {
+            for (quint32 i = 0; i < batch; i++)
+            {
+                if (recordSize == 32)
+                    DeepStarComponent::byteSwap(reinterpret_cast<starData *>(records + i * recordSize));
+                else
+                    DeepStarComponent::byteSwap(reinterpret_cast<deepStarData *>(records + i * recordSize));
+            }
+        }
+
+        chunk->count += batch;
+
+        if (recordMagnitude(records + (batch - 1) * recordSize, recordSize) > request.maglim)
+            break;
+    }
+
+    return chunk;
+}
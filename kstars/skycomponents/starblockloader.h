@@ -0,0 +1,108 @@
+/***************************************************************************
+                  starblockloader.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "typedef.h"
+
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <cstdio>
+#include <functional>
+
+class BinFileHelper;
+
+/**
+ * @class StarBlockLoader
+ * @short Reads star records of a deep star catalog ahead of time, on a background thread.
+ *
+ * DeepStarComponent queues the trixels it is about to draw, and those it expects to draw next. The loader reads their
+ * records with its own handle to the data file, so that the render thread never waits for the disk. Records that were
+ * read are handed back through one atomic slot per trixel, and turned into stars by StarBlockList::addRecords on the
+ * render thread, which owns the StarBlockFactory cache.
+ *
+ * @author agent
+ */
+class StarBlockLoader
+{
+  public:
+    /** Records of one trixel to read */
+    typedef struct
+    {
+        Trixel trixel;
+        quint32 firstRecord; // Index of the first record to read within the trixel
+        float maglim;        // Read until the first star fainter than this
+    } Request;
+
+    /** Records read for one trixel, in the byte order of the host */
+    typedef struct
+    {
+        quint32 firstRecord;
+        quint32 count;
+        QByteArray records;
+    } Chunk;
+
+    /**
+     * @param fileName Data file of the catalog
+     * @param reader Helper that read the header and index of the data file. Only its index is used.
+     * @param trixels Number of trixels in the mesh of the catalog
+     * @param loaded Called from the loader thread whenever a batch of requests has been read
+     */
+    StarBlockLoader(const QString &fileName, const BinFileHelper *reader, int trixels, std::function<void()> loaded);
+
+    /** Waits for the read in progress, if any, and discards all records that were not taken */
+    ~StarBlockLoader();
+
+    /** @return True if the data file could be opened */
+    bool isOpen() const { return dataFile != nullptr; }
+
+    /**
+     * @short Replace the queue of pending reads, most urgent first
+     *
+     * Requests that were queued earlier and not read yet are dropped, since they were made for a view that is gone.
+     */
+    void submit(const QList<Request> &requests);
+
+    /**
+     * @short Take the records read for a trixel, without locking
+     * @return The records, to be deleted by the caller, or nullptr if none are ready
+     */
+    Chunk *take(Trixel trixel);
+
+  private:
+    void run();
+    Chunk *read(const Request &request);
+
+    FILE *dataFile = nullptr;
+    const BinFileHelper *reader;
+    std::function<void()> loaded;
+
+    QVector<QAtomicPointer<Chunk>> ready;
+
+    // Requests not read yet, and whether the loader thread is running, guarded by mutex
+    QMutex mutex;
+    QList<Request> queue;
+    bool running = false;
+
+    QThreadPool pool;
+};
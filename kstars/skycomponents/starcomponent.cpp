@@ -21,6 +21,7 @@
 #include "deepstarcomponent.h"
 #include "kstarsdata.h"
 #include "kstarssplash.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabel.h"
 #include "skylabeler.h"
@@ -432,6 +433,9 @@ bool StarComponent::loadStaticData()
     QT_FSEEK(nameFile, nameReader.getDataOffset(), SEEK_SET);
     swapBytes = dataReader.getByteSwap();
 
+    // Star records are read from memory if possible, names are still read through nameFile
+    dataReader.mapFile();
+
     long int nstars = 0;
 
     //KDE_fseek(dataFile, dataReader.getDataOffset(), SEEK_SET);
@@ -461,9 +465,13 @@ bool StarComponent::loadStaticData()
     for (int i = 0; i < m_skyMesh->size(); ++i)
     {
         Trixel trixel = i; // = ( ( i >= 256 ) ? ( i - 256 ) : ( i + 256 ) );
+        const BinFileRecords<starData> records = dataReader.getRecords<starData>(i);
+
         for (unsigned long j = 0; j < (unsigned long)dataReader.getRecordCount(i); ++j)
         {
-            if (!fread(&stardata, sizeof(starData), 1, dataFile))
+            if (records.isValid())
+                stardata = records.at(j);
+            else if (!fread(&stardata, sizeof(starData), 1, dataFile))
             {
                 qDebug() << "FILE FORMAT ERROR: Could not read starData structure for star #" << j << " under trixel #"
                          << trixel << endl;
@@ -531,6 +539,7 @@ bool StarComponent::loadStaticData()
             {
                 objectNames(SkyObject::STAR).append(name);
                 objectLists(SkyObject::STAR).append(QPair<QString, const SkyObject *>(name, star));
+                nameIndex().add(name, star);
             }
 
             if (!visibleName.isEmpty() && gname != name)
@@ -538,8 +547,13 @@ bool StarComponent::loadStaticData()
                 QString gName = star->gname(false);
                 objectNames(SkyObject::STAR).append(gName);
                 objectLists(SkyObject::STAR).append(QPair<QString, const SkyObject *>(gName, star));
+                nameIndex().add(gName, star);
             }
 
+            // StarComponent::findByName() also finds stars by their abbreviated genetive name
+            if (gnamed)
+                nameIndex().addAlias(star->gname(false), star);
+
             m_ObjectList.append(star);
 
             m_starIndex->at(trixel)->append(star);
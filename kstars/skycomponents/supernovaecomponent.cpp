@@ -32,6 +32,7 @@
 
 #include "kstarsdata.h"
 #include "auxiliary/kspaths.h"
+#include "nameindex.h"
 
 SupernovaeComponent::SupernovaeComponent(SkyComposite *parent) : ListComponent(parent)
 {
@@ -69,6 +70,7 @@ void SupernovaeComponent::loadData()
 
     objectNames(SkyObject::SUPERNOVA).clear();
     objectLists(SkyObject::SUPERNOVA).clear();
+    nameIndex().removeType(SkyObject::SUPERNOVA);
 
     QString name, type, host, date, ra, de;
     float z, mag;
@@ -139,6 +141,7 @@ void SupernovaeComponent::loadData()
 
         m_ObjectList.append(sup);
         objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(name, sup));
+        nameIndex().add(name, sup);
     }
 }
 
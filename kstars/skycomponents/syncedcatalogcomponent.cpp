@@ -19,6 +19,7 @@
 #include "syncedcatalogcomponent.h"
 #include "kstarsdata.h"
 #include "deepskyobject.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "catalogdata.h"
 
@@ -101,13 +102,16 @@ DeepSkyObject *SyncedCatalogComponent::addObject(CatalogEntryData catalogEntry)
         //        newObj->setName( newObj->longname() );
         objectNames()[newObj->type()].append(newObj->longname());
         objectLists()[newObj->type()].append(QPair<QString, const SkyObject *>(newObj->longname(), newObj));
+        nameIndex().add(newObj->longname(), newObj);
     }
     else
     {
         qWarning() << "Created object with name " << newObj->name() << " which is probably fake!";
         objectNames()[newObj->type()].append(newObj->name());
         objectLists()[newObj->type()].append(QPair<QString, const SkyObject *>(newObj->name(), newObj));
+        nameIndex().add(newObj->name(), newObj);
     }
+    nameIndex().addAliases(newObj);
     m_ObjectList.append(newObj);
     qDebug() << "Added new SkyObject " << newObj->name() << " to synced catalog " << m_catName << " which now contains "
              << m_ObjectList.count() << " objects.";
@@ -148,6 +148,12 @@ bool SkyGLPainter::addItem(SkyPoint *p, int type, float width, char sp)
     if (!visible)
         return false;
 
+    addItem(vec, type, width, sp);
+    return true;
+}
+
+void SkyGLPainter::addItem(const Vector2f &vec, int type, float width, char sp)
+{
     // Prevent crash if type > UNKNOWN
     if (type > SkyObject::TYPE_UNKNOWN)
         type = SkyObject::TYPE_UNKNOWN;
@@ -244,7 +250,6 @@ bool SkyGLPainter::addItem(SkyPoint *p, int type, float width, char sp)
     }
 
     ++m_idx[type];
-    return true;
 }
 
 void SkyGLPainter::drawTexturedRectangle(const QImage &img, const Vector2f &pos, const float angle, const float sizeX,
@@ -413,6 +418,14 @@ bool SkyGLPainter::drawPointSource(SkyPoint *loc, float mag, char sp)
     return addItem(loc, SkyObject::STAR, starWidth(mag), sp);
 }
 
+bool SkyGLPainter::drawProjectedPointSource(const QPointF &pos, quint8 flags, float mag, char sp)
+{
+    if (!(flags & Projector::PointVisible))
+        return false;
+    addItem(Vector2f(pos.x(), pos.y()), SkyObject::STAR, starWidth(mag), sp);
+    return true;
+}
+
 void SkyGLPainter::drawSkyPolygon(LineList *list)
 {
     SkyList *points = list->points();
@@ -37,6 +37,7 @@ class SkyGLPainter : public SkyPainter
     bool drawPlanet(KSPlanetBase *planet) Q_DECL_OVERRIDE;
     bool drawDeepSkyObject(DeepSkyObject *obj, bool drawImage = false) Q_DECL_OVERRIDE;
     bool drawPointSource(SkyPoint *loc, float mag, char sp = 'A') Q_DECL_OVERRIDE;
+    bool drawProjectedPointSource(const QPointF &pos, quint8 flags, float mag, char sp = 'A') Q_DECL_OVERRIDE;
     void drawSkyPolygon(LineList *list, bool forceClip = true) Q_DECL_OVERRIDE;
     void drawSkyPolyline(LineList *list, SkipList *skipList = 0, LineListLabel *label = 0) Q_DECL_OVERRIDE;
     void drawSkyLine(SkyPoint *a, SkyPoint *b) Q_DECL_OVERRIDE;
@@ -55,6 +56,7 @@ class SkyGLPainter : public SkyPainter
 
   private:
     bool addItem(SkyPoint *p, int type, float width, char sp = 'a');
+    void addItem(const Vector2f &vec, int type, float width, char sp = 'a');
     void drawBuffer(int type);
     void drawPolygon(const QVector<Vector2f> &poly, bool convex = true, bool flush_buffers = true);
 
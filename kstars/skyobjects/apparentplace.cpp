@@ -0,0 +1,207 @@
+/***************************************************************************
+                apparentplace.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "apparentplace.h"
+
+#include "cachingdms.h"
+#include "ksnumbers.h"
+
+#include <cmath>
+
+namespace
+{
+// Stars carried through the stages together, few enough for the intermediate arrays to stay in the L1 cache
+const int BATCH = 256;
+
+// Below this declination, nutation is the first order approximation of SkyPoint::nutate
+const double NUTATION_APPROXIMATION_LIMIT = 80.0;
+
+// Sine and cosine of a + d from those of a, for d (in radian) small enough that the series is exact to double
+// precision. Nutation shifts stars by less than a few arcminutes.
+inline void addSmallAngle(double &sinA, double &cosA, double d)
+{
+    double d2   = d * d;
+    double sinD = d * (1.0 - d2 / 6.0 * (1.0 - d2 / 20.0));
+    double cosD = 1.0 - d2 / 2.0 * (1.0 - d2 / 12.0);
+    double sinS = sinA * cosD + cosA * sinD;
+
+    cosA = cosA * cosD - sinA * sinD;
+    sinA = sinS;
+}
+
+inline double reduceDegrees(double degrees)
+{
+    return degrees - 360.0 * floor(degrees / 360.0);
+}
+}
+
+namespace ApparentPlace
+{
+void fromCatalog(const KSNumbers *num, int count, const double *ra0, const double *dec0, const double *pmRA,
+                 const double *pmDec, double *ra, double *dec)
+{
+    const Eigen::Matrix3d &precessionMatrix = num->p2();
+    const double p00 = precessionMatrix(0, 0), p01 = precessionMatrix(0, 1), p02 = precessionMatrix(0, 2);
+    const double p10 = precessionMatrix(1, 0), p11 = precessionMatrix(1, 1), p12 = precessionMatrix(1, 2);
+    const double p20 = precessionMatrix(2, 0), p21 = precessionMatrix(2, 1), p22 = precessionMatrix(2, 2);
+
+    const double jm      = num->julianMillenia();
+    const double dEcLong = num->dEcLong();
+    const double dObliq  = num->dObliq();
+    const double K       = num->constAberr().Degrees();
+    const double e       = num->earthEccentricity();
+
+    double sinOb, cosOb, sinL, cosL, sinP, cosP;
+    num->obliquity()->SinCos(sinOb, cosOb);
+    num->sunTrueLongitude().SinCos(sinL, cosL);
+    num->earthPerihelionLongitude().SinCos(sinP, cosP);
+
+    const double sinDL = sin(dEcLong * dms::DegToRad), cosDL = cos(dEcLong * dms::DegToRad);
+    const double aberrL = e * cosP - cosL, aberrP = e * sinP - sinL;
+
+    double x[BATCH], y[BATCH], z[BATCH];
+
+    for (int first = 0; first < count; first += BATCH)
+    {
+        const int n = (count - first < BATCH) ? count - first : BATCH;
+
+        // Unit vectors of the catalog coordinates, moved by the proper motion along a great circle as
+        // StarObject::getIndexCoords does
+        for (int i = 0; i < n; ++i)
+        {
+            const int star     = first + i;
+            const double raRad = ra0[star] * 15.0 * dms::DegToRad, decRad = dec0[star] * dms::DegToRad;
+            const double sinRA = sin(raRad), cosRA = cos(raRad), sinDec = sin(decRad), cosDec = cos(decRad);
+
+            x[i] = cosRA * cosDec;
+            y[i] = sinRA * cosDec;
+            z[i] = sinDec;
+
+            const double weightedPmRA = cosDec * pmRA[star];
+            const double pmms         = weightedPmRA * weightedPmRA + pmDec[star] * pmDec[star];
+
+            // Also false for a NaN proper motion, which is ignored
+            if (pmms * jm * jm >= 1.)
+            {
+                double pm   = sqrt(pmms) * jm;
+                double dir0 = (pm > 0) ? atan2(pmRA[star], pmDec[star]) : atan2(-pmRA[star], -pmDec[star]);
+                double dst  = fabs(pm) * M_PI / (180.0 * 3600.0);
+
+                double sinDst = sin(dst), cosDst = cos(dst);
+                double north = cos(dir0) * sinDst, east = sin(dir0) * sinDst;
+
+                x[i] = x[i] * cosDst - north * sinDec * cosRA - east * sinRA;
+                y[i] = y[i] * cosDst - north * sinDec * sinRA + east * cosRA;
+                z[i] = z[i] * cosDst + north * cosDec;
+            }
+        }
+
+        // Precession, as in SkyPoint::precess
+        for (int i = 0; i < n; ++i)
+        {
+            const double sx = x[i], sy = y[i], sz = z[i];
+
+            x[i] = p00 * sx + p01 * sy + p02 * sz;
+            y[i] = p10 * sx + p11 * sy + p12 * sz;
+            z[i] = p20 * sx + p21 * sy + p22 * sz;
+        }
+
+        // Nutation and aberration, as in SkyPoint::nutate and SkyPoint::aberrate
+        for (int i = 0; i < n; ++i)
+        {
+            double vx = x[i], vy = y[i], vz = z[i];
+            double decDeg = asin(vz) / dms::DegToRad;
+
+            if (fabs(decDeg) >= NUTATION_APPROXIMATION_LIMIT)
+            {
+                // Rotate around the pole of the ecliptic by the nutation in longitude
+                double eclY = vy * cosOb + vz * sinOb, eclZ = vz * cosOb - vy * sinOb;
+                double eclX = vx * cosDL - eclY * sinDL;
+
+                eclY = vx * sinDL + eclY * cosDL;
+                vx   = eclX;
+                vy   = eclY * cosOb - eclZ * sinOb;
+                vz   = eclY * sinOb + eclZ * cosOb;
+
+                decDeg = asin(vz) / dms::DegToRad;
+            }
+
+            double r      = sqrt(vx * vx + vy * vy);
+            double sinRA  = vy / r, cosRA = vx / r;
+            double sinDec = vz, cosDec = sqrt(1 - vz * vz);
+            double raDeg  = reduceDegrees(atan2(vy, vx) / dms::DegToRad);
+
+            if (fabs(decDeg) < NUTATION_APPROXIMATION_LIMIT)
+            {
+                double tanDec = sinDec / cosDec;
+                double dRA    = dEcLong * (cosOb + sinOb * sinRA * tanDec) - dObliq * cosRA * tanDec;
+                double dDec   = dEcLong * (sinOb * cosRA) + dObliq * sinRA;
+
+                raDeg += dRA;
+                decDeg += dDec;
+                addSmallAngle(sinRA, cosRA, dRA * dms::DegToRad);
+                addSmallAngle(sinDec, cosDec, dDec * dms::DegToRad);
+            }
+
+            double dRA  = K * (cosRA * cosOb / cosDec) * aberrL;
+            double dDec = K * (sinRA * (sinOb * cosDec - cosOb * sinDec) * aberrL + cosRA * sinDec * aberrP);
+
+            ra[first + i]  = reduceDegrees(raDeg + dRA) / 15.0;
+            dec[first + i] = decDeg + dDec;
+        }
+    }
+}
+
+void toHorizontal(const CachingDms *LST, const CachingDms *lat, int count, const double *ra, const double *dec,
+                  double *alt, double *az)
+{
+    double sinLat, cosLat;
+    lat->SinCos(sinLat, cosLat);
+
+    const double lst = LST->Degrees();
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double haRad = (lst - ra[i] * 15.0) * dms::DegToRad, decRad = dec[i] * dms::DegToRad;
+        const double sinHA = sin(haRad), cosHA = cos(haRad), sinDec = sin(decRad), cosDec = cos(decRad);
+
+        double sinAlt = sinDec * sinLat + cosDec * cosLat * cosHA;
+        double altRad = asin(sinAlt);
+
+        // asin() is in [-pi/2, pi/2], where the cosine is never negative
+        double cosAlt = sqrt(1 - sinAlt * sinAlt);
+        if (cosAlt == 0)
+            cosAlt = cos(altRad);
+
+        double arg = (sinDec - sinLat * sinAlt) / (cosLat * cosAlt);
+        double azRad;
+
+        if (arg <= -1.0)
+            azRad = dms::PI;
+        else if (arg >= 1.0)
+            azRad = 0.0;
+        else
+            azRad = acos(arg);
+
+        if (sinHA > 0.0)
+            azRad = 2.0 * dms::PI - azRad; // resolve acos() ambiguity
+
+        alt[i] = altRad / dms::DegToRad;
+        az[i]  = azRad / dms::DegToRad;
+    }
+}
+}
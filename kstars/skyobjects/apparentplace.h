@@ -0,0 +1,67 @@
+/***************************************************************************
+                 apparentplace.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+class CachingDms;
+class KSNumbers;
+
+/**
+ * @namespace ApparentPlace
+ * @short Apparent and horizontal coordinates of many stars at once.
+ *
+ * These compute what StarObject::updateCoords and SkyPoint::EquatorialToHorizontal compute for one star, for arrays
+ * of stars that share the same KSNumbers, LST and latitude. Everything that only depends on the time is worked out
+ * once per call. Stars are then carried through proper motion, precession, nutation and aberration as unit vectors,
+ * in short loops over contiguous arrays that the compiler can vectorize, so that each star only needs the sine and
+ * cosine of its catalog coordinates, and one atan2 and asin to get back to angles.
+ *
+ * @author agent
+ */
+namespace ApparentPlace
+{
+/**
+ * @short Apply proper motion, precession, nutation and aberration to the J2000 coordinates of stars
+ *
+ * The result is the one of StarObject::updateCoords, except for the bending of light by the sun, which is only
+ * applied to stars close to it and is left to the caller.
+ *
+ * @param num Time to compute the coordinates for
+ * @param count Number of stars
+ * @param ra0 J2000 right ascensions, in hours
+ * @param dec0 J2000 declinations, in degrees
+ * @param pmRA Proper motions in right ascension, multiplied by cos(dec), in milliarcsec/year
+ * @param pmDec Proper motions in declination, in milliarcsec/year
+ * @param ra Apparent right ascensions, in hours, in the range [0, 24)
+ * @param dec Apparent declinations, in degrees
+ */
+void fromCatalog(const KSNumbers *num, int count, const double *ra0, const double *dec0, const double *pmRA,
+                 const double *pmDec, double *ra, double *dec);
+
+/**
+ * @short Convert apparent coordinates of stars to horizontal coordinates, as SkyPoint::EquatorialToHorizontal does
+ * @param LST Local sidereal time
+ * @param lat Latitude of the observer
+ * @param count Number of stars
+ * @param ra Right ascensions, in hours
+ * @param dec Declinations, in degrees
+ * @param alt Altitudes, in degrees
+ * @param az Azimuths, in degrees
+ */
+void toHorizontal(const CachingDms *LST, const CachingDms *lat, int count, const double *ra, const double *dec,
+                  double *alt, double *az);
+}
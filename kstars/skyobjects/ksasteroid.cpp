@@ -38,10 +38,45 @@ KSAsteroid *KSAsteroid::clone() const
 {
     Q_ASSERT(typeid(this) ==
              typeid(static_cast<const KSAsteroid *>(this))); // Ensure we are not slicing a derived class
-    return new KSAsteroid(*this);
+    KSAsteroid *copy = new KSAsteroid(*this);
+
+    // The copy does not stand for this body in the index of its component
+    copy->setIndex(nullptr);
+    return copy;
 }
 
 bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
+{
+    //Without the Earth, the Sun is at the origin and the position stays heliocentric
+    EclipticPosition earth;
+    if (Earth)
+        earth = EclipticPosition(Earth->ecLong(), Earth->ecLat(), Earth->rsun());
+
+    findEclipticPositions(num, earth, helEcPos, ep);
+
+    if (Earth)
+        setRearth(Earth);
+
+    EclipticToEquatorial(num->obliquity());
+    nutate(num);
+    aberrate(num);
+
+    return true;
+}
+
+bool KSAsteroid::computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                                 const EclipticPosition &Earth, Position &position) const
+{
+    findEclipticPositions(num, Earth, position.helEcPos, position.ep);
+    completePosition(num, lat, LST, Earth, physicalSize(), position);
+
+    position.mag = magnitude(position.ep.radius, position.rearth, position.phase * dms::DegToRad);
+
+    return true;
+}
+
+void KSAsteroid::findEclipticPositions(const KSNumbers *num, const EclipticPosition &Earth,
+                                       EclipticPosition &heliocentric, EclipticPosition &geocentric) const
 {
     //determine the mean anomaly for the desired date.  This is the mean anomaly for the
     //ephemeis epoch, plus the number of days between the desired date and ephemeris epoch,
@@ -94,52 +129,45 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     double ELongRad = atan2(yh, xh);
     double ELatRad  = atan2(zh, r);
 
-    helEcPos.longitude.setRadians(ELongRad);
-    helEcPos.latitude.setRadians(ELatRad);
-    setRsun(r);
+    heliocentric.longitude.setRadians(ELongRad);
+    heliocentric.latitude.setRadians(ELatRad);
+    geocentric.radius = r;
 
-    if (Earth)
-    {
-        //xe, ye, ze are the Earth's heliocentric cartesian coords
-        double cosBe, sinBe, cosLe, sinLe;
-        Earth->ecLong().SinCos(sinLe, cosLe);
-        Earth->ecLat().SinCos(sinBe, cosBe);
-
-        double xe = Earth->rsun() * cosBe * cosLe;
-        double ye = Earth->rsun() * cosBe * sinLe;
-        double ze = Earth->rsun() * sinBe;
-
-        //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
-        xh -= xe;
-        yh -= ye;
-        zh -= ze;
-    }
+    //xe, ye, ze are the Earth's heliocentric cartesian coords
+    double cosBe, sinBe, cosLe, sinLe;
+    Earth.longitude.SinCos(sinLe, cosLe);
+    Earth.latitude.SinCos(sinBe, cosBe);
+
+    double xe = Earth.radius * cosBe * cosLe;
+    double ye = Earth.radius * cosBe * sinLe;
+    double ze = Earth.radius * sinBe;
+
+    //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
+    xh -= xe;
+    yh -= ye;
+    zh -= ze;
 
     //the spherical geocentricecliptic coordinates:
     ELongRad  = atan2(yh, xh);
     double rr = sqrt(xh * xh + yh * yh + zh * zh);
     ELatRad   = atan2(zh, rr);
 
-    ep.longitude.setRadians(ELongRad);
-    ep.latitude.setRadians(ELatRad);
-    if (Earth)
-        setRearth(Earth);
-
-    EclipticToEquatorial(num->obliquity());
-    nutate(num);
-    aberrate(num);
-
-    return true;
+    geocentric.longitude.setRadians(ELongRad);
+    geocentric.latitude.setRadians(ELatRad);
 }
 
 void KSAsteroid::findMagnitude(const KSNumbers *)
 {
-    double param     = 5 * log10(rsun() * rearth());
-    double phase_rad = phase().radians();
-    double phi1      = exp(-3.33 * pow(tan(phase_rad / 2), 0.63));
-    double phi2      = exp(-1.87 * pow(tan(phase_rad / 2), 1.22));
+    setMag(magnitude(rsun(), rearth(), phase().radians()));
+}
+
+double KSAsteroid::magnitude(double rsun, double rearth, double phase) const
+{
+    double param = 5 * log10(rsun * rearth);
+    double phi1  = exp(-3.33 * pow(tan(phase / 2), 0.63));
+    double phi2  = exp(-1.87 * pow(tan(phase / 2), 1.22));
 
-    setMag(H + param - 2.5 * log((1 - G) * phi1 + G * phi2));
+    return H + param - 2.5 * log((1 - G) * phi1 + G * phi2);
 }
 
 void KSAsteroid::setPerihelion(double perihelion)
@@ -75,6 +75,12 @@ class KSAsteroid : public KSPlanetBase
         	*/
     bool loadData() Q_DECL_OVERRIDE;
 
+    /** Compute the position of the asteroid without changing it.
+        	*@note reimplemented from KSPlanetBase
+        	*/
+    bool computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                         const EclipticPosition &Earth, Position &position) const Q_DECL_OVERRIDE;
+
     /** This lets other classes like KSPlanetBase access H and G values
         *Used by KSPlanetBase::FindMagnitude
         */
@@ -203,6 +209,15 @@ class KSAsteroid : public KSPlanetBase
   private:
     void findMagnitude(const KSNumbers *) Q_DECL_OVERRIDE;
 
+    /** Find the heliocentric and geocentric ecliptic positions of the asteroid, the latter with its distance from the
+        	*Sun. The geocentric position is heliocentric if the distance of Earth from the Sun is 0.
+        	*/
+    void findEclipticPositions(const KSNumbers *num, const EclipticPosition &Earth, EclipticPosition &heliocentric,
+                               EclipticPosition &geocentric) const;
+
+    /** @return the magnitude of the asteroid at these distances in AU, and phase angle in radians */
+    double magnitude(double rsun, double rearth, double phase) const;
+
     int catN;
     long double JD;
     double q, a, e, P, EarthMOID;
@@ -144,7 +144,11 @@ KSComet::KSComet(const QString &_s, const QString &imfile, long double _JD, doub
 KSComet *KSComet::clone() const
 {
     Q_ASSERT(typeid(this) == typeid(static_cast<const KSComet *>(this))); // Ensure we are not slicing a derived class
-    return new KSComet(*this);
+    KSComet *copy = new KSComet(*this);
+
+    // The copy does not stand for this body in the index of its component
+    copy->setIndex(nullptr);
+    return copy;
 }
 
 void KSComet::findPhysicalParameters()
@@ -153,32 +157,77 @@ void KSComet::findPhysicalParameters()
     // References:
     // * http://www.projectpluto.com/update7b.htm#comet_tail_formula [Project Pluto / GUIDE]
     // * http://articles.adsabs.harvard.edu//full/1978BAICz..29..103K/0000113.000.html [Kresak, 1978a, "Passages of comets and asteroids near the earth"]
-    NuclearSize   = pow(10, 2.1 - 0.2 * M1);
-    double mHelio = M1 + K1 * log10(rsun());
+    NuclearSize = pow(10, 2.1 - 0.2 * M1);
+    estimateSizes(rsun(), TailSize, ComaSize);
+    setPhysicalSize(ComaSize);
+}
+
+void KSComet::estimateSizes(double rsun, double &tailSize, double &comaSize) const
+{
+    double mHelio = M1 + K1 * log10(rsun);
     double L0, D0, L, D;
     L0       = pow(10, -0.0075 * mHelio * mHelio - 0.19 * mHelio + 2.10);
     D0       = pow(10, -0.0033 * mHelio * mHelio - 0.07 * mHelio + 3.25);
-    L        = L0 * (1 - pow(10, -4 * rsun())) * (1 - pow(10, -2 * rsun()));
-    D        = D0 * (1 - pow(10, -2 * rsun())) * (1 - pow(10, -rsun()));
-    TailSize = L * 1e6;
-    ComaSize = D * 1e3;
-    setPhysicalSize(ComaSize);
+    L        = L0 * (1 - pow(10, -4 * rsun)) * (1 - pow(10, -2 * rsun));
+    D        = D0 * (1 - pow(10, -2 * rsun)) * (1 - pow(10, -rsun));
+    tailSize = L * 1e6;
+    comaSize = D * 1e3;
 }
 
 bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
+{
+    lastPrecessJD = num->julianDay();
+
+    findEclipticPositions(num, EclipticPosition(Earth->ecLong(), Earth->ecLat(), Earth->rsun()), helEcPos, ep);
+    setRearth(Earth);
+
+    EclipticToEquatorial(num->obliquity());
+    nutate(num);
+    aberrate(num);
+
+    findPhysicalParameters();
+
+    return true;
+}
+
+bool KSComet::computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                              const EclipticPosition &Earth, Position &position) const
+{
+    double tailSize, comaSize;
+
+    findEclipticPositions(num, Earth, position.helEcPos, position.ep);
+    estimateSizes(position.ep.radius, tailSize, comaSize);
+    completePosition(num, lat, LST, Earth, comaSize, position);
+
+    position.mag = magnitude(position.ep.radius, position.rearth);
+
+    return true;
+}
+
+void KSComet::setPosition(const Position &position)
+{
+    KSPlanetBase::setPosition(position);
+
+    findPhysicalParameters();
+    // Apparent size of the coma as projected on the celestial sphere, as findPosition() does
+    setComaAngSize(angSize() * fabs(sin(phase().radians())));
+}
+
+void KSComet::findEclipticPositions(const KSNumbers *num, const EclipticPosition &Earth,
+                                    EclipticPosition &heliocentric, EclipticPosition &geocentric) const
 {
     double v(0.0), r(0.0);
 
-    lastPrecessJD = num->julianDay();
+    double jd = num->julianDay();
 
     //Precess the longitude of the Ascending Node to the desired epoch:
-    dms n = dms(double(N.Degrees() - 3.82394E-5 * (lastPrecessJD - J2000))).reduce();
+    dms n = dms(double(N.Degrees() - 3.82394E-5 * (jd - J2000))).reduce();
 
     if (e > 0.98)
     {
         //Use near-parabolic approximation
         double k = 0.01720209895; //Gauss gravitational constant
-        double a = 0.75 * (lastPrecessJD - JDp) * k * sqrt((1 + e) / (q * q * q));
+        double a = 0.75 * (jd - JDp) * k * sqrt((1 + e) / (q * q * q));
         double b = sqrt(1.0 + a * a);
         double W = pow((b + a), 1.0 / 3.0) - pow((b - a), 1.0 / 3.0);
         double c = 1.0 + 1.0 / (W * W);
@@ -197,7 +246,7 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     {
         //Use normal ellipse method
         //Determine Mean anomaly for desired date:
-        dms m = dms(double(360.0 * (lastPrecessJD - JDp) / P)).reduce();
+        dms m = dms(double(360.0 * (jd - JDp) / P)).reduce();
         double sinm, cosm;
         m.SinCos(sinm, cosm);
 
@@ -246,18 +295,18 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     double ELongRad = atan2(yh, xh);
     double ELatRad  = atan2(zh, r);
 
-    helEcPos.longitude.setRadians(ELongRad);
-    helEcPos.latitude.setRadians(ELatRad);
-    setRsun(r);
+    heliocentric.longitude.setRadians(ELongRad);
+    heliocentric.latitude.setRadians(ELatRad);
+    geocentric.radius = r;
 
     //xe, ye, ze are the Earth's heliocentric cartesian coords
     double cosBe, sinBe, cosLe, sinLe;
-    Earth->ecLong().SinCos(sinLe, cosLe);
-    Earth->ecLat().SinCos(sinBe, cosBe);
+    Earth.longitude.SinCos(sinLe, cosLe);
+    Earth.latitude.SinCos(sinBe, cosBe);
 
-    double xe = Earth->rsun() * cosBe * cosLe;
-    double ye = Earth->rsun() * cosBe * sinLe;
-    double ze = Earth->rsun() * sinBe;
+    double xe = Earth.radius * cosBe * cosLe;
+    double ye = Earth.radius * cosBe * sinLe;
+    double ze = Earth.radius * sinBe;
 
     //convert to geocentric ecliptic coordinates by subtracting Earth's coords:
     xh -= xe;
@@ -269,23 +318,19 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     double rr = sqrt(xh * xh + yh * yh);
     ELatRad   = atan2(zh, rr);
 
-    ep.longitude.setRadians(ELongRad);
-    ep.latitude.setRadians(ELatRad);
-    setRearth(Earth);
-
-    EclipticToEquatorial(num->obliquity());
-    nutate(num);
-    aberrate(num);
-
-    findPhysicalParameters();
+    geocentric.longitude.setRadians(ELongRad);
+    geocentric.latitude.setRadians(ELatRad);
+}
 
-    return true;
+void KSComet::findMagnitude(const KSNumbers *)
+{
+    setMag(magnitude(rsun(), rearth()));
 }
 
 //T-mag =  M1 + 5*log10(delta) + k1*log10(r)
-void KSComet::findMagnitude(const KSNumbers *)
+double KSComet::magnitude(double rsun, double rearth) const
 {
-    setMag(M1 + 5.0 * log10(rearth()) + K1 * log10(rsun()));
+    return M1 + 5.0 * log10(rearth) + K1 * log10(rsun);
 }
 
 void KSComet::setEarthMOID(double earth_moid)
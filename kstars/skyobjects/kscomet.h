@@ -79,6 +79,17 @@ class KSComet : public KSPlanetBase
             */
     bool loadData() Q_DECL_OVERRIDE;
 
+    /** Compute the position of the comet without changing it.
+            *@note reimplemented from KSPlanetBase
+            */
+    bool computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                         const EclipticPosition &Earth, Position &position) const Q_DECL_OVERRIDE;
+
+    /** Move the comet to a computed position, and estimate its size there.
+            *@note reimplemented from KSPlanetBase
+            */
+    void setPosition(const Position &position) Q_DECL_OVERRIDE;
+
     /**
          *@short Returns the Julian Day of Perihelion passage
          *@return Julian Day of Perihelion Passage
@@ -244,6 +255,17 @@ class KSComet : public KSPlanetBase
   private:
     void findMagnitude(const KSNumbers *) Q_DECL_OVERRIDE;
 
+    /** Find the heliocentric and geocentric ecliptic positions of the comet, the latter with its distance from the Sun.
+            */
+    void findEclipticPositions(const KSNumbers *num, const EclipticPosition &Earth, EclipticPosition &heliocentric,
+                               EclipticPosition &geocentric) const;
+
+    /** Estimate the sizes of the tail and coma, in km, at a distance rsun from the Sun in AU */
+    void estimateSizes(double rsun, double &tailSize, double &comaSize) const;
+
+    /** @return the total magnitude of the comet at these distances in AU */
+    double magnitude(double rsun, double rearth) const;
+
     long double JD, JDp;
     double q, e, a, P, EarthMOID;
     double TailSize, ComaAngSize, ComaSize, NuclearSize; // All in kilometres
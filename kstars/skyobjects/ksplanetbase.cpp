@@ -35,9 +35,87 @@
 #include "ksplanet.h"
 #include "kssun.h"
 #include "ksmoon.h"
+#include "skycomponents/movingobjectindex.h"
 #include "skycomponents/skymapcomposite.h"
 #include "texturemanager.h"
 
+namespace
+{
+// Distance between a body and the Earth, in AU, from their heliocentric ecliptic positions
+double distance(const dms &helEcLong, const dms &helEcLat, double rsun, const EclipticPosition &Earth)
+{
+    double sinL, sinB, sinL0, sinB0;
+    double cosL, cosB, cosL0, cosB0;
+    double x, y, z;
+
+    Earth.longitude.SinCos(sinL0, cosL0);
+    Earth.latitude.SinCos(sinB0, cosB0);
+    double eX = Earth.radius * cosB0 * cosL0;
+    double eY = Earth.radius * cosB0 * sinL0;
+    double eZ = Earth.radius * sinB0;
+
+    helEcLong.SinCos(sinL, cosL);
+    helEcLat.SinCos(sinB, cosB);
+    x = rsun * cosB * cosL - eX;
+    y = rsun * cosB * sinL - eY;
+    z = rsun * sinB - eZ;
+
+    return sqrt(x * x + y * y + z * z);
+}
+
+// Phase angle of a body, in degrees, from its distances to the Sun and the Earth
+double phaseAngle(double rsun, double rearth, double earthSun)
+{
+    double cosPhase = (rsun * rearth == 0 ? 0 : (rsun * rsun + rearth * rearth - earthSun * earthSun)
+                      / (2 * rsun * rearth));
+
+    return acos(cosPhase) * 180.0 / dms::PI;
+}
+
+// Topocentric coordinates of point, seen from lat at LST, from its geocentric coordinates
+void localize(SkyPoint &point, double rearth, const CachingDms *lat, const CachingDms *LST)
+{
+    dms HA, HA2; //Hour Angle, before and after correction
+    double rsinp, rcosp, u, sinHA, cosHA, sinDec, cosDec, D;
+    double cosHA2;
+    double r = rearth * AU_KM; //distance from Earth, in km
+    u        = atan(0.996647 * tan(lat->radians()));
+    rsinp    = 0.996647 * sin(u);
+    rcosp    = cos(u);
+    HA.setD(LST->Degrees() - point.ra().Degrees());
+    HA.SinCos(sinHA, cosHA);
+    point.dec().SinCos(sinDec, cosDec);
+
+    D = atan2(rcosp * sinHA, r * cosDec / 6378.14 - rcosp * cosHA);
+    dms temp;
+    temp.setRadians(point.ra().radians() - D);
+    point.setRA(temp);
+
+    HA2.setD(LST->Degrees() - point.ra().Degrees());
+    cosHA2 = cos(HA2.radians());
+
+    //temp.setRadians( atan2( cosHA2*( r*sinDec/6378.14 - rsinp ), r*cosDec*cosHA/6378.14 - rcosp ) );
+    // The atan2() version above makes the planets move crazy in the htm branch -jbb
+    temp.setRadians(atan(cosHA2 * (r * sinDec / 6378.14 - rsinp) / (r * cosDec * cosHA / 6378.14 - rcosp)));
+
+    point.setDec(temp);
+
+    //Make sure Dec is between -90 and +90
+    if (point.dec().Degrees() > 90.0)
+    {
+        point.setDec(180.0 - point.dec().Degrees());
+        point.setRA(point.ra().Hours() + 12.0);
+        point.ra().reduce();
+    }
+    if (point.dec().Degrees() < -90.0)
+    {
+        point.setDec(180.0 + point.dec().Degrees());
+        point.setRA(point.ra().Hours() + 12.0);
+        point.ra().reduce();
+    }
+}
+}
+
 QVector<QColor> KSPlanetBase::planetColor = QVector<QColor>() << QColor("slateblue") << //Mercury
                                             QColor("lightgreen") <<                     //Venus
                                             QColor("red") <<                            //Mars
@@ -123,6 +201,7 @@ void KSPlanetBase::updateCoords(const KSNumbers *num, bool includePlanets, const
         else
         {
             findGeocentricPosition(num, kd->skyComposite()->earth());
+            reindex();
         }
     }
 }
@@ -132,7 +211,12 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
 {
     // DEBUG edit
     findGeocentricPosition(num, Earth); //private function, reimplemented in each subclass
-    findPhase();
+
+    // The phase is seen from the Earth the position is found for, as computePosition() sees it
+    if (Earth)
+        Phase = phaseAngle(rsun(), rearth(), Earth->rsun());
+    else
+        findPhase();
     setAngularSize(asin(physicalSize() / Rearth / AU_KM) * 60. * 180. / dms::PI); //angular size in arcmin
 
     if (lat && LST)
@@ -158,6 +242,54 @@ void KSPlanetBase::findPosition(const KSNumbers *num, const CachingDms *lat, con
         // Find the apparent length as projected on the celestial sphere (the comet's tail points away from the sun)
         me->setComaAngSize(comaAngSize * fabs(sin(phase().radians())));
     }
+
+    reindex();
+}
+
+bool KSPlanetBase::computePosition(const KSNumbers *, const CachingDms *, const CachingDms *,
+                                   const EclipticPosition &, Position &) const
+{
+    return false;
+}
+
+void KSPlanetBase::completePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                                    const EclipticPosition &Earth, double physicalSize, Position &position) const
+{
+    position.coords.setFromEcliptic(num->obliquity(), position.ep.longitude, position.ep.latitude);
+    position.coords.nutate(num);
+    position.coords.aberrate(num);
+
+    position.rearth      = distance(position.helEcPos.longitude, position.helEcPos.latitude, position.ep.radius, Earth);
+    position.phase       = phaseAngle(position.ep.radius, position.rearth, Earth.radius);
+    position.angularSize = asin(physicalSize / position.rearth / AU_KM) * 60. * 180. / dms::PI; //angular size in arcmin
+
+    if (lat && LST)
+    {
+        //correct for figure-of-the-Earth
+        localize(position.coords, position.rearth, lat, LST);
+        position.coords.findEcliptic(num->obliquity(), position.ep.longitude, position.ep.latitude);
+    }
+}
+
+void KSPlanetBase::setPosition(const Position &position)
+{
+    ep          = position.ep;
+    helEcPos    = position.helEcPos;
+    Rearth      = position.rearth;
+    Phase       = position.phase;
+    AngularSize = position.angularSize;
+
+    setRA(position.coords.ra());
+    setDec(position.coords.dec());
+    setMag(position.mag);
+
+    reindex();
+}
+
+void KSPlanetBase::reindex()
+{
+    if (Index)
+        Index->update(this);
 }
 
 bool KSPlanetBase::isMajorPlanet() const
@@ -171,54 +303,13 @@ bool KSPlanetBase::isMajorPlanet() const
 void KSPlanetBase::localizeCoords(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST)
 {
     //convert geocentric coordinates to local apparent coordinates (topocentric coordinates)
-    dms HA, HA2; //Hour Angle, before and after correction
-    double rsinp, rcosp, u, sinHA, cosHA, sinDec, cosDec, D;
-    double cosHA2;
-    double r = Rearth * AU_KM; //distance from Earth, in km
-    u        = atan(0.996647 * tan(lat->radians()));
-    rsinp    = 0.996647 * sin(u);
-    rcosp    = cos(u);
-    HA.setD(LST->Degrees() - ra().Degrees());
-    HA.SinCos(sinHA, cosHA);
-    dec().SinCos(sinDec, cosDec);
-
-    D = atan2(rcosp * sinHA, r * cosDec / 6378.14 - rcosp * cosHA);
-    dms temp;
-    temp.setRadians(ra().radians() - D);
-    setRA(temp);
-
-    HA2.setD(LST->Degrees() - ra().Degrees());
-    cosHA2 = cos(HA2.radians());
-
-    //temp.setRadians( atan2( cosHA2*( r*sinDec/6378.14 - rsinp ), r*cosDec*cosHA/6378.14 - rcosp ) );
-    // The atan2() version above makes the planets move crazy in the htm branch -jbb
-    temp.setRadians(atan(cosHA2 * (r * sinDec / 6378.14 - rsinp) / (r * cosDec * cosHA / 6378.14 - rcosp)));
-
-    setDec(temp);
-
-    //Make sure Dec is between -90 and +90
-    if (dec().Degrees() > 90.0)
-    {
-        setDec(180.0 - dec().Degrees());
-        setRA(ra().Hours() + 12.0);
-        ra().reduce();
-    }
-    if (dec().Degrees() < -90.0)
-    {
-        setDec(180.0 + dec().Degrees());
-        setRA(ra().Hours() + 12.0);
-        ra().reduce();
-    }
+    localize(*this, Rearth, lat, LST);
 
     EquatorialToEcliptic(num->obliquity());
 }
 
 void KSPlanetBase::setRearth(const KSPlanetBase *Earth)
 {
-    double sinL, sinB, sinL0, sinB0;
-    double cosL, cosB, cosL0, cosB0;
-    double x, y, z;
-
     //The Moon's Rearth is set in its findGeocentricPosition()...
     if (name() == "Moon")
     {
@@ -238,19 +329,8 @@ void KSPlanetBase::setRearth(const KSPlanetBase *Earth)
         return;
     }
 
-    Earth->ecLong().SinCos(sinL0, cosL0);
-    Earth->ecLat().SinCos(sinB0, cosB0);
-    double eX = Earth->rsun() * cosB0 * cosL0;
-    double eY = Earth->rsun() * cosB0 * sinL0;
-    double eZ = Earth->rsun() * sinB0;
-
-    helEcLong().SinCos(sinL, cosL);
-    helEcLat().SinCos(sinB, cosB);
-    x = rsun() * cosB * cosL - eX;
-    y = rsun() * cosB * sinL - eY;
-    z = rsun() * sinB - eZ;
-
-    Rearth = sqrt(x * x + y * y + z * z);
+    Rearth = distance(helEcLong(), helEcLat(), rsun(),
+                      EclipticPosition(Earth->ecLong(), Earth->ecLat(), Earth->rsun()));
 
     //Set angular size, in arcmin
     AngularSize = asin(PhysicalSize / Rearth / AU_KM) * 60. * 180. / dms::PI;
@@ -302,10 +382,8 @@ void KSPlanetBase::findPhase()
 {
     /* Compute the phase of the planet in degrees */
     double earthSun = KStarsData::Instance()->skyComposite()->earth()->rsun();
-    double cosPhase = (rsun()*rearth() == 0 ? 0 : (rsun()*rsun() + rearth()*rearth() - earthSun*earthSun)
-                      / (2 * rsun() * rearth() ));
 
-    Phase           = acos(cosPhase) * 180.0 / dms::PI;
+    Phase = phaseAngle(rsun(), rearth(), earthSun);
     /* More elegant way of doing it, but requires the Sun.
        TODO: Switch to this if and when we make KSSun a singleton */
     //    Phase = ecLong()->Degrees() - Sun->ecLong()->Degrees();
@@ -27,6 +27,7 @@
 #include "trailobject.h"
 
 class KSNumbers;
+class MovingObjectIndex;
 
 /**
  *@class EclipticPosition
@@ -173,6 +174,47 @@ class KSPlanetBase : public TrailObject
     void findPosition(const KSNumbers *num, const CachingDms *lat = 0, const CachingDms *LST = 0,
                       const KSPlanetBase *Earth = 0);
 
+    /**
+     *@struct Position
+     *@short The position of a body at some date, computed apart from the body.
+     *
+     *Positions are computed by computePosition() without changing the body, so that the positions
+     *of many bodies can be computed on a worker thread while the sky map keeps drawing them, then
+     *moved into the bodies at once by setPosition().
+     */
+    struct Position
+    {
+        EclipticPosition ep;       // Geocentric ecliptic position, but distance to the Sun
+        EclipticPosition helEcPos; // Heliocentric ecliptic position
+        SkyPoint coords;           // Apparent equatorial coordinates
+        double rearth;
+        double phase;
+        double angularSize;
+        float mag;
+    };
+
+    /** @short Compute the position of the body like findPosition() does, without changing the body.
+         * Only the bodies whose orbit is computed from orbital elements support it; the default
+         * implementation returns false, and the others must be moved with findPosition().
+         * @note The trail of the body is not extended.
+         * @param num KSNumbers pointer for the target date/time
+         * @param lat pointer to the geographic latitude; if nullptr, we skip the figure-of-the-Earth correction
+         * @param LST pointer to the local sidereal time; if nullptr, we skip the figure-of-the-Earth correction
+         * @param Earth heliocentric ecliptic position of the Earth at the target date/time
+         * @param position the computed position
+         * @return true if the position was computed.
+         */
+    virtual bool computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                                 const EclipticPosition &Earth, Position &position) const;
+
+    /** @short Move the body to a position computed by computePosition(). */
+    virtual void setPosition(const Position &position);
+
+    /** @short Keep the body in index at its new position whenever it moves, or in no index if index is nullptr.
+         * The body must then only be moved on the thread that owns the index. Copies of the body are not indexed.
+         */
+    void setIndex(MovingObjectIndex *index) { Index = index; }
+
     /** @return the Planet's position angle. */
     double pa() const Q_DECL_OVERRIDE { return PositionAngle; }
 
@@ -248,6 +290,13 @@ class KSPlanetBase : public TrailObject
     /** Determine the phase of the planet. */
     virtual void findPhase();
 
+    /** @short Complete a position whose ecliptic coordinates are known with its equatorial
+         * coordinates, distance from Earth, phase and angular size (used by computePosition()).
+         * @param physicalSize the size of the body at the target date/time, in km
+         */
+    void completePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                          const EclipticPosition &Earth, double physicalSize, Position &position) const;
+
     // Geocentric ecliptic position, but distance to the Sun
     EclipticPosition ep;
 
@@ -270,7 +319,11 @@ class KSPlanetBase : public TrailObject
          */
     void localizeCoords(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST);
 
+    /** @short Move the body to its trixel in its index, if it has one, after its coordinates changed */
+    void reindex();
+
     double PositionAngle, AngularSize, PhysicalSize;
+    MovingObjectIndex *Index = nullptr;
     QColor m_Color;
 };
 
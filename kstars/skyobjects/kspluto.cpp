@@ -66,6 +66,12 @@ KSPluto::~KSPluto()
 {
 }
 
+bool KSPluto::computePosition(const KSNumbers *, const CachingDms *, const CachingDms *, const EclipticPosition &,
+                              Position &) const
+{
+    return false;
+}
+
 //Determine values for the orbital elements for the requested JD, then
 //call KSAsteroid::findGeocentricPosition()
 bool KSPluto::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
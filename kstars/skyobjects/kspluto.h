@@ -56,6 +56,12 @@ class KSPluto : public KSAsteroid
     /**Destructor (empty) */
     virtual ~KSPluto();
 
+    /** Pluto's orbital elements change with the date, so its position is only found by findPosition().
+        	*@return false
+        	*/
+    bool computePosition(const KSNumbers *num, const CachingDms *lat, const CachingDms *LST,
+                         const EclipticPosition &Earth, Position &position) const Q_DECL_OVERRIDE;
+
   protected:
     /** A custom findPosition() function for Pluto.  Computes the values of the
         	*orbital elements on the requested date, and calls KSAsteroid::findGeocentricPosition()
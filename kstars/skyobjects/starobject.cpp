@@ -37,8 +37,12 @@
 #include "ksutils.h"
 
 #ifdef PROFILE_UPDATECOORDS
-double StarObject::updateCoordsCpuTime = 0.;
-unsigned int StarObject::starsUpdated  = 0;
+double StarObject::updateCoordsCpuTime        = 0.;
+unsigned int StarObject::starsUpdated         = 0;
+double StarObject::batchUpdateCoordsCpuTime   = 0.;
+unsigned int StarObject::starsBatchUpdated    = 0;
+double StarObject::batchHorizontalCpuTime     = 0.;
+unsigned int StarObject::starsBatchHorizontal = 0;
 #include <cstdlib>
 #include <ctime>
 #endif
@@ -150,7 +154,7 @@ void StarObject::init(const starData *stardata)
     ra  = stardata->RA / 1000000.0;
     dec = stardata->Dec / 100000.0;
     setType(SkyObject::STAR);
-    setMag(stardata->mag / 100.0);
+    setMag(magnitude(stardata));
     setRA0(ra);
     setDec0(dec);
     setRA(ra0());
@@ -195,38 +199,21 @@ void StarObject::init(const starData *stardata)
 
 void StarObject::init(const deepStarData *stardata)
 {
-    double ra, dec, BV_Index;
+    double ra, dec;
 
     ra  = stardata->RA / 1000000.0;
     dec = stardata->Dec / 100000.0;
     setType(SkyObject::STAR);
 
-    if (stardata->V == 30000 && stardata->B != 30000)
-        setMag((stardata->B - 1600) / 1000.0); // FIXME: Is it okay to make up stuff like this?
-    else
-        setMag(stardata->V / 1000.0);
+    setMag(magnitude(stardata));
 
     setRA0(ra);
     setDec0(dec);
     setRA(ra);
     setDec(dec);
 
+    SpType[0] = spectralClass(stardata);
     SpType[1] = '?';
-    SpType[0] = 'B';
-    if (stardata->B == 30000 || stardata->V == 30000)
-    {
-        BV_Index  = -100;
-        SpType[0] = '?';
-    }
-    else
-    {
-        BV_Index = (stardata->B - stardata->V) / 1000.0;
-        (BV_Index > 0.0) && (SpType[0] = 'A');
-        (BV_Index > 0.325) && (SpType[0] = 'F');
-        (BV_Index > 0.575) && (SpType[0] = 'G');
-        (BV_Index > 0.975) && (SpType[0] = 'K');
-        (BV_Index > 1.6) && (SpType[0] = 'M');
-    }
 
     PM_RA        = stardata->dRA / 100.0;
     PM_Dec       = stardata->dDec / 100.0;
@@ -239,6 +226,39 @@ void StarObject::init(const deepStarData *stardata)
     lastPrecessJD          = J2000;
 }
 
+float StarObject::magnitude(const starData *stardata)
+{
+    return stardata->mag / 100.0;
+}
+
+float StarObject::magnitude(const deepStarData *stardata)
+{
+    if (stardata->V == 30000 && stardata->B != 30000)
+        return (stardata->B - 1600) / 1000.0; // FIXME: Is it okay to make up stuff like this?
+    return stardata->V / 1000.0;
+}
+
+char StarObject::spectralClass(const starData *stardata)
+{
+    return stardata->spec_type[0];
+}
+
+char StarObject::spectralClass(const deepStarData *stardata)
+{
+    if (stardata->B == 30000 || stardata->V == 30000)
+        return '?';
+
+    double BV_Index = (stardata->B - stardata->V) / 1000.0;
+    char spchar     = 'B';
+
+    (BV_Index > 0.0) && (spchar = 'A');
+    (BV_Index > 0.325) && (spchar = 'F');
+    (BV_Index > 0.575) && (spchar = 'G');
+    (BV_Index > 0.975) && (spchar = 'K');
+    (BV_Index > 1.6) && (spchar = 'M');
+    return spchar;
+}
+
 void StarObject::setNames(QString name, QString name2)
 {
     QString lname;
@@ -113,6 +113,14 @@ class StarObject : public SkyObject
          */
     void init(const deepStarData *stardata);
 
+    /** @return The magnitude that init() gives to the star described by stardata */
+    static float magnitude(const starData *stardata);
+    static float magnitude(const deepStarData *stardata);
+
+    /** @return The first character of the spectral type that init() gives to the star described by stardata */
+    static char spectralClass(const starData *stardata);
+    static char spectralClass(const deepStarData *stardata);
+
     /**
          *@short  Sets the name, genetive name, and long name
          *
@@ -279,6 +287,11 @@ class StarObject : public SkyObject
 #ifdef PROFILE_UPDATECOORDS
     static double updateCoordsCpuTime;
     static unsigned int starsUpdated;
+    // The same for stars of a StarBlock, updated in batches through ApparentPlace
+    static double batchUpdateCoordsCpuTime;
+    static unsigned int starsBatchUpdated;
+    static double batchHorizontalCpuTime;
+    static unsigned int starsBatchHorizontal;
 #endif
 
     void initPopupMenu(KSPopupMenu *pmenu) Q_DECL_OVERRIDE;
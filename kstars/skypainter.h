@@ -125,6 +125,15 @@ class SkyPainter
             */
     virtual bool drawPointSource(SkyPoint *loc, float mag, char sp = 'A') = 0;
 
+    /** @short Draw a point source that was already projected by Projector::toScreenBatch()
+            @param pos the screen position of the source
+            @param flags the Projector::PointFlag values of the source
+            @param mag the magnitude of the source
+            @param sp the spectral class of the source
+            @return true if a source was drawn
+            */
+    virtual bool drawProjectedPointSource(const QPointF &pos, quint8 flags, float mag, char sp = 'A') = 0;
+
     /** @short Draw a deep sky object
             @param obj the object to draw
             @param drawImage if true, try to draw the image of the object
@@ -537,6 +537,16 @@ bool SkyQPainter::drawPointSource(SkyPoint *loc, float mag, char sp)
     }
 }
 
+bool SkyQPainter::drawProjectedPointSource(const QPointF &pos, quint8 flags, float mag, char sp)
+{
+    if ((flags & (Projector::PointVisible | Projector::PointOnScreen)) !=
+        (Projector::PointVisible | Projector::PointOnScreen))
+        return false;
+
+    drawPointSource(pos, starWidth(mag), sp);
+    return true;
+}
+
 void SkyQPainter::drawPointSource(const QPointF &pos, float size, char sp)
 {
     int isize = qMin(static_cast<int>(size), 14);
@@ -76,6 +76,7 @@ class SkyQPainter : public SkyPainter, public QPainter
     void drawSkyPolyline(LineList *list, SkipList *skipList = 0, LineListLabel *label = 0) Q_DECL_OVERRIDE;
     void drawSkyPolygon(LineList *list, bool forceClip = true) Q_DECL_OVERRIDE;
     bool drawPointSource(SkyPoint *loc, float mag, char sp = 'A') Q_DECL_OVERRIDE;
+    bool drawProjectedPointSource(const QPointF &pos, quint8 flags, float mag, char sp = 'A') Q_DECL_OVERRIDE;
     bool drawDeepSkyObject(DeepSkyObject *obj, bool drawImage = false) Q_DECL_OVERRIDE;
     bool drawPlanet(KSPlanetBase *planet) Q_DECL_OVERRIDE;
     void drawObservingList(const QList<SkyObject *> &obs) Q_DECL_OVERRIDE;